@@ -10,6 +10,8 @@ usage() {
     echo "  -c <channels>, default 2"
     echo "  -h shows this text"
     echo "  -i <input wav>, default /usr/share/sounds/alsa/Front_Center.wav"
+    echo "  -j runs the pipelines of each core in host threads and compares"
+    echo "     the output with a single threaded run, not available with -x"
     echo "  -k keep temporary files in /tmp"
     echo "  -m <module>, default gain"
     echo "  -n <pipelines>, default 1,2"
@@ -29,6 +31,9 @@ usage() {
     echo "Example: check component eqiir with valgrind"
     echo "$0 -v -m eqiir"
     echo
+    echo "Example: check threaded run with the DAI pipelines on core 1"
+    echo "$0 -j -t development/sof-hda-benchmark-gain32-cores.tplg"
+    echo
 }
 
 if [ -z "${SOF_WORKSPACE}" ]; then
@@ -47,6 +52,7 @@ CHANNELS_OUT=2
 PIPELINES="1,2"
 INFILE1=$(mktemp --tmpdir=/tmp in-XXXX.raw)
 OUTFILE1=$(mktemp --tmpdir=/tmp out-XXXX.raw)
+OUTFILE2=$(mktemp --tmpdir=/tmp out-XXXX.raw)
 TRACEFILE=$(mktemp --tmpdir=/tmp trace-XXXX.txt)
 PROFILEOUT=$(mktemp --tmpdir=/tmp profile-XXXX.out)
 KEEP_TMP=false
@@ -55,7 +61,7 @@ PROFILE=false
 TPLG0=
 VALGRIND=
 
-while getopts "b:c:hi:km:n:o:p:r:t:vx" opt; do
+while getopts "b:c:hi:jkm:n:o:p:r:t:vx" opt; do
     case "${opt}" in
         b)
 	    BITS=${OPTARG}
@@ -71,6 +77,9 @@ while getopts "b:c:hi:km:n:o:p:r:t:vx" opt; do
         i)
 	    CLIP=${OPTARG}
 	    ;;
+	j)
+	    THREADS=true
+	    ;;
 	k)
 	    KEEP_TMP=true
 	    ;;
@@ -167,6 +176,18 @@ else
     if [ -n "$VALGRIND" ]; then
 	cat "$TRACEFILE"
     fi
+    if [[ "$THREADS" == true ]]; then
+	echo "Running testbench with threads, output: $OUTFILE2"
+	OPTS_J="${OPTS/-o $OUTFILE1/-o $OUTFILE2} -j"
+	$VALGRIND "$TB4" $OPTS_J 2> "$TRACEFILE" || {
+	    cat "$TRACEFILE"
+	    exit $?
+	}
+	cmp "$OUTFILE1" "$OUTFILE2" || {
+	    echo "Error: threaded output differs from single threaded output"
+	    exit 1
+	}
+    fi
 fi
 
 if [ -n "$OUTWAV" ]; then
@@ -180,5 +201,5 @@ fi
 
 if [[ "$KEEP_TMP" == false ]]; then
     echo Deleting temporary files
-    rm -f "$INFILE1" "$OUTFILE1" "$TRACEFILE" "$PROFILEOUT"
+    rm -f "$INFILE1" "$OUTFILE1" "$OUTFILE2" "$TRACEFILE" "$PROFILEOUT"
 fi
@@ -11,12 +11,31 @@
 #ifndef __ARCH_SPINLOCK_H__
 #define __ARCH_SPINLOCK_H__
 
+#include <stdint.h>
+
+/* host threads stand in for the cores, so the lock is real */
 struct k_spinlock {
+	uint32_t lock;
+#if CONFIG_DEBUG_LOCKS
+	uint32_t user;
+#endif
 };
 
-static inline void arch_spinlock_init(struct k_spinlock *lock) {}
-static inline void arch_spin_lock(struct k_spinlock *lock) {}
-static inline void arch_spin_unlock(struct k_spinlock *lock) {}
+static inline void arch_spinlock_init(struct k_spinlock *lock)
+{
+	lock->lock = 0;
+}
+
+static inline void arch_spin_lock(struct k_spinlock *lock)
+{
+	while (__atomic_exchange_n(&lock->lock, 1, __ATOMIC_ACQUIRE))
+		;
+}
+
+static inline void arch_spin_unlock(struct k_spinlock *lock)
+{
+	__atomic_store_n(&lock->lock, 0, __ATOMIC_RELEASE);
+}
 
 #endif /* __ARCH_SPINLOCK_H__ */
 
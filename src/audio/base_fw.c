@@ -382,6 +382,24 @@ int schedulers_info_get(uint32_t *data_off_size,
 	return IPC4_SUCCESS;
 }
 
+static int basefw_dp_load_info_get(uint32_t *data_offset, char *data)
+{
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	struct ipc4_dp_load_info *info = (struct ipc4_dp_load_info *)data;
+	int i;
+
+	info->core_count = CONFIG_CORE_COUNT;
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		scheduler_dp_load_get(i, &info->cores[i]);
+
+	*data_offset = sizeof(*info) + CONFIG_CORE_COUNT * sizeof(info->cores[0]);
+
+	return IPC4_SUCCESS;
+#else
+	return IPC4_UNAVAILABLE;
+#endif
+}
+
 static int basefw_pipeline_list_info_get(uint32_t *data_offset, char *data)
 {
 	struct ipc4_pipeline_set_state_data *ppl_data = (struct ipc4_pipeline_set_state_data *)data;
@@ -407,11 +425,102 @@ static int basefw_pipeline_list_info_get(uint32_t *data_offset, char *data)
 	return IPC4_SUCCESS;
 }
 
+#if CONFIG_COMP_PROFILE
+/* the IPC payload mirrors struct comp_profile layout */
+STATIC_ASSERT(IPC4_MODULE_PROFILE_PHASES == COMP_PROFILE_PHASE_COUNT,
+	      module_profile_phase_mismatch);
+STATIC_ASSERT(IPC4_MODULE_PROFILE_HIST_BUCKETS == COMP_PROFILE_HIST_BUCKETS,
+	      module_profile_hist_mismatch);
+
+static void module_profile_set_state(enum ipc4_perf_measurements_state_set state)
+{
+	struct ipc *ipc = ipc_get();
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+
+	comp_profile_enable(state == IPC4_PERF_MEASUREMENTS_STARTED);
+
+	if (state != IPC4_PERF_MEASUREMENTS_STOPPED)
+		return;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type == COMP_TYPE_COMPONENT)
+			comp_profile_reset(comp_dev_profile(icd->cd));
+	}
+}
+
+static void module_profile_item_fill(struct ipc4_module_profile_item *item,
+				     struct comp_dev *dev)
+{
+	const struct comp_profile *prof = comp_dev_profile(dev);
+	uint32_t ticks;
+	int i;
+
+	ticks = prof->phase[COMP_PROFILE_COPY].count;
+	item->resource_id = dev->ipc_config.id;
+	item->avg_bytes = ticks ? prof->total_bytes / ticks : 0;
+	item->peak_bytes = prof->peak_bytes;
+
+	for (i = 0; i < COMP_PROFILE_PHASE_COUNT; i++) {
+		const struct comp_profile_stats *stats = &prof->phase[i];
+		struct ipc4_module_profile_phase_data *phase = &item->phase[i];
+
+		phase->count = stats->count;
+		phase->min_cycles = stats->min;
+		phase->avg_cycles = stats->count ? stats->total / stats->count : 0;
+		phase->max_cycles = stats->max;
+		phase->p99_cycles = comp_profile_percentile(stats, 990);
+		memcpy_s(phase->hist, sizeof(phase->hist), stats->hist, sizeof(stats->hist));
+	}
+}
+
+static int module_profile_data_get(uint32_t *data_off_size, char *data)
+{
+	struct ipc4_module_profile_data *profile_data = (struct ipc4_module_profile_data *)data;
+	const size_t max_items = (SOF_IPC_MSG_MAX_SIZE - sizeof(*profile_data)) /
+				 sizeof(profile_data->profile_items[0]);
+	struct ipc *ipc = ipc_get();
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	uint32_t count = 0;
+
+	list_for_item(clist, &ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT)
+			continue;
+
+		if (count == max_items) {
+			tr_warn(&basefw_comp_tr, "module profile truncated to %u items", count);
+			break;
+		}
+
+		module_profile_item_fill(&profile_data->profile_items[count++], icd->cd);
+	}
+
+	profile_data->item_count = count;
+	*data_off_size = sizeof(*profile_data) + count * sizeof(profile_data->profile_items[0]);
+
+	return IPC4_SUCCESS;
+}
+#else
+static inline void module_profile_set_state(enum ipc4_perf_measurements_state_set state)
+{
+}
+
+static int module_profile_data_get(uint32_t *data_off_size, char *data)
+{
+	return IPC4_UNAVAILABLE;
+}
+#endif
+
 int set_perf_meas_state(const char *data)
 {
-#ifdef CONFIG_SOF_TELEMETRY
 	enum ipc4_perf_measurements_state_set state = *data;
 
+	module_profile_set_state(state);
+
+#ifdef CONFIG_SOF_TELEMETRY
 	switch (state) {
 	case IPC4_PERF_MEASUREMENTS_DISABLED:
 		disable_performance_counters();
@@ -437,8 +546,12 @@ int set_perf_meas_state(const char *data)
 	return IPC4_SUCCESS;
 }
 
-static int extended_global_perf_data_get(uint32_t *data_off_size, char *data)
+static int extended_global_perf_data_get(uint32_t *data_off_size, char *data,
+					 uint32_t instance)
 {
+	if (instance == IPC4_EXT_PERF_DATA_MODULE_PROFILE)
+		return module_profile_data_get(data_off_size, data);
+
 #ifdef CONFIG_SOF_TELEMETRY_PERFORMANCE_MEASUREMENTS
 	int ret;
 	struct extended_global_perf_data *perf_data = (struct extended_global_perf_data *)data;
@@ -547,12 +660,15 @@ static int basefw_get_large_config(struct comp_dev *dev,
 					 extended_param_id.part.parameter_instance);
 	case IPC4_PIPELINE_LIST_INFO_GET:
 		return basefw_pipeline_list_info_get(data_offset, data);
+	case IPC4_DP_LOAD_INFO_GET:
+		return basefw_dp_load_info_get(data_offset, data);
 	case IPC4_MODULES_INFO_GET:
 		return basefw_modules_info_get(data_offset, data);
 	case IPC4_LIBRARIES_INFO_GET:
 		return basefw_libraries_info_get(data_offset, data);
 	case IPC4_EXTENDED_GLOBAL_PERF_DATA:
-		return extended_global_perf_data_get(data_offset, data);
+		return extended_global_perf_data_get(data_offset, data,
+						     extended_param_id.part.parameter_instance);
 	case IPC4_GLOBAL_PERF_DATA:
 		return global_perf_data_get(data_offset, data);
 	case IPC4_IO_PERF_MEASUREMENTS_STATE:
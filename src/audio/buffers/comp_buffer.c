@@ -59,7 +59,7 @@ static int comp_buffer_release_data(struct sof_source *source, size_t free_size)
 	struct comp_buffer *buffer = comp_buffer_get_from_source(source);
 
 	if (free_size)
-		audio_stream_consume(&buffer->stream, free_size);
+		buffer_stream_consume(buffer, free_size);
 
 	return 0;
 }
@@ -92,7 +92,7 @@ static int comp_buffer_commit_buffer(struct sof_sink *sink, size_t commit_size)
 
 	if (commit_size) {
 		buffer_stream_writeback(buffer, commit_size);
-		audio_stream_produce(&buffer->stream, commit_size);
+		buffer_stream_produce(buffer, commit_size);
 	}
 
 	return 0;
@@ -214,6 +214,7 @@ static struct comp_buffer *buffer_alloc_struct(void *stream_addr, size_t size, u
 
 	list_init(&buffer->source_list);
 	list_init(&buffer->sink_list);
+	k_spinlock_init(&buffer->lock);
 
 	return buffer;
 }
@@ -474,7 +475,7 @@ void comp_update_buffer_produce(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
-	audio_stream_produce(&buffer->stream, bytes);
+	buffer_stream_produce(buffer, bytes);
 
 	notifier_event(buffer, NOTIFIER_ID_BUFFER_PRODUCE,
 		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
@@ -517,7 +518,7 @@ void comp_update_buffer_consume(struct comp_buffer *buffer, uint32_t bytes)
 		return;
 	}
 
-	audio_stream_consume(&buffer->stream, bytes);
+	buffer_stream_consume(buffer, bytes);
 
 	notifier_event(buffer, NOTIFIER_ID_BUFFER_CONSUME,
 		       NOTIFIER_TARGET_CORE_LOCAL, &cb_data, sizeof(cb_data));
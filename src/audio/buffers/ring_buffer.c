@@ -83,6 +83,38 @@ static inline void ring_buffer_writeback_shared(struct ring_buffer *ring_buffer,
 	dcache_writeback_region(ptr, size);
 }
 
+/*
+ * Offsets accessors. Each offset is located in its own cache line and has exactly one writer.
+ * In shared mode the writer writes the line back right after the update and the reader
+ * invalidates it right before reading, so only the single metadata line travels between cores.
+ */
+static inline size_t ring_buffer_load_offset(struct ring_buffer *ring_buffer,
+					     atomic_t __sparse_cache *offset)
+{
+	if (ring_buffer_is_shared(ring_buffer))
+		dcache_invalidate_region(offset, sizeof(*offset));
+
+	return atomic_read((__sparse_force atomic_t *)offset);
+}
+
+static inline void ring_buffer_store_offset(struct ring_buffer *ring_buffer,
+					    atomic_t __sparse_cache *offset, size_t value)
+{
+	atomic_set((__sparse_force atomic_t *)offset, value);
+
+	if (ring_buffer_is_shared(ring_buffer))
+		dcache_writeback_region(offset, sizeof(*offset));
+}
+
+static inline size_t ring_buffer_get_write_offset(struct ring_buffer *ring_buffer)
+{
+	return ring_buffer_load_offset(ring_buffer, &ring_buffer->_offsets->write_offset);
+}
+
+static inline size_t ring_buffer_get_read_offset(struct ring_buffer *ring_buffer)
+{
+	return ring_buffer_load_offset(ring_buffer, &ring_buffer->_offsets->read_offset);
+}
 
 /**
  * @brief remove the queue from the list, free memory
@@ -103,8 +135,8 @@ static void ring_buffer_reset(struct sof_audio_buffer *audio_buffer)
 	struct ring_buffer *ring_buffer =
 			container_of(audio_buffer, struct ring_buffer, audio_buffer);
 
-	ring_buffer->_write_offset = 0;
-	ring_buffer->_read_offset = 0;
+	ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->write_offset, 0);
+	ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->read_offset, 0);
 
 	ring_buffer_invalidate_shared(ring_buffer, ring_buffer->_data_buffer,
 				      ring_buffer->data_buffer_size);
@@ -138,7 +170,8 @@ size_t ring_buffer_inc_offset(struct ring_buffer *ring_buffer, size_t offset, si
 static inline
 size_t _ring_buffer_get_data_available(struct ring_buffer *ring_buffer)
 {
-	int32_t avail_data =  ring_buffer->_write_offset - ring_buffer->_read_offset;
+	int32_t avail_data = ring_buffer_get_write_offset(ring_buffer) -
+			     ring_buffer_get_read_offset(ring_buffer);
 	/* wrap around ? 2*size because of "double area" */
 	if (avail_data < 0)
 		avail_data = 2 * ring_buffer->data_buffer_size + avail_data;
@@ -166,14 +199,16 @@ static int ring_buffer_get_buffer(struct sof_sink *sink, size_t req_size,
 				  void **data_ptr, void **buffer_start, size_t *buffer_size)
 {
 	struct ring_buffer *ring_buffer = ring_buffer_from_sink(sink);
+	size_t write_offset;
 
 	CORE_CHECK_STRUCT(&ring_buffer->audio_buffer);
 	if (req_size > ring_buffer_get_free_size(sink))
 		return -ENODATA;
 
+	write_offset = ring_buffer_get_write_offset(ring_buffer);
+
 	/* note, __sparse_force is to be removed once sink/src use __sparse_cache for data ptrs */
-	*data_ptr = (__sparse_force void *)ring_buffer_get_pointer(ring_buffer,
-								   ring_buffer->_write_offset);
+	*data_ptr = (__sparse_force void *)ring_buffer_get_pointer(ring_buffer, write_offset);
 	*buffer_start = (__sparse_force void *)ring_buffer->_data_buffer;
 	*buffer_size = ring_buffer->data_buffer_size;
 
@@ -184,18 +219,19 @@ static int ring_buffer_get_buffer(struct sof_sink *sink, size_t req_size,
 static int ring_buffer_commit_buffer(struct sof_sink *sink, size_t commit_size)
 {
 	struct ring_buffer *ring_buffer = ring_buffer_from_sink(sink);
+	size_t write_offset;
 
 	CORE_CHECK_STRUCT(&ring_buffer->audio_buffer);
 	if (commit_size) {
+		write_offset = ring_buffer_get_write_offset(ring_buffer);
 		ring_buffer_writeback_shared(ring_buffer,
-					     ring_buffer_get_pointer(ring_buffer,
-								     ring_buffer->_write_offset),
+					     ring_buffer_get_pointer(ring_buffer, write_offset),
 					     commit_size);
 
-		/* move write pointer */
-		ring_buffer->_write_offset = ring_buffer_inc_offset(ring_buffer,
-								    ring_buffer->_write_offset,
-								    commit_size);
+		/* move write pointer, data must be written back before it becomes visible */
+		write_offset = ring_buffer_inc_offset(ring_buffer, write_offset, commit_size);
+		ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->write_offset,
+					 write_offset);
 	}
 
 	return 0;
@@ -212,7 +248,7 @@ static int ring_buffer_get_data(struct sof_source *source, size_t req_size,
 	if (req_size > ring_buffer_get_data_available(source))
 		return -ENODATA;
 
-	data_ptr_c = ring_buffer_get_pointer(ring_buffer, ring_buffer->_read_offset);
+	data_ptr_c = ring_buffer_get_pointer(ring_buffer, ring_buffer_get_read_offset(ring_buffer));
 
 	/* clean cache in provided data range */
 	ring_buffer_invalidate_shared(ring_buffer, data_ptr_c, req_size);
@@ -227,13 +263,16 @@ static int ring_buffer_get_data(struct sof_source *source, size_t req_size,
 static int ring_buffer_release_data(struct sof_source *source, size_t free_size)
 {
 	struct ring_buffer *ring_buffer = ring_buffer_from_source(source);
+	size_t read_offset;
 
 	CORE_CHECK_STRUCT(&ring_buffer->audio_buffer);
 	if (free_size) {
-		/* data consumed, free buffer space, no need for any special cache operations */
-		ring_buffer->_read_offset = ring_buffer_inc_offset(ring_buffer,
-								   ring_buffer->_read_offset,
-								   free_size);
+		/* data consumed, free buffer space, no need for any cache operations on data */
+		read_offset = ring_buffer_inc_offset(ring_buffer,
+						     ring_buffer_get_read_offset(ring_buffer),
+						     free_size);
+		ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->read_offset,
+					 read_offset);
 	}
 
 	return 0;
@@ -333,14 +372,20 @@ struct ring_buffer *ring_buffer_create(size_t min_available, size_t min_free_spa
 	 */
 	ring_buffer->data_buffer_size = 3 * max_ibs_obs;
 
-	/* allocate data buffer - always in cached memory alias */
+	/* allocate data buffer and offsets behind it - always in cached memory alias */
 	ring_buffer->data_buffer_size =
 			ALIGN_UP(ring_buffer->data_buffer_size, PLATFORM_DCACHE_ALIGN);
 	ring_buffer->_data_buffer = (__sparse_force __sparse_cache void *)
-			rballoc_align(0, 0, ring_buffer->data_buffer_size, PLATFORM_DCACHE_ALIGN);
+			rballoc_align(0, 0, ring_buffer->data_buffer_size +
+				      sizeof(struct ring_buffer_offsets), PLATFORM_DCACHE_ALIGN);
 	if (!ring_buffer->_data_buffer)
 		goto err;
 
+	ring_buffer->_offsets = (struct ring_buffer_offsets __sparse_cache *)
+			ring_buffer_buffer_end(ring_buffer);
+	ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->write_offset, 0);
+	ring_buffer_store_offset(ring_buffer, &ring_buffer->_offsets->read_offset, 0);
+
 	tr_info(&ring_buffer_tr, "Ring buffer created, id: %u shared: %u min_available: %u min_free_space %u, size %u",
 		id, ring_buffer_is_shared(ring_buffer), min_available, min_free_space,
 		ring_buffer->data_buffer_size);
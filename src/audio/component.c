@@ -497,9 +497,13 @@ int comp_copy(struct comp_dev *dev)
 #ifdef CONFIG_SOF_TELEMETRY_PERFORMANCE_MEASUREMENTS
 		const uint32_t begin_stamp = (uint32_t)telemetry_timestamp();
 #endif
+		/* DP modules process in their own thread, only the LL side copy is profiled */
+		comp_profile_begin(comp_dev_profile(dev));
 
 		ret = dev->drv->ops.copy(dev);
 
+		comp_profile_end(comp_dev_profile(dev));
+
 #ifdef CONFIG_SOF_TELEMETRY_PERFORMANCE_MEASUREMENTS
 		const uint32_t cycles_consumed = (uint32_t)telemetry_timestamp() - begin_stamp;
 
@@ -565,6 +569,66 @@ bool comp_update_performance_data(struct comp_dev *dev, uint32_t cycles_used)
 }
 #endif
 
+#if CONFIG_COMP_PROFILE
+atomic_t comp_profile_active;
+
+void comp_profile_enable(bool enable)
+{
+	atomic_set(&comp_profile_active, enable);
+}
+
+void comp_profile_reset(struct comp_profile *prof)
+{
+	memset(prof, 0, sizeof(*prof));
+}
+
+void comp_profile_stats_add(struct comp_profile_stats *stats, uint32_t cycles)
+{
+	uint32_t bucket = cycles >> COMP_PROFILE_HIST_SHIFT;
+	uint32_t idx = 0;
+
+	/* bucket index is the bit length of the scaled sample */
+	while (bucket && idx < COMP_PROFILE_HIST_BUCKETS - 1) {
+		bucket >>= 1;
+		idx++;
+	}
+	stats->hist[idx]++;
+
+	if (!stats->count || cycles < stats->min)
+		stats->min = cycles;
+	if (cycles > stats->max)
+		stats->max = cycles;
+	stats->total += cycles;
+	stats->count++;
+}
+
+uint32_t comp_profile_percentile(const struct comp_profile_stats *stats, uint32_t permille)
+{
+	uint64_t target;
+	uint32_t seen = 0;
+	uint32_t upper;
+	int i;
+
+	if (!stats->count)
+		return 0;
+
+	/* rank of the requested sample, rounded up */
+	target = ((uint64_t)stats->count * permille + 999) / 1000;
+	for (i = 0; i < COMP_PROFILE_HIST_BUCKETS - 1; i++) {
+		seen += stats->hist[i];
+		if (seen >= target)
+			break;
+	}
+
+	/* the last bucket is open ended */
+	if (i == COMP_PROFILE_HIST_BUCKETS - 1)
+		return stats->max;
+
+	upper = (1U << (COMP_PROFILE_HIST_SHIFT + i)) - 1;
+	return MIN(upper, stats->max);
+}
+#endif
+
 #if CONFIG_IPC_MAJOR_4
 static uint32_t get_sample_group_size_in_bytes(const struct ipc4_audio_format fmt)
 {
@@ -551,6 +551,11 @@ int copier_dai_params(struct copier_data *cd, struct comp_dev *dev,
 		cd->dd[0]->process =
 			get_converter_func(&in_fmt, &out_fmt, cd->gtw_type, dir, cd->dd[0]->chmap);
 
+		/* gain is applied to the local buffer on capture only */
+		if (cd->dd[0]->gain_data && dir == ipc4_capture)
+			cd->dd[0]->gain_data->convert =
+				get_gain_converter_func(cd->dd[0]->process, &in_fmt, &out_fmt);
+
 		return ret;
 	}
 
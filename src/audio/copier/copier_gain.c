@@ -61,6 +61,48 @@ int copier_gain_set_params(struct comp_dev *dev, struct dai_data *dd)
 	return ret;
 }
 
+int copier_gain_copy_input(struct comp_dev *dev, struct dai_data *dd,
+			   enum copier_gain_envelope_dir dir, uint32_t stream_bytes)
+{
+	struct copier_gain_params *gain_params = dd->gain_data;
+	struct comp_buffer *local_buffer = dd->local_buffer;
+	uint32_t samples;
+	int ret;
+
+	if (!gain_params)
+		return -EINVAL;
+
+	/* The most common case of a static non unity gain only reads and writes
+	 * the samples once. The local buffer and the DMA buffer have the same frame
+	 * size when there is a fused function. copier_gain_input() applies the gain
+	 * from the read pointer, the fused function from the write pointer, so they
+	 * only cover the same samples when the local buffer is empty.
+	 */
+	if (gain_params->convert && !gain_params->unity_gain &&
+	    !audio_stream_get_avail_bytes(&local_buffer->stream) &&
+	    copier_gain_eval_state(gain_params) == STATIC_GAIN) {
+		samples = stream_bytes / audio_stream_sample_bytes(&dd->dma_buffer->stream);
+		if (gain_params->convert(&dd->dma_buffer->stream, &local_buffer->stream,
+					 gain_params, samples, dd->chmap)) {
+			buffer_stream_writeback(local_buffer, stream_bytes);
+			comp_update_buffer_produce(local_buffer, stream_bytes);
+			return 0;
+		}
+	}
+
+	/*
+	 * The PCM converter functions used during DMA buffer copy can never fail,
+	 * so no need to check the return value of stream_copy_from_no_consume().
+	 */
+	stream_copy_from_no_consume(dd->dma_buffer, local_buffer, dd->process,
+				    stream_bytes, dd->chmap);
+
+	ret = copier_gain_input(dev, local_buffer, gain_params, dir, stream_bytes);
+	buffer_stream_writeback(local_buffer, stream_bytes);
+
+	return ret;
+}
+
 int copier_gain_input(struct comp_dev *dev, struct comp_buffer *buff,
 		      struct copier_gain_params *gain_params,
 		      enum copier_gain_envelope_dir dir, uint32_t stream_bytes)
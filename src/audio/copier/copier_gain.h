@@ -9,6 +9,8 @@
 #define __SOF_COPIER_GAIN_H__
 
 #include <sof/audio/buffer.h>
+#include <sof/audio/pcm_converter.h>
+#include <ipc4/base-config.h>
 #include <ipc4/base_fw.h>
 #include <ipc/dai.h>
 #if SOF_USE_HIFI(3, COPIER) || SOF_USE_HIFI(4, COPIER) || SOF_USE_HIFI(5, COPIER)
@@ -72,6 +74,41 @@ enum copier_gain_envelope_dir {
 	GAIN_SUBTRACT, /**< gain envelope subtract direction */
 };
 
+struct copier_gain_params;
+
+/**
+ * @brief Conversion of DMA data into the local buffer that applies a static gain
+ * in the same pass.
+ *
+ * @param source Stream to convert from, data is not consumed.
+ * @param sink Stream to convert to, data is not produced.
+ * @param gain_params The pointer to the copier_gain_params structure.
+ * @param samples The number of source samples to convert.
+ * @param chmap The channel map, 0xf in a sink channel nibble mutes the channel.
+ * @return The number of converted samples, 0 if the caller has to convert and
+ * apply the gain separately.
+ */
+typedef int (*copier_gain_convert_func)(const struct audio_stream *source,
+					struct audio_stream *sink,
+					const struct copier_gain_params *gain_params,
+					uint32_t samples, uint32_t chmap);
+
+/**
+ * @brief Fused conversion and gain counterpart of a PCM converter function.
+ */
+struct copier_gain_convert_map {
+	uint32_t depth;			/**< container bits of the source and sink */
+	enum sof_ipc_frame source;	/**< source format of the PCM converter lookup */
+	enum sof_ipc_frame sink;	/**< sink format of the PCM converter lookup */
+	bool remap;			/**< PCM converter is a remapping one */
+	copier_gain_convert_func func;	/**< fused conversion and gain */
+};
+
+#if SOF_USE_HIFI(NONE, COPIER)
+extern const struct copier_gain_convert_map copier_gain_convert_map[];
+extern const size_t copier_gain_convert_count;
+#endif
+
 /**
  * @brief Structure representing the parameters for copier gain processing.
  */
@@ -99,6 +136,8 @@ struct copier_gain_params {
 	uint64_t gain_env;  /**< Gain envelope for fade-in calculated in high precision */
 	uint64_t step_i64;  /**< Step for fade-in envelope in high precision */
 	uint16_t channels_count; /**< Number of channels */
+	/**< Fused conversion and static gain, NULL when not available for the formats */
+	copier_gain_convert_func convert;
 };
 
 /** Gain Coefficients IO Control
@@ -183,6 +222,24 @@ int copier_gain_input32(struct comp_buffer *buff, enum copier_gain_state state,
 			enum copier_gain_envelope_dir dir,
 			struct copier_gain_params *gain_params, uint32_t frames);
 
+/**
+ * @brief Copies DMA data into the local buffer and applies gain to it.
+ *
+ * In the static gain state a non unity gain is applied by gain_params->convert in the
+ * same pass as the conversion, if the formats allow it and the local buffer is empty.
+ * copier_gain_input() applies the gain from the read pointer of the local buffer, so
+ * only then do both cover the same samples. Otherwise the data is converted with
+ * dd->process and the gain is applied by copier_gain_input().
+ *
+ * @param dev The pointer to the comp_dev structure representing the audio component device.
+ * @param dd The pointer to the DAI data structure.
+ * @param dir Direction of the gain envelope change.
+ * @param stream_bytes The number of bytes to copy from the DMA buffer.
+ * @return 0 on success, negative error code on failure.
+ */
+int copier_gain_copy_input(struct comp_dev *dev, struct dai_data *dd,
+			   enum copier_gain_envelope_dir dir, uint32_t stream_bytes);
+
 /**
  * @brief Applies gain to the input audio buffer, selects the appropriate gain method.
  *
@@ -239,4 +296,22 @@ bool copier_is_unity_gain(struct copier_gain_params *gain_params);
 int copier_gain_dma_control(union ipc4_connector_node_id node, const char *config_data,
 			    size_t config_size, enum sof_ipc_dai_type dai_type);
 
+/**
+ * Gets the fused conversion and static gain function counterpart of the PCM
+ * converter selected by get_converter_func().
+ *
+ * The fused function gives the same local buffer data as the PCM converter
+ * followed by copier_gain_input(). Only conversions that keep the frame size,
+ * for up to MAX_GAIN_COEFFS_CNT channels, have a fused version. HiFi builds
+ * have none and keep their SIMD gain pass.
+ *
+ * @param process The PCM converter function between the formats.
+ * @param in_fmt The source audio format.
+ * @param out_fmt The sink audio format.
+ * @return The fused function or NULL if not available.
+ */
+copier_gain_convert_func get_gain_converter_func(pcm_converter_func process,
+						 const struct ipc4_audio_format *in_fmt,
+						 const struct ipc4_audio_format *out_fmt);
+
 #endif /* __SOF_COPIER_GAIN_H__ */
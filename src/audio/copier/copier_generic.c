@@ -5,11 +5,13 @@
 // Author: Andrula Song <xiaoyuan.song@intel.com>
 
 #include <ipc4/base-config.h>
+#include <ipc4/module.h>
 #include <sof/audio/component_ext.h>
 #include <module/module/base.h>
 #include <sof/common.h>
 #include <ipc/dai.h>
 #include "copier.h"
+#include "copier_gain.h"
 
 LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 
@@ -22,7 +24,6 @@ LOG_MODULE_DECLARE(copier, CONFIG_SOF_LOG_LEVEL);
 #include <stddef.h>
 #include <errno.h>
 #include <stdint.h>
-#include "copier_gain.h"
 
 int apply_attenuation(struct comp_dev *dev, struct copier_data *cd,
 		      struct comp_buffer *sink, int frame)
@@ -298,6 +299,179 @@ bool copier_is_unity_gain(struct copier_gain_params *gain_params)
 	return true;
 }
 
+static int copier_gain_remap16(const struct audio_stream *source,
+			       struct audio_stream *sink,
+			       const struct copier_gain_params *gain_params,
+			       uint32_t samples, uint32_t chmap)
+{
+	const int src_nch = audio_stream_get_channels(source);
+	const int nch = audio_stream_get_channels(sink);
+	const int frames = samples / src_nch;
+	int16_t *src, *dst;
+	int16_t gain;
+	int src_ch, ch, left, nmax, n, i;
+
+	for (ch = 0; ch < nch; ch++) {
+		src_ch = chmap & 0xf;
+		chmap >>= 4;
+
+		gain = gain_params->gain_coeffs[ch];
+		/* a muted channel is made of the first one with zero gain */
+		if (src_ch == 0xf) {
+			src_ch = 0;
+			gain = 0;
+		}
+
+		src = (int16_t *)audio_stream_get_rptr(source) + src_ch;
+		dst = (int16_t *)audio_stream_get_wptr(sink) + ch;
+
+		for (left = frames; left; left -= n) {
+			src = audio_stream_wrap(source, src);
+			dst = audio_stream_wrap(sink, dst);
+			nmax = audio_stream_samples_without_wrap_s16(sink, dst);
+			n = MIN(left, SOF_DIV_ROUND_UP(nmax, nch));
+			nmax = audio_stream_samples_without_wrap_s16(source, src);
+			n = MIN(n, SOF_DIV_ROUND_UP(nmax, src_nch));
+			for (i = 0; i < n; i++, src += src_nch, dst += nch)
+				*dst = q_multsr_sat_16x16(*src, gain, GAIN_Q10_INT_SHIFT);
+		}
+	}
+
+	return samples;
+}
+
+/* shift > 0 is a left shift of the samples, shift < 0 a right one */
+static inline int copier_gain_remap32(const struct audio_stream *source,
+				      struct audio_stream *sink,
+				      const struct copier_gain_params *gain_params,
+				      uint32_t samples, uint32_t chmap, int shift)
+{
+	const int src_nch = audio_stream_get_channels(source);
+	const int nch = audio_stream_get_channels(sink);
+	const int frames = samples / src_nch;
+	int32_t *src, *dst;
+	int32_t sample;
+	int16_t gain;
+	int src_ch, ch, left, nmax, n, i;
+
+	for (ch = 0; ch < nch; ch++) {
+		src_ch = chmap & 0xf;
+		chmap >>= 4;
+
+		/* Gain is in Q21.10 format */
+		gain = gain_params->gain_coeffs[ch];
+		/* a muted channel is made of the first one with zero gain */
+		if (src_ch == 0xf) {
+			src_ch = 0;
+			gain = 0;
+		}
+
+		src = (int32_t *)audio_stream_get_rptr(source) + src_ch;
+		dst = (int32_t *)audio_stream_get_wptr(sink) + ch;
+
+		for (left = frames; left; left -= n) {
+			src = audio_stream_wrap(source, src);
+			dst = audio_stream_wrap(sink, dst);
+			nmax = audio_stream_samples_without_wrap_s32(sink, dst);
+			n = MIN(left, SOF_DIV_ROUND_UP(nmax, nch));
+			nmax = audio_stream_samples_without_wrap_s32(source, src);
+			n = MIN(n, SOF_DIV_ROUND_UP(nmax, src_nch));
+			for (i = 0; i < n; i++, src += src_nch, dst += nch) {
+				sample = shift >= 0 ? *src << shift : *src >> -shift;
+				*dst = q_multsr_sat_32x32(sample, gain, GAIN_Q10_INT_SHIFT);
+			}
+		}
+	}
+
+	return samples;
+}
+
+/* the channel map of the conversions without remapping */
+#define COPIER_GAIN_CHMAP_IDENTITY	0x76543210
+
+static int copier_gain_copy16(const struct audio_stream *source, struct audio_stream *sink,
+			      const struct copier_gain_params *gain_params,
+			      uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap16(source, sink, gain_params, samples,
+				   COPIER_GAIN_CHMAP_IDENTITY);
+}
+
+static int copier_gain_copy32(const struct audio_stream *source, struct audio_stream *sink,
+			      const struct copier_gain_params *gain_params,
+			      uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples,
+				   COPIER_GAIN_CHMAP_IDENTITY, 0);
+}
+
+static int copier_gain_convert_s24_to_s32(const struct audio_stream *source,
+					  struct audio_stream *sink,
+					  const struct copier_gain_params *gain_params,
+					  uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples,
+				   COPIER_GAIN_CHMAP_IDENTITY, 8);
+}
+
+static int copier_gain_remap_c32(const struct audio_stream *source, struct audio_stream *sink,
+				 const struct copier_gain_params *gain_params,
+				 uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples, chmap, 0);
+}
+
+static int copier_gain_remap_c32_left_shift_8(const struct audio_stream *source,
+					      struct audio_stream *sink,
+					      const struct copier_gain_params *gain_params,
+					      uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples, chmap, 8);
+}
+
+static int copier_gain_remap_c32_right_shift_8(const struct audio_stream *source,
+					       struct audio_stream *sink,
+					       const struct copier_gain_params *gain_params,
+					       uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples, chmap, -8);
+}
+
+static int copier_gain_remap_c32_left_shift_16(const struct audio_stream *source,
+					       struct audio_stream *sink,
+					       const struct copier_gain_params *gain_params,
+					       uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples, chmap, 16);
+}
+
+static int copier_gain_remap_c32_right_shift_16(const struct audio_stream *source,
+						struct audio_stream *sink,
+						const struct copier_gain_params *gain_params,
+						uint32_t samples, uint32_t chmap)
+{
+	return copier_gain_remap32(source, sink, gain_params, samples, chmap, -16);
+}
+
+const struct copier_gain_convert_map copier_gain_convert_map[] = {
+	{ 16, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, false, copier_gain_copy16 },
+	{ 32, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, false, copier_gain_copy32 },
+	{ 32, SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, false,
+		copier_gain_convert_s24_to_s32 },
+	{ 16, SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, true, copier_gain_remap16 },
+	{ 32, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, true, copier_gain_remap_c32 },
+	{ 32, SOF_IPC_FRAME_S24_4LE, SOF_IPC_FRAME_S32_LE, true,
+		copier_gain_remap_c32_left_shift_8 },
+	{ 32, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S24_4LE, true,
+		copier_gain_remap_c32_right_shift_8 },
+	{ 32, SOF_IPC_FRAME_S16_4LE, SOF_IPC_FRAME_S32_LE, true,
+		copier_gain_remap_c32_left_shift_16 },
+	{ 32, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S16_4LE, true,
+		copier_gain_remap_c32_right_shift_16 },
+};
+
+const size_t copier_gain_convert_count = ARRAY_SIZE(copier_gain_convert_map);
+
 #endif
 
 void copier_update_params(struct copier_data *cd, struct comp_dev *dev,
@@ -567,3 +741,37 @@ pcm_converter_func get_converter_func(const struct ipc4_audio_format *in_fmt,
 	else
 		return pcm_get_conversion_vc_function(in, in_valid, out, out_valid, type, dir);
 }
+
+copier_gain_convert_func get_gain_converter_func(pcm_converter_func process,
+						 const struct ipc4_audio_format *in_fmt,
+						 const struct ipc4_audio_format *out_fmt)
+{
+#if SOF_USE_HIFI(NONE, COPIER)
+	const struct copier_gain_convert_map *map;
+	pcm_converter_func func;
+	size_t i;
+
+	/* copier_gain_input() covers as many local buffer bytes as were read from DMA */
+	if (!process || in_fmt->depth != out_fmt->depth ||
+	    in_fmt->channels_count != out_fmt->channels_count ||
+	    out_fmt->channels_count > MAX_GAIN_COEFFS_CNT)
+		return NULL;
+
+	/* the fused function of the very converter that get_converter_func() picked */
+	for (i = 0; i < copier_gain_convert_count; i++) {
+		map = &copier_gain_convert_map[i];
+		if (map->depth != in_fmt->depth)
+			continue;
+
+		if (map->remap)
+			func = pcm_get_remap_function(map->source, map->sink);
+		else
+			func = pcm_get_conversion_function(map->source, map->sink);
+
+		if (func == process)
+			return map->func;
+	}
+#endif
+
+	return NULL;
+}
@@ -118,13 +118,13 @@ extern const crossover_split crossover_split_fnmap[];
 extern const size_t crossover_split_fncount;
 
 /*
- * \brief Runs input in through the LR4 filter and returns it's output.
+ * \brief Runs a block x through the LR4 filter, the output replaces it.
  */
-static inline int32_t crossover_generic_process_lr4(int32_t in,
-						    struct iir_state_df1 *lr4)
+static inline void crossover_generic_process_lr4(int32_t *x, int frames,
+						 struct iir_state_df1 *lr4)
 {
 	/* Cascade two biquads with same coefficients in series. */
-	return iir_df1_4th(lr4, in);
+	iir_df1_4th_block(lr4, x, frames);
 }
 
 static inline void crossover_free_config(struct sof_crossover_config **config)
@@ -23,11 +23,18 @@
  */
 static inline void crossover_generic_lr4_split(struct iir_state_df1 *lp,
 					       struct iir_state_df1 *hp,
-					       int32_t x, int32_t *y1,
-					       int32_t *y2)
+					       const int32_t x[], int32_t y1[],
+					       int32_t y2[], int frames)
 {
-	*y1 = crossover_generic_process_lr4(x, lp);
-	*y2 = crossover_generic_process_lr4(x, hp);
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		y1[i] = x[i];
+		y2[i] = x[i];
+	}
+
+	crossover_generic_process_lr4(y1, frames, lp);
+	crossover_generic_process_lr4(y2, frames, hp);
 }
 
 /*
@@ -38,53 +45,65 @@ static inline void crossover_generic_lr4_split(struct iir_state_df1 *lp,
  * whereas the other two go through two LR4 filters. This causes the signals
  * to be out of phase. We need to pass the signal through another set of LR4
  * filters to align back the phase.
+ *
+ * The input x is used as scratch.
  */
 static inline void crossover_generic_lr4_merge(struct iir_state_df1 *lp,
 					       struct iir_state_df1 *hp,
-					       int32_t x, int32_t *y)
+					       int32_t x[], int32_t y[],
+					       int frames)
 {
-	int32_t z1, z2;
+	int i;
+
+	for (i = 0; i < frames; i++)
+		y[i] = x[i];
 
-	z1 = crossover_generic_process_lr4(x, lp);
-	z2 = crossover_generic_process_lr4(x, hp);
-	*y = sat_int32(((int64_t)z1) + z2);
+	crossover_generic_process_lr4(y, frames, lp);
+	crossover_generic_process_lr4(x, frames, hp);
+	for (i = 0; i < frames; i++)
+		y[i] = sat_int32(((int64_t)y[i]) + x[i]);
 }
 
-static void crossover_generic_split_2way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_2way(const int32_t in[],
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &out[0], &out[1]);
+				    in, out[0], out[1], frames);
 }
 
-static void crossover_generic_split_3way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_3way(const int32_t in[],
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
-	int32_t z1, z2;
+	int32_t z1[CROSSOVER_BLOCK_FRAMES];
+	int32_t z2[CROSSOVER_BLOCK_FRAMES];
 
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    in, &z1, &z2);
+				    in, z1, z2, frames);
 	/* Realign the phase of z1 */
 	crossover_generic_lr4_merge(&state->lowpass[1], &state->highpass[1],
-				    z1, &out[0]);
+				    z1, out[0], frames);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[1], &out[2]);
+				    z2, out[1], out[2], frames);
 }
 
-static void crossover_generic_split_4way(int32_t in,
-					 int32_t out[],
-					 struct crossover_state *state)
+static void crossover_generic_split_4way(const int32_t in[],
+					 int32_t *out[],
+					 struct crossover_state *state,
+					 int frames)
 {
-	int32_t z1, z2;
+	int32_t z1[CROSSOVER_BLOCK_FRAMES];
+	int32_t z2[CROSSOVER_BLOCK_FRAMES];
 
 	crossover_generic_lr4_split(&state->lowpass[1], &state->highpass[1],
-				    in, &z1, &z2);
+				    in, z1, z2, frames);
 	crossover_generic_lr4_split(&state->lowpass[0], &state->highpass[0],
-				    z1, &out[0], &out[1]);
+				    z1, out[0], out[1], frames);
 	crossover_generic_lr4_split(&state->lowpass[2], &state->highpass[2],
-				    z2, &out[2], &out[3]);
+				    z2, out[2], out[3], frames);
 }
 
 static void crossover_default_pass(struct comp_data *cd,
@@ -115,28 +134,40 @@ static void crossover_s16_default(struct comp_data *cd,
 	const struct audio_stream *source_stream = bsource->data;
 	struct audio_stream *sink_stream;
 	int16_t *x, *y;
-	int ch, i, j;
+	int ch, i, j, k, n;
 	int idx;
 	int nch = audio_stream_get_channels(source_stream);
-	int32_t out[num_sinks];
+	int32_t in[CROSSOVER_BLOCK_FRAMES];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][CROSSOVER_BLOCK_FRAMES];
+	int32_t *out_blocks[SOF_CROSSOVER_MAX_STREAMS];
+
+	for (j = 0; j < SOF_CROSSOVER_MAX_STREAMS; j++)
+		out_blocks[j] = out[j];
 
 	for (ch = 0; ch < nch; ch++) {
 		idx = ch;
 		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s16(source_stream, idx);
-			cd->crossover_split(*x << 16, out, state);
+		for (i = 0; i < frames; i += n) {
+			n = MIN(frames - i, CROSSOVER_BLOCK_FRAMES);
+			for (k = 0; k < n; k++) {
+				x = audio_stream_read_frag_s16(source_stream, idx + k * nch);
+				in[k] = *x << 16;
+			}
+
+			cd->crossover_split(in, out_blocks, state, n);
 
 			for (j = 0; j < num_sinks; j++) {
 				if (!bsinks[j])
 					continue;
 				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s16(sink_stream,
-								idx);
-				*y = sat_int16(Q_SHIFT_RND(out[j], 31, 15));
+				for (k = 0; k < n; k++) {
+					y = audio_stream_write_frag_s16(sink_stream,
+									idx + k * nch);
+					*y = sat_int16(Q_SHIFT_RND(out[j][k], 31, 15));
+				}
 			}
 
-			idx += nch;
+			idx += n * nch;
 		}
 	}
 }
@@ -153,28 +184,40 @@ static void crossover_s24_default(struct comp_data *cd,
 	const struct audio_stream *source_stream = bsource->data;
 	struct audio_stream *sink_stream;
 	int32_t *x, *y;
-	int ch, i, j;
+	int ch, i, j, k, n;
 	int idx;
 	int nch = audio_stream_get_channels(source_stream);
-	int32_t out[num_sinks];
+	int32_t in[CROSSOVER_BLOCK_FRAMES];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][CROSSOVER_BLOCK_FRAMES];
+	int32_t *out_blocks[SOF_CROSSOVER_MAX_STREAMS];
+
+	for (j = 0; j < SOF_CROSSOVER_MAX_STREAMS; j++)
+		out_blocks[j] = out[j];
 
 	for (ch = 0; ch < nch; ch++) {
 		idx = ch;
 		state = &cd->state[ch];
-		for (i = 0; i < frames; i++) {
-			x = audio_stream_read_frag_s32(source_stream, idx);
-			cd->crossover_split(*x << 8, out, state);
+		for (i = 0; i < frames; i += n) {
+			n = MIN(frames - i, CROSSOVER_BLOCK_FRAMES);
+			for (k = 0; k < n; k++) {
+				x = audio_stream_read_frag_s32(source_stream, idx + k * nch);
+				in[k] = *x << 8;
+			}
+
+			cd->crossover_split(in, out_blocks, state, n);
 
 			for (j = 0; j < num_sinks; j++) {
 				if (!bsinks[j])
 					continue;
 				sink_stream = bsinks[j]->data;
-				y = audio_stream_write_frag_s32(sink_stream,
-								idx);
-				*y = sat_int24(Q_SHIFT_RND(out[j], 31, 23));
+				for (k = 0; k < n; k++) {
+					y = audio_stream_write_frag_s32(sink_stream,
+									idx + k * nch);
+					*y = sat_int24(Q_SHIFT_RND(out[j][k], 31, 23));
+				}
 			}
 
-			idx += nch;
+			idx += n * nch;
 		}
 	}
 }
@@ -207,14 +250,19 @@ static void crossover_s32_default(struct comp_data *cd,
 	/* Source stream to read audio data from */
 	const struct audio_stream *source_stream = bsource->data;
 	int32_t *x, *y;
-	int ch, i, j;
+	int ch, i, j, k, n;
 	int idx;
 	/* Counter for active sink streams */
 	int active_sinks = 0;
 	/* Number of channels in the source stream */
 	int nch = audio_stream_get_channels(source_stream);
-	/* Output buffer for processed data */
-	int32_t out[num_sinks];
+	/* Input and output blocks of processed data */
+	int32_t in[CROSSOVER_BLOCK_FRAMES];
+	int32_t out[SOF_CROSSOVER_MAX_STREAMS][CROSSOVER_BLOCK_FRAMES];
+	int32_t *out_blocks[SOF_CROSSOVER_MAX_STREAMS];
+
+	for (j = 0; j < SOF_CROSSOVER_MAX_STREAMS; j++)
+		out_blocks[j] = out[j];
 
 	/* Identify active sinks, avoid processing null sinks later */
 	for (j = 0; j < num_sinks; j++) {
@@ -227,23 +275,26 @@ static void crossover_s32_default(struct comp_data *cd,
 	for (ch = 0; ch < nch; ch++) {
 		/* Set current crossover state for this channel */
 		state = &cd->state[ch];
-		/* Iterate over frames */
-		/* Loop through each frame */
-		for (i = 0, idx = ch; i < frames; i++, idx += nch) {
-			/* Read source */
-			/* Read the current audio frame for the channel */
-			x = audio_stream_read_frag_s32(source_stream, idx);
+		/* Iterate over blocks of frames */
+		for (i = 0, idx = ch; i < frames; i += n, idx += n * nch) {
+			n = MIN(frames - i, CROSSOVER_BLOCK_FRAMES);
+			/* Read the block of frames for the channel */
+			for (k = 0; k < n; k++) {
+				x = audio_stream_read_frag_s32(source_stream, idx + k * nch);
+				in[k] = *x;
+			}
+
 			/* Apply the crossover split logic to the audio data */
-			cd->crossover_split(*x, out, state);
+			cd->crossover_split(in, out_blocks, state, n);
 
-			/* Write output to active sinks */
 			/* Write processed output to active sinks */
 			for (j = 0; j < active_sinks; j++) {
-				/* Write processed data to sink */
-				y = audio_stream_write_frag_s32(sink_stream[j], idx);
-				*y = out[j];
+				for (k = 0; k < n; k++) {
+					y = audio_stream_write_frag_s32(sink_stream[j],
+									idx + k * nch);
+					*y = out[j][k];
+				}
 			}
-
 		}
 	}
 }
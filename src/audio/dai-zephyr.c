@@ -318,20 +318,15 @@ dai_dma_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes,
 					 dd->process, bytes, dd->chmap);
 	} else {
 		audio_stream_invalidate(&dd->dma_buffer->stream, bytes);
-		/*
-		 * The PCM converter functions used during DMA buffer copy can never fail,
-		 * so no need to check the return value of stream_copy_from_no_consume().
-		 */
-		ret = stream_copy_from_no_consume(dd->dma_buffer, dd->local_buffer,
-						  dd->process, bytes, dd->chmap);
 #if CONFIG_IPC_MAJOR_4
-		/* Apply gain to the local buffer */
+		/* Copy to the local buffer and apply gain, in one pass when possible */
 		if (dd->ipc_config.apply_gain) {
-			ret = copier_gain_input(dev, dd->local_buffer, dd->gain_data,
-						GAIN_ADD, bytes);
+			ret = copier_gain_copy_input(dev, dd, GAIN_ADD, bytes);
 			if (ret)
-				comp_err(dev, "copier_gain_input() failed err=%d", ret);
-			buffer_stream_writeback(dd->local_buffer, bytes);
+				comp_err(dev, "copier_gain_copy_input() failed err=%d", ret);
+		} else {
+			ret = stream_copy_from_no_consume(dd->dma_buffer, dd->local_buffer,
+							  dd->process, bytes, dd->chmap);
 		}
 
 		/* Skip in case of endpoint DAI devices created by the copier */
@@ -374,6 +369,13 @@ dai_dma_cb(struct dai_data *dd, struct comp_dev *dev, uint32_t bytes,
 									  bytes, dd->chmap);
 			}
 		}
+#else
+		/*
+		 * The PCM converter functions used during DMA buffer copy can never fail,
+		 * so no need to check the return value of stream_copy_from_no_consume().
+		 */
+		ret = stream_copy_from_no_consume(dd->dma_buffer, dd->local_buffer,
+						  dd->process, bytes, dd->chmap);
 #endif
 		audio_stream_consume(&dd->dma_buffer->stream, bytes);
 	}
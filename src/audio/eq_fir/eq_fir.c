@@ -71,6 +71,10 @@ static void eq_fir_free_delaylines(struct comp_data *cd)
 	cd->fir_delay_size = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		fir[i].delay = NULL;
+
+#if CONFIG_COMP_FIR_FFT
+	eq_fir_fft_free(cd);
+#endif
 }
 
 static int eq_fir_init_coef(struct comp_dev *dev, struct sof_eq_fir_config *config,
@@ -208,6 +212,13 @@ static int eq_fir_setup(struct comp_dev *dev, struct comp_data *cd, int nch)
 	/* Update number of channels */
 	cd->nch = nch;
 
+#if CONFIG_COMP_FIR_FFT
+	/* Long responses are filtered with FFT convolution */
+	delay_size = eq_fir_fft_setup(dev, cd, nch);
+	if (delay_size)
+		return delay_size < 0 ? delay_size : 0;
+#endif
+
 	/* Set coefficients for each channel EQ from coefficient blob */
 	delay_size = eq_fir_init_coef(dev, cd->config, cd->fir, nch);
 	if (delay_size < 0)
@@ -236,6 +247,15 @@ static int eq_fir_setup(struct comp_dev *dev, struct comp_data *cd, int nch)
 
 static int eq_fir_validator(struct comp_dev *dev, void *new_data, uint32_t new_data_size)
 {
+#if CONFIG_COMP_FIR_FFT
+	struct comp_data *cd = module_get_private_data(comp_mod(dev));
+	int ret;
+
+	ret = eq_fir_fft_check(dev, new_data, cd->nch);
+	if (ret)
+		return ret < 0 ? ret : 0;
+#endif
+
 	return eq_fir_init_coef(dev, new_data, NULL, -1);
 }
 
@@ -258,9 +278,9 @@ static int eq_fir_init(struct processing_module *mod)
 	/* Check first before proceeding with dev and cd that coefficients
 	 * blob size is sane.
 	 */
-	if (bs > SOF_EQ_FIR_MAX_SIZE) {
-		comp_err(dev, "eq_fir_init(): coefficients blob size = %zu > SOF_EQ_FIR_MAX_SIZE",
-			 bs);
+	if (bs > EQ_FIR_MAX_BLOB_SIZE) {
+		comp_err(dev, "eq_fir_init(): coefficients blob size = %zu > %zu",
+			 bs, EQ_FIR_MAX_BLOB_SIZE);
 		return -EINVAL;
 	}
 
@@ -386,7 +406,19 @@ static int eq_fir_process(struct processing_module *mod,
 
 	frame_count &= ~0x1;
 	if (frame_count) {
+#if CONFIG_COMP_FIR_FFT
+		if (cd->fft) {
+			ret = eq_fir_fft_process(cd->fft, &input_buffers[0], &output_buffers[0],
+						 frame_count);
+			if (ret < 0)
+				return ret;
+		} else {
+			cd->eq_fir_func(cd->fir, &input_buffers[0], &output_buffers[0],
+					frame_count);
+		}
+#else
 		cd->eq_fir_func(cd->fir, &input_buffers[0], &output_buffers[0], frame_count);
+#endif
 		module_update_buffer_position(&input_buffers[0], &output_buffers[0], frame_count);
 	}
 
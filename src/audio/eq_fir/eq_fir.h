@@ -23,6 +23,7 @@
 #if SOF_USE_MIN_HIFI(3, FILTER)
 #include <sof/math/fir_hifi3.h>
 #endif
+#include <user/eq.h>
 #include <user/fir.h>
 #include <stdint.h>
 
@@ -30,6 +31,25 @@
 #define EQ_FIR_BYTES_TO_S16_SAMPLES(b)	((b) >> 1)
 #define EQ_FIR_BYTES_TO_S32_SAMPLES(b)	((b) >> 2)
 
+#if CONFIG_COMP_FIR_FFT
+/** \brief Partition length of FFT convolution, also the latency it adds */
+#define EQ_FIR_FFT_BLOCK	128
+
+/** \brief Max response length for FFT convolution */
+#define EQ_FIR_FFT_MAX_LENGTH	2048
+
+/** \brief Max blob size, room for every response at the max FFT length */
+#define EQ_FIR_MAX_BLOB_SIZE \
+	(sizeof(struct sof_eq_fir_config) + PLATFORM_MAX_CHANNELS * sizeof(int16_t) + \
+	 SOF_EQ_FIR_MAX_RESPONSES * (sizeof(struct sof_fir_coef_data) + \
+				     EQ_FIR_FFT_MAX_LENGTH * sizeof(int16_t)))
+#else
+/** \brief Max blob size */
+#define EQ_FIR_MAX_BLOB_SIZE	SOF_EQ_FIR_MAX_SIZE
+
+struct eq_fir_fft;
+#endif
+
 /* fir component private data */
 struct comp_data {
 	struct fir_state_32x16 fir[PLATFORM_MAX_CHANNELS]; /**< filters state */
@@ -41,6 +61,9 @@ struct comp_data {
 			    struct input_stream_buffer *bsource,
 			    struct output_stream_buffer *bsink,
 			    int frames);
+#if CONFIG_COMP_FIR_FFT
+	struct eq_fir_fft *fft;			/**< FFT convolution, NULL if not used */
+#endif
 	int nch;
 };
 
@@ -72,6 +95,17 @@ int set_fir_func(struct processing_module *mod, enum sof_ipc_frame fmt);
 
 int eq_fir_params(struct processing_module *mod);
 
+#if CONFIG_COMP_FIR_FFT
+int eq_fir_fft_check(struct comp_dev *dev, struct sof_eq_fir_config *config, int nch);
+
+int eq_fir_fft_setup(struct comp_dev *dev, struct comp_data *cd, int nch);
+
+void eq_fir_fft_free(struct comp_data *cd);
+
+int eq_fir_fft_process(struct eq_fir_fft *fft, struct input_stream_buffer *bsource,
+		       struct output_stream_buffer *bsink, int frames);
+#endif
+
 /*
  * The optimized FIR functions variants need to be updated into function
  * set_fir_func.
@@ -0,0 +1,568 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/* Uniformly partitioned overlap-save FFT convolution for the FIR
+ * equalizer. The response is split into partitions of EQ_FIR_FFT_BLOCK
+ * taps. Every block of input frames is transformed once with an FFT of
+ * twice the block length and the spectra of the latest input blocks are
+ * kept in a frequency domain delay line. The output block is the inverse
+ * FFT of the sum of the delay line spectra multiplied with the partition
+ * spectra. The cost per frame grows with the number of partitions instead
+ * of the number of taps, so long responses that the direct form can't run
+ * become possible. The output is delayed by one block.
+ *
+ * Only the newest input spectrum is needed for the first partition, the
+ * products of the older partitions are accumulated a part of the bins at
+ * a time while the frames of the block arrive. The block boundary then
+ * has the forward and inverse FFT and the first partition of each
+ * channel, the cost of the other partitions is spread over the periods.
+ */
+
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/format.h>
+#include <sof/math/fft.h>
+#include <sof/math/numbers.h>
+#include <sof/common.h>
+#include <rtos/alloc.h>
+#include <rtos/string.h>
+#include <user/eq.h>
+#include <user/fir.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eq_fir.h"
+
+LOG_MODULE_DECLARE(eq_fir, CONFIG_SOF_LOG_LEVEL);
+
+#define EQ_FIR_FFT_SIZE		(2 * EQ_FIR_FFT_BLOCK)
+#define EQ_FIR_FFT_BINS		(EQ_FIR_FFT_BLOCK + 1)
+
+/* Scale down of the spectra products to not overflow the sum of the
+ * max EQ_FIR_FFT_MAX_LENGTH / EQ_FIR_FFT_BLOCK partitions.
+ */
+#define EQ_FIR_FFT_ACC_SHIFT	4
+
+struct eq_fir_fft_channel {
+	int32_t *hist;			/**< previous and current input block */
+	int32_t *out;			/**< output block */
+	struct icomplex32 *fdl;		/**< frequency domain delay line */
+	struct icomplex32 *h;		/**< partitions spectra, NULL for bypass */
+	int64_t *acc;			/**< accumulated spectrum */
+	int h_shift;			/**< products shift of h */
+	int partitions;
+	int fdl_idx;			/**< newest spectrum in fdl */
+	int fdl_shift[EQ_FIR_FFT_MAX_LENGTH / EQ_FIR_FFT_BLOCK]; /**< products shift */
+};
+
+struct eq_fir_fft {
+	struct eq_fir_fft_channel ch[PLATFORM_MAX_CHANNELS];
+	struct fft_plan *fft;		/**< time to spectrum */
+	struct fft_plan *ifft;		/**< spectrum to time */
+	struct icomplex32 *time;
+	struct icomplex32 *spec;
+	void *data;			/**< pointer to allocated RAM */
+	int pos;			/**< frames in current block */
+	int acc_bins;			/**< bins accumulated for current block */
+	int nch;
+};
+
+static inline int eq_fir_fft_partitions(const struct sof_fir_coef_data *eq)
+{
+	return (eq->length + EQ_FIR_FFT_BLOCK - 1) / EQ_FIR_FFT_BLOCK;
+}
+
+/* Finds the response of each channel, -1 is bypass */
+static void eq_fir_fft_responses(struct sof_eq_fir_config *config, int nch,
+				 struct sof_fir_coef_data *lookup[], int *assign)
+{
+	int16_t *assign_response = ASSUME_ALIGNED(&config->data[0], 4);
+	int16_t *coef_data = ASSUME_ALIGNED(&config->data[config->channels_in_config], 4);
+	int resp = 0;
+	int i;
+	int j = 0;
+
+	for (i = 0; i < config->number_of_responses; i++) {
+		lookup[i] = (struct sof_fir_coef_data *)&coef_data[j];
+		j += SOF_FIR_COEF_NHEADER + coef_data[j];
+	}
+
+	/* The last assigned response repeats for additional channels */
+	for (i = 0; i < nch; i++) {
+		if (i < config->channels_in_config)
+			resp = assign_response[i];
+
+		assign[i] = resp;
+	}
+}
+
+int eq_fir_fft_check(struct comp_dev *dev, struct sof_eq_fir_config *config, int nch)
+{
+	struct sof_fir_coef_data *lookup[SOF_EQ_FIR_MAX_RESPONSES];
+	int assign[PLATFORM_MAX_CHANNELS];
+	struct sof_fir_coef_data *eq;
+	bool need_fft = false;
+	int i;
+
+	/* Leave the reporting of broken configurations to the direct form setup */
+	if (nch > PLATFORM_MAX_CHANNELS || config->channels_in_config > PLATFORM_MAX_CHANNELS ||
+	    !config->channels_in_config ||
+	    config->number_of_responses > SOF_EQ_FIR_MAX_RESPONSES)
+		return 0;
+
+	eq_fir_fft_responses(config, nch, lookup, assign);
+	for (i = 0; i < nch; i++) {
+		if (assign[i] >= 0 && assign[i] < config->number_of_responses &&
+		    lookup[assign[i]]->length > CONFIG_COMP_FIR_FFT_THRESHOLD)
+			need_fft = true;
+	}
+
+	if (!need_fft)
+		return 0;
+
+	for (i = 0; i < nch; i++) {
+		if (assign[i] < 0)
+			continue;
+
+		if (assign[i] >= config->number_of_responses) {
+			comp_err(dev, "eq_fir_fft_check(), requested response %d exceeds what has been defined",
+				 assign[i]);
+			return -EINVAL;
+		}
+
+		eq = lookup[assign[i]];
+		if (eq->length < 1 || eq->length > EQ_FIR_FFT_MAX_LENGTH ||
+		    eq->out_shift < 0 || eq->out_shift > 15) {
+			comp_err(dev, "eq_fir_fft_check(), FIR length %d or shift %d is invalid",
+				 eq->length, eq->out_shift);
+			return -EINVAL;
+		}
+	}
+
+	return 1;
+}
+
+/* Computes the spectra of the response partitions, returns the right
+ * shift to apply for the products with them.
+ */
+static int eq_fir_fft_response(struct eq_fir_fft *fft, const struct sof_fir_coef_data *eq,
+			       struct icomplex32 *h)
+{
+	const int partitions = eq_fir_fft_partitions(eq);
+	int32_t peak = 0;
+	int norm;
+	int tap = 0;
+	int i;
+	int p;
+
+	/* Normalize the Q1.15 taps to Q1.31 for precision of the FFT */
+	for (i = 0; i < eq->length; i++)
+		peak |= eq->coef[i] ^ (eq->coef[i] >> 15);
+
+	norm = peak ? norm_int32(peak << 16) : 0;
+	for (p = 0; p < partitions; p++) {
+		memset(fft->time, 0, EQ_FIR_FFT_SIZE * sizeof(*fft->time));
+		for (i = 0; i < EQ_FIR_FFT_BLOCK && tap < eq->length; i++, tap++)
+			fft->time[i].real = ((int32_t)eq->coef[tap] << 16) << norm;
+
+		fft_execute_32(fft->fft, false);
+		memcpy_s(h, EQ_FIR_FFT_BINS * sizeof(*h), fft->spec,
+			 EQ_FIR_FFT_BINS * sizeof(*fft->spec));
+		h += EQ_FIR_FFT_BINS;
+	}
+
+	return norm + eq->out_shift;
+}
+
+int eq_fir_fft_setup(struct comp_dev *dev, struct comp_data *cd, int nch)
+{
+	struct sof_fir_coef_data *lookup[SOF_EQ_FIR_MAX_RESPONSES];
+	struct icomplex32 *h[SOF_EQ_FIR_MAX_RESPONSES] = { NULL };
+	int h_shift[SOF_EQ_FIR_MAX_RESPONSES];
+	bool used[SOF_EQ_FIR_MAX_RESPONSES] = { false };
+	int assign[PLATFORM_MAX_CHANNELS];
+	struct eq_fir_fft_channel *ch;
+	struct icomplex32 *spectra;
+	struct eq_fir_fft *fft;
+	int32_t *samples;
+	size_t bins = 0;
+	size_t size;
+	int resp;
+	int ret;
+	int i;
+
+	ret = eq_fir_fft_check(dev, cd->config, nch);
+	if (ret <= 0)
+		return ret;
+
+	comp_info(dev, "eq_fir_fft_setup(), %d channels use FFT convolution", nch);
+
+	/* Spectra of the used responses and of the channels delay lines */
+	eq_fir_fft_responses(cd->config, nch, lookup, assign);
+	for (i = 0; i < nch; i++) {
+		resp = assign[i];
+		if (resp < 0)
+			continue;
+
+		if (!used[resp]) {
+			used[resp] = true;
+			bins += eq_fir_fft_partitions(lookup[resp]) * EQ_FIR_FFT_BINS;
+		}
+
+		bins += eq_fir_fft_partitions(lookup[resp]) * EQ_FIR_FFT_BINS;
+	}
+
+	fft = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(*fft));
+	if (!fft)
+		return -ENOMEM;
+
+	size = nch * 2 * EQ_FIR_FFT_BINS * sizeof(int64_t) +
+	       (bins + 2 * EQ_FIR_FFT_SIZE) * sizeof(struct icomplex32) +
+	       nch * (EQ_FIR_FFT_SIZE + EQ_FIR_FFT_BLOCK) * sizeof(int32_t);
+	fft->data = rballoc(0, SOF_MEM_CAPS_RAM, size);
+	if (!fft->data) {
+		comp_err(dev, "eq_fir_fft_setup(), allocation failed for size %zu", size);
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	memset(fft->data, 0, size);
+	fft->nch = nch;
+	fft->time = (struct icomplex32 *)((int64_t *)fft->data + nch * 2 * EQ_FIR_FFT_BINS);
+	fft->spec = fft->time + EQ_FIR_FFT_SIZE;
+	spectra = fft->spec + EQ_FIR_FFT_SIZE;
+	samples = (int32_t *)(spectra + bins);
+
+	fft->fft = fft_plan_new(fft->time, fft->spec, EQ_FIR_FFT_SIZE, 32);
+	fft->ifft = fft_plan_new(fft->spec, fft->time, EQ_FIR_FFT_SIZE, 32);
+	if (!fft->fft || !fft->ifft) {
+		comp_err(dev, "eq_fir_fft_setup(), FFT plan allocation failed");
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	for (resp = 0; resp < SOF_EQ_FIR_MAX_RESPONSES; resp++) {
+		if (!used[resp])
+			continue;
+
+		h[resp] = spectra;
+		h_shift[resp] = eq_fir_fft_response(fft, lookup[resp], spectra);
+		spectra += eq_fir_fft_partitions(lookup[resp]) * EQ_FIR_FFT_BINS;
+	}
+
+	for (i = 0; i < nch; i++) {
+		ch = &fft->ch[i];
+		ch->acc = (int64_t *)fft->data + i * 2 * EQ_FIR_FFT_BINS;
+		ch->hist = samples;
+		ch->out = samples + EQ_FIR_FFT_SIZE;
+		samples += EQ_FIR_FFT_SIZE + EQ_FIR_FFT_BLOCK;
+		resp = assign[i];
+		if (resp < 0) {
+			comp_info(dev, "eq_fir_fft_setup(), ch %d is set to bypass", i);
+			continue;
+		}
+
+		ch->h = h[resp];
+		ch->h_shift = h_shift[resp];
+		ch->partitions = eq_fir_fft_partitions(lookup[resp]);
+		ch->fdl = spectra;
+		spectra += ch->partitions * EQ_FIR_FFT_BINS;
+		comp_info(dev, "eq_fir_fft_setup(), ch %d is set to response = %d, %d partitions",
+			  i, resp, ch->partitions);
+	}
+
+	cd->fft = fft;
+	return 1;
+
+err:
+	fft_plan_free(fft->fft);
+	fft_plan_free(fft->ifft);
+	rfree(fft->data);
+	rfree(fft);
+	return ret;
+}
+
+void eq_fir_fft_free(struct comp_data *cd)
+{
+	struct eq_fir_fft *fft = cd->fft;
+
+	if (!fft)
+		return;
+
+	fft_plan_free(fft->fft);
+	fft_plan_free(fft->ifft);
+	rfree(fft->data);
+	rfree(fft);
+	cd->fft = NULL;
+}
+
+/* Accumulates the products of the partitions other than the first up to
+ * bin count bins, they only need the already stored input spectra.
+ */
+static void eq_fir_fft_accumulate(struct eq_fir_fft *fft, int bins)
+{
+	struct eq_fir_fft_channel *ch;
+	struct icomplex32 *x;
+	struct icomplex32 *h;
+	int64_t re;
+	int64_t im;
+	int j;
+	int k;
+	int p;
+	int q;
+
+	for (j = 0; j < fft->nch; j++) {
+		ch = &fft->ch[j];
+		if (!ch->h)
+			continue;
+
+		/* The current newest input goes with the 2nd partition */
+		for (k = fft->acc_bins; k < bins; k++) {
+			re = 0;
+			im = 0;
+			q = ch->fdl_idx;
+			for (p = 1; p < ch->partitions; p++) {
+				x = &ch->fdl[q * EQ_FIR_FFT_BINS + k];
+				h = &ch->h[p * EQ_FIR_FFT_BINS + k];
+				re += ((int64_t)x->real * h->real - (int64_t)x->imag * h->imag) >>
+				      ch->fdl_shift[q];
+				im += ((int64_t)x->real * h->imag + (int64_t)x->imag * h->real) >>
+				      ch->fdl_shift[q];
+				q = q ? q - 1 : ch->partitions - 1;
+			}
+
+			ch->acc[2 * k] = re;
+			ch->acc[2 * k + 1] = im;
+		}
+	}
+
+	fft->acc_bins = bins;
+}
+
+/* Filters the block of input frames in hist[] into out[] */
+static void eq_fir_fft_block(struct eq_fir_fft *fft)
+{
+	struct eq_fir_fft_channel *ch;
+	struct icomplex32 *x;
+	struct icomplex32 *h;
+	struct icomplex32 *y = fft->spec;
+	int64_t *acc;
+	const int len = fft->fft->len;
+	uint64_t peak;
+	int32_t peak_in;
+	int64_t re;
+	int64_t im;
+	int shift;
+	int norm;
+	int32_t z;
+	int i;
+	int j;
+	int k;
+
+	for (j = 0; j < fft->nch; j++) {
+		ch = &fft->ch[j];
+		if (!ch->h) {
+			/* Bypass with the same delay as the filtered channels */
+			memcpy_s(ch->out, EQ_FIR_FFT_BLOCK * sizeof(int32_t),
+				 &ch->hist[EQ_FIR_FFT_BLOCK], EQ_FIR_FFT_BLOCK * sizeof(int32_t));
+			continue;
+		}
+
+		/* Normalize the input for precision of the forward FFT, the
+		 * products of the spectrum are scaled back when accumulated.
+		 */
+		peak_in = 0;
+		for (i = 0; i < EQ_FIR_FFT_SIZE; i++)
+			peak_in |= ch->hist[i] ^ (ch->hist[i] >> 31);
+
+		norm = peak_in ? norm_int32(peak_in) : 0;
+		for (i = 0; i < EQ_FIR_FFT_SIZE; i++) {
+			fft->time[i].real = ch->hist[i] << norm;
+			fft->time[i].imag = 0;
+		}
+
+		fft_execute_32(fft->fft, false);
+
+		/* Store the new input spectrum as newest in the delay line */
+		ch->fdl_idx = ch->fdl_idx + 1 < ch->partitions ? ch->fdl_idx + 1 : 0;
+		ch->fdl_shift[ch->fdl_idx] = EQ_FIR_FFT_ACC_SHIFT + norm + ch->h_shift;
+		memcpy_s(&ch->fdl[ch->fdl_idx * EQ_FIR_FFT_BINS],
+			 EQ_FIR_FFT_BINS * sizeof(struct icomplex32), y,
+			 EQ_FIR_FFT_BINS * sizeof(struct icomplex32));
+
+		/* Add the newest input with the 1st partition to the others */
+		acc = ch->acc;
+		shift = ch->fdl_shift[ch->fdl_idx];
+		peak = 0;
+		for (k = 0; k < EQ_FIR_FFT_BINS; k++) {
+			x = &ch->fdl[ch->fdl_idx * EQ_FIR_FFT_BINS + k];
+			h = &ch->h[k];
+			re = acc[2 * k] +
+			     (((int64_t)x->real * h->real - (int64_t)x->imag * h->imag) >> shift);
+			im = acc[2 * k + 1] +
+			     (((int64_t)x->real * h->imag + (int64_t)x->imag * h->real) >> shift);
+			acc[2 * k] = re;
+			acc[2 * k + 1] = im;
+			peak |= re < 0 ? -re : re;
+			peak |= im < 0 ? -im : im;
+		}
+
+		/* Block floating point, the library inverse FFT would drop the
+		 * spectrum LSBs with its input scaling. Normalize the spectrum to
+		 * Q1.30 and run the forward FFT for its conjugate, that is the
+		 * inverse FFT scaled by 1/N.
+		 */
+		shift = 0;
+		while (peak >> shift >= (1ULL << 30))
+			shift++;
+
+		for (k = 0; k < EQ_FIR_FFT_BINS; k++) {
+			y[k].real = acc[2 * k] >> shift;
+			y[k].imag = -(acc[2 * k + 1] >> shift);
+		}
+
+		/* Real output, the upper half of the spectrum is the conjugate mirror */
+		for (k = 1; k < EQ_FIR_FFT_BLOCK; k++) {
+			y[EQ_FIR_FFT_SIZE - k].real = y[k].real;
+			y[EQ_FIR_FFT_SIZE - k].imag = -y[k].imag;
+		}
+
+		fft_execute_32(fft->ifft, false);
+
+		/* The accumulated products are Q2.62 spectra with 1/N scale from
+		 * each of the forward FFTs. Undo the normalization shift and the
+		 * scales, the first half of the block is circular convolution
+		 * wrap and is not used.
+		 */
+		shift += EQ_FIR_FFT_ACC_SHIFT + 2 * len - 31;
+		for (i = 0; i < EQ_FIR_FFT_BLOCK; i++) {
+			z = fft->time[EQ_FIR_FFT_BLOCK + i].real;
+			if (shift > 0)
+				ch->out[i] = sat_int32((int64_t)z << shift);
+			else
+				ch->out[i] = shift ? Q_SHIFT_RND((int64_t)z, -shift, 0) : z;
+		}
+	}
+
+	/* The current block becomes the previous block */
+	for (j = 0; j < fft->nch; j++) {
+		ch = &fft->ch[j];
+		memcpy_s(ch->hist, EQ_FIR_FFT_BLOCK * sizeof(int32_t),
+			 &ch->hist[EQ_FIR_FFT_BLOCK], EQ_FIR_FFT_BLOCK * sizeof(int32_t));
+	}
+}
+
+/* Accounts n new frames of the current block, a part of the accumulation
+ * is done for every frame and the full block is filtered.
+ */
+static void eq_fir_fft_advance(struct eq_fir_fft *fft, int n)
+{
+	fft->pos += n;
+	eq_fir_fft_accumulate(fft, fft->pos * EQ_FIR_FFT_BINS / EQ_FIR_FFT_BLOCK);
+	if (fft->pos == EQ_FIR_FFT_BLOCK) {
+		eq_fir_fft_block(fft);
+		fft->pos = 0;
+		fft->acc_bins = 0;
+	}
+}
+
+#if CONFIG_FORMAT_S16LE
+static void eq_fir_fft_s16(struct eq_fir_fft *fft, struct audio_stream *source,
+			   struct audio_stream *sink, int frames)
+{
+	struct eq_fir_fft_channel *ch;
+	int16_t *x = audio_stream_get_rptr(source);
+	int16_t *y = audio_stream_get_wptr(sink);
+	const int nch = fft->nch;
+	int32_t *in;
+	int32_t *out;
+	int n, i, j;
+
+	while (frames) {
+		n = MIN(frames, EQ_FIR_FFT_BLOCK - fft->pos);
+		n = MIN(n, audio_stream_frames_without_wrap(source, x));
+		n = MIN(n, audio_stream_frames_without_wrap(sink, y));
+		for (j = 0; j < nch; j++) {
+			ch = &fft->ch[j];
+			in = &ch->hist[EQ_FIR_FFT_BLOCK + fft->pos];
+			out = &ch->out[fft->pos];
+			for (i = 0; i < n; i++) {
+				in[i] = x[i * nch + j] << 16;
+				y[i * nch + j] = sat_int16(Q_SHIFT_RND(out[i], 31, 15));
+			}
+		}
+
+		frames -= n;
+		eq_fir_fft_advance(fft, n);
+
+		x = audio_stream_wrap(source, x + n * nch);
+		y = audio_stream_wrap(sink, y + n * nch);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
+static void eq_fir_fft_s32(struct eq_fir_fft *fft, struct audio_stream *source,
+			   struct audio_stream *sink, int frames, bool s24)
+{
+	struct eq_fir_fft_channel *ch;
+	int32_t *x = audio_stream_get_rptr(source);
+	int32_t *y = audio_stream_get_wptr(sink);
+	const int nch = fft->nch;
+	const int in_shift = s24 ? 8 : 0;
+	int32_t *in;
+	int32_t *out;
+	int n, i, j;
+
+	while (frames) {
+		n = MIN(frames, EQ_FIR_FFT_BLOCK - fft->pos);
+		n = MIN(n, audio_stream_frames_without_wrap(source, x));
+		n = MIN(n, audio_stream_frames_without_wrap(sink, y));
+		for (j = 0; j < nch; j++) {
+			ch = &fft->ch[j];
+			in = &ch->hist[EQ_FIR_FFT_BLOCK + fft->pos];
+			out = &ch->out[fft->pos];
+			for (i = 0; i < n; i++) {
+				in[i] = x[i * nch + j] << in_shift;
+				y[i * nch + j] = s24 ? sat_int24(Q_SHIFT_RND(out[i], 31, 23)) :
+						       out[i];
+			}
+		}
+
+		frames -= n;
+		eq_fir_fft_advance(fft, n);
+
+		x = audio_stream_wrap(source, x + n * nch);
+		y = audio_stream_wrap(sink, y + n * nch);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE */
+
+int eq_fir_fft_process(struct eq_fir_fft *fft, struct input_stream_buffer *bsource,
+		       struct output_stream_buffer *bsink, int frames)
+{
+	struct audio_stream *source = bsource->data;
+	struct audio_stream *sink = bsink->data;
+
+	switch (audio_stream_get_frm_fmt(source)) {
+#if CONFIG_FORMAT_S16LE
+	case SOF_IPC_FRAME_S16_LE:
+		eq_fir_fft_s16(fft, source, sink, frames);
+		return 0;
+#endif /* CONFIG_FORMAT_S16LE */
+#if CONFIG_FORMAT_S24LE
+	case SOF_IPC_FRAME_S24_4LE:
+		eq_fir_fft_s32(fft, source, sink, frames, true);
+		return 0;
+#endif /* CONFIG_FORMAT_S24LE */
+#if CONFIG_FORMAT_S32LE
+	case SOF_IPC_FRAME_S32_LE:
+		eq_fir_fft_s32(fft, source, sink, frames, false);
+		return 0;
+#endif /* CONFIG_FORMAT_S32LE */
+	default:
+		return -EINVAL;
+	}
+}
@@ -19,6 +19,12 @@
 #define EQ_IIR_BYTES_TO_S16_SAMPLES(b)	((b) >> 1)
 #define EQ_IIR_BYTES_TO_S32_SAMPLES(b)	((b) >> 2)
 
+/** \brief Max. frames of a channel filtered at once, a block is on stack */
+#define EQ_IIR_BLOCK_FRAMES	32
+
+/** \brief Max. samples of all channels filtered at once, a block is on stack */
+#define EQ_IIR_MULTI_BLOCK_SAMPLES	64
+
 struct audio_stream;
 struct comp_dev;
 
@@ -41,6 +47,10 @@ struct comp_data {
 	int32_t *iir_delay;			/**< pointer to allocated RAM */
 	size_t iir_delay_size;			/**< allocated size */
 	eq_iir_func eq_iir_func;		/**< processing function */
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	struct iir_df1_multi iir_multi;		/**< cross-channel filters state */
+	int32_t *iir_multi_data;		/**< pointer to allocated RAM */
+#endif
 };
 
 #ifdef UNIT_TEST
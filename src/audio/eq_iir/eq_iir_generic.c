@@ -37,6 +37,140 @@
 
 LOG_MODULE_DECLARE(eq_iir, CONFIG_SOF_LOG_LEVEL);
 
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+/* All channels are filtered together in interleaved blocks when the
+ * cross-channel filter is set up, see iir_df1_multi_block().
+ */
+#if CONFIG_FORMAT_S16LE
+static void eq_iir_s16_multi(struct comp_data *cd, struct audio_stream *source,
+			     struct audio_stream *sink, uint32_t frames)
+{
+	int32_t block[EQ_IIR_MULTI_BLOCK_SAMPLES];
+	int16_t *x;
+	int16_t *y;
+	int nmax;
+	int n1;
+	int n2;
+	int i;
+	int j;
+	int m;
+	int n;
+	const int nch = audio_stream_get_channels(source);
+	const int block_samples = EQ_IIR_MULTI_BLOCK_SAMPLES / nch * nch;
+	const int samples = frames * nch;
+	int processed = 0;
+
+	x = audio_stream_get_rptr(source);
+	y = audio_stream_get_wptr(sink);
+	while (processed < samples) {
+		nmax = samples - processed;
+		n1 = audio_stream_bytes_without_wrap(source, x) >> 1;
+		n2 = audio_stream_bytes_without_wrap(sink, y) >> 1;
+		n = MIN(n1, n2);
+		n = MIN(n, nmax);
+		for (j = 0; j < n; j += m) {
+			m = MIN(n - j, block_samples);
+			for (i = 0; i < m; i++)
+				block[i] = (int32_t)x[j + i] << 16;
+
+			iir_df1_multi_block(&cd->iir_multi, block, m / nch);
+			for (i = 0; i < m; i++)
+				y[j + i] = iir_df1_q31_to_s16(block[i]);
+		}
+		processed += n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S16LE */
+
+#if CONFIG_FORMAT_S24LE
+static void eq_iir_s24_multi(struct comp_data *cd, struct audio_stream *source,
+			     struct audio_stream *sink, uint32_t frames)
+{
+	int32_t block[EQ_IIR_MULTI_BLOCK_SAMPLES];
+	int32_t *x;
+	int32_t *y;
+	int nmax;
+	int n1;
+	int n2;
+	int i;
+	int j;
+	int m;
+	int n;
+	const int nch = audio_stream_get_channels(source);
+	const int block_samples = EQ_IIR_MULTI_BLOCK_SAMPLES / nch * nch;
+	const int samples = frames * nch;
+	int processed = 0;
+
+	x = audio_stream_get_rptr(source);
+	y = audio_stream_get_wptr(sink);
+	while (processed < samples) {
+		nmax = samples - processed;
+		n1 = audio_stream_bytes_without_wrap(source, x) >> 2;
+		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
+		n = MIN(n1, n2);
+		n = MIN(n, nmax);
+		for (j = 0; j < n; j += m) {
+			m = MIN(n - j, block_samples);
+			for (i = 0; i < m; i++)
+				block[i] = x[j + i] << 8;
+
+			iir_df1_multi_block(&cd->iir_multi, block, m / nch);
+			for (i = 0; i < m; i++)
+				y[j + i] = iir_df1_q31_to_s24(block[i]);
+		}
+		processed += n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S24LE */
+
+#if CONFIG_FORMAT_S32LE
+static void eq_iir_s32_multi(struct comp_data *cd, struct audio_stream *source,
+			     struct audio_stream *sink, uint32_t frames)
+{
+	int32_t block[EQ_IIR_MULTI_BLOCK_SAMPLES];
+	int32_t *x;
+	int32_t *y;
+	int nmax;
+	int n1;
+	int n2;
+	int i;
+	int j;
+	int m;
+	int n;
+	const int nch = audio_stream_get_channels(source);
+	const int block_samples = EQ_IIR_MULTI_BLOCK_SAMPLES / nch * nch;
+	const int samples = frames * nch;
+	int processed = 0;
+
+	x = audio_stream_get_rptr(source);
+	y = audio_stream_get_wptr(sink);
+	while (processed < samples) {
+		nmax = samples - processed;
+		n1 = audio_stream_bytes_without_wrap(source, x) >> 2;
+		n2 = audio_stream_bytes_without_wrap(sink, y) >> 2;
+		n = MIN(n1, n2);
+		n = MIN(n, nmax);
+		for (j = 0; j < n; j += m) {
+			m = MIN(n - j, block_samples);
+			for (i = 0; i < m; i++)
+				block[i] = x[j + i];
+
+			iir_df1_multi_block(&cd->iir_multi, block, m / nch);
+			for (i = 0; i < m; i++)
+				y[j + i] = block[i];
+		}
+		processed += n;
+		x = audio_stream_wrap(source, x + n);
+		y = audio_stream_wrap(sink, y + n);
+	}
+}
+#endif /* CONFIG_FORMAT_S32LE */
+#endif /* CONFIG_MATH_IIR_DF1_MULTICHANNEL */
+
 #if CONFIG_FORMAT_S16LE
 void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffer *bsource,
 			struct output_stream_buffer *bsink, uint32_t frames)
@@ -45,6 +179,7 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
 	struct iir_state_df1 *filter;
+	int32_t block[EQ_IIR_BLOCK_FRAMES];
 	int16_t *x0;
 	int16_t *y0;
 	int16_t *x;
@@ -54,11 +189,20 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 	int n2;
 	int i;
 	int j;
+	int k;
+	int m;
 	int n;
 	const int nch = audio_stream_get_channels(source);
 	const int samples = frames * nch;
 	int processed = 0;
 
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	if (cd->iir_multi.channels) {
+		eq_iir_s16_multi(cd, source, sink, frames);
+		return;
+	}
+#endif
+
 	x = audio_stream_get_rptr(source);
 	y = audio_stream_get_wptr(sink);
 	while (processed < samples) {
@@ -71,10 +215,18 @@ void eq_iir_s16_default(struct processing_module *mod, struct input_stream_buffe
 			x0 = x + i;
 			y0 = y + i;
 			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+			for (j = n / nch; j > 0; j -= m) {
+				m = MIN(j, EQ_IIR_BLOCK_FRAMES);
+				for (k = 0; k < m; k++) {
+					block[k] = (int32_t)*x0 << 16;
+					x0 += nch;
+				}
+
+				iir_df1_block(filter, block, m);
+				for (k = 0; k < m; k++) {
+					*y0 = iir_df1_q31_to_s16(block[k]);
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -93,6 +245,7 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
 	struct iir_state_df1 *filter;
+	int32_t block[EQ_IIR_BLOCK_FRAMES];
 	int32_t *x0;
 	int32_t *y0;
 	int32_t *x;
@@ -102,11 +255,20 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 	int n2;
 	int i;
 	int j;
+	int k;
+	int m;
 	int n;
 	const int nch = audio_stream_get_channels(source);
 	const int samples = frames * nch;
 	int processed = 0;
 
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	if (cd->iir_multi.channels) {
+		eq_iir_s24_multi(cd, source, sink, frames);
+		return;
+	}
+#endif
+
 	x = audio_stream_get_rptr(source);
 	y = audio_stream_get_wptr(sink);
 	while (processed < samples) {
@@ -119,10 +281,18 @@ void eq_iir_s24_default(struct processing_module *mod, struct input_stream_buffe
 			x0 = x + i;
 			y0 = y + i;
 			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+			for (j = n / nch; j > 0; j -= m) {
+				m = MIN(j, EQ_IIR_BLOCK_FRAMES);
+				for (k = 0; k < m; k++) {
+					block[k] = *x0 << 8;
+					x0 += nch;
+				}
+
+				iir_df1_block(filter, block, m);
+				for (k = 0; k < m; k++) {
+					*y0 = iir_df1_q31_to_s24(block[k]);
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -141,6 +311,7 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
 	struct iir_state_df1 *filter;
+	int32_t block[EQ_IIR_BLOCK_FRAMES];
 	int32_t *x0;
 	int32_t *y0;
 	int32_t *x;
@@ -150,11 +321,20 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 	int n2;
 	int i;
 	int j;
+	int k;
+	int m;
 	int n;
 	const int nch = audio_stream_get_channels(source);
 	const int samples = frames * nch;
 	int processed = 0;
 
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	if (cd->iir_multi.channels) {
+		eq_iir_s32_multi(cd, source, sink, frames);
+		return;
+	}
+#endif
+
 	x = audio_stream_get_rptr(source);
 	y = audio_stream_get_wptr(sink);
 	while (processed < samples) {
@@ -167,10 +347,18 @@ void eq_iir_s32_default(struct processing_module *mod, struct input_stream_buffe
 			x0 = x + i;
 			y0 = y + i;
 			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+			for (j = n / nch; j > 0; j -= m) {
+				m = MIN(j, EQ_IIR_BLOCK_FRAMES);
+				for (k = 0; k < m; k++) {
+					block[k] = *x0;
+					x0 += nch;
+				}
+
+				iir_df1_block(filter, block, m);
+				for (k = 0; k < m; k++) {
+					*y0 = block[k];
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -285,6 +473,31 @@ static void eq_iir_init_delay(struct iir_state_df1 *iir,
 	}
 }
 
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+static void eq_iir_init_multi(struct processing_module *mod, int nch)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+	size_t size;
+
+	/* The per channel filters are used when this fails */
+	size = iir_df1_multi_size(nch, cd->iir[0].biquads);
+	if (!size)
+		return;
+
+	cd->iir_multi_data = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!cd->iir_multi_data)
+		return;
+
+	if (iir_df1_multi_init(&cd->iir_multi, cd->iir, nch, cd->iir_multi_data) < 0) {
+		rfree(cd->iir_multi_data);
+		cd->iir_multi_data = NULL;
+		return;
+	}
+
+	comp_info(mod->dev, "eq_iir_init_multi(), %d channels filtered together", nch);
+}
+
+#endif
 void eq_iir_free_delaylines(struct comp_data *cd)
 {
 	struct iir_state_df1 *iir = cd->iir;
@@ -298,6 +511,12 @@ void eq_iir_free_delaylines(struct comp_data *cd)
 	cd->iir_delay_size = 0;
 	for (i = 0; i < PLATFORM_MAX_CHANNELS; i++)
 		iir[i].delay = NULL;
+
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	rfree(cd->iir_multi_data);
+	cd->iir_multi_data = NULL;
+	cd->iir_multi.channels = 0;
+#endif
 }
 
 void eq_iir_pass(struct processing_module *mod, struct input_stream_buffer *bsource,
@@ -340,6 +559,10 @@ int eq_iir_setup(struct processing_module *mod, int nch)
 
 	/* Assign delay line to each channel EQ */
 	eq_iir_init_delay(cd->iir, cd->iir_delay, nch);
+
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+	eq_iir_init_multi(mod, nch);
+#endif
 	return 0;
 }
 
@@ -46,6 +46,7 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
 	struct iir_state_df1 *filter;
+	int32_t block[EQ_IIR_BLOCK_FRAMES];
 	int32_t *x0;
 	int16_t *y0;
 	int32_t *x;
@@ -55,6 +56,8 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 	int n2;
 	int i;
 	int j;
+	int k;
+	int m;
 	int n;
 	const int nch = audio_stream_get_channels(source);
 	const int samples = frames * nch;
@@ -72,10 +75,18 @@ static void eq_iir_s32_16_default(struct processing_module *mod,
 			x0 = x + i;
 			y0 = y + i;
 			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s16(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+			for (j = n / nch; j > 0; j -= m) {
+				m = MIN(j, EQ_IIR_BLOCK_FRAMES);
+				for (k = 0; k < m; k++) {
+					block[k] = *x0;
+					x0 += nch;
+				}
+
+				iir_df1_block(filter, block, m);
+				for (k = 0; k < m; k++) {
+					*y0 = iir_df1_q31_to_s16(block[k]);
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -94,6 +105,7 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 	struct audio_stream *source = bsource->data;
 	struct audio_stream *sink = bsink->data;
 	struct iir_state_df1 *filter;
+	int32_t block[EQ_IIR_BLOCK_FRAMES];
 	int32_t *x0;
 	int32_t *y0;
 	int32_t *x;
@@ -103,6 +115,8 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 	int n2;
 	int i;
 	int j;
+	int k;
+	int m;
 	int n;
 	const int nch = audio_stream_get_channels(source);
 	const int samples = frames * nch;
@@ -120,10 +134,18 @@ static void eq_iir_s32_24_default(struct processing_module *mod,
 			x0 = x + i;
 			y0 = y + i;
 			filter = &cd->iir[i];
-			for (j = 0; j < n; j += nch) {
-				*y0 = iir_df1_s32_s24(filter, *x0);
-				x0 += nch;
-				y0 += nch;
+			for (j = n / nch; j > 0; j -= m) {
+				m = MIN(j, EQ_IIR_BLOCK_FRAMES);
+				for (k = 0; k < m; k++) {
+					block[k] = *x0;
+					x0 += nch;
+				}
+
+				iir_df1_block(filter, block, m);
+				for (k = 0; k < m; k++) {
+					*y0 = iir_df1_q31_to_s24(block[k]);
+					y0 += nch;
+				}
 			}
 		}
 		processed += n;
@@ -33,6 +33,7 @@
 #include <sof/math/numbers.h>
 #include <sof/platform.h>
 #include <sof/schedule/edf_schedule.h>
+#include <sof/schedule/ll_schedule_domain.h>
 #include <sof/schedule/schedule.h>
 #include <rtos/task.h>
 #include <rtos/string.h>
@@ -508,7 +509,6 @@ static struct comp_dev *kpb_new(const struct comp_driver *drv,
 			       0); /* no flags */
 
 	/* Init basic component data */
-	kpb->hd.c_hb = NULL;
 	kpb->kpb_no_of_clients = 0;
 	kpb->state_log = 0;
 
@@ -528,133 +528,94 @@ static struct comp_dev *kpb_new(const struct comp_driver *drv,
 /**
  * \brief Allocate history buffer.
  * \param[in] kpb - KPB component data pointer.
+ * \param[in] hb_size_req - requested size of history buffer.
  *
- * \return: none.
+ * \return: allocated size, zero on failure.
  */
 static size_t kpb_allocate_history_buffer(struct comp_data *kpb,
 					  size_t hb_size_req)
 {
-	struct history_buffer *hb;
-	struct history_buffer *new_hb = NULL;
-	/*! Total allocation size */
-	size_t hb_size = hb_size_req;
-	/*! Current allocation size */
-	size_t ca_size = hb_size;
+	struct history_buffer *hb = &kpb->hd.hb;
 	/*! Memory caps priorites for history buffer */
 	int hb_mcp[KPB_NO_OF_MEM_POOLS] = {SOF_MEM_CAPS_LP, SOF_MEM_CAPS_HP,
 					   SOF_MEM_CAPS_RAM };
-	void *new_mem_block = NULL;
-	size_t temp_ca_size;
-	int i = 0;
-	size_t allocated_size = 0;
+#if CONFIG_VIRTUAL_HEAP
+	/* rballoc() takes all buffers from the virtual heap whatever
+	 * the caps are, retrying with other caps would be pointless.
+	 */
+	const int pools = 1;
+#else
+	const int pools = ARRAY_SIZE(hb_mcp);
+#endif
+	size_t hb_size = hb_size_req;
+	size_t ca_size = hb_size_req;
+	void *new_mem_block;
+	int i;
 
 	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer()");
 
-	/* Initialize history buffer */
-	kpb->hd.c_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-			       sizeof(struct history_buffer));
-	if (!kpb->hd.c_hb)
-		return 0;
-	kpb->hd.c_hb->next = kpb->hd.c_hb;
-	kpb->hd.c_hb->prev = kpb->hd.c_hb;
-	hb = kpb->hd.c_hb;
-
-	/* Allocate history buffer/s. KPB history buffer has a size of
-	 * KPB_MAX_BUFFER_SIZE, since there is no single memory block
-	 * that big, we need to allocate couple smaller blocks which
-	 * linked together will form history buffer.
+	/* The history buffer is preferably a single ring so that buffering
+	 * and draining are at most two bulk copies. With virtual heap the
+	 * buffers allocation is backed by vmh_alloc() and the ring is one
+	 * virtually contiguous window, but not larger than the biggest block
+	 * of the buffers heap, e.g. 4 and 6 channels of 32 bit samples don't
+	 * fit the 512 KiB KPB block. When the whole ring can't be allocated
+	 * it is stitched from the largest blocks available, found by
+	 * shrinking the current allocation size (ca_size).
 	 */
-	while (hb_size > 0 && i < ARRAY_SIZE(hb_mcp)) {
-		/* Try to allocate ca_size (current allocation size). At first
-		 * attempt it will be equal to hb_size (history buffer size).
-		 */
-		new_mem_block = rballoc(0, hb_mcp[i], ca_size);
+	hb->blocks = 0;
+	while (hb_size && hb->blocks < KPB_MAX_HB_BLOCKS) {
+		new_mem_block = NULL;
+		for (i = 0; i < pools && !new_mem_block; i++)
+			new_mem_block = rballoc(0, hb_mcp[i], ca_size);
 
 		if (new_mem_block) {
-			/* We managed to allocate a block of ca_size.
-			 * Now we initialize it.
-			 */
-			comp_cl_info(&comp_kpb, "kpb new memory block: %zu",
-				     ca_size);
-			allocated_size += ca_size;
-			hb->start_addr = new_mem_block;
-			hb->end_addr = (char *)new_mem_block +
-				ca_size;
-			hb->w_ptr = new_mem_block;
-			hb->r_ptr = new_mem_block;
-			hb->state = KPB_BUFFER_FREE;
+			hb->block[hb->blocks].start_addr = new_mem_block;
+			hb->block[hb->blocks].end_addr = (char *)new_mem_block + ca_size;
+			hb->blocks++;
 			hb_size -= ca_size;
-			hb->next = kpb->hd.c_hb;
-			/* Do we need another buffer? */
-			if (hb_size > 0) {
-				/* Yes, we still need at least one more buffer.
-				 * Let's first create new container for it.
-				 */
-				new_hb = rzalloc(SOF_MEM_ZONE_RUNTIME, 0,
-						 SOF_MEM_CAPS_RAM,
-						 sizeof(struct history_buffer));
-				if (!new_hb)
-					return 0;
-				hb->next = new_hb;
-				new_hb->next = kpb->hd.c_hb;
-				new_hb->state = KPB_BUFFER_OFF;
-				new_hb->prev = hb;
-				hb = new_hb;
-				kpb->hd.c_hb->prev = new_hb;
-				ca_size = hb_size;
-				i++;
-			}
+			ca_size = hb_size;
+		} else if (ca_size > KPB_ALLOCATION_STEP) {
+			ca_size -= KPB_ALLOCATION_STEP;
 		} else {
-			/* We've failed to allocate ca_size of that hb_mcp
-			 * let's try again with some smaller size.
-			 * NOTE! If we decrement by some small value,
-			 * the allocation will take significant time.
-			 * However, bigger values like
-			 * HEAP_HP_BUFFER_BLOCK_SIZE will result in lower
-			 * accuracy of allocation.
-			 */
-			temp_ca_size = ca_size - KPB_ALLOCATION_STEP;
-			ca_size = (ca_size < temp_ca_size) ? 0 : temp_ca_size;
-			if (ca_size == 0) {
-				ca_size = hb_size;
-				i++;
-			}
-			continue;
+			break;
 		}
 	}
 
-	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer(): allocated %zu bytes",
-		     allocated_size);
+	if (hb_size) {
+		comp_cl_err(&comp_kpb, "kpb_allocate_history_buffer(): failed to allocate %zu bytes",
+			    hb_size_req);
+		kpb_free_history_buffer(hb);
+		return 0;
+	}
+
+	hb->w_block = 0;
+	hb->r_block = 0;
+	hb->w_ptr = hb->block[0].start_addr;
+	hb->r_ptr = hb->block[0].start_addr;
 
-	return allocated_size;
+	comp_cl_info(&comp_kpb, "kpb_allocate_history_buffer(): allocated %zu bytes in %d block(s)",
+		     hb_size_req, hb->blocks);
+
+	return hb_size_req;
 }
 
 /**
  * \brief Reclaim memory of a history buffer.
- * \param[in] buff - pointer to current history buffer.
+ * \param[in] buff - pointer to history buffer.
  *
  * \return none.
  */
 static void kpb_free_history_buffer(struct history_buffer *buff)
 {
-	struct history_buffer *_buff;
-	struct history_buffer *first_buff = buff;
+	int i;
 
 	comp_cl_info(&comp_kpb, "kpb_free_history_buffer()");
 
-	if (!buff)
-		return;
+	for (i = 0; i < buff->blocks; i++)
+		rfree(buff->block[i].start_addr);
 
-	/* Free history buffer/s */
-	do {
-		/* First reclaim HB internal memory, then HB itself */
-		if (buff->start_addr)
-			rfree(buff->start_addr);
-
-		_buff = buff->next;
-		rfree(buff);
-		buff = _buff;
-	} while (buff && buff != first_buff);
+	memset(buff, 0, sizeof(*buff));
 }
 
 /**
@@ -683,8 +644,7 @@ static void kpb_free(struct comp_dev *dev)
 #endif/* CONFIG_AMS */
 
 	/* Reclaim memory occupied by history buffer */
-	kpb_free_history_buffer(kpb->hd.c_hb);
-	kpb->hd.c_hb = NULL;
+	kpb_free_history_buffer(&kpb->hd.hb);
 	kpb->hd.buffer_size = 0;
 
 	/* remove scheduling */
@@ -805,13 +765,12 @@ static int kpb_prepare(struct comp_dev *dev)
 	kpb->kpb_no_of_clients = 0;
 	kpb->hd.buffered = 0;
 
-	if (kpb->hd.c_hb && kpb->hd.buffer_size < hb_size_req) {
+	if (kpb->hd.hb.blocks && kpb->hd.buffer_size < hb_size_req) {
 		/* Host params has changed, we need to allocate new buffer */
-		kpb_free_history_buffer(kpb->hd.c_hb);
-		kpb->hd.c_hb = NULL;
+		kpb_free_history_buffer(&kpb->hd.hb);
 	}
 
-	if (!kpb->hd.c_hb) {
+	if (!kpb->hd.hb.blocks) {
 		/* Allocate history buffer */
 		kpb->hd.buffer_size = kpb_allocate_history_buffer(kpb,
 								  hb_size_req);
@@ -819,14 +778,13 @@ static int kpb_prepare(struct comp_dev *dev)
 		/* Have we allocated what we requested? */
 		if (kpb->hd.buffer_size < hb_size_req) {
 			comp_cl_err(&comp_kpb, "kpb_prepare(): failed to allocate space for KPB buffer");
-			kpb_free_history_buffer(kpb->hd.c_hb);
-			kpb->hd.c_hb = NULL;
+			kpb_free_history_buffer(&kpb->hd.hb);
 			kpb->hd.buffer_size = 0;
 			return -EINVAL;
 		}
 	}
 	/* Init history buffer */
-	kpb_reset_history_buffer(kpb->hd.c_hb);
+	kpb_reset_history_buffer(&kpb->hd.hb);
 	kpb->hd.free = kpb->hd.buffer_size;
 
 	/* Initialize clients data */
@@ -847,8 +805,8 @@ static int kpb_prepare(struct comp_dev *dev)
 #endif /* CONFIG_AMS */
 
 	if (ret < 0) {
-		kpb_free_history_buffer(kpb->hd.c_hb);
-		kpb->hd.c_hb = NULL;
+		kpb_free_history_buffer(&kpb->hd.hb);
+		kpb->hd.buffer_size = 0;
 		return -ENOMEM;
 	}
 
@@ -969,11 +927,11 @@ static int kpb_reset(struct comp_dev *dev)
 			kpb->clients[i].r_ptr = NULL;
 		}
 
-		if (kpb->hd.c_hb) {
-			/* Reset history buffer - zero its data, reset pointers
-			 * and states.
+		if (kpb->hd.hb.blocks) {
+			/* Reset history buffer - zero its data and reset
+			 * pointers.
 			 */
-			kpb_reset_history_buffer(kpb->hd.c_hb);
+			kpb_reset_history_buffer(&kpb->hd.hb);
 		}
 
 #ifndef CONFIG_AMS
@@ -1359,7 +1317,7 @@ static int kpb_buffer_data(struct comp_dev *dev,
 	size_t size_to_copy = size;
 	size_t space_avail;
 	struct comp_data *kpb = comp_get_drvdata(dev);
-	struct history_buffer *buff = kpb->hd.c_hb;
+	struct history_buffer *buff = &kpb->hd.hb;
 	uint32_t offset = 0;
 	uint64_t timeout = 0;
 	uint64_t current_time;
@@ -1411,59 +1369,25 @@ static int kpb_buffer_data(struct comp_dev *dev,
 			return -ETIME;
 		}
 
-		/* Check how much space there is in current write buffer */
-		space_avail = (uintptr_t)buff->end_addr - (uintptr_t)buff->w_ptr;
-
-		if (size_to_copy > space_avail) {
-			/* We have more data to copy than available space
-			 * in this buffer, copy what's available and continue
-			 * with next buffer.
-			 */
-			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   space_avail, sample_width);
-			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + space_avail;
-			size_to_copy = size_to_copy - space_avail;
-			/* Update read pointer's offset before continuing
-			 * with next buffer.
-			 */
-			offset += space_avail;
-		} else {
-			/* Requested size is smaller or equal to the space
-			 * available in this buffer. In this scenario simply
-			 * copy what was requested.
-			 */
-			kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
-					   size_to_copy, sample_width);
-			/* Update write pointer & requested copy size */
-			buff->w_ptr = (char *)buff->w_ptr + size_to_copy;
-			/* Reset requested copy size */
-			size_to_copy = 0;
-		}
-		/* Have we filled whole buffer? */
-		if (buff->w_ptr == buff->end_addr) {
-			/* Reset write pointer back to the beginning
-			 * of the buffer.
-			 */
-			buff->w_ptr = buff->start_addr;
-			/* If we have more buffers use them */
-			if (buff->next && buff->next != buff) {
-				/* Mark current buffer FULL */
-				buff->state = KPB_BUFFER_FULL;
-				/* Use next buffer available on the list
-				 * of buffers.
-				 */
-				buff = buff->next;
-				/* Update also component container,
-				 * so next time we enter buffering function
-				 * we will know right away what is the current
-				 * write buffer
-				 */
-				kpb->hd.c_hb = buff;
-			}
-			/* Mark buffer as FREE */
-			buff->state = KPB_BUFFER_FREE;
+		/* Copy up to the end of the current block, the rest of the
+		 * data is copied to the next one in the next iteration.
+		 */
+		space_avail = (uintptr_t)buff->block[buff->w_block].end_addr -
+			      (uintptr_t)buff->w_ptr;
+		space_avail = MIN(size_to_copy, space_avail);
+
+		kpb_buffer_samples(&source->stream, offset, buff->w_ptr,
+				   space_avail, sample_width);
+
+		/* Update write pointer, read offset & requested copy size */
+		buff->w_ptr = (char *)buff->w_ptr + space_avail;
+		if (buff->w_ptr == buff->block[buff->w_block].end_addr) {
+			buff->w_block = (buff->w_block + 1) % buff->blocks;
+			buff->w_ptr = buff->block[buff->w_block].start_addr;
 		}
+
+		offset += space_avail;
+		size_to_copy -= space_avail;
 	}
 
 	kpb_change_state(kpb, state_preserved);
@@ -1567,10 +1491,10 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 	size_t drain_req = cli->drain_req * kpb->config.channels *
 			       (kpb->config.sampling_freq / 1000) *
 			       (KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8);
-	struct history_buffer *buff = kpb->hd.c_hb;
-	struct history_buffer *first_buff = buff;
-	size_t buffered = 0;
-	size_t local_buffered;
+	struct history_buffer *buff = &kpb->hd.hb;
+	size_t r_offset;
+	size_t block_size;
+	int i;
 	size_t drain_interval;
 	size_t host_period_size = kpb->host_period_size;
 	size_t bytes_per_ms = KPB_SAMPLES_PER_MS *
@@ -1606,54 +1530,28 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 		 */
 		kpb->hd.free = kpb->hd.buffer_size - drain_req;
 
-		/* Find buffer to start draining from */
-		do {
-			/* Calculate how much data we have stored in
-			 * current buffer.
-			 */
-			buff->r_ptr = buff->start_addr;
-			if (buff->state == KPB_BUFFER_FREE) {
-				local_buffered = (uintptr_t)buff->w_ptr -
-						 (uintptr_t)buff->start_addr;
-				buffered += local_buffered;
-			} else if (buff->state == KPB_BUFFER_FULL) {
-				local_buffered = (uintptr_t)buff->end_addr -
-						 (uintptr_t)buff->start_addr;
-				buffered += local_buffered;
-			} else {
-				comp_err(dev, "kpb_init_draining(): incorrect buffer label");
-			}
-			/* Check if this is already sufficient to start draining
-			 * if not, go to previous buffer and continue
-			 * calculations.
-			 */
-			if (drain_req > buffered) {
-				if (buff->prev == first_buff) {
-					/* We went full circle and still don't
-					 * have sufficient data for draining.
-					 * That means we need to look up the
-					 * first buffer again. Our read pointer
-					 * is somewhere between write pointer
-					 * and buffer's end address.
-					 */
-					buff = buff->prev;
-					buffered += (uintptr_t)buff->end_addr -
-						    (uintptr_t)buff->w_ptr;
-					buff->r_ptr = (char *)buff->w_ptr +
-						      (buffered - drain_req);
-					break;
-				}
-				buff = buff->prev;
-			} else if (drain_req == buffered) {
-				buff->r_ptr = buff->start_addr;
-				break;
-			} else {
-				buff->r_ptr = (char *)buff->start_addr +
-					      (buffered - drain_req);
+		/* The data to drain is the drain_req bytes written last,
+		 * start reading that much behind the write pointer.
+		 */
+		r_offset = (uintptr_t)buff->w_ptr -
+			   (uintptr_t)buff->block[buff->w_block].start_addr +
+			   kpb->hd.buffer_size - drain_req;
+		for (i = 0; i < buff->w_block; i++)
+			r_offset += (uintptr_t)buff->block[i].end_addr -
+				    (uintptr_t)buff->block[i].start_addr;
+		r_offset %= kpb->hd.buffer_size;
+
+		/* Find the block of that ring offset */
+		for (i = 0; ; i++) {
+			block_size = (uintptr_t)buff->block[i].end_addr -
+				     (uintptr_t)buff->block[i].start_addr;
+			if (r_offset < block_size)
 				break;
-			}
+			r_offset -= block_size;
+		}
 
-		} while (buff != first_buff);
+		buff->r_block = i;
+		buff->r_ptr = (char *)buff->block[i].start_addr + r_offset;
 
 		kpb_unlock(kpb);
 
@@ -1706,6 +1604,52 @@ static void kpb_init_draining(struct comp_dev *dev, struct kpb_client *cli)
 	}
 }
 
+/**
+ * \brief Run the fast mode modules on the data drained so far.
+ *
+ * \param[in] dev - KPB component device pointer.
+ * \param[in] sink_dev - draining sink component, copied by the caller.
+ *
+ * \return none.
+ */
+static void kpb_fast_mode_copy(struct comp_dev *dev, struct comp_dev *sink_dev)
+{
+#ifdef CONFIG_IPC_MAJOR_4
+	struct comp_data *kpb = comp_get_drvdata(dev);
+	struct device_list *list;
+	struct comp_dev *mod;
+	size_t i, j;
+
+	/* The modules registered for fast mode process the drained
+	 * history in the same batches as the host sink does, faster than
+	 * real time. KPB itself and modules of other cores are skipped.
+	 *
+	 * Only LL modules are run. The draining task holds k_sched_lock()
+	 * so the LL thread of this core can't preempt these copies, and an
+	 * LL module copy only processes what its source holds and its sink
+	 * takes, so one more copy between two LL ticks is the same as an
+	 * LL tick which found more data. DP modules run in their own thread
+	 * and must not be copied from here.
+	 */
+	for (i = 0; i < ARRAY_SIZE(kpb->fmt.device_list); i++) {
+		list = kpb->fmt.device_list[i];
+		if (!list)
+			continue;
+
+		for (j = 0; j < list->count; j++) {
+			mod = *list->devs[j];
+			if (mod == dev || mod == sink_dev ||
+			    mod->state != COMP_STATE_ACTIVE ||
+			    mod->ipc_config.proc_domain != COMP_PROCESSING_DOMAIN_LL ||
+			    !cpu_is_me(mod->ipc_config.core))
+				continue;
+
+			comp_copy(mod);
+		}
+	}
+#endif
+}
+
 /**
  * \brief Draining task.
  *
@@ -1723,7 +1667,6 @@ static enum task_state kpb_draining_task(void *arg)
 	size_t sample_width = draining_data->sample_width;
 	size_t size_to_read;
 	size_t size_to_copy;
-	bool move_buffer = false;
 	uint32_t drained = 0;
 	uint64_t draining_time_start;
 	uint64_t draining_time_end;
@@ -1739,6 +1682,8 @@ static enum task_state kpb_draining_task(void *arg)
 	struct comp_data *kpb = comp_get_drvdata(draining_data->dev);
 	bool sync_mode_on = draining_data->sync_mode_on;
 	bool pm_is_active;
+	uint64_t batch_time = k_us_to_cyc_ceil64(KPB_DRAIN_BATCH_TIME_US);
+	uint64_t batch_end = 0;
 
 	/*
 	 * WORKAROUND: The code below accesses KPB sink buffer and calls comp_copy() on
@@ -1767,13 +1712,17 @@ static enum task_state kpb_draining_task(void *arg)
 	while (drain_req > 0) {
 		/*
 		 * Draining task usually runs for quite a lot of time (could be few seconds).
-		 * LL should not be blocked for such a long time.
+		 * LL should not be blocked for such a long time, so the history
+		 * is drained in batches of KPB_DRAIN_BATCH_TIME_US.
 		 */
+		if (sof_cycle_get_64() >= batch_end) {
 #ifdef __ZEPHYR__
-		k_sched_unlock();
-		k_yield();
-		k_sched_lock();
+			k_sched_unlock();
+			k_yield();
+			k_sched_lock();
 #endif
+			batch_end = sof_cycle_get_64() + batch_time;
+		}
 
 		/* Have we received reset request? */
 		if (kpb->state == KPB_STATE_RESETTING) {
@@ -1788,52 +1737,50 @@ static enum task_state kpb_draining_task(void *arg)
 		    next_copy_time > sof_cycle_get_64()) {
 			period_bytes = 0;
 			period_copy_start = sof_cycle_get_64();
+			batch_end = 0;
 			continue;
 		} else if (next_copy_time == 0) {
 			period_copy_start = sof_cycle_get_64();
 		}
 
-		size_to_read = (uintptr_t)buff->end_addr - (uintptr_t)buff->r_ptr;
-
-		if (size_to_read > audio_stream_get_free_bytes(&sink->stream)) {
-			if (audio_stream_get_free_bytes(&sink->stream) >= drain_req)
-				size_to_copy = drain_req;
-			else
-				size_to_copy = audio_stream_get_free_bytes(&sink->stream);
-		} else {
-			if (size_to_read > drain_req) {
-				size_to_copy = drain_req;
-			} else {
-				size_to_copy = size_to_read;
-				move_buffer = true;
-			}
-		}
+		/* Copy as much as the sink can take up to the end of the
+		 * current block in one go.
+		 */
+		size_to_read = (uintptr_t)buff->block[buff->r_block].end_addr -
+			       (uintptr_t)buff->r_ptr;
+		size_to_copy = MIN(size_to_read, drain_req);
+		size_to_copy = MIN(size_to_copy, audio_stream_get_free_bytes(&sink->stream));
 
 		kpb_drain_samples(buff->r_ptr, &sink->stream, size_to_copy,
 				  sample_width);
 
 		buff->r_ptr = (char *)buff->r_ptr + (uint32_t)size_to_copy;
+		if (buff->r_ptr == buff->block[buff->r_block].end_addr) {
+			buff->r_block = (buff->r_block + 1) % buff->blocks;
+			buff->r_ptr = buff->block[buff->r_block].start_addr;
+		}
+
 		drain_req -= size_to_copy;
 		drained += size_to_copy;
 		period_bytes += size_to_copy;
 		kpb->hd.free += MIN(kpb->hd.buffer_size -
 				    kpb->hd.free, size_to_copy);
 
-		if (move_buffer) {
-			buff->r_ptr = buff->start_addr;
-			buff = buff->next;
-			move_buffer = false;
-		}
-
 		if (size_to_copy) {
 			comp_update_buffer_produce(sink, size_to_copy);
 			comp_copy(comp_buffer_get_sink_component(sink));
+			kpb_fast_mode_copy(draining_data->dev,
+					   comp_buffer_get_sink_component(sink));
 		} else if (!audio_stream_get_free_bytes(&sink->stream)) {
 			/* There is no free space in sink buffer.
 			 * Call .copy() on sink component so it can
 			 * process its data further.
 			 */
 			comp_copy(comp_buffer_get_sink_component(sink));
+			kpb_fast_mode_copy(draining_data->dev,
+					   comp_buffer_get_sink_component(sink));
+			/* and let the host consume it before the next try */
+			batch_end = 0;
 		}
 
 		if (sync_mode_on && period_bytes >= period_bytes_limit) {
@@ -2109,26 +2056,20 @@ static void kpb_buffer_samples(const struct audio_stream *source,
 
 /**
  * \brief Initialize history buffer by zeroing its memory.
- * \param[in] buff - pointer to current history buffer.
+ * \param[in] buff - pointer to history buffer.
  *
  * \return: none.
  */
 static void kpb_clear_history_buffer(struct history_buffer *buff)
 {
-	struct history_buffer *first_buff = buff;
-	void *start_addr;
-	size_t size;
+	int i;
 
 	comp_cl_info(&comp_kpb, "kpb_clear_history_buffer()");
 
-	do {
-		start_addr = buff->start_addr;
-		size = (uintptr_t)buff->end_addr - (uintptr_t)start_addr;
-
-		bzero(start_addr, size);
-
-		buff = buff->next;
-	} while (buff != first_buff);
+	for (i = 0; i < buff->blocks; i++)
+		bzero(buff->block[i].start_addr,
+		      (uintptr_t)buff->block[i].end_addr -
+		      (uintptr_t)buff->block[i].start_addr);
 }
 
 static inline bool kpb_is_sample_width_supported(uint32_t sampling_width)
@@ -2262,29 +2203,23 @@ static void kpb_copy_samples(struct comp_buffer *sink,
 
 /**
  * \brief Reset history buffer.
- * \param[in] buff - pointer to current history buffer.
+ * \param[in] buff - pointer to history buffer.
  *
  * \return none.
  */
 static void kpb_reset_history_buffer(struct history_buffer *buff)
 {
-	struct history_buffer *first_buff = buff;
-
 	comp_cl_info(&comp_kpb, "kpb_reset_history_buffer()");
 
-	if (!buff)
+	if (!buff->blocks)
 		return;
 
 	kpb_clear_history_buffer(buff);
 
-	do {
-		buff->w_ptr = buff->start_addr;
-		buff->r_ptr = buff->start_addr;
-		buff->state = KPB_BUFFER_FREE;
-
-		buff = buff->next;
-
-	} while (buff != first_buff);
+	buff->w_block = 0;
+	buff->r_block = 0;
+	buff->w_ptr = buff->block[0].start_addr;
+	buff->r_ptr = buff->block[0].start_addr;
 }
 
 static inline bool validate_host_params(struct comp_dev *dev,
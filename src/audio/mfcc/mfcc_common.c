@@ -98,9 +98,9 @@ static int mfcc_stft_process(const struct comp_dev *dev, struct mfcc_state *stat
 
 		/* Compute FFT */
 #if MFCC_FFT_BITS == 16
-		fft_execute_16(fft->fft_plan, false);
+		fft_execute_real_16(fft->fft_plan, false);
 #else
-		fft_execute_32(fft->fft_plan, false);
+		fft_execute_real_32(fft->fft_plan, false);
 #endif
 
 		/* Convert powerspectrum to Mel band logarithmic spectrum */
@@ -111,7 +111,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	 * remains zero.
 	 */
 	for (j = 0; j < state->prev_data_size; j++)
-		fft->fft_buf[idx + j].real = state->prev_data[j];
+		fft->fft_buf[idx + j] = state->prev_data[j];
 
 	/* Copy hop size of new data from circular buffer */
 	idx += state->prev_data_size;
@@ -120,7 +120,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 		n = mfcc_buffer_samples_without_wrap(buf, r);
 		n = MIN(n, nmax);
 		for (j = 0; j < n; j++) {
-			fft->fft_buf[idx].real = *r;
+			fft->fft_buf[idx] = *r;
 			r++;
 			idx++;
 		}
@@ -134,7 +134,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	/* Copy for next time data back to overlap buffer */
 	idx = fft->fft_fill_start_idx + fft->fft_hop_size;
 	for (j = 0; j < state->prev_data_size; j++)
-		state->prev_data[j] = fft->fft_buf[idx + j].real;
+		state->prev_data[j] = fft->fft_buf[idx + j];
 }
 
 #ifdef MFCC_NORMALIZE_FFT
@@ -149,7 +149,7 @@ int mfcc_normalize_fft_buffer(struct mfcc_state *state)
 	int i = fft->fft_fill_start_idx;
 
 	for (j = 0; j < fft->fft_size; j++) {
-		x = fft->fft_buf[i + j].real;
+		x = fft->fft_buf[i + j];
 		absx = (x < 0) ? -x : x;
 		if (smax < absx)
 			smax = absx;
@@ -174,15 +174,15 @@ void mfcc_apply_window(struct mfcc_state *state, int input_shift)
 	int s = 14 - input_shift; /* Q1.15 x Q1.15 -> Q30 -> Q15, shift by 15 - 1 for round */
 
 	for (j = 0; j < fft->fft_size; j++) {
-		x = (int32_t)fft->fft_buf[i + j].real * state->window[j];
-		fft->fft_buf[i + j].real = ((x >> s) + 1) >> 1;
+		x = (int32_t)fft->fft_buf[i + j] * state->window[j];
+		fft->fft_buf[i + j] = ((x >> s) + 1) >> 1;
 	}
 #else
 	/* TODO: Use proper multiply and saturate function to make sure no overflows */
 	int s = input_shift + 1; /* To convert 16 -> 32 with Q1.15 x Q1.15 -> Q30 -> Q31 */
 
 	for (j = 0; j < fft->fft_size; j++)
-		fft->fft_buf[i + j].real = (fft->fft_buf[i + j].real * state->window[j]) << s;
+		fft->fft_buf[i + j] = (fft->fft_buf[i + j] * state->window[j]) << s;
 #endif
 }
 
@@ -124,7 +124,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	struct mfcc_buffer *buf = &state->buf;
 	struct mfcc_fft *fft = &state->fft;
 	int idx = fft->fft_fill_start_idx;
-	ae_int16 *out = (ae_int16 *)&fft->fft_buf[idx].real;
+	ae_int16 *out = (ae_int16 *)&fft->fft_buf[idx];
 	ae_int16 *in = (ae_int16 *)state->prev_data;
 	ae_int16x4 sample;
 	const int buf_inc = sizeof(ae_int16);
@@ -142,7 +142,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 	/* Copy hop size of new data from circular buffer */
 	idx += state->prev_data_size;
 	in = (ae_int16 *)buf->r_ptr;
-	out = (ae_int16 *)&fft->fft_buf[idx].real;
+	out = (ae_int16 *)&fft->fft_buf[idx];
 	set_circular_buf0(buf->addr, buf->end_addr);
 	for (j = 0; j < fft->fft_hop_size; j++) {
 		AE_L16_XC(sample, in, buf_inc);
@@ -155,7 +155,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 
 	/* Copy for next time data back to overlap buffer */
 	idx = fft->fft_fill_start_idx + fft->fft_hop_size;
-	in = (ae_int16 *)&fft->fft_buf[idx].real;
+	in = (ae_int16 *)&fft->fft_buf[idx];
 	out = (ae_int16 *)state->prev_data;
 	for (j = 0; j < state->prev_data_size; j++) {
 		AE_L16_XP(sample, in, fft_inc);
@@ -167,7 +167,7 @@ void mfcc_fill_fft_buffer(struct mfcc_state *state)
 int mfcc_normalize_fft_buffer(struct mfcc_state *state)
 {
 	struct mfcc_fft *fft = &state->fft;
-	ae_p16s *in = (ae_p16s *)&fft->fft_buf[fft->fft_fill_start_idx].real;
+	ae_p16s *in = (ae_p16s *)&fft->fft_buf[fft->fft_fill_start_idx];
 	ae_int32x2 sample;
 	ae_int32x2 max = AE_ZERO32();
 	const int fft_inc = sizeof(fft->fft_buf[0]);
@@ -197,7 +197,7 @@ void mfcc_apply_window(struct mfcc_state *state, int input_shift)
 	int j;
 
 #if MFCC_FFT_BITS == 16
-	ae_int16 *fft_in = (ae_int16 *)&fft->fft_buf[fft->fft_fill_start_idx].real;
+	ae_int16 *fft_in = (ae_int16 *)&fft->fft_buf[fft->fft_fill_start_idx];
 	ae_int16x4 sample;
 
 	for (j = 0; j < fft->fft_size; j++) {
@@ -209,7 +209,7 @@ void mfcc_apply_window(struct mfcc_state *state, int input_shift)
 		AE_S16_0_XP(sample, fft_in, fft_inc);
 	}
 #else
-	ae_int32 *fft_in = (ae_int32 *)&fft->fft_buf[fft->fft_fill_start_idx].real;
+	ae_int32 *fft_in = (ae_int32 *)&fft->fft_buf[fft->fft_fill_start_idx];
 	ae_int32x2 sample;
 
 	for (j = 0; j < fft->fft_size; j++) {
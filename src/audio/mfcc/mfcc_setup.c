@@ -183,7 +183,10 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	state->prev_data = state->buffers + state->buffer_size;
 	state->window = state->prev_data + state->prev_data_size;
 
-	/* Allocate buffers for FFT input and output data */
+	/* Allocate buffers for FFT input and output data. The real FFT needs only
+	 * half of the size but the buffers are used as scratch also for the Mel
+	 * filterbank setup and for the power spectra.
+	 */
 #if MFCC_FFT_BITS == 16
 	fft->fft_buffer_size = fft->fft_padded_size * sizeof(struct icomplex16);
 #else
@@ -206,8 +209,8 @@ int mfcc_setup(struct processing_module *mod, int max_frames, int sample_rate, i
 	fft->fft_fill_start_idx = 0; /* From config pad_type */
 
 	/* Setup FFT */
-	fft->fft_plan = fft_plan_new(fft->fft_buf, fft->fft_out, fft->fft_padded_size,
-				     MFCC_FFT_BITS);
+	fft->fft_plan = fft_real_plan_new(fft->fft_buf, fft->fft_out, fft->fft_padded_size,
+					  MFCC_FFT_BITS);
 	if (!fft->fft_plan) {
 		comp_err(dev, "mfcc_setup(): Failed FFT init");
 		ret = -EINVAL;
@@ -319,7 +322,7 @@ exit:
 
 void mfcc_free_buffers(struct mfcc_comp_data *cd)
 {
-	fft_plan_free(cd->state.fft.fft_plan);
+	fft_real_plan_free(cd->state.fft.fft_plan);
 	rfree(cd->state.fft.fft_buf);
 	rfree(cd->state.fft.fft_out);
 	rfree(cd->state.buffers);
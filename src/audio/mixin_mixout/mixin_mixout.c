@@ -74,6 +74,13 @@ struct mixin_data {
 	mix_func mix;
 	mix_func gain_mix;
 	struct mixin_sink_config sink_config[MIXIN_MAX_SINKS];
+
+	/* Source data with a gain applied, shared by all mixouts that use that gain.
+	 * Only allocated for S16 and S24 when at least two sinks are configured with
+	 * the same non unity gain.
+	 */
+	void *gain_buf;
+	uint32_t gain_buf_size;
 };
 
 /*
@@ -173,6 +180,7 @@ static int mixin_free(struct processing_module *mod)
 {
 	struct mixin_data *md = module_get_private_data(mod);
 
+	rfree(md->gain_buf);
 	rfree(md);
 
 	return 0;
@@ -237,6 +245,83 @@ static void silence(struct cir_buf_ptr *stream, uint32_t start_offset,
 	}
 }
 
+/* Returns a mask of the active mixouts, starting with the first one, that mix with the
+ * same non unity gain and channel count as the first one. Such mixouts get the very same
+ * data mixed in, so the gain can be applied just once for all of them.
+ */
+static uint32_t gain_group(const struct mixin_data *mixin_data,
+			   struct processing_module **mixouts, const uint16_t *sinks_ids,
+			   int first, int num_of_sinks)
+{
+	uint32_t channels = sink_get_channels(mixouts[first]->sinks[0]);
+	uint32_t group = BIT(first);
+	uint16_t gain;
+	int i;
+
+	/* an invalid sink index is reported by mix() */
+	if (!mixin_data->gain_buf || sinks_ids[first] >= MIXIN_MAX_SINKS)
+		return group;
+
+	gain = mixin_data->sink_config[sinks_ids[first]].gain;
+	if (gain == IPC4_MIXIN_UNITY_GAIN)
+		return group;
+
+	for (i = first + 1; i < num_of_sinks; i++)
+		if (mixouts[i] && sinks_ids[i] < MIXIN_MAX_SINKS &&
+		    mixin_data->sink_config[sinks_ids[i]].gain == gain &&
+		    sink_get_channels(mixouts[i]->sinks[0]) == channels)
+			group |= BIT(i);
+
+	return group;
+}
+
+/* Mixes source into a group of mixouts found by gain_group(). The gain is applied to a
+ * chunk of source data into gain_buf and then the result is mixed into each mixout of
+ * the group with the cheaper unity gain function.
+ */
+static void mix_gain_group(struct mixin_data *mixin_data, struct processing_module **mixouts,
+			   struct pending_frames **pending, int first, int num_of_sinks,
+			   uint32_t group, uint16_t gain, const struct cir_buf_ptr *source,
+			   uint32_t frames)
+{
+	struct sof_sink *first_sink = mixouts[first]->sinks[0];
+	uint32_t channel_count = sink_get_channels(first_sink);
+	uint32_t sample_bytes = sink_get_frame_bytes(first_sink) / channel_count;
+	uint32_t chunk_samples = mixin_data->gain_buf_size / sample_bytes;
+	uint32_t sample_count = frames * channel_count;
+	struct cir_buf_ptr src = *source;
+	struct cir_buf_ptr scaled;
+	struct mixout_data *mixout_data;
+	uint32_t offset, start_sample, mixed_samples, n;
+	int i;
+
+	scaled.buf_start = mixin_data->gain_buf;
+	scaled.ptr = mixin_data->gain_buf;
+
+	for (offset = 0; offset < sample_count; offset += n) {
+		n = MIN(sample_count - offset, chunk_samples);
+		scaled.buf_end = (uint8_t *)mixin_data->gain_buf + n * sample_bytes;
+
+		/* nothing mixed in gain_buf yet, so this is a copy with gain */
+		mixin_data->gain_mix(&scaled, 0, 0, &src, n, gain);
+
+		for (i = first; i < num_of_sinks; i++) {
+			if (!(group & BIT(i)))
+				continue;
+
+			mixout_data = module_get_private_data(mixouts[i]);
+			start_sample = pending[i]->frames * channel_count + offset;
+			mixed_samples = MAX(mixout_data->mixed_frames * channel_count,
+					    start_sample);
+			mixin_data->mix(&mixout_data->acquired_buf, start_sample, mixed_samples,
+					&scaled, n, IPC4_MIXIN_UNITY_GAIN);
+		}
+
+		src.ptr = cir_buf_wrap((uint8_t *)src.ptr + n * sample_bytes,
+				       src.buf_start, src.buf_end);
+	}
+}
+
 /* Most of the mixing is done here on mixin side. mixin mixes its source data
  * into each connected mixout sink buffer. Basically, if mixout sink buffer has
  * no data, mixin copies its source data into mixout sink buffer. If mixout sink
@@ -261,8 +346,10 @@ static int mixin_process(struct processing_module *mod,
 	struct comp_dev *dev = mod->dev;
 	uint32_t source_avail_frames, sinks_free_frames;
 	struct processing_module *active_mixouts[MIXIN_MAX_SINKS];
+	struct pending_frames *sinks_pending[MIXIN_MAX_SINKS];
 	uint16_t sinks_ids[MIXIN_MAX_SINKS];
 	uint32_t bytes_to_consume = 0;
+	uint32_t mixed_sinks = 0;
 	uint32_t frames_to_copy;
 	struct pending_frames *pending_frames;
 	int i, ret;
@@ -335,6 +422,7 @@ static int mixin_process(struct processing_module *mod,
 			comp_err(dev, "No source info");
 			return -EINVAL;
 		}
+		sinks_pending[i] = pending_frames;
 
 		/* In theory, though unlikely, mixout sink can be connected to some module on
 		 * another core. In this case free space in mixout sink buffer can suddenly increase
@@ -376,22 +464,47 @@ static int mixin_process(struct processing_module *mod,
 		frames_to_copy = MIN(dev->frames, sinks_free_frames);
 	}
 
+	/* mixout sink buffer is acquired here by its first connected mixin and is
+	 * released in mixout_process(). Other connected mixins just use a pointer
+	 * stored in mixout_data->acquired_buf.
+	 */
+	for (i = 0; i < num_of_sinks; i++) {
+		struct mixout_data *mixout_data;
+		struct processing_module *mixout_mod;
+		struct sof_sink *sink;
+		size_t free_bytes;
+		size_t buf_size;
+
+		mixout_mod = active_mixouts[i];
+		if (!mixout_mod)
+			continue;
+
+		mixout_data = module_get_private_data(mixout_mod);
+		if (mixout_data->acquired_buf.ptr)
+			continue;
+
+		sink = mixout_mod->sinks[0];
+		free_bytes = sink_get_free_size(sink);
+		sink_get_buffer(sink, free_bytes, &mixout_data->acquired_buf.ptr,
+				&mixout_data->acquired_buf.buf_start, &buf_size);
+		mixout_data->acquired_buf.buf_end =
+			(uint8_t *)mixout_data->acquired_buf.buf_start + buf_size;
+		mixout_data->acquired_buf_free_frames = free_bytes / sink_get_frame_bytes(sink);
+	}
+
 	/* iterate over all connected mixouts and mix source data into each mixout sink buffer */
 	for (i = 0; i < num_of_sinks; i++) {
 		struct mixout_data *mixout_data;
 		struct processing_module *mixout_mod;
 		uint32_t start_frame;
+		uint32_t group;
 
 		mixout_mod = active_mixouts[i];
 		if (!mixout_mod)
 			continue;
 
 		mixout_data = module_get_private_data(mixout_mod);
-		pending_frames = get_mixin_pending_frames(mixout_data, dev);
-		if (!pending_frames) {
-			comp_err(dev, "No source info");
-			return -EINVAL;
-		}
+		pending_frames = sinks_pending[i];
 
 		/* Skip data from previous run(s) not yet produced in mixout_process().
 		 * Normally start_frame would be 0 unless mixout pipeline has serious
@@ -399,23 +512,6 @@ static int mixin_process(struct processing_module *mod,
 		 */
 		start_frame = pending_frames->frames;
 
-		/* mixout sink buffer is acquired here by its first connected mixin and is
-		 * released in mixout_process(). Other connected mixins just use a pointer
-		 * stored in mixout_data->acquired_buf.
-		 */
-		if (!mixout_data->acquired_buf.ptr) {
-			struct sof_sink *sink = mixout_mod->sinks[0];
-			size_t free_bytes = sink_get_free_size(sink);
-			size_t buf_size;
-
-			sink_get_buffer(sink, free_bytes, &mixout_data->acquired_buf.ptr,
-					&mixout_data->acquired_buf.buf_start, &buf_size);
-			mixout_data->acquired_buf.buf_end =
-				(uint8_t *)mixout_data->acquired_buf.buf_start + buf_size;
-			mixout_data->acquired_buf_free_frames =
-				free_bytes / sink_get_frame_bytes(sink);
-		}
-
 		/* if source does not produce any data but mixin is in active state -- generate
 		 * silence instead of that source data
 		 */
@@ -426,19 +522,31 @@ static int mixin_process(struct processing_module *mod,
 			silence(&mixout_data->acquired_buf, start_frame * frame_bytes,
 				mixout_data->mixed_frames * frame_bytes,
 				frames_to_copy * frame_bytes);
-		} else {
+		} else if (!(mixed_sinks & BIT(i))) {
 			uint32_t channel_count = sink_get_channels(mixout_mod->sinks[0]);
 
-			/* basically, if sink buffer has no data -- copy source data there, if
-			 * sink buffer has some data (written by another mixin) mix that data
-			 * with source data.
-			 */
-			ret = mix(dev, mixin_data, sinks_ids[i], &mixout_data->acquired_buf,
-				  start_frame * channel_count,
-				  mixout_data->mixed_frames * channel_count,
-				  &source_ptr, frames_to_copy * channel_count);
-			if (ret < 0)
-				return ret;
+			/* mixouts sharing a gain were mixed along with the first of them */
+			group = gain_group(mixin_data, active_mixouts, sinks_ids, i, num_of_sinks);
+			mixed_sinks |= group;
+
+			if (group != BIT(i)) {
+				mix_gain_group(mixin_data, active_mixouts, sinks_pending, i,
+					       num_of_sinks, group,
+					       mixin_data->sink_config[sinks_ids[i]].gain,
+					       &source_ptr, frames_to_copy);
+			} else {
+				/* basically, if sink buffer has no data -- copy source data
+				 * there, if sink buffer has some data (written by another
+				 * mixin) mix that data with source data.
+				 */
+				ret = mix(dev, mixin_data, sinks_ids[i],
+					  &mixout_data->acquired_buf,
+					  start_frame * channel_count,
+					  mixout_data->mixed_frames * channel_count,
+					  &source_ptr, frames_to_copy * channel_count);
+				if (ret < 0)
+					return ret;
+			}
 		}
 
 		pending_frames->frames += frames_to_copy;
@@ -546,6 +654,10 @@ static int mixin_reset(struct processing_module *mod)
 	mixin_data->mix = NULL;
 	mixin_data->gain_mix = NULL;
 
+	rfree(mixin_data->gain_buf);
+	mixin_data->gain_buf = NULL;
+	mixin_data->gain_buf_size = 0;
+
 	return 0;
 }
 
@@ -639,6 +751,29 @@ static int mixin_params(struct processing_module *mod)
 	return 0;
 }
 
+/* Returns true when at least two sinks are configured with the same non unity gain */
+static bool mixin_gain_shared(const struct mixin_data *md, struct sof_sink **sinks,
+			      int num_of_sinks)
+{
+	uint32_t id, other;
+	int i, j;
+
+	for (i = 0; i < num_of_sinks; i++) {
+		id = IPC4_SRC_QUEUE_ID(sink_get_id(sinks[i]));
+		if (id >= MIXIN_MAX_SINKS || md->sink_config[id].gain == IPC4_MIXIN_UNITY_GAIN)
+			continue;
+
+		for (j = i + 1; j < num_of_sinks; j++) {
+			other = IPC4_SRC_QUEUE_ID(sink_get_id(sinks[j]));
+			if (other < MIXIN_MAX_SINKS &&
+			    md->sink_config[other].gain == md->sink_config[id].gain)
+				return true;
+		}
+	}
+
+	return false;
+}
+
 /*
  * Prepare the mixer. The mixer may already be running at this point with other
  * sources. Make sure we only prepare the "prepared" source streams and not
@@ -681,6 +816,22 @@ static int mixin_prepare(struct processing_module *mod,
 		return -EINVAL;
 	}
 
+	/* mix_gain_group() applies a gain once for all mixouts sharing it, a period of
+	 * source data at a time. Not needed unless two sinks share a non unity gain.
+	 * The S32 unity mix costs about as much as the gain mix, so the extra pass
+	 * over gain_buf does not pay off there (see mix_gain_shared in audio_bench).
+	 */
+	if (fmt != SOF_IPC_FRAME_S32_LE && mixin_gain_shared(md, sinks, num_of_sinks) &&
+	    dev->frames && !md->gain_buf) {
+		md->gain_buf_size = dev->frames * sink_get_frame_bytes(sinks[0]);
+		md->gain_buf = rballoc(0, SOF_MEM_CAPS_RAM, md->gain_buf_size);
+		if (!md->gain_buf) {
+			comp_err(dev, "failed to allocate gain buffer");
+			md->gain_buf_size = 0;
+			return -ENOMEM;
+		}
+	}
+
 	return 0;
 }
 
@@ -142,6 +142,7 @@ void *module_allocate_memory(struct processing_module *mod, uint32_t size, uint3
 	}
 	/* Store reference to allocated memory */
 	container->ptr = ptr;
+	container->size = size;
 	list_item_prepend(&container->mem_list, &mod->priv.memory.mem_list);
 
 	return ptr;
@@ -239,6 +240,8 @@ int module_process_legacy(struct processing_module *mod,
 	/* set state to processing */
 	md->state = MODULE_PROCESSING;
 #endif
+	comp_profile_mark(comp_dev_profile(dev), COMP_PROFILE_GET_DATA);
+
 	if (IS_PROCESSING_MODE_AUDIO_STREAM(mod))
 		ret = ops->process_audio_stream(mod, input_buffers, num_input_buffers,
 							     output_buffers, num_output_buffers);
@@ -248,6 +251,8 @@ int module_process_legacy(struct processing_module *mod,
 	else
 		ret = -EOPNOTSUPP;
 
+	comp_profile_mark(comp_dev_profile(dev), COMP_PROFILE_PROCESS);
+
 	if (ret && ret != -ENOSPC && ret != -ENODATA) {
 		comp_err(dev, "module_process() error %d: for comp %d",
 			 ret, dev_comp_id(dev));
@@ -286,8 +291,15 @@ int module_process_sink_src(struct processing_module *mod,
 	md->state = MODULE_PROCESSING;
 #endif
 	assert(ops->process);
+	/* DP modules are processed in their own thread, outside of comp_copy() */
+	if (dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_LL)
+		comp_profile_mark(comp_dev_profile(dev), COMP_PROFILE_GET_DATA);
+
 	ret = ops->process(mod, sources, num_of_sources, sinks, num_of_sinks);
 
+	if (dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_LL)
+		comp_profile_mark(comp_dev_profile(dev), COMP_PROFILE_PROCESS);
+
 	if (ret && ret != -ENOSPC && ret != -ENODATA) {
 		comp_err(dev, "module_process() error %d: for comp %d",
 			 ret, dev_comp_id(dev));
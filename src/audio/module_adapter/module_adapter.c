@@ -114,8 +114,14 @@ struct comp_dev *module_adapter_new(const struct comp_driver *drv,
 
 #if CONFIG_ZEPHYR_DP_SCHEDULER
 	/* create a task for DP processing */
-	if (config->proc_domain == COMP_PROCESSING_DOMAIN_DP)
-		pipeline_comp_dp_task_init(dev);
+	if (config->proc_domain == COMP_PROCESSING_DOMAIN_DP) {
+		ret = pipeline_comp_dp_task_init(dev);
+		if (ret) {
+			comp_err(dev, "module_adapter_new() %d: DP task creation failed", ret);
+			module_free(mod);
+			goto err;
+		}
+	}
 #endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
 
 	module_adapter_reset_data(dst);
@@ -152,6 +158,18 @@ static void module_adapter_calculate_dp_period(struct comp_dev *dev)
 }
 #endif /* CONFIG_ZEPHYR_DP_SCHEDULER */
 
+/*
+ * In raw data mode an in-place module with a single input and a single output may use its
+ * input buffer as the output buffer, provided the output fits into it.
+ */
+static bool module_adapter_raw_in_place(struct processing_module *mod)
+{
+	struct module_data *md = &mod->priv;
+
+	return mod->in_place && mod->num_of_sources == 1 && mod->num_of_sinks == 1 &&
+	       md->mpd.out_buff_size <= MAX(mod->deep_buff_bytes, mod->period_bytes);
+}
+
 /*
  * \brief Prepare the module
  * \param[in] dev - component device pointer.
@@ -341,6 +359,9 @@ int module_adapter_prepare(struct comp_dev *dev)
 	buff_size = MAX(mod->period_bytes, md->mpd.out_buff_size) * buff_periods;
 	mod->output_buffer_size = buff_size;
 
+	/* decided once here, the buffers are then freed the way they were allocated */
+	mod->raw_in_place = module_adapter_raw_in_place(mod);
+
 	/* allocate memory for input buffer data */
 	list_for_item(blist, &dev->bsource_list) {
 		size_t size = MAX(mod->deep_buff_bytes, mod->period_bytes);
@@ -354,9 +375,15 @@ int module_adapter_prepare(struct comp_dev *dev)
 		i++;
 	}
 
-	/* allocate memory for output buffer data */
+	/* allocate memory for output buffer data, in-place modules reuse the input buffer */
 	i = 0;
 	list_for_item(blist, &dev->bsink_list) {
+		if (mod->raw_in_place) {
+			mod->output_buffers[i].data = mod->input_buffers[i].data;
+			i++;
+			continue;
+		}
+
 		mod->output_buffers[i].data = rballoc(0, SOF_MEM_CAPS_RAM, md->mpd.out_buff_size);
 		if (!mod->output_buffers[i].data) {
 			comp_err(mod->dev, "module_adapter_prepare(): Failed to alloc output buffer data");
@@ -421,8 +448,9 @@ free:
 	}
 
 out_data_free:
-	for (i = 0; i < mod->num_of_sinks; i++)
-		rfree(mod->output_buffers[i].data);
+	if (!mod->raw_in_place)
+		for (i = 0; i < mod->num_of_sinks; i++)
+			rfree(mod->output_buffers[i].data);
 
 in_data_free:
 	for (i = 0; i < mod->num_of_sources; i++)
@@ -433,6 +461,7 @@ in_out_free:
 	mod->output_buffers = NULL;
 	rfree(mod->input_buffers);
 	mod->input_buffers = NULL;
+	mod->raw_in_place = false;
 	return ret;
 }
 EXPORT_SYMBOL(module_adapter_prepare);
@@ -614,7 +643,7 @@ static void module_adapter_process_output(struct comp_dev *dev)
 
 			ca_copy_from_module_to_sink(&buffer->stream, mod->output_buffers[i].data,
 						    mod->output_buffers[i].size);
-			audio_stream_produce(&buffer->stream, mod->output_buffers[i].size);
+			buffer_stream_produce(buffer, mod->output_buffers[i].size);
 		}
 		i++;
 	}
@@ -765,8 +794,7 @@ static int module_adapter_audio_stream_copy_1to1(struct comp_dev *dev)
 	/* consume from the input buffer */
 	mod->total_data_consumed += mod->input_buffers[0].consumed;
 	if (mod->input_buffers[0].consumed)
-		audio_stream_consume(&mod->source_comp_buffer->stream,
-				     mod->input_buffers[0].consumed);
+		buffer_stream_consume(mod->source_comp_buffer, mod->input_buffers[0].consumed);
 
 	/* produce data into the output buffer */
 	mod->total_data_produced += mod->output_buffers[0].size;
@@ -855,7 +883,7 @@ static int module_adapter_audio_stream_type_copy(struct comp_dev *dev)
 			container_of(mod->input_buffers[i].data, struct comp_buffer, stream);
 
 		if (mod->input_buffers[i].consumed)
-			audio_stream_consume(&src->stream, mod->input_buffers[i].consumed);
+			buffer_stream_consume(src, mod->input_buffers[i].consumed);
 	}
 
 	/* compute data consumed based on pin 0 since it is processed with base config
@@ -1067,7 +1095,9 @@ static int module_adapter_raw_data_type_copy(struct comp_dev *dev)
 
 		comp_update_buffer_consume(source, mod->input_buffers[i].consumed);
 
-		bzero((__sparse_force void *)mod->input_buffers[i].data, size);
+		/* for in-place modules the input buffer holds the output until it is copied out */
+		if (!mod->raw_in_place)
+			bzero((__sparse_force void *)mod->input_buffers[i].data, size);
 		mod->input_buffers[i].size = 0;
 		mod->input_buffers[i].consumed = 0;
 
@@ -1100,23 +1130,27 @@ int module_adapter_copy(struct comp_dev *dev)
 	comp_dbg(dev, "module_adapter_copy(): start");
 
 	struct processing_module *mod = comp_mod(dev);
+	uint64_t moved = mod->total_data_consumed + mod->total_data_produced;
+	int ret;
 
-	if (IS_PROCESSING_MODE_AUDIO_STREAM(mod))
-		return module_adapter_audio_stream_type_copy(dev);
-
-	if (IS_PROCESSING_MODE_RAW_DATA(mod))
-		return module_adapter_raw_data_type_copy(dev);
-
-	if (IS_PROCESSING_MODE_SINK_SOURCE(mod)) {
+	if (IS_PROCESSING_MODE_AUDIO_STREAM(mod)) {
+		ret = module_adapter_audio_stream_type_copy(dev);
+	} else if (IS_PROCESSING_MODE_RAW_DATA(mod)) {
+		ret = module_adapter_raw_data_type_copy(dev);
+	} else if (IS_PROCESSING_MODE_SINK_SOURCE(mod)) {
 		if (mod->dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP)
-			return module_adapter_copy_ring_buffers(dev);
+			ret = module_adapter_copy_ring_buffers(dev);
 		else
-			return module_adapter_sink_source_copy(dev);
-
+			ret = module_adapter_sink_source_copy(dev);
+	} else {
+		comp_err(dev, "module_adapter_copy(): unknown processing_data_type");
+		return -EINVAL;
 	}
 
-	comp_err(dev, "module_adapter_copy(): unknown processing_data_type");
-	return -EINVAL;
+	comp_profile_add_bytes(comp_dev_profile(dev),
+			       mod->total_data_consumed + mod->total_data_produced - moved);
+
+	return ret;
 }
 EXPORT_SYMBOL(module_adapter_copy);
 
@@ -1162,10 +1196,12 @@ int module_adapter_reset(struct comp_dev *dev)
 	}
 
 	if (IS_PROCESSING_MODE_RAW_DATA(mod)) {
-		for (i = 0; i < mod->num_of_sinks; i++)
-			rfree((__sparse_force void *)mod->output_buffers[i].data);
+		if (!mod->raw_in_place)
+			for (i = 0; i < mod->num_of_sinks; i++)
+				rfree((__sparse_force void *)mod->output_buffers[i].data);
 		for (i = 0; i < mod->num_of_sources; i++)
 			rfree((__sparse_force void *)mod->input_buffers[i].data);
+		mod->raw_in_place = false;
 	}
 
 	if (IS_PROCESSING_MODE_RAW_DATA(mod) || IS_PROCESSING_MODE_AUDIO_STREAM(mod)) {
@@ -32,7 +32,7 @@ static void multiband_drc_process_emp_crossover(struct multiband_drc_state *stat
 	int32_t *buf_sink_band;
 	int ch, band;
 	int32_t emp_out;
-	int32_t crossover_out[nband];
+	int32_t *crossover_out[SOF_MULTIBAND_DRC_MAX_BANDS];
 
 	for (ch = 0; ch < nch; ch++) {
 		emp_s = &state->emphasis[ch];
@@ -43,13 +43,17 @@ static void multiband_drc_process_emp_crossover(struct multiband_drc_state *stat
 		else
 			emp_out = *buf_src;
 
-		split_func(emp_out, crossover_out, crossover_s);
+		/* The DRC runs frame by frame, split a block of one frame
+		 * directly to the band buffers.
+		 */
 		buf_sink_band = buf_sink;
 		for (band = 0; band < nband; band++) {
-			*buf_sink_band = crossover_out[band];
+			crossover_out[band] = buf_sink_band;
 			buf_sink_band += PLATFORM_MAX_CHANNELS;
 		}
 
+		split_func(&emp_out, crossover_out, crossover_s, 1);
+
 		buf_src++;
 		buf_sink++;
 	}
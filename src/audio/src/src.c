@@ -15,7 +15,9 @@
 #include "src_common.h"
 #include "src_config.h"
 
-#if SRC_SHORT || CONFIG_COMP_SRC_TINY
+#if CONFIG_COMP_SRC_SYNTH
+/* Coefficients are synthesized in prepare */
+#elif SRC_SHORT || CONFIG_COMP_SRC_TINY
 #include "coef/src_tiny_int16_define.h"
 #include "coef/src_tiny_int16_table.h"
 #elif CONFIG_COMP_SRC_SMALL
@@ -46,6 +48,13 @@ static int src_prepare(struct processing_module *mod,
 	if (num_of_sources != 1 || num_of_sinks != 1)
 		return -EINVAL;
 
+	src_get_source_sink_params(mod->dev, sources[0], sinks[0]);
+
+#if CONFIG_COMP_SRC_SYNTH
+	ret = src_synth_stages(mod->dev, a, cd->source_rate, cd->sink_rate);
+	if (ret < 0)
+		return ret;
+#else
 	a->in_fs = src_in_fs;
 	a->out_fs = src_out_fs;
 	a->num_in_fs = NUM_IN_FS;
@@ -53,8 +62,6 @@ static int src_prepare(struct processing_module *mod,
 	a->max_fir_delay_size_xnch = (PLATFORM_MAX_CHANNELS * MAX_FIR_DELAY_SIZE);
 	a->max_out_delay_size_xnch = (PLATFORM_MAX_CHANNELS * MAX_OUT_DELAY_SIZE);
 
-	src_get_source_sink_params(mod->dev, sources[0], sinks[0]);
-
 	ret = src_param_set(mod->dev, cd);
 	if (ret < 0)
 		return ret;
@@ -64,6 +71,7 @@ static int src_prepare(struct processing_module *mod,
 				       src_table2[a->idx_out][a->idx_in]);
 	if (ret < 0)
 		return ret;
+#endif
 
 	ret = src_params_general(mod, sources[0], sinks[0]);
 	if (ret < 0)
@@ -72,6 +80,16 @@ static int src_prepare(struct processing_module *mod,
 	return src_prepare_general(mod, sources[0], sinks[0]);
 }
 
+#if CONFIG_COMP_SRC_SYNTH
+static int src_synth_module_free(struct processing_module *mod)
+{
+	struct comp_data *cd = module_get_private_data(mod);
+
+	src_synth_put_stages(&cd->param);
+	return src_free(mod);
+}
+#endif
+
 static const struct module_interface src_interface = {
 	.init = src_init,
 	.prepare = src_prepare,
@@ -80,7 +98,11 @@ static const struct module_interface src_interface = {
 	.set_configuration = src_set_config,
 	.get_configuration = src_get_config,
 	.reset = src_reset,
+#if CONFIG_COMP_SRC_SYNTH
+	.free = src_synth_module_free,
+#else
 	.free = src_free,
+#endif
 };
 
 DECLARE_MODULE_ADAPTER(src_interface, SRC_UUID, src_tr);
@@ -53,6 +53,9 @@ struct src_param {
 	const struct src_stage *stage2;
 	const int *in_fs;
 	const int *out_fs;
+#if CONFIG_COMP_SRC_SYNTH
+	int synth_fs[2];	/* rates of the synthesized conversion */
+#endif
 };
 
 struct src_state {
@@ -218,6 +221,18 @@ static inline int src_fallback(struct comp_data *cd,
 int src_allocate_copy_stages(struct comp_dev *dev, struct src_param *prm,
 			     const struct src_stage *stage_src1,
 			     const struct src_stage *stage_src2);
+#if CONFIG_COMP_SRC_SYNTH
+/* Max. delay line lengths in samples per channel for synthesized stages */
+#define SRC_SYNTH_MAX_FIR_DELAY_SIZE	1024
+#define SRC_SYNTH_MAX_OUT_DELAY_SIZE	1024
+
+/* Synthesizes the stages for the conversion, releases earlier stages first */
+int src_synth_stages(struct comp_dev *dev, struct src_param *prm, int fs_in, int fs_out);
+
+/* Releases the stages of src_synth_stages() */
+void src_synth_put_stages(struct src_param *prm);
+#endif
+
 int src_rate_check(const void *spec);
 int src_set_params(struct processing_module *mod, struct sof_sink *sink);
 
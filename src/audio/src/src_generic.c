@@ -18,197 +18,144 @@
 
 #include "src_common.h"
 
+/* The FIR core processes all channels of a delay line frame with the same
+ * coefficient. A frame has the channels in reversed order, the first word at
+ * data[0] is the last channel. The sums are the same as with one channel at
+ * time so the output is bit exact with it. The channels loop is unrolled and
+ * vectorized by the compiler for the constant channels counts from
+ * fir_filter_generic().
+ */
 #if SRC_SHORT /* 16 bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch,
-				      const int shift, const int nch)
+static inline void fir_filter_frames(int32_t *rp, const void *cp, int32_t *wp,
+				     int32_t *fir_start, int32_t *fir_end,
+				     const int taps_x_nch, const int shift,
+				     const int nch)
 {
-	int64_t y0;
-	int64_t y1;
-	int32_t *data;
-	const int16_t *coef;
-	int i;
-	int j;
-	int n1;
-	int n2;
-	int frames;
+	int64_t y[PLATFORM_MAX_CHANNELS];
+	const int16_t *coef = (const int16_t *)cp;
 	const int qshift = 15 + shift; /* Q2.46 -> Q2.31 */
 	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
-
-	/* Check for 2ch FIR case */
-	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
-
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		y1 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
-
-		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
-		 * output shift includes the shift by 15 for Qx.46 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i++, coef++, data += 2) {
-			y0 += (int64_t)(*coef) * data[0];
-			y1 += (int64_t)(*coef) * data[1];
-		}
-
-		/* No need to check for circular wrap. Pointer data is moved to
-		 * fir_start to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start;
-		for (i = 0; i < n2; i++, coef++, data += 2) {
-			y0 += (int64_t)(*coef) * data[0];
-			y1 += (int64_t)(*coef) * data[1];
-		}
+	int32_t *data = rp - nch + 1;
+	int16_t c;
+	int n1;
+	int n2;
+	int i;
+	int j;
 
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
-		return;
+	/* Initialize to half LSB for rounding. Note that initialization
+	 * code ensures that circular wrap does not happen mid-frame.
+	 */
+	for (j = 0; j < nch; j++)
+		y[j] = rnd;
+
+	n1 = MIN(taps_x_nch, fir_end - data) / nch; /* Frames until wrap */
+	n2 = taps_x_nch / nch - n1;
+
+	/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
+	 * output shift includes the shift by 15 for Qx.46 to
+	 * Qx.31.
+	 */
+	for (i = 0; i < n1; i++, data += nch) {
+		c = *coef++;
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)c * data[j];
 	}
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
-
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		coef = (const int16_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
-
-		/* The FIR is calculated as Q1.15 x Q1.31 -> Q2.46. The
-		 * output shift includes the shift by 15 for Qx.46 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef) * (*data);
-
-		/* No need to check for circular wrap. Pointer data is moved to fir_start
-		 * plus actual channel to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start + nch - j - 1;
-		for (i = 0; i < n2; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef) * (*data);
-
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
+	/* No need to check for circular wrap. Pointer data is moved to
+	 * fir_start to be used by next loop if n2 is greater than zero.
+	 */
+	data = fir_start;
+	for (i = 0; i < n2; i++, data += nch) {
+		c = *coef++;
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)c * data[j];
 	}
+
+	for (j = 0; j < nch; j++)
+		wp[j] = sat_int32(y[nch - 1 - j] >> qshift);
 }
 
 #else /* 32bit coefficients version */
 
-static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
-				      int32_t *fir_start, int32_t *fir_end,
-				      const int taps_x_nch, const int shift,
-				      const int nch)
+static inline void fir_filter_frames(int32_t *rp, const void *cp, int32_t *wp,
+				     int32_t *fir_start, int32_t *fir_end,
+				     const int taps_x_nch, const int shift,
+				     const int nch)
 {
-	int64_t y0;
-	int64_t y1;
+	int64_t y[PLATFORM_MAX_CHANNELS];
+	const int32_t *coef = (const int32_t *)cp;
+	const int qshift = 23 + shift; /* Qx.54 -> Qx.31 */
+	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
+	int32_t *data = rp - nch + 1;
 	int32_t scaled_coef;
-	int32_t *data;
-	const int32_t *coef;
-	int i;
-	int j;
-	int frames;
 	int n1;
 	int n2;
+	int i;
+	int j;
 
-	const int qshift = 23 + shift; /* Qx.54 -> Qx.31 */
-	const int32_t rnd = 1 << (qshift - 1); /* Half LSB */
-	int32_t *d = rp;
-	int32_t *wp = wp0;
-
-	/* Check for 2ch FIR case */
-	if (nch == 2) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d - 1;
-
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		y1 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data; /* Frames until wrap */
-		n1 = ((taps_x_nch < frames) ? taps_x_nch : frames) >> 1;
-		n2 = (taps_x_nch >> 1) - n1;
-
-		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
-		 * output shift includes the shift by 23 for Qx.54 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i++, coef++, data += 2) {
-			scaled_coef = *coef >> 8;
-			y0 += (int64_t)scaled_coef * data[0];
-			y1 += (int64_t)scaled_coef * data[1];
-		}
-
-		/* No need to check for circular wrap. Pointer data is moved to
-		 * fir_start to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start;
-		for (i = 0; i < n2; i++, coef++, data += 2) {
-			scaled_coef = *coef >> 8;
-			y0 += (int64_t)scaled_coef * data[0];
-			y1 += (int64_t)scaled_coef * data[1];
-		}
-		*wp = sat_int32(y1 >> qshift);
-		*(wp + 1) = sat_int32(y0 >> qshift);
-		return;
+	/* Initialize to half LSB for rounding. Note that initialization
+	 * code ensures that circular wrap does not happen mid-frame.
+	 */
+	for (j = 0; j < nch; j++)
+		y[j] = rnd;
+
+	n1 = MIN(taps_x_nch, fir_end - data) / nch; /* Frames until wrap */
+	n2 = taps_x_nch / nch - n1;
+
+	/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
+	 * output shift includes the shift by 23 for Qx.54 to
+	 * Qx.31.
+	 */
+	for (i = 0; i < n1; i++, data += nch) {
+		scaled_coef = *coef++ >> 8;
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)scaled_coef * data[j];
 	}
 
-	for (j = 0; j < nch; j++) {
-		/* Decrement data pointer to next channel start. Note that
-		 * initialization code ensures that circular wrap does not
-		 * happen mid-frame.
-		 */
-		data = d--;
-
-		/* Initialize to half LSB for rounding, prepare for FIR core */
-		y0 = rnd;
-		coef = (const int32_t *)cp;
-		frames = fir_end - data + nch - j - 1; /* Frames until wrap */
-		n1 = (taps_x_nch < frames) ? taps_x_nch : frames;
-		n2 = taps_x_nch - n1;
-
-		/* The FIR is calculated as Q1.23 x Q1.31 -> Q2.54. The
-		 * output shift includes the shift by 23 for Qx.54 to
-		 * Qx.31.
-		 */
-		for (i = 0; i < n1; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef >> 8) * (*data);
-
-		/* No need to check for circular wrap. Pointer data is moved to fir_start
-		 * plus actual channel to be used by next loop if n2 is greater than zero.
-		 */
-		data = fir_start + nch - j - 1;
-		for (i = 0; i < n2; i += nch, coef++, data += nch)
-			y0 += (int64_t)(*coef >> 8) * (*data);
-
-		*wp = sat_int32(y0 >> qshift);
-		wp++;
+	/* No need to check for circular wrap. Pointer data is moved to
+	 * fir_start to be used by next loop if n2 is greater than zero.
+	 */
+	data = fir_start;
+	for (i = 0; i < n2; i++, data += nch) {
+		scaled_coef = *coef++ >> 8;
+		for (j = 0; j < nch; j++)
+			y[j] += (int64_t)scaled_coef * data[j];
 	}
+
+	for (j = 0; j < nch; j++)
+		wp[j] = sat_int32(y[nch - 1 - j] >> qshift);
 }
 
 #endif /* 32bit coefficients version */
 
+static inline void fir_filter_generic(int32_t *rp, const void *cp, int32_t *wp0,
+				      int32_t *fir_start, int32_t *fir_end,
+				      const int taps_x_nch, const int shift,
+				      const int nch)
+{
+	switch (nch) {
+	case 1:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, 1);
+		break;
+	case 2:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, 2);
+		break;
+	case 4:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, 4);
+		break;
+	case 6:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, 6);
+		break;
+	case 8:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, 8);
+		break;
+	default:
+		fir_filter_frames(rp, cp, wp0, fir_start, fir_end, taps_x_nch, shift, nch);
+		break;
+	}
+}
+
 #if CONFIG_FORMAT_S24LE || CONFIG_FORMAT_S32LE
 void src_polyphase_stage_cir(struct src_stage_prm *s)
 {
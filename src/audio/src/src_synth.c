@@ -0,0 +1,637 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/*
+ * Synthesis of the polyphase filter banks at prepare time. The design
+ * follows the tools/tune scripts that generate the coefficient tables: the
+ * conversion is factored to at most two stages, each stage is a Kaiser
+ * windowed sinc lowpass with the passband and stopband edges of the
+ * scripts, and the coefficients are exported in the same order and
+ * format. Instead of iterating the stopband attenuation to meet a THD+N
+ * target the attenuation and the filter length are fixed by the Kaiser
+ * design formulas.
+ *
+ * The stages are kept in a reference counted cache so that instances with
+ * the same conversion share one copy of the coefficients.
+ */
+
+#include <sof/audio/component.h>
+#include <sof/audio/format.h>
+#include <sof/list.h>
+#include <sof/math/numbers.h>
+#include <sof/math/trig.h>
+#include <rtos/alloc.h>
+#include <rtos/cache.h>
+#include <rtos/spinlock.h>
+#include <ipc/topology.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "src_common.h"
+#include "src_config.h"
+
+LOG_MODULE_DECLARE(src, CONFIG_SOF_LOG_LEVEL);
+
+/* Stopband attenuation in dB, the Kaiser window beta and filter length
+ * factor (A - 7.95) / (2.285 * 2 * pi) are from it.
+ */
+#define SRC_SYNTH_ATTENUATION	70
+#define SRC_SYNTH_BETA_Q24	Q_CONVERT_FLOAT(0.1102 * (SRC_SYNTH_ATTENUATION - 8.7), 24)
+#define SRC_SYNTH_ORDER_Q16	Q_CONVERT_FLOAT((SRC_SYNTH_ATTENUATION - 7.95) / 14.357, 16)
+
+/* The Kaiser estimate is short for the few taps of the wide transition
+ * bands, these taps are added to the order.
+ */
+#define SRC_SYNTH_ORDER_ADD	8
+
+/* Band edges are in 1/10000 of the lower stage sample rate as in the
+ * coefficient table names. The stopband starts at the Nyquist frequency.
+ */
+#define SRC_SYNTH_BAND_SCALE	10000
+#define SRC_SYNTH_SB		5000
+#define SRC_SYNTH_PB_MIN	1000
+#define SRC_SYNTH_PB_MAX	4900
+
+/* The passband is 20 kHz at 44.1 kHz and scales with the rate, but is
+ * limited to 24 kHz for rates above 80 kHz. The frequencies are in Hz
+ * multiplied by 441 to keep them integers.
+ */
+#define SRC_SYNTH_PB_HZ_MAX	24000
+#define SRC_SYNTH_PB_FS_MAX	80000
+#define SRC_SYNTH_PB_RATIO	200
+#define SRC_SYNTH_HZ_SCALE	441
+
+/* Gain at 0 Hz is -1 dB for the conversion, split between the stages */
+#define SRC_SYNTH_GAIN_1S	Q_CONVERT_FLOAT(0.8912509381, 31)	/* -1 dB */
+#define SRC_SYNTH_GAIN_2S	Q_CONVERT_FLOAT(0.9440608763, 31)	/* -0.5 dB */
+
+/* Coefficients are scaled to max. 32767/32768 */
+#define SRC_SYNTH_COEF_MAX	(INT32_MAX - (1 << 16) + 1)
+
+/* Limits for a stage to keep the filter and delay lines in bounds */
+#define SRC_SYNTH_MAX_FACTOR		80
+#define SRC_SYNTH_MAX_FILTER_LENGTH	4096
+
+#define SRC_SYNTH_I0_TERMS_MAX		64
+
+#if SRC_SHORT
+typedef int16_t src_synth_coef_t;
+static const int16_t src_synth_fir_one = 16384;
+#else
+typedef int32_t src_synth_coef_t;
+static const int32_t src_synth_fir_one = 1073741824;
+#endif
+
+/* Single tap pass-through stage, the second stage of one stage conversions */
+static const struct src_stage src_synth_stage_one = {
+	0, 0, 1, 1, 1, 1, 1, 0, -1, &src_synth_fir_one
+};
+
+struct src_synth_entry {
+	struct list_item list;
+	struct src_stage stage;
+	int pb;
+	int32_t gain;
+	unsigned int refcount;
+	size_t size;
+};
+
+static struct list_item src_synth_cache = LIST_INIT(src_synth_cache);
+static struct k_spinlock src_synth_lock;
+
+/* Conversions that the tuning scripts factor differently from the default */
+static const struct src_synth_factors {
+	int l;
+	int m;
+	int l1;
+	int m1;
+} src_synth_factors[] = {
+	{ 147, 640, 7, 8 },	/* 192 to 44.1 kHz */
+	{ 147, 320, 7, 8 },	/* 96 to 44.1 kHz */
+	{ 147, 160, 7, 8 },	/* 48 to 44.1 kHz */
+	{ 160, 147, 8, 7 },	/* 44.1 to 48 kHz */
+	{ 320, 147, 8, 7 },	/* 44.1 to 96 kHz */
+	{ 4, 3, 4, 3 },		/* 24 to 32 kHz, one stage */
+	{ 3, 4, 3, 4 },		/* 32 to 24 kHz, one stage */
+};
+
+/* Splits c to two factors close to the square root of it */
+static int src_synth_factor2(int c)
+{
+	int x = 1;
+	int a1 = 0;
+	int a2 = 0;
+	int t;
+
+	while ((x + 1) * (x + 1) <= c)
+		x++;
+
+	/* round to nearest */
+	if (c - x * x > x)
+		x++;
+
+	for (t = x; t <= 2 * x; t++) {
+		if (!(c % t)) {
+			a1 = t;
+			break;
+		}
+	}
+
+	for (t = x; t >= x / 2 && t > 0; t--) {
+		if (!(c % t)) {
+			a2 = t;
+			break;
+		}
+	}
+
+	if (a1 && (!a2 || a1 - x < x - a2))
+		return a1;
+
+	return a2 ? a2 : 1;
+}
+
+/* Factors the conversion to two stages with the intermediate rate nearest
+ * to the lower of the input and output rates.
+ */
+static void src_synth_factor(int fs_in, int fs_out, int *l1, int *m1, int *l2, int *m2)
+{
+	int k = gcd(fs_in, fs_out);
+	int l = fs_out / k;
+	int m = fs_in / k;
+	int fs_min = MIN(fs_in, fs_out);
+	int l0[2], m0[2];
+	int fs3_best = 0;
+	int fs3;
+	int i, j;
+
+	*l1 = l;
+	*m1 = m;
+	*l2 = 1;
+	*m2 = 1;
+	l0[0] = src_synth_factor2(l);
+	m0[0] = src_synth_factor2(m);
+	for (i = 0; i < ARRAY_SIZE(src_synth_factors); i++) {
+		if (src_synth_factors[i].l == l && src_synth_factors[i].m == m) {
+			l0[0] = src_synth_factors[i].l1;
+			m0[0] = src_synth_factors[i].m1;
+			break;
+		}
+	}
+
+	l0[1] = l / l0[0];
+	m0[1] = m / m0[0];
+
+	/* the order of the candidates is the same as in the scripts */
+	for (i = 0; i < 2; i++) {
+		for (j = 0; j < 2; j++) {
+			fs3 = (int)((int64_t)fs_in * l0[i] / m0[j]);
+			if (fs3 >= fs_min && (!fs3_best || fs3 < fs3_best)) {
+				fs3_best = fs3;
+				*l1 = l0[i];
+				*m1 = m0[j];
+				*l2 = l0[i ^ 1];
+				*m2 = m0[j ^ 1];
+			}
+		}
+	}
+
+	if (*l1 == 1 && *m1 == 1) {
+		*l1 = *l2;
+		*m1 = *m2;
+		*l2 = 1;
+		*m2 = 1;
+	}
+}
+
+/* Returns the passband edge in Hz * 441 for a conversion between the rates */
+static int src_synth_pb_hz(int fs_a, int fs_b)
+{
+	int fs_min = MIN(fs_a, fs_b);
+
+	if (fs_min > SRC_SYNTH_PB_FS_MAX)
+		return SRC_SYNTH_PB_HZ_MAX * SRC_SYNTH_HZ_SCALE;
+
+	return fs_min * SRC_SYNTH_PB_RATIO;
+}
+
+/* Returns the passband edge in 1/10000 of the lower stage rate, rounded */
+static int src_synth_band_edge(int pb_hz, int fs_min)
+{
+	int64_t den = (int64_t)SRC_SYNTH_HZ_SCALE * fs_min;
+
+	return ((int64_t)SRC_SYNTH_BAND_SCALE * pb_hz + (den >> 1)) / den;
+}
+
+/* Solves -idm * l + odm * m = 1 with the smallest idm + odm */
+static void src_synth_find_l0m0(int l, int m, int *idm, int *odm)
+{
+	int lt;
+
+	*idm = 1;
+	*odm = 0;
+	if (m == 1) {
+		*idm = 0;
+		*odm = 1;
+		return;
+	}
+
+	if (l == 1)
+		return;
+
+	for (lt = 1; lt <= 4 * l; lt++) {
+		if (!((1 + lt * l) % m)) {
+			*idm = lt;
+			*odm = (1 + lt * l) / m;
+			return;
+		}
+	}
+}
+
+/* Returns a * b with b in Q8.24 */
+static uint64_t src_synth_mul_q24(uint64_t a, uint32_t b)
+{
+	return (((a >> 32) * b) << 8) + (((a & UINT32_MAX) * b) >> 24);
+}
+
+/* Returns the modified Bessel function I0(x) in Q32.32 for y = (x / 2)^2
+ * in Q8.24 from the series sum of y^k / (k!)^2.
+ */
+static uint64_t src_synth_bessel_i0(uint32_t y)
+{
+	uint64_t sum = (uint64_t)1 << 32;
+	uint64_t term = sum;
+	int k;
+
+	for (k = 1; k < SRC_SYNTH_I0_TERMS_MAX; k++) {
+		term = src_synth_mul_q24(term, y / (k * k));
+		if (!term)
+			break;
+
+		sum += term;
+	}
+
+	return sum;
+}
+
+/* Returns the polyphase order index of prototype filter tap n */
+static inline int src_synth_coef_index(const struct src_stage *stage, int n)
+{
+	return (n % stage->num_of_subfilters) * stage->subfilter_length +
+		n / stage->num_of_subfilters;
+}
+
+/*
+ * Designs the prototype lowpass filter of a stage with upsampling factor l
+ * and downsampling factor m and writes it in polyphase order to coefs. The
+ * cutoff frequency is the middle of the transition band from pb to the
+ * stopband edge.
+ */
+static int src_synth_design(struct src_stage *stage, src_synth_coef_t *coefs,
+			    int32_t *proto, int l, int m, int pb, int32_t gain)
+{
+	const int n = stage->filter_length;
+	const int half = n >> 1;
+	const int64_t den = 4LL * SRC_SYNTH_BAND_SCALE * MAX(l, m);
+	const int cutoff = pb + SRC_SYNTH_SB;
+	uint64_t beta2 = ((uint64_t)SRC_SYNTH_BETA_Q24 * SRC_SYNTH_BETA_Q24) >> 24;
+	uint64_t i0_max;
+	uint64_t i0;
+	uint32_t y;
+	int64_t dc = 0;
+	int64_t ratio;
+	int64_t limit;
+	int64_t peak = 0;
+	int64_t phase;
+	int64_t c;
+	int32_t w;
+	int32_t s;
+	int32_t h;
+	int shift_i0 = 0;
+	int shift;
+	int q;
+	int k;
+	int t;
+
+	/* Normalize I0(beta) to less than 2^32 for the window divide */
+	i0_max = src_synth_bessel_i0(beta2 >> 2);
+	while (i0_max >> 32) {
+		i0_max >>= 1;
+		shift_i0++;
+	}
+
+	/* Symmetric filter, compute the first half of the taps in Q1.31 */
+	for (k = 0; k < half; k++) {
+		/* Kaiser window, (x / 2)^2 = beta^2 * k * (n - 1 - k) / (n - 1)^2 */
+		y = (beta2 * k * (n - 1 - k)) / ((int64_t)(n - 1) * (n - 1));
+		i0 = src_synth_bessel_i0(y) >> shift_i0;
+		w = (i0 << 30) / i0_max;
+
+		/* sin(pi * wn * t / 2) / (pi * t / 2), the phase is reduced to
+		 * turns in [-0.5, 0.5) before converting to radians.
+		 */
+		t = 2 * k - (n - 1);
+		phase = ((int64_t)cutoff * t) % den;
+		if (phase >= den / 2)
+			phase -= den;
+		else if (phase < -den / 2)
+			phase += den;
+
+		s = sin_fixed_32b((int32_t)(phase * PI_MUL2_Q4_28 / den));
+		h = ((int64_t)s << 29) / ((int64_t)PI_Q4_28 * t);
+
+		proto[k] = ((int64_t)h * w) >> 30;
+		dc += 2 * proto[k];
+		peak = MAX(peak, ABS(proto[k]));
+	}
+
+	if (dc <= 0)
+		return -EINVAL;
+
+	/* Scale to gain l * gain at 0 Hz and find the shift that keeps the
+	 * largest coefficient below 32767/32768.
+	 */
+	ratio = ((int64_t)l * gain << 24) / dc;
+	peak *= ratio;
+	limit = (int64_t)SRC_SYNTH_COEF_MAX << 24;
+	shift = 0;
+	while (peak <= limit >> 1) {
+		peak <<= 1;
+		shift++;
+	}
+
+	while (peak > limit) {
+		peak >>= 1;
+		shift--;
+	}
+
+	stage->shift = shift;
+	q = 24 - shift;
+#if SRC_SHORT
+	q += 16;
+#endif
+	for (k = 0; k < half; k++) {
+		c = ((int64_t)proto[k] * ratio + ((int64_t)1 << (q - 1))) >> q;
+		coefs[src_synth_coef_index(stage, k)] = c;
+		coefs[src_synth_coef_index(stage, n - 1 - k)] = c;
+	}
+
+	return 0;
+}
+
+/* Returns a cached stage, the caller holds src_synth_lock */
+static struct src_synth_entry *src_synth_find(int l, int m, int pb, int32_t gain)
+{
+	struct src_synth_entry *entry;
+	struct list_item *item;
+
+	list_for_item(item, &src_synth_cache) {
+		entry = container_of(item, struct src_synth_entry, list);
+		if (entry->stage.blk_out == l && entry->stage.blk_in == m &&
+		    entry->pb == pb && entry->gain == gain)
+			return entry;
+	}
+
+	return NULL;
+}
+
+static struct src_synth_entry *src_synth_new(struct comp_dev *dev, int l, int m, int pb,
+					     int32_t gain)
+{
+	struct src_synth_entry *entry;
+	struct src_stage *stage;
+	int32_t *proto;
+	int order;
+	int step;
+	int ret;
+
+	entry = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
+			sizeof(*entry));
+	if (!entry)
+		return NULL;
+
+	stage = &entry->stage;
+	src_synth_find_l0m0(l, m, &stage->idm, &stage->odm);
+	stage->num_of_subfilters = l;
+	stage->blk_in = m;
+	stage->blk_out = l;
+	stage->halfband = 0;
+
+	/* Kaiser filter order for the transition band, rounded up to a
+	 * multiple of four taps per subfilter for the optimized filter cores.
+	 */
+	order = ((int64_t)SRC_SYNTH_ORDER_Q16 * MAX(l, m) * SRC_SYNTH_BAND_SCALE /
+		 (SRC_SYNTH_SB - pb)) >> 16;
+	order += SRC_SYNTH_ORDER_ADD;
+	step = 4 * l;
+	stage->filter_length = (order + step) / step * step;
+	stage->subfilter_length = stage->filter_length / l;
+	if (stage->filter_length > SRC_SYNTH_MAX_FILTER_LENGTH ||
+	    src_fir_delay_length(stage) > SRC_SYNTH_MAX_FIR_DELAY_SIZE ||
+	    src_out_delay_length(stage) > SRC_SYNTH_MAX_OUT_DELAY_SIZE) {
+		comp_err(dev, "src_synth_new(): too long filter for %d/%d", l, m);
+		goto err;
+	}
+
+	entry->size = sizeof(src_synth_coef_t) * stage->filter_length;
+	stage->coefs = rballoc(0, SOF_MEM_CAPS_RAM, entry->size);
+	proto = rballoc(0, SOF_MEM_CAPS_RAM,
+			sizeof(int32_t) * (stage->filter_length >> 1));
+	if (!stage->coefs || !proto) {
+		comp_err(dev, "src_synth_new(): failed to allocate coefficients");
+		rfree(proto);
+		goto err;
+	}
+
+	ret = src_synth_design(stage, (src_synth_coef_t *)stage->coefs, proto, l, m, pb, gain);
+	rfree(proto);
+	if (ret < 0) {
+		comp_err(dev, "src_synth_new(): design failed for %d/%d", l, m);
+		goto err;
+	}
+
+	dcache_writeback_region((__sparse_force void __sparse_cache *)stage->coefs,
+				entry->size);
+	entry->pb = pb;
+	entry->gain = gain;
+	entry->refcount = 1;
+	comp_info(dev, "src_synth_new(): %d/%d, pb %d, %d taps, shift %d", l, m, pb,
+		  stage->filter_length, stage->shift);
+	return entry;
+
+err:
+	rfree((void *)stage->coefs);
+	rfree(entry);
+	return NULL;
+}
+
+static void src_synth_free(struct src_synth_entry *entry)
+{
+	rfree((void *)entry->stage.coefs);
+	rfree(entry);
+}
+
+/* Gets a stage from the cache or synthesizes it */
+static int src_synth_get(struct comp_dev *dev, struct src_stage *stage, int l, int m,
+			 int pb, int32_t gain)
+{
+	struct src_synth_entry *entry;
+	struct src_synth_entry *new;
+	k_spinlock_key_t key;
+
+	if (l == 1 && m == 1) {
+		*stage = src_synth_stage_one;
+		return 0;
+	}
+
+	if (l > SRC_SYNTH_MAX_FACTOR || m > SRC_SYNTH_MAX_FACTOR ||
+	    pb < SRC_SYNTH_PB_MIN || pb > SRC_SYNTH_PB_MAX) {
+		comp_err(dev, "src_synth_get(): unsupported stage %d/%d, pb %d", l, m, pb);
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&src_synth_lock);
+	entry = src_synth_find(l, m, pb, gain);
+	if (entry)
+		entry->refcount++;
+	k_spin_unlock(&src_synth_lock, key);
+
+	if (!entry) {
+		/* the design takes time, it is done without the lock */
+		new = src_synth_new(dev, l, m, pb, gain);
+		if (!new)
+			return -ENOMEM;
+
+		key = k_spin_lock(&src_synth_lock);
+		entry = src_synth_find(l, m, pb, gain);
+		if (entry) {
+			entry->refcount++;
+		} else {
+			list_item_prepend(&new->list, &src_synth_cache);
+			entry = new;
+			new = NULL;
+		}
+		k_spin_unlock(&src_synth_lock, key);
+
+		if (new)
+			src_synth_free(new);
+	}
+
+	*stage = entry->stage;
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)stage->coefs,
+				 entry->size);
+	return 0;
+}
+
+static void src_synth_put(const struct src_stage *stage)
+{
+	struct src_synth_entry *entry = NULL;
+	struct list_item *item;
+	k_spinlock_key_t key;
+
+	if (stage->coefs == &src_synth_fir_one)
+		return;
+
+	key = k_spin_lock(&src_synth_lock);
+	list_for_item(item, &src_synth_cache) {
+		entry = container_of(item, struct src_synth_entry, list);
+		if (entry->stage.coefs == stage->coefs)
+			break;
+
+		entry = NULL;
+	}
+
+	if (entry && !--entry->refcount)
+		list_item_del(&entry->list);
+	else
+		entry = NULL;
+	k_spin_unlock(&src_synth_lock, key);
+
+	if (entry)
+		src_synth_free(entry);
+}
+
+int src_synth_stages(struct comp_dev *dev, struct src_param *prm, int fs_in, int fs_out)
+{
+	struct src_stage *stages;
+	int32_t gain;
+	int fs3;
+	int pb_hz;
+	int l1, m1, l2, m2;
+	int ret;
+
+	src_synth_put_stages(prm);
+
+	prm->synth_fs[0] = fs_in;
+	prm->synth_fs[1] = fs_out;
+	prm->in_fs = &prm->synth_fs[0];
+	prm->out_fs = &prm->synth_fs[1];
+	prm->num_in_fs = 1;
+	prm->num_out_fs = 1;
+	prm->idx_in = 0;
+	prm->idx_out = 0;
+	prm->max_fir_delay_size_xnch = PLATFORM_MAX_CHANNELS * SRC_SYNTH_MAX_FIR_DELAY_SIZE;
+	prm->max_out_delay_size_xnch = PLATFORM_MAX_CHANNELS * SRC_SYNTH_MAX_OUT_DELAY_SIZE;
+
+	if (fs_in <= 0 || fs_out <= 0) {
+		comp_err(dev, "src_synth_stages(): invalid rates %d, %d", fs_in, fs_out);
+		return -EINVAL;
+	}
+
+	stages = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, 2 * sizeof(*stages));
+	if (!stages) {
+		comp_err(dev, "src_synth_stages(): failed to allocate stages");
+		return -ENOMEM;
+	}
+
+	if (fs_in == fs_out) {
+		stages[0] = src_synth_stage_one;
+		stages[1] = src_synth_stage_one;
+		goto out;
+	}
+
+	src_synth_factor(fs_in, fs_out, &l1, &m1, &l2, &m2);
+	fs3 = fs_in / m1 * l1;
+
+	/* The passband of both stages is set by the lower rate side, the
+	 * stage at the higher rate gets a wider transition band.
+	 */
+	if (fs_out < fs_in)
+		pb_hz = src_synth_pb_hz(fs3, fs_out);
+	else
+		pb_hz = src_synth_pb_hz(fs_in, fs3);
+
+	gain = l2 == 1 && m2 == 1 ? SRC_SYNTH_GAIN_1S : SRC_SYNTH_GAIN_2S;
+	ret = src_synth_get(dev, &stages[0], l1, m1,
+			    src_synth_band_edge(pb_hz, MIN(fs_in, fs3)), gain);
+	if (ret < 0) {
+		rfree(stages);
+		return ret;
+	}
+
+	ret = src_synth_get(dev, &stages[1], l2, m2,
+			    src_synth_band_edge(pb_hz, MIN(fs3, fs_out)), gain);
+	if (ret < 0) {
+		src_synth_put(&stages[0]);
+		rfree(stages);
+		return ret;
+	}
+
+out:
+	prm->stage1 = stages;
+	prm->stage2 = stages + 1;
+	return 0;
+}
+
+void src_synth_put_stages(struct src_param *prm)
+{
+	if (!prm->stage1)
+		return;
+
+	src_synth_put(prm->stage1);
+	src_synth_put(prm->stage2);
+	rfree((void *)prm->stage1);
+	prm->stage1 = NULL;
+	prm->stage2 = NULL;
+}
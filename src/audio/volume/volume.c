@@ -23,8 +23,10 @@
 #include <sof/audio/ipc-config.h>
 #include <sof/common.h>
 #include <rtos/panic.h>
+#include <rtos/spinlock.h>
 #include <sof/ipc/msg.h>
 #include <rtos/alloc.h>
+#include <rtos/cache.h>
 #include <rtos/init.h>
 #include <sof/lib/cpu.h>
 #include <sof/lib/uuid.h>
@@ -226,32 +228,264 @@ static inline int32_t volume_linear_ramp(struct vol_data *cd, int32_t ramp_time,
 }
 #endif
 
+#if defined CONFIG_COMP_VOLUME_WINDOWS_FADE || defined CONFIG_COMP_VOLUME_LINEAR_RAMP
+/**
+ * \brief Converts frames since ramp start to ramp time.
+ * \param[in] frames Number of frames since ramp start.
+ * \param[in] sample_rate_inv 1000x inverse of sample rate as Q1.31.
+ * \return Ramp time as milliseconds Q29.3.
+ */
+static inline int32_t volume_ramp_time(uint32_t frames, int32_t sample_rate_inv)
+{
+	return Q_MULTSR_32X32((int64_t)frames, sample_rate_inv, 0, 31, 3);
+}
+#endif
+
 #if CONFIG_COMP_VOLUME_WINDOWS_FADE
+/* Max. number of ramp updates in a cached windows fade shape, the updates
+ * past it are calculated directly.
+ */
+#define VOL_RAMP_CURVE_MAX_STEPS	256
+
+/**
+ * \brief Windows fade shape sampled at each ramp update.
+ *
+ * The shape only depends on the ramp length, the sample rate and the ramp
+ * update period, so volume instances with the same ones share it. The pow()
+ * and the division of the ramp time are then done once per shape instead of
+ * per channel on every ramp update.
+ */
+struct vol_ramp_curve {
+	struct list_item item;
+	uint32_t ref_count;
+	uint32_t initial_ramp;		/**< ramp length in ms */
+	int32_t sample_rate_inv;	/**< 1000x inverse of sample rate as Q1.31 */
+	uint32_t step_frames;		/**< frames per ramp update */
+	uint32_t steps;			/**< number of ramp updates in shape */
+	int32_t (*shape)[2];		/**< Q2.30 shape for volume increase and decrease */
+};
+
+/* The curves are shared by instances on all cores, the IPC that attaches
+ * and releases them can run on any core.
+ */
+static struct list_item vol_ramp_curve_list = LIST_INIT(vol_ramp_curve_list);
+static struct k_spinlock vol_ramp_curve_lock;
+
+/**
+ * \brief Calculates windows fade shape.
+ * \param[in] initial_ramp Ramp length in ms.
+ * \param[in] ramp_time Time spent since ramp start as milliseconds Q29.3
+ * \param[in] decrease Set for volume decrease.
+ * \return Shape value in Q2.30.
+ */
+static int32_t volume_windows_fade_shape(uint32_t initial_ramp, int32_t ramp_time,
+					 bool decrease)
+{
+	int32_t time_ratio = (((int64_t)ramp_time) << 30) / (initial_ramp << 3); /* Q2.30 */
+
+	if (decrease)
+		time_ratio = (1 << 30) - time_ratio;
+
+	return volume_pow_175(time_ratio);
+}
+
+static void volume_ramp_curve_free(struct vol_ramp_curve *curve)
+{
+	rfree(curve->shape);
+	rfree(curve);
+}
+
+static void volume_ramp_curve_put(struct vol_data *cd)
+{
+	struct vol_ramp_curve *curve = cd->ramp_curve;
+	k_spinlock_key_t key;
+
+	if (!curve)
+		return;
+
+	/* unpublish before a possible free */
+	cd->ramp_curve = NULL;
+
+	key = k_spin_lock(&vol_ramp_curve_lock);
+	if (--curve->ref_count)
+		curve = NULL;
+	else
+		list_item_del(&curve->item);
+	k_spin_unlock(&vol_ramp_curve_lock, key);
+
+	if (curve)
+		volume_ramp_curve_free(curve);
+}
+
+static bool volume_ramp_curve_match(const struct vol_ramp_curve *curve,
+				    const struct vol_data *cd)
+{
+	return curve->initial_ramp == cd->initial_ramp &&
+		curve->sample_rate_inv == cd->sample_rate_inv &&
+		curve->step_frames == cd->vol_ramp_frames;
+}
+
+/* Returns a cached shape, the caller holds vol_ramp_curve_lock */
+static struct vol_ramp_curve *volume_ramp_curve_find(const struct vol_data *cd)
+{
+	struct vol_ramp_curve *curve;
+	struct list_item *item;
+
+	list_for_item(item, &vol_ramp_curve_list) {
+		curve = container_of(item, struct vol_ramp_curve, item);
+		if (volume_ramp_curve_match(curve, cd))
+			return curve;
+	}
+
+	return NULL;
+}
+
+static struct vol_ramp_curve *volume_ramp_curve_new(const struct vol_data *cd)
+{
+	struct vol_ramp_curve *curve;
+	int64_t ramp_end;
+	int32_t ramp_time;
+	uint32_t steps;
+	uint32_t i;
+
+	/* updates until the ramp time reaches the ramp length */
+	ramp_end = (int64_t)cd->initial_ramp << 3;
+	for (steps = 1; steps < VOL_RAMP_CURVE_MAX_STEPS; steps++) {
+		ramp_time = volume_ramp_time((steps - 1) * cd->vol_ramp_frames,
+					     cd->sample_rate_inv);
+		if (ramp_time >= ramp_end)
+			break;
+	}
+
+	curve = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
+			sizeof(*curve));
+	if (!curve)
+		return NULL;
+
+	curve->shape = rballoc(0, SOF_MEM_CAPS_RAM, steps * sizeof(curve->shape[0]));
+	if (!curve->shape) {
+		rfree(curve);
+		return NULL;
+	}
+
+	curve->ref_count = 1;
+	curve->initial_ramp = cd->initial_ramp;
+	curve->sample_rate_inv = cd->sample_rate_inv;
+	curve->step_frames = cd->vol_ramp_frames;
+	curve->steps = steps;
+	for (i = 0; i < steps; i++) {
+		ramp_time = volume_ramp_time(i * cd->vol_ramp_frames, cd->sample_rate_inv);
+		curve->shape[i][0] = volume_windows_fade_shape(cd->initial_ramp, ramp_time, false);
+		curve->shape[i][1] = volume_windows_fade_shape(cd->initial_ramp, ramp_time, true);
+	}
+
+	dcache_writeback_region((__sparse_force void __sparse_cache *)curve->shape,
+				steps * sizeof(curve->shape[0]));
+	return curve;
+}
+
+/**
+ * \brief Attaches the shared windows fade shape for current ramp parameters.
+ * \param[in,out] cd Volume component data.
+ *
+ * The shape is an optimization only, without it the ramp is calculated
+ * directly, so a failure to allocate it is not an error.
+ */
+static void volume_ramp_curve_get(struct vol_data *cd)
+{
+	struct vol_ramp_curve *curve;
+	struct vol_ramp_curve *new;
+	k_spinlock_key_t key;
+
+	if (cd->ramp_curve && volume_ramp_curve_match(cd->ramp_curve, cd))
+		return;
+
+	volume_ramp_curve_put(cd);
+
+	if (cd->ramp_type != SOF_VOLUME_WINDOWS_FADE || !cd->initial_ramp ||
+	    !cd->sample_rate_inv || !cd->vol_ramp_frames)
+		return;
+
+	key = k_spin_lock(&vol_ramp_curve_lock);
+	curve = volume_ramp_curve_find(cd);
+	if (curve)
+		curve->ref_count++;
+	k_spin_unlock(&vol_ramp_curve_lock, key);
+
+	if (!curve) {
+		/* the pow() calls take time, they are done without the lock */
+		new = volume_ramp_curve_new(cd);
+		if (!new)
+			return;
+
+		key = k_spin_lock(&vol_ramp_curve_lock);
+		curve = volume_ramp_curve_find(cd);
+		if (curve) {
+			curve->ref_count++;
+		} else {
+			list_item_append(&new->item, &vol_ramp_curve_list);
+			curve = new;
+			new = NULL;
+		}
+		k_spin_unlock(&vol_ramp_curve_lock, key);
+
+		if (new)
+			volume_ramp_curve_free(new);
+	}
+
+	/* the shape may have been calculated on another core */
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)curve->shape,
+				 curve->steps * sizeof(curve->shape[0]));
+	cd->ramp_curve = curve;
+}
+
+/**
+ * \brief Looks up the cached windows fade shape of current ramp update.
+ * \param[in] cd Volume component data.
+ * \return Rising and falling shape, NULL if the update is not cached.
+ */
+static inline const int32_t *volume_ramp_curve_step(const struct vol_data *cd)
+{
+	const struct vol_ramp_curve *curve = cd->ramp_curve;
+	uint32_t step;
+
+	if (!curve || curve->initial_ramp != cd->initial_ramp)
+		return NULL;
+
+	/* the ramp is updated every step_frames except after a restart */
+	step = cd->vol_ramp_elapsed_frames / curve->step_frames;
+	if (step >= curve->steps || step * curve->step_frames != cd->vol_ramp_elapsed_frames)
+		return NULL;
+
+	return curve->shape[step];
+}
+
 /**
  * \brief Calculate windows fade ramp function
  * \param[in,out] dev Component data: target gain, ramp start gain, ramp duration
  * \param[in] ramp_time Time spent since ramp start as milliseconds Q29.3
  * \param[in] channel Current channel to update
+ * \param[in] shape Cached rising and falling shape at ramp_time or NULL
  */
 
-static inline int32_t volume_windows_fade_ramp(struct vol_data *cd, int32_t ramp_time, int channel)
+static inline int32_t volume_windows_fade_ramp(struct vol_data *cd, int32_t ramp_time, int channel,
+					       const int32_t *shape)
 {
-	int32_t time_ratio; /* Q2.30 */
 	int32_t pow_value; /* Q2.30 */
 	int32_t volume_delta = cd->tvolume[channel] - cd->rvolume[channel]; /* Q16.16 */
 
 	if (!cd->initial_ramp)
 		return cd->tvolume[channel];
 
-	time_ratio = (((int64_t)ramp_time) << 30) / (cd->initial_ramp << 3);
 	if (volume_delta < 0) {
-		time_ratio = (1 << 30) - time_ratio;
-		pow_value = volume_pow_175(time_ratio);
+		pow_value = shape ? shape[1] :
+			volume_windows_fade_shape(cd->initial_ramp, ramp_time, true);
 		return cd->tvolume[channel] - Q_MULTSR_32X32((int64_t)volume_delta,
 							     pow_value, 16, 30, 16);
 	}
 
-	pow_value = volume_pow_175(time_ratio);
+	pow_value = shape ? shape[0] :
+		volume_windows_fade_shape(cd->initial_ramp, ramp_time, false);
 	return cd->rvolume[channel] + Q_MULTSR_32X32((int64_t)volume_delta, pow_value, 16, 30, 16);
 }
 #endif
@@ -298,8 +532,10 @@ static inline void volume_ramp(struct processing_module *mod)
 	 * for milliseconds.
 	 */
 #if defined CONFIG_COMP_VOLUME_WINDOWS_FADE || defined CONFIG_COMP_VOLUME_LINEAR_RAMP
-	int32_t ramp_time = Q_MULTSR_32X32((int64_t)cd->vol_ramp_elapsed_frames,
-					   cd->sample_rate_inv, 0, 31, 3);
+	int32_t ramp_time = volume_ramp_time(cd->vol_ramp_elapsed_frames, cd->sample_rate_inv);
+#endif
+#if CONFIG_COMP_VOLUME_WINDOWS_FADE
+	const int32_t *shape = volume_ramp_curve_step(cd);
 #endif
 
 	/* Update each volume if it's not at target for active channels */
@@ -317,7 +553,7 @@ static inline void volume_ramp(struct processing_module *mod)
 		switch (cd->ramp_type) {
 #if CONFIG_COMP_VOLUME_WINDOWS_FADE
 		case SOF_VOLUME_WINDOWS_FADE:
-			new_vol = volume_windows_fade_ramp(cd, ramp_time, i);
+			new_vol = volume_windows_fade_ramp(cd, ramp_time, i, shape);
 			break;
 #endif
 #if CONFIG_COMP_VOLUME_LINEAR_RAMP
@@ -380,6 +616,9 @@ void volume_reset_state(struct vol_data *cd)
 	cd->sample_rate_inv = 0;
 	cd->copy_gain = true;
 	cd->is_passthrough = false;
+#if CONFIG_COMP_VOLUME_WINDOWS_FADE
+	volume_ramp_curve_put(cd);
+#endif
 
 #if CONFIG_COMP_PEAK_VOL
 	memset(cd->peak_regs.peak_meter, 0, sizeof(cd->peak_regs.peak_meter));
@@ -413,6 +652,10 @@ void volume_prepare_ramp(struct comp_dev *dev, struct vol_data *cd)
 		cd->vol_ramp_frames = dev->frames;
 	else
 		cd->vol_ramp_frames = dev->frames / (dev->period / ramp_update_us);
+
+#if CONFIG_COMP_VOLUME_WINDOWS_FADE
+	volume_ramp_curve_get(cd);
+#endif
 }
 
 /**
@@ -427,6 +670,9 @@ static int volume_free(struct processing_module *mod)
 	comp_dbg(mod->dev, "volume_free()");
 
 	volume_peak_free(cd);
+#if CONFIG_COMP_VOLUME_WINDOWS_FADE
+	volume_ramp_curve_put(cd);
+#endif
 	rfree(cd->vol);
 	rfree(cd);
 
@@ -134,6 +134,8 @@ typedef uint32_t (*vol_zc_func)(const struct audio_stream *source,
  * \brief Function for volume ramp shape function
  */
 
+struct vol_ramp_curve;
+
 struct vol_data {
 #if CONFIG_IPC_MAJOR_4
 	uint32_t mailbox_offset;		/**< store peak volume in mailbox */
@@ -161,6 +163,9 @@ struct vol_data {
 	uint32_t vol_ramp_frames;
 	uint32_t vol_ramp_elapsed_frames;	/**< frames since transition */
 	int32_t sample_rate_inv;		/**< 1000x inverse of sample rate as Q1.31 */
+#if CONFIG_COMP_VOLUME_WINDOWS_FADE
+	struct vol_ramp_curve *ramp_curve;	/**< shared fade shape per ramp update */
+#endif
 	unsigned int channels;			/**< current channels count */
 	bool muted[SOF_IPC_MAX_CHANNELS];	/**< set if channel is muted */
 	bool ramp_finished;			/**< control ramp launch */
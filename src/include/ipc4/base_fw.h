@@ -288,6 +288,11 @@ enum ipc4_basefw_params {
 
 	/* Use LARGE_CONFIG_SET to change SDW ownership */
 	IPC4_SDW_OWNERSHIP = 31,
+
+	/* Use LARGE_CONFIG_GET to retrieve the DP load admitted on each core
+	 * and the headroom left, see struct ipc4_dp_load_info
+	 */
+	IPC4_DP_LOAD_INFO_GET = 32,
 };
 
 enum ipc4_fw_config_params {
@@ -778,6 +783,67 @@ struct extended_global_perf_data {
 	struct ext_perf_data_item perf_items[0];
 } __packed __aligned(4);
 
+/* parameter_instance of IPC4_EXTENDED_GLOBAL_PERF_DATA selecting the per-module
+ * cycle and bandwidth profile (struct ipc4_module_profile_data) instead of
+ * struct extended_global_perf_data
+ */
+#define IPC4_EXT_PERF_DATA_MODULE_PROFILE	1
+
+#define IPC4_MODULE_PROFILE_HIST_BUCKETS	16
+
+enum ipc4_module_profile_phase {
+	IPC4_MODULE_PROFILE_COPY = 0,
+	IPC4_MODULE_PROFILE_GET_DATA,
+	IPC4_MODULE_PROFILE_PROCESS,
+	IPC4_MODULE_PROFILE_COMMIT,
+	IPC4_MODULE_PROFILE_PHASES,
+};
+
+struct ipc4_module_profile_phase_data {
+	/* number of measured ticks */
+	uint32_t count;
+	uint32_t min_cycles;
+	uint32_t avg_cycles;
+	uint32_t max_cycles;
+	/* upper bound of the histogram bucket holding the 99th percentile */
+	uint32_t p99_cycles;
+	/* bucket 0 counts ticks below 64 cycles, bucket n ticks below 64 << n */
+	uint32_t hist[IPC4_MODULE_PROFILE_HIST_BUCKETS];
+} __packed __aligned(4);
+
+struct ipc4_module_profile_item {
+	/* ID of the FW component */
+	uint32_t resource_id;
+	/* average and peak number of bytes consumed and produced per tick */
+	uint32_t avg_bytes;
+	uint32_t peak_bytes;
+	struct ipc4_module_profile_phase_data phase[IPC4_MODULE_PROFILE_PHASES];
+} __packed __aligned(4);
+
+struct ipc4_module_profile_data {
+	/* Specifies number of items in profile_items array. */
+	uint32_t item_count;
+	struct ipc4_module_profile_item profile_items[0];
+} __packed __aligned(4);
+
+struct ipc4_dp_core_load {
+	uint32_t core_id;
+	/* number of DP modules admitted on the core */
+	uint32_t task_count;
+	/* KCPS of the core available to DP modules */
+	uint32_t budget_kcps;
+	/* sum of the KCPS declared by the admitted DP modules */
+	uint32_t load_kcps;
+	/* KCPS a new DP module may declare on the core */
+	uint32_t headroom_kcps;
+} __packed __aligned(4);
+
+struct ipc4_dp_load_info {
+	/* Specifies number of items in cores array. */
+	uint32_t core_count;
+	struct ipc4_dp_core_load cores[0];
+} __packed __aligned(4);
+
 struct perf_data_item_comp {
 	struct perf_data_item item;
 	/* Total iteration count of module instance */
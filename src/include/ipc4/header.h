@@ -87,7 +87,11 @@ enum ipc4_message_type {
 	SOF_IPC4_GLB_INTERNAL_MESSAGE = 26,
 	/**< Notification (FW to SW driver) */
 	SOF_IPC4_GLB_NOTIFICATION = 27,
-	/* GAP HERE- DO NOT USE - size 3 (28 .. 30)  */
+	/**< Batch of module and pipeline operations, SOF extension of the ABI
+	 * only handled with CONFIG_IPC4_BATCH
+	 */
+	SOF_IPC4_GLB_BATCH = 28,
+	/* GAP HERE- DO NOT USE - size 2 (29 .. 30)  */
 
 	/**< Maximum message number */
 	SOF_IPC4_GLB_MAX_IXC_MESSAGE_TYPE = 31
@@ -171,6 +175,58 @@ struct ipc4_message_reply {
 	} extension;
 } __attribute((packed, aligned(4)));
 
+/**
+ * \brief IPC4 batch message. The mailbox holds data_size bytes of num_ops
+ * operations, each a struct ipc4_batch_op followed by its payload. The
+ * operations are executed in order until one fails. The reply extension is
+ * the number of operations executed and the reply data has an IPC4 status
+ * word for each of them.
+ */
+struct ipc4_batch {
+	union {
+		uint32_t dat;
+
+		struct {
+			/**< number of operations in the batch */
+			uint32_t num_ops : 16;
+			uint32_t rsvd0 : 8;
+
+			/**< Global::BATCH */
+			uint32_t type : 5;
+
+			/**< Msg::MSG_REQUEST */
+			uint32_t rsp : 1;
+
+			/**< Msg::FW_GEN_MSG */
+			uint32_t msg_tgt : 1;
+
+			uint32_t _reserved_0 : 1;
+		} r;
+	} primary;
+
+	union {
+		uint32_t dat;
+
+		struct {
+			/**< size of the operations in the mailbox in bytes */
+			uint32_t data_size : 30;
+
+			uint32_t _reserved_2 : 2;
+		} r;
+	} extension;
+} __attribute((packed, aligned(4)));
+
+/**
+ * \brief An operation of an IPC4 batch, the header of a module init
+ * instance, bind, unbind or large config set message or of a create
+ * pipeline message as it would be sent alone, followed by data_size bytes
+ * of the message payload.
+ */
+struct ipc4_batch_op {
+	struct ipc4_message_request msg;
+	uint32_t data_size; /**< payload size in bytes, multiple of 4 */
+} __attribute((packed, aligned(4)));
+
 #define SOF_IPC4_SWITCH_CONTROL_PARAM_ID 200
 #define SOF_IPC4_ENUM_CONTROL_PARAM_ID  201
 #define SOF_IPC4_NOTIFY_MODULE_EVENTID_ALSA_MAGIC_VAL ((uint32_t)(0xA15A << 16))
@@ -184,6 +184,42 @@ int sink_get_buffer(struct sof_sink *sink, size_t req_size, void **data_ptr, voi
  */
 int sink_commit_buffer(struct sof_sink *sink, size_t commit_size);
 
+/**
+ * A batch of whole periods of free space obtained from a sink by a single
+ * sink_get_buffer_batch() call
+ *
+ * The circular buffer wrap is already resolved by the API - the space is provided as at most
+ * two linear segments that must be filled in order. If no wrap occurs, seg_size[1] is 0.
+ */
+struct sof_sink_batch {
+	void *seg_ptr[2];	/* start of each linear segment */
+	size_t seg_size[2];	/* size of each linear segment in bytes */
+	size_t frames;		/* total number of frames in the batch */
+	size_t periods;		/* number of whole periods in the batch */
+};
+
+/**
+ * Get space for as many whole periods as possible, up to max_periods, in one call
+ *
+ * This is a batch version of sink_get_buffer() intended for modules producing more than one
+ * period at once (i.e. DP modules running at long periods). The whole batch is obtained with
+ * a single get_buffer() call on the implementation and committed with a single
+ * sink_commit_buffer() call, so all the per-call overhead like cache writeback of a shared
+ * buffer is paid once per batch, not once per period.
+ *
+ * Total size of the batch is batch->frames * sink_get_frame_bytes()
+ *
+ * @param sink a handler to sink
+ * @param period_frames number of frames in a single period
+ * @param max_periods maximum number of periods the caller is able to produce
+ * @param [out] batch description of the obtained space
+ *
+ * @retval -ENODATA if there is no free space for even a single period
+ * @retval -EINVAL if period size is zero
+ */
+int sink_get_buffer_batch(struct sof_sink *sink, size_t period_frames, size_t max_periods,
+			  struct sof_sink_batch *batch);
+
 /** set of functions for retrieve audio parameters */
 int sink_set_frm_fmt(struct sof_sink *sink, enum sof_ipc_frame frame_fmt);
 
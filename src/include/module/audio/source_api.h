@@ -200,6 +200,41 @@ int source_get_data(struct sof_source *source, size_t req_size, void const **dat
  */
 int source_release_data(struct sof_source *source, size_t free_size);
 
+/**
+ * A batch of whole periods obtained from a source by a single source_get_data_batch() call
+ *
+ * The circular buffer wrap is already resolved by the API - the data are provided as at most
+ * two linear segments that must be processed in order. If no wrap occurs, seg_size[1] is 0.
+ */
+struct sof_source_batch {
+	void const *seg_ptr[2];	/* start of each linear segment */
+	size_t seg_size[2];	/* size of each linear segment in bytes */
+	size_t frames;		/* total number of frames in the batch */
+	size_t periods;		/* number of whole periods in the batch */
+};
+
+/**
+ * Retrieves as many whole periods of data as available, up to max_periods, in one call
+ *
+ * This is a batch version of source_get_data() intended for modules processing more than one
+ * period at once (i.e. DP modules running at long periods). The whole batch is obtained with
+ * a single get_data() call on the implementation, so all the per-call overhead like cache
+ * invalidation of a shared buffer is paid once per batch, not once per period.
+ *
+ * The batch must be released by source_release_data(), the same way as data obtained by
+ * source_get_data(). Total size of the batch is batch->frames * source_get_frame_bytes()
+ *
+ * @param source a handler to source
+ * @param period_frames number of frames in a single period
+ * @param max_periods maximum number of periods the caller is able to process
+ * @param [out] batch description of the obtained data
+ *
+ * @retval -ENODATA if not even a single period of data is available
+ * @retval -EINVAL if period size is zero
+ */
+int source_get_data_batch(struct sof_source *source, size_t period_frames, size_t max_periods,
+			  struct sof_source_batch *batch);
+
 /** set of functions for retrieve audio parameters */
 static inline enum sof_ipc_frame source_get_valid_fmt(struct sof_source *source)
 {
@@ -23,6 +23,8 @@
 #define CROSSOVER_MAX_LR4 3
 /* Maximum Number of sinks allowed in config */
 #define SOF_CROSSOVER_MAX_STREAMS 4
+/* Maximum number of frames for a split function call */
+#define CROSSOVER_BLOCK_FRAMES 16
 
 /**
  * Stores the state of one channel of the Crossover filter
@@ -33,8 +35,11 @@ struct crossover_state {
 	struct iir_state_df1 highpass[CROSSOVER_MAX_LR4];
 };
 
-typedef void (*crossover_split)(int32_t in, int32_t out[],
-				struct crossover_state *state);
+/* Splits a block of frames of one channel in in[] to out[] blocks of each
+ * sink, frames must not exceed CROSSOVER_BLOCK_FRAMES.
+ */
+typedef void (*crossover_split)(const int32_t in[], int32_t *out[],
+				struct crossover_state *state, int frames);
 
 extern const crossover_split crossover_split_fnmap[];
 
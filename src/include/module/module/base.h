@@ -168,6 +168,26 @@ struct processing_module {
 	 */
 	bool stream_copy_single_to_single;
 
+	/*
+	 * flag to indicate that the module processes data in place, i.e. it is able to use
+	 * the same memory as input and output. In raw data mode the module adapter then
+	 * aliases the output buffer to the input buffer instead of allocating a separate one,
+	 * and the module does not need to copy the data between them.
+	 */
+	bool in_place;
+
+	/*
+	 * set by the module adapter at prepare when the in_place module output buffer aliases
+	 * its input buffer, used until the buffers are freed
+	 */
+	bool raw_in_place;
+
+	/*
+	 * set at init by a DP module that keeps all of its run-time state in memory allocated
+	 * with the module memory API, lets DP work stealing run it on other cores
+	 */
+	bool dp_stealable;
+
 	/* total processed data after stream started */
 	uint64_t total_data_consumed;
 	uint64_t total_data_produced;
@@ -134,6 +134,9 @@ struct comp_buffer {
 	uint32_t core;
 	struct tr_ctx tctx;			/* trace settings */
 
+	/* stream pointers of a buffer shared between cores */
+	struct k_spinlock lock;
+
 	/* connected components */
 	struct comp_dev *source;	/* source component */
 	struct comp_dev *sink;		/* sink component */
@@ -249,6 +252,39 @@ static inline void buffer_stream_writeback(struct comp_buffer *buffer, uint32_t
 #endif
 }
 
+/*
+ * The producer and the consumer of a buffer shared between cores update the
+ * read and write pointers concurrently, so they are locked like the coherent
+ * objects of coherent devices.
+ */
+static inline void buffer_stream_produce(struct comp_buffer *buffer, uint32_t bytes)
+{
+	k_spinlock_key_t key;
+
+	if (!audio_buffer_is_shared(&buffer->audio_buffer)) {
+		audio_stream_produce(&buffer->stream, bytes);
+		return;
+	}
+
+	key = k_spin_lock(&buffer->lock);
+	audio_stream_produce(&buffer->stream, bytes);
+	k_spin_unlock(&buffer->lock, key);
+}
+
+static inline void buffer_stream_consume(struct comp_buffer *buffer, uint32_t bytes)
+{
+	k_spinlock_key_t key;
+
+	if (!audio_buffer_is_shared(&buffer->audio_buffer)) {
+		audio_stream_consume(&buffer->stream, bytes);
+		return;
+	}
+
+	key = k_spin_lock(&buffer->lock);
+	audio_stream_consume(&buffer->stream, bytes);
+	k_spin_unlock(&buffer->lock, key);
+}
+
 
 /*
  * Attach a new buffer at the beginning of the list. Note, that "head" must
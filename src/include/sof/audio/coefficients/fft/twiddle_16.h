@@ -9,12 +9,11 @@
 #ifndef __INCLUDE_TWIDDLE_16_H__
 #define __INCLUDE_TWIDDLE_16_H__
 
+#include <sof/math/fft.h>
 #include <stdint.h>
 
-#define FFT_SIZE_MAX	1024
-
 /* in Q1.15, generated from cos(i * 2 * pi / FFT_SIZE_MAX) */
-const int16_t twiddle_real_16[FFT_SIZE_MAX] = {
+__fft_rodata const int16_t twiddle_real_16[FFT_SIZE_MAX] = {
 	32767,
 	32767,
 	32766,
@@ -1042,7 +1041,7 @@ const int16_t twiddle_real_16[FFT_SIZE_MAX] = {
 };
 
 /* in Q1.15, generated from sin(i * 2 * pi / FFT_SIZE_MAX) */
-const int16_t twiddle_imag_16[FFT_SIZE_MAX] = {
+__fft_rodata const int16_t twiddle_imag_16[FFT_SIZE_MAX] = {
 	0,
 	-201,
 	-402,
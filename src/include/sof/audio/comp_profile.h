@@ -0,0 +1,224 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2025 Intel Corporation. All rights reserved.
+ */
+
+/**
+ * \file include/sof/audio/comp_profile.h
+ * \brief Per-component cycle and memory bandwidth profiling.
+ *
+ * Every comp_copy() call of a component is accounted as one tick. For each
+ * tick the cycles spent in the whole copy and, for module adapter based
+ * components, in the get_data / process / commit phases are folded into
+ * min/max/total counters and into a log2 histogram from which percentiles
+ * are derived. Bytes consumed and produced by the module during the tick
+ * are accounted too.
+ *
+ * The instrumentation is compiled in with CONFIG_COMP_PROFILE and stays
+ * idle until enabled at run-time, which costs one load and branch per copy.
+ *
+ * Statistics are updated by the core running the component and read or reset
+ * by the IPC core. They are kept in the component device, which is allocated
+ * uncached, so no cache maintenance is needed. The run-time switch is an
+ * atomic variable written by the IPC core and read by all cores.
+ */
+
+#ifndef __SOF_AUDIO_COMP_PROFILE_H__
+#define __SOF_AUDIO_COMP_PROFILE_H__
+
+#include <sof/debug/telemetry/telemetry.h>
+#include <rtos/atomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#if CONFIG_LIBRARY
+#include <time.h>
+#endif
+
+/** \brief Number of histogram buckets kept per phase. */
+#define COMP_PROFILE_HIST_BUCKETS	16
+
+/**
+ * \brief Log2 of the upper bound of histogram bucket 0.
+ *
+ * Bucket 0 counts ticks shorter than 64 cycles, bucket n (n > 0) counts ticks
+ * in [64 << (n - 1), 64 << n) and the last bucket also takes all longer ticks.
+ */
+#define COMP_PROFILE_HIST_SHIFT		6
+
+/** \brief Profiled phases of a component copy. */
+enum comp_profile_phase {
+	COMP_PROFILE_COPY = 0,	/**< whole comp_copy() */
+	COMP_PROFILE_GET_DATA,	/**< acquiring and invalidating input data */
+	COMP_PROFILE_PROCESS,	/**< module processing */
+	COMP_PROFILE_COMMIT,	/**< writeback, consume and produce */
+	COMP_PROFILE_PHASE_COUNT,
+};
+
+/** \brief Cycle statistics of a single phase. */
+struct comp_profile_stats {
+	uint32_t count;		/**< number of samples */
+	uint32_t min;		/**< minimum cycles */
+	uint32_t max;		/**< maximum cycles */
+	uint64_t total;		/**< sum of cycles, for the average */
+	uint32_t hist[COMP_PROFILE_HIST_BUCKETS]; /**< log2 histogram */
+};
+
+/** \brief Profiling state of a component. */
+struct comp_profile {
+	struct comp_profile_stats phase[COMP_PROFILE_PHASE_COUNT];
+	uint64_t total_bytes;	/**< bytes consumed and produced */
+	uint32_t peak_bytes;	/**< max bytes moved in a single tick */
+
+	/* current tick, valid between comp_profile_begin() and comp_profile_end() */
+	uint32_t begin_stamp;
+	uint32_t phase_stamp;
+	uint32_t tick_bytes;
+	bool in_tick;
+	bool process_marked;
+};
+
+#if CONFIG_COMP_PROFILE
+
+extern atomic_t comp_profile_active;
+
+/** \brief Retrieves profiling state of a component. */
+#define comp_dev_profile(dev) (&(dev)->profile)
+
+#if CONFIG_LIBRARY
+/* host builds have no cycle counter, profile in nanoseconds instead */
+static inline uint32_t comp_profile_timestamp(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+#else
+static inline uint32_t comp_profile_timestamp(void)
+{
+	return (uint32_t)telemetry_timestamp();
+}
+#endif
+
+/**
+ * \brief Adds a sample to phase statistics.
+ * \param[in,out] stats Phase statistics.
+ * \param[in] cycles Duration of the phase.
+ */
+void comp_profile_stats_add(struct comp_profile_stats *stats, uint32_t cycles);
+
+/**
+ * \brief Returns a percentile of phase statistics.
+ *
+ * The result is the upper bound of the histogram bucket holding the requested
+ * percentile, clamped to the measured maximum.
+ *
+ * \param[in] stats Phase statistics.
+ * \param[in] permille Requested percentile in 1/1000 units, 990 for p99.
+ * \return Cycles, 0 if there are no samples.
+ */
+uint32_t comp_profile_percentile(const struct comp_profile_stats *stats, uint32_t permille);
+
+/**
+ * \brief Enables or disables profiling of all components.
+ * \param[in] enable True to start collecting samples.
+ */
+void comp_profile_enable(bool enable);
+
+/**
+ * \brief Clears collected statistics of a component.
+ * \param[in,out] prof Profiling state.
+ */
+void comp_profile_reset(struct comp_profile *prof);
+
+static inline bool comp_profile_enabled(void)
+{
+	return atomic_read(&comp_profile_active);
+}
+
+/** \brief Starts a tick, called from comp_copy(). */
+static inline void comp_profile_begin(struct comp_profile *prof)
+{
+	if (!comp_profile_enabled())
+		return;
+
+	prof->begin_stamp = comp_profile_timestamp();
+	prof->phase_stamp = prof->begin_stamp;
+	prof->tick_bytes = 0;
+	prof->process_marked = false;
+	prof->in_tick = true;
+}
+
+/**
+ * \brief Closes a phase of the current tick.
+ *
+ * Cycles since the previous mark (or the tick start) are accounted to \p phase.
+ * Marks outside a tick are ignored.
+ */
+static inline void comp_profile_mark(struct comp_profile *prof, enum comp_profile_phase phase)
+{
+	uint32_t now;
+
+	if (!prof->in_tick)
+		return;
+
+	now = comp_profile_timestamp();
+	comp_profile_stats_add(&prof->phase[phase], now - prof->phase_stamp);
+	prof->phase_stamp = now;
+	if (phase == COMP_PROFILE_PROCESS)
+		prof->process_marked = true;
+}
+
+/** \brief Accounts bytes consumed and produced during the current tick. */
+static inline void comp_profile_add_bytes(struct comp_profile *prof, uint32_t bytes)
+{
+	if (prof->in_tick)
+		prof->tick_bytes += bytes;
+}
+
+/**
+ * \brief Ends a tick, called from comp_copy().
+ *
+ * Cycles since the last mark are accounted to the commit phase, or to the
+ * process phase when the component did not mark any phase itself.
+ */
+static inline void comp_profile_end(struct comp_profile *prof)
+{
+	uint32_t now;
+
+	if (!prof->in_tick)
+		return;
+
+	now = comp_profile_timestamp();
+	comp_profile_stats_add(&prof->phase[prof->process_marked ? COMP_PROFILE_COMMIT :
+					    COMP_PROFILE_PROCESS], now - prof->phase_stamp);
+	comp_profile_stats_add(&prof->phase[COMP_PROFILE_COPY], now - prof->begin_stamp);
+
+	prof->total_bytes += prof->tick_bytes;
+	if (prof->tick_bytes > prof->peak_bytes)
+		prof->peak_bytes = prof->tick_bytes;
+	prof->in_tick = false;
+}
+
+#else
+
+#define comp_dev_profile(dev) ((struct comp_profile *)NULL)
+
+static inline bool comp_profile_enabled(void) { return false; }
+static inline void comp_profile_enable(bool enable) {}
+static inline void comp_profile_reset(struct comp_profile *prof) {}
+static inline void comp_profile_begin(struct comp_profile *prof) {}
+static inline void comp_profile_mark(struct comp_profile *prof,
+				     enum comp_profile_phase phase) {}
+static inline void comp_profile_add_bytes(struct comp_profile *prof, uint32_t bytes) {}
+static inline void comp_profile_end(struct comp_profile *prof) {}
+
+static inline uint32_t comp_profile_percentile(const struct comp_profile_stats *stats,
+					       uint32_t permille)
+{
+	return 0;
+}
+
+#endif /* CONFIG_COMP_PROFILE */
+
+#endif /* __SOF_AUDIO_COMP_PROFILE_H__ */
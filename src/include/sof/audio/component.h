@@ -17,6 +17,7 @@
 #define __SOF_AUDIO_COMPONENT_H__
 
 #include <sof/audio/buffer.h>
+#include <sof/audio/comp_profile.h>
 #include <sof/audio/format.h>
 #include <sof/audio/pipeline.h>
 #include <sof/debug/telemetry/telemetry.h>
@@ -631,6 +632,10 @@ struct comp_dev {
 	struct perf_cnt_data pcd;
 #endif
 
+#if CONFIG_COMP_PROFILE
+	struct comp_profile profile;	/**< run-time cycle and bandwidth profile */
+#endif
+
 #if CONFIG_KCPS_DYNAMIC_CLOCK_CONTROL
 	int32_t kcps_inc[CONFIG_CORE_COUNT];
 #endif
@@ -38,7 +38,7 @@ struct comp_driver_list {
 #if CONFIG_IPC_MAJOR_3
 struct comp_dev *comp_new(struct sof_ipc_comp *comp);
 #elif CONFIG_IPC_MAJOR_4
-struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init);
+struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init, char *data);
 #endif
 
 /** See comp_ops::free */
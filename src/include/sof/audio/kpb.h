@@ -45,13 +45,19 @@ struct comp_buffer;
 #define KPB_MAX_NO_OF_CLIENTS 2
 #define KPB_MAX_SINK_CNT (1 + KPB_MAX_NO_OF_CLIENTS)
 #define KPB_NO_OF_HISTORY_BUFFERS 2 /**< no of internal buffers */
+#define KPB_NO_OF_MEM_POOLS 3
+#define KPB_MAX_HB_BLOCKS 8 /**< max no of blocks of the history ring */
 #define KPB_ALLOCATION_STEP 0x100
-#define KPB_NO_OF_MEM_POOLS 5
 #define KPB_BYTES_TO_FRAMES(bytes, sample_width, channels_number) \
 	((bytes) / ((KPB_SAMPLE_CONTAINER_SIZE(sample_width) / 8) * \
 	 (channels_number)))
 /**< Defines how much faster draining is in comparison to pipeline copy. */
 #define KPB_DRAIN_NUM_OF_PPL_PERIODS_AT_ONCE 2
+/**< Max. time in us the draining task copies in a batch before it yields.
+ * LL is blocked while a batch runs, a quarter of the LL period keeps the
+ * LL ticks on time.
+ */
+#define KPB_DRAIN_BATCH_TIME_US (LL_TIMER_PERIOD_US / 4)
 /**< Host buffer shall be at least two times bigger than history buffer. */
 #define HOST_BUFFER_MIN_SIZE(hb, channels_number) ((hb) * (channels_number))
 
@@ -120,25 +126,28 @@ struct kpb_client {
 	struct comp_buffer *sink; /**< client's sink */
 };
 
-enum buffer_state {
-	KPB_BUFFER_FREE = 0,
-	KPB_BUFFER_FULL,
-	KPB_BUFFER_OFF,
-};
-
 enum kpb_id {
 	KPB_LP = 0,
 	KPB_HP,
 };
 
+/* Memory block of the history ring buffer */
+struct history_block {
+	void *start_addr; /**< block start address */
+	void *end_addr; /**< block end address */
+};
+
+/* History ring buffer. It is a single contiguous (virtual) memory window
+ * when one can be allocated, else a few blocks which follow each other
+ * in the ring.
+ */
 struct history_buffer {
-	enum buffer_state state; /**< state of the buffer */
-	void *start_addr; /**< buffer start address */
-	void *end_addr; /**< buffer end address */
+	struct history_block block[KPB_MAX_HB_BLOCKS]; /**< blocks in ring order */
+	int blocks; /**< number of blocks in use */
+	int w_block; /**< block of the write pointer */
+	int r_block; /**< block of the read pointer */
 	void *w_ptr; /**< buffer write pointer */
 	void *r_ptr; /**< buffer read pointer */
-	struct history_buffer *next; /**< next history buffer */
-	struct history_buffer *prev; /**< next history buffer */
 };
 
 /* Draining task data */
@@ -160,7 +169,7 @@ struct history_data {
 	size_t buffer_size; /**< size of internal history buffer */
 	size_t buffered; /**< amount of buffered data */
 	size_t free; /** spce we can use to write new data */
-	struct history_buffer *c_hb; /**< current buffer used for writing */
+	struct history_buffer hb; /**< history ring buffer */
 };
 
 /* moved to ipc4/kpb.h */
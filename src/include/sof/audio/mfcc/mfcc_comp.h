@@ -80,15 +80,15 @@ struct mfcc_pre_emph {
 
 struct mfcc_fft {
 #if MFCC_FFT_BITS == 16
-	struct icomplex16 *fft_buf; /**< fft_padded_size */
-	struct icomplex16 *fft_out; /**< fft_padded_size */
+	int16_t *fft_buf; /**< fft_padded_size real samples */
+	struct icomplex16 *fft_out; /**< fft_padded_size / 2 + 1 bins */
 #elif MFCC_FFT_BITS == 32
-	struct icomplex32 *fft_buf; /**< fft_padded_size */
-	struct icomplex32 *fft_out; /**< fft_padded_size */
+	int32_t *fft_buf; /**< fft_padded_size real samples */
+	struct icomplex32 *fft_out; /**< fft_padded_size / 2 + 1 bins */
 #else
 #error "MFCC_FFT_BITS needs to be 16 or 32"
 #endif
-	struct fft_plan *fft_plan;
+	struct fft_real_plan *fft_plan;
 	int fft_fill_start_idx; /**< Set to 0 for pad left, etc. */
 	int fft_size;
 	int fft_padded_size;
@@ -121,6 +121,7 @@ struct module_param {
  */
 struct module_memory {
 	void *ptr; /**< A pointr to particular memory block */
+	size_t size; /**< Size of the memory block */
 	struct list_item mem_list; /**< list of memory allocated by module */
 };
 
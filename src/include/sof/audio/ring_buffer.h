@@ -15,6 +15,7 @@
 #include <sof/common.h>
 #include <ipc/topology.h>
 #include <sof/coherent.h>
+#include <rtos/atomic.h>
 
 /**
  * ring_buffer is a lockless async circular buffer
@@ -68,21 +69,33 @@
  *    secondary core. ring_buffer structure is located in shared memory
  *
  *
- * ring_buffer is a lockless consumer/producer safe buffer. It is achieved by having only 2 shared
- * variables:
- *  _write_offset - can be modified by data producer only
- *  _read_offset - can be modified by data consumer only
+ * ring_buffer is a lockless single producer / single consumer safe buffer. It is achieved by
+ * having only 2 shared variables:
+ *  write_offset - can be modified by data producer only
+ *  read_offset - can be modified by data consumer only
  *
- *  as 32 bit operations are atomic, it is multi-thread and multi-core save
+ * Both offsets are kept in a separate metadata block, each one in its own cache line, located
+ * in cached memory right behind the data buffer. Each cache line has exactly one writer, so
+ * in shared mode it is enough to writeback the producer's (or consumer's) offset line after
+ * it has been updated and to invalidate the peer's line before reading it - the ring_buffer
+ * structure itself is never modified during data processing and no other memory is bounced
+ * between cores.
+ *
+ * Offsets are accessed with atomic operations, so the ordering is explicit:
+ *  - producer writes data, writes it back (shared mode) and only then publishes write_offset
+ *  - consumer reads the data only after it has observed the new write_offset
+ *  - the same applies to the consumer releasing space with read_offset
+ * this makes the buffer multi-thread and multi-core safe regardless of the scheduling of
+ * the producer and the consumer
  *
  * There some explanation needed how free_space and available_data are calculated
  *
  * number of avail data in circular buffer may be calculated as:
- *	data_avail = _write_offset - _read_offset
+ *	data_avail = write_offset - read_offset
  *   and check for wrap around
  *	if (data_avail < 0) data_avail = buffer_size - data_avail
  *
- * The problem is when _write_offset == _read_offset,
+ * The problem is when write_offset == read_offset,
  * !!! it may mean either that the buffer is empty or the buffer is completely filled !!!
  *
  * To solve the above issue having only 2 variables mentioned before:
@@ -91,15 +104,21 @@
  *  - use double buffer size in wrap around check when calculating available data
  *
  * And now:
- *   - _write_offset == _read_offset
+ *   - write_offset == read_offset
  *		always means "buffer empty"
- *   - _write_offset == _read_offset + buffer_size
+ *   - write_offset == read_offset + buffer_size
  *		always means "buffer full"
  */
 
 struct ring_buffer;
 struct sof_audio_stream_params;
 
+/* producer and consumer offsets, each one in a separate cache line */
+struct ring_buffer_offsets {
+	atomic_t __aligned(PLATFORM_DCACHE_ALIGN) write_offset; /* modified by producer only */
+	atomic_t __aligned(PLATFORM_DCACHE_ALIGN) read_offset;  /* modified by consumer only */
+};
+
 /* the ring_buffer structure */
 struct ring_buffer {
 	/* public: read only */
@@ -108,8 +127,8 @@ struct ring_buffer {
 	size_t data_buffer_size;
 
 	uint8_t __sparse_cache *_data_buffer;
-	size_t _write_offset;		/* private: to be modified by data producer using API */
-	size_t _read_offset;		/* private: to be modified by data consumer using API */
+	/* private: to be modified using API only, located behind _data_buffer */
+	struct ring_buffer_offsets __sparse_cache *_offsets;
 };
 
 /**
@@ -26,6 +26,16 @@
 #endif
 
 #define FFT_SIZE_MAX	1024
+#define FFT_SIZE_MAX_LEN	10	/* FFT_SIZE_MAX in exponent of 2 */
+
+/* The FFT reads the shared tables for every butterfly. They can be in cold
+ * memory only if fast_get() copies them to SRAM for the plans.
+ */
+#if CONFIG_FAST_GET
+#define __fft_rodata	__cold_rodata
+#else
+#define __fft_rodata
+#endif
 
 struct icomplex32 {
 	int32_t real;
@@ -41,20 +51,46 @@ struct icomplex16 {
 	int16_t imag;
 };
 
+/* The bit reverse index and twiddle factor tables are shared const data
+ * for FFT_SIZE_MAX. With CONFIG_FAST_GET the plan references them from
+ * fast memory, a plan of smaller size uses a subset of the entries.
+ */
 struct fft_plan {
 	uint32_t size;	/* fft size */
 	uint32_t len;	/* fft length in exponent of 2 */
-	uint16_t *bit_reverse_idx;	/* pointer to bit reverse index array */
+	const uint16_t *bit_reverse_idx;	/* pointer to bit reverse index table */
+	uint32_t bit_reverse_shift;	/* right shift of the index table entries */
+	const int16_t *twiddle_real_16;	/* pointer to Q1.15 twiddle factor tables */
+	const int16_t *twiddle_imag_16;
+	const int32_t *twiddle_real_32;	/* pointer to Q1.31 twiddle factor tables */
+	const int32_t *twiddle_imag_32;
 	struct icomplex32 *inb32;	/* pointer to input integer complex buffer */
 	struct icomplex32 *outb32;	/* pointer to output integer complex buffer */
 	struct icomplex16 *inb16;	/* pointer to input integer complex buffer */
 	struct icomplex16 *outb16;	/* pointer to output integer complex buffer */
 };
 
+/* A real input FFT of size N runs as a complex FFT of size N / 2. The
+ * forward transform reads N real samples from the input buffer and writes
+ * N / 2 + 1 complex bins to the output buffer, with the same 1 / N scaling
+ * as the complex FFT. The inverse transform reads N / 2 + 1 bins from the
+ * input buffer, uses it as scratch, and writes N real samples to the output.
+ */
+struct fft_real_plan {
+	uint32_t size;	/* real fft size */
+	uint32_t len;	/* real fft length in exponent of 2 */
+	struct fft_plan *plan;	/* complex fft of half size */
+};
+
 /* interfaces of the library */
 struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits);
 void fft_execute_16(struct fft_plan *plan, bool ifft);
 void fft_execute_32(struct fft_plan *plan, bool ifft);
 void fft_plan_free(struct fft_plan *plan16);
 
+struct fft_real_plan *fft_real_plan_new(void *inb, void *outb, uint32_t size, int bits);
+void fft_execute_real_16(struct fft_real_plan *plan, bool ifft);
+void fft_execute_real_32(struct fft_real_plan *plan, bool ifft);
+void fft_real_plan_free(struct fft_real_plan *plan);
+
 #endif /* __SOF_FFT_H__ */
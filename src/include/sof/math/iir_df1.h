@@ -24,6 +24,17 @@ struct iir_state_df1 {
 	int32_t *delay; /* Pointer to IIR delay line */
 };
 
+/* Cross-channel state for biquads in series. Coefficient k of biquad b of
+ * channel ch is in coef[(b * SOF_EQ_IIR_NBIQUAD + k) * channels + ch], the
+ * delay lines are ordered in the same way with IIR_DF1_NUM_STATE per biquad.
+ */
+struct iir_df1_multi {
+	unsigned int channels; /* Number of channels, zero if not in use */
+	unsigned int biquads; /* Number of IIR 2nd order sections in series */
+	int32_t *coef; /* Pointer to channels interleaved IIR coefficients */
+	int32_t *delay; /* Pointer to channels interleaved IIR delay lines */
+};
+
 struct sof_eq_iir_header;
 
 int iir_init_coef_df1(struct iir_state_df1 *iir,
@@ -53,6 +64,57 @@ int32_t iir_df1(struct iir_state_df1 *iir, int32_t x);
  */
 int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x);
 
+/**
+ * Calculate IIR filter consisting of biquads for a block of samples of one
+ * channel. The output is bit exact with iir_df1() for each sample but each
+ * biquad is run over the whole block before the next one, so that its
+ * coefficients and delay line stay in registers.
+ * @param iir	IIR state with configured biquad coefficients and delay lines data
+ * @param x	Block of s32 Q1.31 format samples, filtered in place
+ * @param n	Number of samples in block
+ */
+void iir_df1_block(struct iir_state_df1 *iir, int32_t *x, int n);
+
+/**
+ * Calculate IIR filter of two biquads in series for a block of samples of
+ * one channel, the block version of iir_df1_4th().
+ * @param iir	IIR state with configured biquad coefficients and delay lines data
+ * @param x	Block of s32 Q1.31 format samples, filtered in place
+ * @param n	Number of samples in block
+ */
+void iir_df1_4th_block(struct iir_state_df1 *iir, int32_t *x, int n);
+
+/**
+ * Get the size of the data of a cross-channel IIR filter
+ * @param channels	Number of channels
+ * @param biquads	Number of biquads in series of each channel
+ * @return		Size in bytes for coefficients and delay lines
+ */
+size_t iir_df1_multi_size(int channels, int biquads);
+
+/**
+ * Set up a cross-channel IIR filter from the per channel filters. All
+ * channels must have the same number of biquads, all in series. The
+ * coefficients and delay lines are copied to the channels interleaved order.
+ * @param multi		Cross-channel IIR state to set up
+ * @param iir		Configured filters of each channel
+ * @param channels	Number of channels
+ * @param data		Memory of iir_df1_multi_size() bytes for the state
+ * @return		Zero for success, -EINVAL if the filters can't be used
+ */
+int iir_df1_multi_init(struct iir_df1_multi *multi, const struct iir_state_df1 *iir,
+		       int channels, int32_t *data);
+
+/**
+ * Calculate IIR filter of biquads in series for a block of interleaved
+ * frames. Each biquad is run for all channels of the block before the
+ * next one. The output is bit exact with iir_df1() of each channel.
+ * @param multi		Cross-channel IIR state
+ * @param x		Block of interleaved s32 Q1.31 samples, filtered in place
+ * @param frames	Number of frames in block
+ */
+void iir_df1_multi_block(struct iir_df1_multi *multi, int32_t *x, int frames);
+
 /* Inline functions */
 #if SOF_USE_MIN_HIFI(3, FILTER)
 #include "iir_df1_hifi3.h"
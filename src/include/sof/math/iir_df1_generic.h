@@ -30,5 +30,16 @@ static inline int32_t iir_df1_s32_s24(struct iir_state_df1 *iir, int32_t x)
 	return sat_int24(Q_SHIFT_RND(iir_df1(iir, x), 31, 23));
 }
 
+/* Output conversions of the block versions, same as in the above */
+static inline int16_t iir_df1_q31_to_s16(int32_t x)
+{
+	return sat_int16(Q_SHIFT_RND(x, 31, 15));
+}
+
+static inline int32_t iir_df1_q31_to_s24(int32_t x)
+{
+	return sat_int24(Q_SHIFT_RND(x, 31, 23));
+}
+
 #endif /* __IIR_DF1_GENERIC_H__ */
 
@@ -39,5 +39,20 @@ static inline int32_t iir_df1_s32_s24(struct iir_state_df1 *iir, int32_t x)
 	return AE_SRAI32(AE_SLAI32S(AE_SRAI32R(y, 8), 8), 8);
 }
 
+/* Output conversions of the block versions, same as in the above */
+static inline int16_t iir_df1_q31_to_s16(int32_t x)
+{
+	ae_f32x2 y = x;
+
+	return AE_ROUND16X4F32SSYM(y, y);
+}
+
+static inline int32_t iir_df1_q31_to_s24(int32_t x)
+{
+	ae_f32x2 y = x;
+
+	return AE_SRAI32(AE_SLAI32S(AE_SRAI32R(y, 8), 8), 8);
+}
+
 #endif /* __IIR_DF1_HIFI3_H__ */
 
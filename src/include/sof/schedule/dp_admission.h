@@ -0,0 +1,93 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright(c) 2025 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_SCHEDULE_DP_ADMISSION_H__
+#define __SOF_SCHEDULE_DP_ADMISSION_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * DP admission control
+ *
+ * Each DP module declares its CPC, the cycles it needs to process one chunk,
+ * in the IPC4 base config. A chunk is produced every period, so the module
+ * takes CPC * 1000 / period_us KCPS of its core. The DP scheduler keeps the
+ * sum of the load of the admitted modules of each core and refuses a module
+ * that would push its core over the DP budget, instead of letting it miss
+ * deadlines once streaming.
+ */
+
+/**
+ * \brief Computes the load of a DP module.
+ * \param[in] cpc Cycles needed to process a chunk.
+ * \param[in] period_us Period of the module in us.
+ * \return Load in KCPS, rounded up, 0 for modules without a declared CPC.
+ */
+static inline uint32_t dp_admission_kcps(uint32_t cpc, uint32_t period_us)
+{
+	if (!cpc || !period_us)
+		return 0;
+
+	return ((uint64_t)cpc * 1000 + period_us - 1) / period_us;
+}
+
+/**
+ * \brief Computes the period of a DP module from its output chunk size.
+ * \param[in] obs Bytes produced per chunk.
+ * \param[in] frame_bytes Bytes per frame.
+ * \param[in] rate Frames per second.
+ * \return Period in us, 0 if it cannot be determined.
+ */
+static inline uint32_t dp_admission_period_us(uint32_t obs, uint32_t frame_bytes, uint32_t rate)
+{
+	if (!frame_bytes || !rate)
+		return 0;
+
+	return (uint64_t)obs * 1000000 / ((uint64_t)frame_bytes * rate);
+}
+
+/**
+ * \brief Computes the free DP budget of a core.
+ * \param[in] budget_kcps DP budget of the core.
+ * \param[in] load_kcps Load of the modules admitted on the core.
+ * \return Headroom in KCPS.
+ */
+static inline uint32_t dp_admission_headroom(uint32_t budget_kcps, uint32_t load_kcps)
+{
+	return load_kcps < budget_kcps ? budget_kcps - load_kcps : 0;
+}
+
+/**
+ * \brief Finds the core with the largest DP headroom.
+ * \param[in] load_kcps Load of the modules admitted on each core.
+ * \param[in] budget_kcps DP budget of a core.
+ * \param[in] core_mask Cores to consider.
+ * \param[in] core_count Number of entries in load_kcps.
+ * \return Core index or -1 if no core is in the mask.
+ */
+static inline int dp_admission_best_core(const uint32_t *load_kcps, uint32_t budget_kcps,
+					 uint32_t core_mask, int core_count)
+{
+	uint32_t best_headroom = 0;
+	uint32_t headroom;
+	int best = -1;
+	int i;
+
+	for (i = 0; i < core_count; i++) {
+		if (!(core_mask & (1U << i)))
+			continue;
+
+		headroom = dp_admission_headroom(budget_kcps, load_kcps[i]);
+		if (best < 0 || headroom > best_headroom) {
+			best = i;
+			best_headroom = headroom;
+		}
+	}
+
+	return best;
+}
+
+#endif /* __SOF_SCHEDULE_DP_ADMISSION_H__ */
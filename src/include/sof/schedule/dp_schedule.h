@@ -75,6 +75,14 @@ int scheduler_dp_task_init(struct task **task,
 			   uint16_t core,
 			   size_t stack_size);
 
+/**
+ * \brief Retrieves the DP load admitted on a core
+ *
+ * \param[in] core index of the reported core
+ * \param[out] load admitted load, budget and headroom of the core
+ */
+void scheduler_dp_load_get(int core, struct ipc4_dp_core_load *load);
+
 /**
  * \brief Extract information about scheduler's tasks
  *
@@ -0,0 +1,121 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/*
+ * Copyright(c) 2025 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __SOF_SCHEDULE_DP_STEAL_H__
+#define __SOF_SCHEDULE_DP_STEAL_H__
+
+#include <sof/common.h>
+#include <sof/list.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * DP work stealing
+ *
+ * When a DP task becomes ready while its own core is already busy with DP
+ * processing, the task is also put on a queue shared by all cores, ordered by
+ * deadline. An idle core picks the earliest deadline task of another core
+ * from the queue and runs it in its own worker thread. Whichever of the own
+ * thread and a worker claims the task first under the scheduler lock runs it,
+ * a single run never moves between cores.
+ *
+ * Only the memory a module allocated with the module memory API is written
+ * back and invalidated around a move, so only modules which keep all of their
+ * run-time state there and opt in are handed out. They also need a period of
+ * at least CONFIG_DP_SCHEDULER_STEAL_MIN_PERIOD_US, as running on another core
+ * costs that cache maintenance, and must fit into the worker stack.
+ */
+
+/** \brief Shared queue membership of a DP task. */
+struct dp_steal_entry {
+	struct list_item list;	/**< in the shared queue, earliest deadline first */
+	uint64_t deadline;	/**< absolute deadline in system clock ticks */
+	uint32_t core;		/**< core the task belongs to */
+	bool queued;		/**< on the shared queue */
+};
+
+/**
+ * \brief Checks if a DP task that became ready may be run by other cores.
+ * \param[in] opt_in True if the module of the task may run on other cores.
+ * \param[in] period_us Period of the task, also its deadline.
+ * \param[in] stack_size Stack size of the task.
+ * \param[in] stack_max Stack size of the worker threads.
+ * \param[in] home_busy True if the core of the task is already busy with DP work.
+ * \return True if the task may be put on the shared queue.
+ */
+static inline bool dp_steal_allowed(bool opt_in, uint32_t period_us, size_t stack_size,
+				    size_t stack_max, bool home_busy)
+{
+	return opt_in && home_busy && period_us >= CONFIG_DP_SCHEDULER_STEAL_MIN_PERIOD_US &&
+	       stack_size <= stack_max;
+}
+
+/**
+ * \brief Puts a task on the shared queue.
+ * \param[in,out] queue Shared queue.
+ * \param[in,out] entry Queue membership of the task, not queued.
+ * \param[in] deadline Absolute deadline of the task.
+ */
+static inline void dp_steal_push(struct list_item *queue, struct dp_steal_entry *entry,
+				 uint64_t deadline)
+{
+	struct list_item *item;
+	struct dp_steal_entry *next;
+
+	entry->deadline = deadline;
+	entry->queued = true;
+
+	list_for_item(item, queue) {
+		next = container_of(item, struct dp_steal_entry, list);
+		if (deadline < next->deadline) {
+			/* insert before the first later deadline */
+			list_item_append(&entry->list, item);
+			return;
+		}
+	}
+
+	list_item_append(&entry->list, queue);
+}
+
+/**
+ * \brief Takes the earliest deadline task of other cores off the shared queue.
+ * \param[in,out] queue Shared queue.
+ * \param[in] core Index of the core looking for work.
+ * \return Queue membership of the task or NULL if there is none.
+ */
+static inline struct dp_steal_entry *dp_steal_pop(struct list_item *queue, uint32_t core)
+{
+	struct list_item *item;
+	struct dp_steal_entry *entry;
+
+	list_for_item(item, queue) {
+		entry = container_of(item, struct dp_steal_entry, list);
+		if (entry->core != core) {
+			list_item_del(&entry->list);
+			entry->queued = false;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * \brief Takes a task off the shared queue, if it is still there.
+ * \param[in,out] entry Queue membership of the task.
+ * \return True if the task was queued, i.e. no other core has claimed it.
+ */
+static inline bool dp_steal_remove(struct dp_steal_entry *entry)
+{
+	if (!entry->queued)
+		return false;
+
+	list_item_del(&entry->list);
+	entry->queued = false;
+	return true;
+}
+
+#endif /* __SOF_SCHEDULE_DP_STEAL_H__ */
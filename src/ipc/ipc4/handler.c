@@ -102,6 +102,14 @@ static inline const struct ipc4_pipeline_set_state_data *ipc4_get_pipeline_data(
 
 	return ppl_data;
 }
+
+/* the payload follows the msg_size bytes of message header */
+static inline char *ipc4_get_msg_data(size_t msg_size)
+{
+	struct ipc *ipc = ipc_get();
+
+	return (char *)ipc->comp_data + msg_size;
+}
 #else
 static inline struct ipc4_message_request *ipc4_get_message_request(void)
 {
@@ -127,6 +135,12 @@ static inline const struct ipc4_pipeline_set_state_data *ipc4_get_pipeline_data(
 
 	return ppl_data;
 }
+
+/* the payload is in the mailbox, the header is in the IPC registers */
+static inline char *ipc4_get_msg_data(size_t msg_size)
+{
+	return (char *)MAILBOX_HOSTBOX_BASE;
+}
 #endif
 /*
  * Global IPC Operations.
@@ -795,6 +809,10 @@ static int ipc4_process_ipcgtw_cmd(struct ipc4_message_request *ipc4)
 #endif
 }
 
+#if CONFIG_IPC4_BATCH
+static int ipc4_process_batch(struct ipc4_message_request *ipc4);
+#endif
+
 static int ipc4_process_glb_message(struct ipc4_message_request *ipc4)
 {
 	uint32_t type;
@@ -859,6 +877,12 @@ static int ipc4_process_glb_message(struct ipc4_message_request *ipc4)
 		ret = ipc4_process_ipcgtw_cmd(ipc4);
 		break;
 
+#if CONFIG_IPC4_BATCH
+	case SOF_IPC4_GLB_BATCH:
+		ret = ipc4_process_batch(ipc4);
+		break;
+#endif
+
 	default:
 		ipc_cmd_err(&ipc_tr, "unsupported ipc message type %d", type);
 		ret = IPC4_UNAVAILABLE;
@@ -876,7 +900,7 @@ static int ipc4_process_glb_message(struct ipc4_message_request *ipc4)
  * delete module <-------> free component
  */
 
-__cold static int ipc4_init_module_instance(struct ipc4_message_request *ipc4)
+__cold static int ipc4_init_module_instance(struct ipc4_message_request *ipc4, char *data)
 {
 	struct ipc4_module_init_instance module_init;
 	struct comp_dev *dev;
@@ -895,7 +919,7 @@ __cold static int ipc4_init_module_instance(struct ipc4_message_request *ipc4)
 	if (!cpu_is_me(module_init.extension.r.core_id))
 		return ipc4_process_on_core(module_init.extension.r.core_id, false);
 
-	dev = comp_new_ipc4(&module_init);
+	dev = comp_new_ipc4(&module_init, data);
 	if (!dev) {
 		ipc_cmd_err(&ipc_tr, "error: failed to init module %x : %x",
 			    (uint32_t)module_init.primary.r.module_id,
@@ -1186,7 +1210,8 @@ static int ipc4_set_vendor_config_module_instance(struct comp_dev *dev,
 					 data_off_size, data);
 }
 
-static int ipc4_set_large_config_module_instance(struct ipc4_message_request *ipc4)
+static int ipc4_set_large_config_module_instance(struct ipc4_message_request *ipc4,
+						 const char *data)
 {
 	struct ipc4_module_large_config config;
 	struct comp_dev *dev = NULL;
@@ -1232,14 +1257,8 @@ static int ipc4_set_large_config_module_instance(struct ipc4_message_request *ip
 							     config.extension.r.init_block,
 							     config.extension.r.final_block,
 							     config.extension.r.data_off_size,
-							     (const char *)MAILBOX_HOSTBOX_BASE);
+							     data);
 	} else {
-#if CONFIG_LIBRARY
-		struct ipc *ipc = ipc_get();
-		const char *data = (const char *)ipc->comp_data + sizeof(config);
-#else
-		const char *data = (const char *)MAILBOX_HOSTBOX_BASE;
-#endif
 		ret = drv->ops.set_large_config(dev, config.extension.r.large_param_id,
 			config.extension.r.init_block, config.extension.r.final_block,
 			config.extension.r.data_off_size, data);
@@ -1403,13 +1422,15 @@ static int ipc4_module_process_dx(struct ipc4_message_request *ipc4)
 static int ipc4_process_module_message(struct ipc4_message_request *ipc4)
 {
 	uint32_t type;
+	char *data;
 	int ret;
 
 	type = ipc4->primary.r.type;
 
 	switch (type) {
 	case SOF_IPC4_MOD_INIT_INSTANCE:
-		ret = ipc4_init_module_instance(ipc4);
+		data = ipc4_get_msg_data(sizeof(struct ipc4_module_init_instance));
+		ret = ipc4_init_module_instance(ipc4, data);
 		break;
 	case SOF_IPC4_MOD_CONFIG_GET:
 	case SOF_IPC4_MOD_CONFIG_SET:
@@ -1420,7 +1441,8 @@ static int ipc4_process_module_message(struct ipc4_message_request *ipc4)
 		ret = ipc4_get_large_config_module_instance(ipc4);
 		break;
 	case SOF_IPC4_MOD_LARGE_CONFIG_SET:
-		ret = ipc4_set_large_config_module_instance(ipc4);
+		data = ipc4_get_msg_data(sizeof(struct ipc4_module_large_config));
+		ret = ipc4_set_large_config_module_instance(ipc4, data);
 		break;
 	case SOF_IPC4_MOD_BIND:
 		ret = ipc4_bind_module_instance(ipc4);
@@ -1449,6 +1471,151 @@ static int ipc4_process_module_message(struct ipc4_message_request *ipc4)
 	return ret;
 }
 
+#if CONFIG_IPC4_BATCH
+/* status of each operation of the batch until the reply */
+static uint32_t batch_status[CONFIG_IPC4_BATCH_MAX_OPS];
+
+/* The operations of a batch are executed on the core that received it and
+ * never forwarded, forwarding would pass the whole batch message.
+ */
+static int ipc4_process_batch_op(struct ipc4_message_request *msg, char *data,
+				 uint32_t data_size)
+{
+	const struct ipc4_pipeline_create *ppl;
+	const struct ipc4_module_init_instance *init;
+	const struct ipc4_module_bind_unbind *bu;
+	const struct ipc4_module_large_config *config;
+	struct comp_dev *sink;
+	struct comp_dev *dev;
+
+	if (msg->primary.r.msg_tgt == SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG) {
+		if (msg->primary.r.type != SOF_IPC4_GLB_CREATE_PIPELINE)
+			return IPC4_INVALID_REQUEST;
+
+		ppl = (const struct ipc4_pipeline_create *)msg;
+		if (!cpu_is_me(ppl->extension.r.core_id))
+			return IPC4_INVALID_CORE_ID;
+
+		return ipc4_new_pipeline(msg);
+	}
+
+	switch (msg->primary.r.type) {
+	case SOF_IPC4_MOD_INIT_INSTANCE:
+		init = (const struct ipc4_module_init_instance *)msg;
+		if (init->extension.r.param_block_size * sizeof(uint32_t) > data_size)
+			return IPC4_INVALID_CONFIG_DATA_LEN;
+
+		if (!cpu_is_me(init->extension.r.core_id))
+			return IPC4_INVALID_CORE_ID;
+
+		return ipc4_init_module_instance(msg, data);
+	case SOF_IPC4_MOD_BIND:
+	case SOF_IPC4_MOD_UNBIND:
+		/* as in ipc_comp_connect() and ipc_comp_disconnect() a cross
+		 * core bind is done on this core, only a bind of two modules
+		 * of another core would need to be forwarded
+		 */
+		bu = (const struct ipc4_module_bind_unbind *)msg;
+		dev = ipc4_get_comp_dev(IPC4_COMP_ID(bu->primary.r.module_id,
+						     bu->primary.r.instance_id));
+		sink = ipc4_get_comp_dev(IPC4_COMP_ID(bu->extension.r.dst_module_id,
+						      bu->extension.r.dst_instance_id));
+		if (dev && sink && dev->ipc_config.core == sink->ipc_config.core &&
+		    !cpu_is_me(dev->ipc_config.core))
+			return IPC4_INVALID_CORE_ID;
+
+		if (msg->primary.r.type == SOF_IPC4_MOD_BIND)
+			return ipc4_bind_module_instance(msg);
+
+		return ipc4_unbind_module_instance(msg);
+	case SOF_IPC4_MOD_LARGE_CONFIG_SET:
+		/* only single block configs, the data of all fits the mailbox */
+		config = (const struct ipc4_module_large_config *)msg;
+		if (!config->extension.r.init_block || !config->extension.r.final_block ||
+		    config->extension.r.data_off_size > data_size)
+			return IPC4_INVALID_CONFIG_DATA_LEN;
+
+		if (config->primary.r.module_id) {
+			dev = ipc4_get_comp_dev(IPC4_COMP_ID(config->primary.r.module_id,
+							     config->primary.r.instance_id));
+			if (dev && !cpu_is_me(dev->ipc_config.core))
+				return IPC4_INVALID_CORE_ID;
+		}
+
+		return ipc4_set_large_config_module_instance(msg, data);
+	default:
+		return IPC4_INVALID_REQUEST;
+	}
+}
+
+static int ipc4_process_batch(struct ipc4_message_request *ipc4)
+{
+	struct ipc *ipc = ipc_get();
+	struct ipc4_batch batch;
+	struct ipc4_batch_op op;
+	char *data = ipc4_get_msg_data(sizeof(batch));
+	char *reply_data = ipc->comp_data;
+	uint32_t data_size;
+	uint32_t offset = 0;
+	uint32_t i;
+	int ret = memcpy_s(&batch, sizeof(batch), ipc4, sizeof(*ipc4));
+
+	if (ret < 0)
+		return IPC4_FAILURE;
+
+	data_size = batch.extension.r.data_size;
+	if (!batch.primary.r.num_ops || batch.primary.r.num_ops > ARRAY_SIZE(batch_status) ||
+	    data_size > MAILBOX_HOSTBOX_SIZE) {
+		ipc_cmd_err(&ipc_tr, "ipc4: invalid batch of %u ops in %u bytes",
+			    (uint32_t)batch.primary.r.num_ops, data_size);
+		return IPC4_ERROR_INVALID_PARAM;
+	}
+
+	dcache_invalidate_region((__sparse_force void __sparse_cache *)MAILBOX_HOSTBOX_BASE,
+				 data_size);
+
+	/* execute the operations in order until one fails */
+	for (i = 0; i < batch.primary.r.num_ops; i++) {
+		if (offset + sizeof(op) > data_size) {
+			ret = IPC4_INVALID_CONFIG_DATA_LEN;
+		} else {
+			memcpy_s(&op, sizeof(op), data + offset, sizeof(op));
+			offset += sizeof(op);
+			if (op.data_size % sizeof(uint32_t) || op.data_size > data_size - offset)
+				ret = IPC4_INVALID_CONFIG_DATA_LEN;
+			else
+				ret = ipc4_process_batch_op(&op.msg, data + offset, op.data_size);
+
+			offset += op.data_size;
+		}
+
+		batch_status[i] = ret;
+		if (ret) {
+			ipc_cmd_err(&ipc_tr, "ipc4: batch op %u failed with err %d", i, ret);
+			i++;
+			break;
+		}
+	}
+
+#if CONFIG_LIBRARY
+	/* the reply header is copied to the start, as for large config get */
+	reply_data += sizeof(struct ipc4_message_reply);
+#endif
+
+	/* reply with the number of executed operations and their statuses */
+	msg_reply.extension = i;
+	ret = memcpy_s(reply_data, SOF_IPC_MSG_MAX_SIZE - (reply_data - (char *)ipc->comp_data),
+		       batch_status, i * sizeof(batch_status[0]));
+	if (ret < 0)
+		return IPC4_FAILURE;
+
+	msg_reply.tx_data = reply_data;
+	msg_reply.tx_size = i * sizeof(batch_status[0]);
+
+	return batch_status[i - 1];
+}
+#endif /* CONFIG_IPC4_BATCH */
+
 struct ipc_cmd_hdr *mailbox_validate(void)
 {
 	struct ipc_cmd_hdr *hdr = ipc_get()->comp_data;
@@ -83,32 +83,18 @@ void ipc_build_trace_posn(struct sof_ipc_dma_trace_posn *posn)
 }
 
 #if CONFIG_LIBRARY
-static inline char *ipc4_get_comp_new_data(void)
-{
-	struct ipc *ipc = ipc_get();
-	char *data = (char *)ipc->comp_data + sizeof(struct ipc4_module_init_instance);
-
-	return data;
-}
-
 static const struct comp_driver *ipc4_library_get_comp_drv(char *data)
 {
 	return ipc4_get_drv(data);
 }
-#else
-static inline char *ipc4_get_comp_new_data(void)
-{
-	return (char *)MAILBOX_HOSTBOX_BASE;
-}
 #endif
 
-__cold struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init)
+__cold struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init, char *data)
 {
 	struct comp_ipc_config ipc_config;
 	const struct comp_driver *drv;
 	struct comp_dev *dev;
 	uint32_t comp_id;
-	char *data;
 
 	comp_id = IPC4_COMP_ID(module_init->primary.r.module_id,
 			       module_init->primary.r.instance_id);
@@ -132,8 +118,6 @@ __cold struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_i
 	dcache_invalidate_region((__sparse_force void __sparse_cache *)MAILBOX_HOSTBOX_BASE,
 				 MAILBOX_HOSTBOX_SIZE);
 
-	data = ipc4_get_comp_new_data();
-
 #if CONFIG_LIBRARY
 	ipc_config.ipc_config_size -= sizeof(struct sof_uuid);
 	drv = ipc4_library_get_comp_drv(data + ipc_config.ipc_config_size);
@@ -455,6 +439,19 @@ static int ll_wait_finished_on_core(struct comp_dev *dev)
 
 #endif
 
+#if CONFIG_ZEPHYR_DP_SCHEDULER
+/* checks if DP work stealing may run the module of the component on other cores */
+static bool ipc_comp_dp_stealable(struct comp_dev *dev)
+{
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	return dev->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP &&
+	       comp_mod(dev)->dp_stealable;
+#else
+	return false;
+#endif
+}
+#endif
+
 int ipc_comp_connect(struct ipc *ipc, ipc_pipe_comp_connect *_connect)
 {
 	struct ipc4_module_bind_unbind *bu;
@@ -575,12 +572,14 @@ int ipc_comp_connect(struct ipc *ipc, ipc_pipe_comp_connect *_connect)
 
 	if (sink->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP ||
 	    source->ipc_config.proc_domain == COMP_PROCESSING_DOMAIN_DP) {
+		/* a DP module that work stealing may run on any core needs shared buffers */
+		bool shared = audio_buffer_is_shared(&buffer->audio_buffer) ||
+			      ipc_comp_dp_stealable(sink) || ipc_comp_dp_stealable(source);
 		struct sof_source *source = audio_buffer_get_source(&buffer->audio_buffer);
 		struct sof_sink *sink = audio_buffer_get_sink(&buffer->audio_buffer);
 
 		ring_buffer = ring_buffer_create(source_get_min_available(source),
-						 sink_get_min_free_space(sink),
-						 audio_buffer_is_shared(&buffer->audio_buffer),
+						 sink_get_min_free_space(sink), shared,
 						 buf_get_id(buffer));
 		if (!ring_buffer)
 			goto free;
@@ -424,6 +424,215 @@ static void *get_ptr_from_heap(struct mm_heap *heap, uint32_t flags,
 	return ptr;
 }
 
+#if CONFIG_MM_SLAB
+/*
+ * Slabs hand out objects of one size from pages, which are single heap blocks
+ * of CONFIG_MM_SLAB_PAGE_SIZE. The block headers of pages are marked with
+ * BLOCK_USED_SLAB, so free_block() can tell slab objects from plain blocks.
+ * Free objects of a page are linked through their first word.
+ *
+ * Any core may free an object to the slab of another core, under the heap
+ * lock like every other rfree(). Page headers and slot links are therefore
+ * only ever accessed through the uncached alias, so that no core works on a
+ * stale copy of them or leaves dirty lines behind on top of them.
+ */
+#define BLOCK_USED_SLAB		2
+
+struct mm_slab_page {
+	struct list_item list;	/* in mm_slab.partial while it has free slots */
+	struct mm_slab *slab;	/* owner */
+	void *free;		/* first free slot */
+	uint16_t used;		/* slots handed out */
+	uint16_t count;		/* slots in the page */
+};
+
+#define MM_SLAB_PAGE_HDR ALIGN_UP_COMPILE(sizeof(struct mm_slab_page), MM_SLAB_ALIGN)
+
+STATIC_ASSERT(CONFIG_MM_SLAB_MAX_SIZE >= MM_SLAB_ALIGN, mm_slab_max_size_too_small);
+STATIC_ASSERT(CONFIG_MM_SLAB_PAGE_SIZE >= 2 * CONFIG_MM_SLAB_MAX_SIZE,
+	      mm_slab_page_too_small);
+
+static inline struct mm_slab_page *slab_page_get(void *page)
+{
+	return cache_to_uncache(page);
+}
+
+static inline void **slab_link(void *obj)
+{
+	return cache_to_uncache(obj);
+}
+
+static void init_slabs(struct mm *memmap)
+{
+	struct mm_slab *slab;
+	int core, zone, i;
+
+	for (core = 0; core < CONFIG_CORE_COUNT; core++)
+		for (zone = 0; zone < MM_SLAB_ZONES; zone++)
+			for (i = 0; i < MM_SLAB_CLASSES; i++) {
+				slab = &memmap->slab[core][zone][i];
+				list_init(&slab->partial);
+				slab->obj_size = (i + 1) * MM_SLAB_ALIGN;
+			}
+}
+
+static struct mm_slab *get_slab(enum mem_zone zone, uint32_t caps, size_t bytes)
+{
+	struct mm *memmap = memmap_get();
+	int index;
+
+	if (!bytes || bytes > MM_SLAB_CLASSES * MM_SLAB_ALIGN || caps != SOF_MEM_CAPS_RAM)
+		return NULL;
+
+	switch (zone) {
+	case SOF_MEM_ZONE_RUNTIME:
+		index = 0;
+		break;
+	case SOF_MEM_ZONE_RUNTIME_SHARED:
+		index = 1;
+		break;
+	default:
+		return NULL;
+	}
+
+	return &memmap->slab[cpu_get_id()][index][(bytes - 1) / MM_SLAB_ALIGN];
+}
+
+static struct mm_heap *get_slab_heap(enum mem_zone zone)
+{
+	struct mm *memmap = memmap_get();
+
+#if CONFIG_CORE_COUNT > 1
+	if (zone == SOF_MEM_ZONE_RUNTIME_SHARED)
+		return get_heap_from_caps(memmap->runtime_shared, PLATFORM_HEAP_RUNTIME_SHARED,
+					  SOF_MEM_CAPS_RAM);
+#endif
+
+	return get_heap_from_caps(memmap->runtime, PLATFORM_HEAP_RUNTIME, SOF_MEM_CAPS_RAM);
+}
+
+static struct mm_slab_page *slab_page_new(struct mm_slab *slab, enum mem_zone zone,
+					  uint32_t flags)
+{
+	struct mm_heap *heap = get_slab_heap(zone);
+	struct mm_slab_page *page;
+	struct block_map *map;
+	char *base;
+	char *obj;
+	int i;
+
+	if (!heap)
+		return NULL;
+
+	base = get_ptr_from_heap(heap, flags, SOF_MEM_CAPS_RAM, CONFIG_MM_SLAB_PAGE_SIZE,
+				 PLATFORM_DCACHE_ALIGN);
+	if (!base)
+		return NULL;
+
+	page = slab_page_get(base);
+
+	/* mark the block, pages are always single blocks */
+	for (i = 0; i < heap->blocks; i++) {
+		map = &heap->map[i];
+		if ((uint32_t)page < map->base + map->block_size * map->count) {
+			map->block[((uint32_t)page - map->base) / map->block_size].used =
+				BLOCK_USED_SLAB;
+			break;
+		}
+	}
+
+	page->slab = slab;
+	page->used = 0;
+	page->count = (CONFIG_MM_SLAB_PAGE_SIZE - MM_SLAB_PAGE_HDR) / slab->obj_size;
+	page->free = NULL;
+
+	/*
+	 * link the slots so that they are handed out in address order, slots
+	 * keep the alias of the heap for the users
+	 */
+	obj = base + MM_SLAB_PAGE_HDR + (page->count - 1) * slab->obj_size;
+	for (i = 0; i < page->count; i++, obj -= slab->obj_size) {
+		*slab_link(obj) = page->free;
+		page->free = obj;
+	}
+
+	slab->info.pages++;
+	slab->info.objs_total += page->count;
+
+	return page;
+}
+
+static void *slab_alloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
+{
+	struct mm_slab *slab = get_slab(zone, caps, bytes);
+	struct mm_slab_page *page;
+	void *obj;
+
+	if (!slab)
+		return NULL;
+
+	if (list_is_empty(&slab->partial)) {
+		page = slab_page_new(slab, zone, flags);
+		if (!page) {
+			slab->info.fallbacks++;
+			return NULL;
+		}
+		list_item_prepend(&page->list, &slab->partial);
+	} else {
+		page = list_first_item(&slab->partial, struct mm_slab_page, list);
+	}
+
+	obj = page->free;
+	page->free = *slab_link(obj);
+
+	if (++page->used == page->count)
+		list_item_del(&page->list);
+
+	slab->info.allocs++;
+	if (++slab->info.objs_used > slab->info.objs_peak)
+		slab->info.objs_peak = slab->info.objs_used;
+
+	return obj;
+}
+
+/*
+ * Returns an object to its slab. Returns the page if it became empty and
+ * goes back to the heap, NULL otherwise.
+ */
+static void *slab_free(struct block_hdr *hdr, void *ptr, void *free_ptr)
+{
+	void *base = (void *)ALIGN_UP((uintptr_t)hdr->unaligned_ptr, PLATFORM_DCACHE_ALIGN);
+	struct mm_slab_page *page = slab_page_get(base);
+	struct mm_slab *slab = page->slab;
+
+	/* the object may be handed out on another core next, see free_block() */
+	dcache_writeback_invalidate_region(ptr, slab->obj_size);
+
+	*slab_link(free_ptr) = page->free;
+	page->free = free_ptr;
+	slab->info.objs_used--;
+
+	/* pages with most slots in use go first, to let others drain */
+	if (page->used-- == page->count)
+		list_item_prepend(&page->list, &slab->partial);
+
+	if (page->used)
+		return NULL;
+
+	list_item_del(&page->list);
+	slab->info.pages--;
+	slab->info.objs_total -= page->count;
+	hdr->used = 1;
+
+	return base;
+}
+#else
+static inline void *slab_alloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t bytes)
+{
+	return NULL;
+}
+#endif
+
 /* free block(s) */
 static void free_block(void *ptr)
 {
@@ -478,6 +687,17 @@ static void free_block(void *ptr)
 
 	hdr = &block_map->block[block];
 
+#if CONFIG_MM_SLAB
+	if (hdr->used == BLOCK_USED_SLAB) {
+		free_ptr = slab_free(hdr, ptr, free_ptr);
+		if (!free_ptr)
+			return;
+
+		/* release the whole page */
+		ptr = free_ptr;
+	}
+#endif
+
 	/* bring back original unaligned pointer position
 	 * and calculate correct hdr for free operation (it could
 	 * be from different block since we got user pointer here
@@ -563,6 +783,28 @@ void heap_trace(struct mm_heap *heap, int size)
 	}
 }
 
+#if CONFIG_MM_SLAB
+static void slab_trace(struct mm *memmap)
+{
+	struct mm_slab *slab;
+	int core, zone, i;
+
+	for (core = 0; core < CONFIG_CORE_COUNT; core++)
+		for (zone = 0; zone < MM_SLAB_ZONES; zone++)
+			for (i = 0; i < MM_SLAB_CLASSES; i++) {
+				slab = &memmap->slab[core][zone][i];
+				if (!slab->info.allocs && !slab->info.fallbacks)
+					continue;
+
+				tr_info(&mem_tr, " slab: core %d zone %d %d Bytes objects, pages %d",
+					core, zone, slab->obj_size, slab->info.pages);
+				tr_info(&mem_tr, "   Number of objects: total %d used %d peak %d fallbacks %d",
+					slab->info.objs_total, slab->info.objs_used,
+					slab->info.objs_peak, slab->info.fallbacks);
+			}
+}
+#endif
+
 void heap_trace_all(int force)
 {
 	struct mm *memmap = memmap_get();
@@ -582,6 +824,10 @@ void heap_trace_all(int force)
 		heap_trace(memmap->runtime_shared, PLATFORM_HEAP_RUNTIME_SHARED);
 		tr_info(&mem_tr, "heap: system shared status");
 		heap_trace(memmap->system_shared, PLATFORM_HEAP_SYSTEM_SHARED);
+#endif
+#if CONFIG_MM_SLAB
+		tr_info(&mem_tr, "heap: slab status");
+		slab_trace(memmap);
 #endif
 	}
 
@@ -683,7 +929,11 @@ static void *_malloc_unlocked(enum mem_zone zone, uint32_t flags, uint32_t caps,
 			      size_t bytes)
 {
 	struct mm *memmap = memmap_get();
-	void *ptr = NULL;
+	void *ptr;
+
+	ptr = slab_alloc(zone, flags, caps, bytes);
+	if (ptr)
+		goto out;
 
 	switch (zone) {
 	case SOF_MEM_ZONE_SYS:
@@ -717,6 +967,7 @@ static void *_malloc_unlocked(enum mem_zone zone, uint32_t flags, uint32_t caps,
 		break;
 	}
 
+out:
 #if CONFIG_DEBUG_BLOCK_FREE
 	if (ptr)
 		bzero(ptr, bytes);
@@ -1057,6 +1308,10 @@ void init_heap(struct sof *sof)
 
 	init_heap_map(memmap->buffer, PLATFORM_HEAP_BUFFER);
 
+#if CONFIG_MM_SLAB
+	init_slabs(memmap);
+#endif
+
 #if CONFIG_DEBUG_BLOCK_FREE
 	write_pattern((struct mm_heap *)&memmap->buffer, PLATFORM_HEAP_BUFFER,
 		      DEBUG_BLOCK_FREE_VALUE_8BIT);
@@ -1124,3 +1379,44 @@ error:
 	return -EINVAL;
 }
 #endif
+
+#if CONFIG_MM_SLAB
+int heap_slab_info(enum mem_zone zone, int core, struct mm_slab_info *out)
+{
+	struct mm *memmap = memmap_get();
+	struct mm_slab_info *info;
+	k_spinlock_key_t key;
+	int index;
+	int i;
+
+	switch (zone) {
+	case SOF_MEM_ZONE_RUNTIME:
+		index = 0;
+		break;
+	case SOF_MEM_ZONE_RUNTIME_SHARED:
+		index = 1;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	if (!out || core < 0 || core >= CONFIG_CORE_COUNT)
+		return -EINVAL;
+
+	memset(out, 0, sizeof(*out));
+
+	key = k_spin_lock(&memmap->lock);
+	for (i = 0; i < MM_SLAB_CLASSES; i++) {
+		info = &memmap->slab[core][index][i].info;
+		out->pages += info->pages;
+		out->objs_total += info->objs_total;
+		out->objs_used += info->objs_used;
+		out->objs_peak += info->objs_peak;
+		out->allocs += info->allocs;
+		out->fallbacks += info->fallbacks;
+	}
+	k_spin_unlock(&memmap->lock, key);
+
+	return 0;
+}
+#endif
@@ -10,8 +10,6 @@
 #include <sof/math/fft.h>
 
 #ifdef FFT_GENERIC
-#include <sof/audio/coefficients/fft/twiddle_16.h>
-
 /*
  * Helpers for 16 bit FFT calculation
  */
@@ -100,8 +98,9 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
-		icomplex16_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
+	for (i = 0; i < plan->size; ++i)
+		icomplex16_shift(&inb[i], -(plan->len),
+				 &outb[plan->bit_reverse_idx[i] >> plan->bit_reverse_shift]);
 
 	/* step 2: loop to do FFT transform in smaller size */
 	for (depth = 1; depth <= plan->len; ++depth) {
@@ -116,8 +115,8 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 				index = i * j;
 				top = k + j;
 				bottom = top + n;
-				tmp1.real = twiddle_real_16[index];
-				tmp1.imag = twiddle_imag_16[index];
+				tmp1.real = plan->twiddle_real_16[index];
+				tmp1.imag = plan->twiddle_imag_16[index];
 				/* calculate the accumulator: twiddle * bottom */
 				icomplex16_mul(&tmp1, &outb[bottom], &tmp2);
 				tmp1 = outb[top];
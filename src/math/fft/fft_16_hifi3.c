@@ -9,7 +9,6 @@
 #include <sof/math/fft.h>
 
 #ifdef FFT_HIFI3
-#include <sof/audio/coefficients/fft/twiddle_16.h>
 #include <xtensa/tie/xt_hifi3.h>
 
 /**
@@ -54,9 +53,9 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	in = (ae_int16 *)&plan->inb16[1];
-	for (i = 1; i < size ; ++i) {
-		out = (ae_int16 *)&outb[plan->bit_reverse_idx[i]];
+	in = (ae_int16 *)plan->inb16;
+	for (i = 0; i < size ; ++i) {
+		out = (ae_int16 *)&outb[plan->bit_reverse_idx[i] >> plan->bit_reverse_shift];
 		AE_L16_IP(sample, in, 2);
 		sample = AE_SRAA16RS(sample, len);
 		AE_S16_0_IP(sample, out, 2);
@@ -81,8 +80,8 @@ void fft_execute_16(struct fft_plan *plan, bool ifft)
 				bottom = top + n;
 				/* store twiddle and bottom as Q9.23*/
 				temp1 = AE_CVTP24A16X2_LL(outb[bottom].real, outb[bottom].imag);
-				temp2 = AE_CVTP24A16X2_LL(twiddle_real_16[index],
-							  twiddle_imag_16[index]);
+				temp2 = AE_CVTP24A16X2_LL(plan->twiddle_real_16[index],
+							  plan->twiddle_imag_16[index]);
 				/* calculate the accumulator: twiddle * bottom */
 				res = AE_MULFC24RA(temp1, temp2);
 				/* saturate and round the result to 16bit and put it in
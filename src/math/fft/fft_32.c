@@ -8,11 +8,10 @@
 #include <sof/audio/format.h>
 #include <sof/common.h>
 #include <rtos/alloc.h>
+#include <rtos/symbol.h>
 #include <sof/math/fft.h>
 
 #ifdef FFT_GENERIC
-#include <sof/audio/coefficients/fft/twiddle_32.h>
-
 /*
  * These helpers are optimized for FFT calculation only.
  * e.g. _add/sub() assume the output won't be saturate so no check needed,
@@ -97,8 +96,9 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	}
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
-	for (i = 1; i < plan->size; ++i)
-		icomplex32_shift(&inb[i], -(plan->len), &outb[plan->bit_reverse_idx[i]]);
+	for (i = 0; i < plan->size; ++i)
+		icomplex32_shift(&inb[i], -(plan->len),
+				 &outb[plan->bit_reverse_idx[i] >> plan->bit_reverse_shift]);
 
 	/* step 2: loop to do FFT transform in smaller size */
 	for (depth = 1; depth <= plan->len; ++depth) {
@@ -113,8 +113,8 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 				index = i * j;
 				top = k + j;
 				bottom = top + n;
-				tmp1.real = twiddle_real_32[index];
-				tmp1.imag = twiddle_imag_32[index];
+				tmp1.real = plan->twiddle_real_32[index];
+				tmp1.imag = plan->twiddle_imag_32[index];
 				/* calculate the accumulator: twiddle * bottom */
 				icomplex32_mul(&tmp1, &outb[bottom], &tmp2);
 				tmp1 = outb[top];
@@ -137,5 +137,6 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 			icomplex32_shift(&outb[i], plan->len, &outb[i]);
 	}
 }
+EXPORT_SYMBOL(fft_execute_32);
 
 #endif
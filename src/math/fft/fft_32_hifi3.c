@@ -7,10 +7,10 @@
 #include <sof/audio/format.h>
 #include <sof/common.h>
 #include <rtos/alloc.h>
+#include <rtos/symbol.h>
 #include <sof/math/fft.h>
 
 #ifdef FFT_HIFI3
-#include <sof/audio/coefficients/fft/twiddle_32.h>
 #include <xtensa/tie/xt_hifi3.h>
 
 void fft_execute_32(struct fft_plan *plan, bool ifft)
@@ -39,7 +39,7 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 	if (!plan->inb32 || !plan->outb32)
 		return;
 
-	inx = (ae_int32x2 *)plan->inb32 + 1;
+	inx = (ae_int32x2 *)plan->inb32;
 	outx = (ae_int32x2 *)plan->outb32;
 
 	/* convert to complex conjugate for ifft */
@@ -54,10 +54,10 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 
 	/* step 1: re-arrange input in bit reverse order, and shrink the level to avoid overflow */
 	inu = AE_LA64_PP(inx);
-	for (i = 1; i < size; ++i) {
+	for (i = 0; i < size; ++i) {
 		AE_LA32X2_IP(sample, inu, inx);
 		sample = AE_SRAA32S(sample, len);
-		out = &outx[plan->bit_reverse_idx[i]];
+		out = &outx[plan->bit_reverse_idx[i] >> plan->bit_reverse_shift];
 		AE_SA32X2_IP(sample, outu, out);
 	}
 	AE_SA64POS_FP(outu, out);
@@ -75,8 +75,8 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 				index = i * j;
 				top = k + j;
 				bottom = top + n;
-				tmp1.real = twiddle_real_32[index];
-				tmp1.imag = twiddle_imag_32[index];
+				tmp1.real = plan->twiddle_real_32[index];
+				tmp1.imag = plan->twiddle_imag_32[index];
 				inx = (ae_int32x2 *)&tmp1;
 				AE_LA32X2_IP(sample1, inu, inx);
 				/* calculate the accumulator: twiddle * bottom */
@@ -117,4 +117,5 @@ void fft_execute_32(struct fft_plan *plan, bool ifft)
 		AE_SA64POS_FP(outu, outx);
 	}
 }
+EXPORT_SYMBOL(fft_execute_32);
 #endif
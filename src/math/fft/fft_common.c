@@ -8,19 +8,88 @@
 #include <sof/audio/buffer.h>
 #include <sof/audio/format.h>
 #include <sof/common.h>
+#include <sof/lib/fast-get.h>
+#include <sof/lib/memory.h>
 #include <rtos/alloc.h>
+#include <rtos/symbol.h>
 #include <sof/math/fft.h>
+#include <errno.h>
+#include <sof/audio/coefficients/fft/bit_reverse.h>
+#if CONFIG_MATH_16BIT_FFT
+#include <sof/audio/coefficients/fft/twiddle_16.h>
+#endif
+#if CONFIG_MATH_32BIT_FFT
+#include <sof/audio/coefficients/fft/twiddle_32.h>
+#endif
+
+#if CONFIG_FAST_GET
+static void fft_put_tables(struct fft_plan *plan)
+{
+	if (plan->bit_reverse_idx)
+		fast_put(plan->bit_reverse_idx);
+	if (plan->twiddle_real_16)
+		fast_put(plan->twiddle_real_16);
+	if (plan->twiddle_imag_16)
+		fast_put(plan->twiddle_imag_16);
+	if (plan->twiddle_real_32)
+		fast_put(plan->twiddle_real_32);
+	if (plan->twiddle_imag_32)
+		fast_put(plan->twiddle_imag_32);
+}
+
+#define fft_get_table(table)	fast_get(table, sizeof(table))
+#else
+#define fft_put_tables(plan)
+#define fft_get_table(table)	(table)
+#endif
+
+static int fft_get_tables(struct fft_plan *plan, int bits)
+{
+	plan->bit_reverse_idx = fft_get_table(fft_bit_reverse_idx);
+	if (!plan->bit_reverse_idx)
+		return -ENOMEM;
+
+	switch (bits) {
+#if CONFIG_MATH_16BIT_FFT
+	case 16:
+		plan->twiddle_real_16 = fft_get_table(twiddle_real_16);
+		plan->twiddle_imag_16 = fft_get_table(twiddle_imag_16);
+		if (!plan->twiddle_real_16 || !plan->twiddle_imag_16)
+			return -ENOMEM;
+		return 0;
+#endif
+#if CONFIG_MATH_32BIT_FFT
+	case 32:
+		plan->twiddle_real_32 = fft_get_table(twiddle_real_32);
+		plan->twiddle_imag_32 = fft_get_table(twiddle_imag_32);
+		if (!plan->twiddle_real_32 || !plan->twiddle_imag_32)
+			return -ENOMEM;
+		return 0;
+#endif
+	default:
+		return -EINVAL;
+	}
+}
 
 struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
 {
 	struct fft_plan *plan;
 	int lim = 1;
 	int len = 0;
-	int i;
 
 	if (!inb || !outb)
 		return NULL;
 
+	/* calculate the exponent of 2 */
+	while (lim < size) {
+		lim <<= 1;
+		len++;
+	}
+
+	/* the shared tables are for sizes up to FFT_SIZE_MAX */
+	if (lim > FFT_SIZE_MAX)
+		return NULL;
+
 	plan = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(struct fft_plan));
 	if (!plan)
 		return NULL;
@@ -39,35 +108,26 @@ struct fft_plan *fft_plan_new(void *inb, void *outb, uint32_t size, int bits)
 		return NULL;
 	}
 
-	/* calculate the exponent of 2 */
-	while (lim < size) {
-		lim <<= 1;
-		len++;
-	}
-
 	plan->size = lim;
 	plan->len = len;
+	plan->bit_reverse_shift = FFT_SIZE_MAX_LEN - len;
 
-	plan->bit_reverse_idx = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
-					plan->size * sizeof(uint16_t));
-	if (!plan->bit_reverse_idx) {
+	if (fft_get_tables(plan, bits) < 0) {
+		fft_put_tables(plan);
 		rfree(plan);
 		return NULL;
 	}
 
-	/* set up the bit reverse index */
-	for (i = 1; i < plan->size; ++i)
-		plan->bit_reverse_idx[i] = (plan->bit_reverse_idx[i >> 1] >> 1) |
-					   ((i & 1) << (len - 1));
-
 	return plan;
 }
+EXPORT_SYMBOL(fft_plan_new);
 
 void fft_plan_free(struct fft_plan *plan)
 {
 	if (!plan)
 		return;
 
-	rfree(plan->bit_reverse_idx);
+	fft_put_tables(plan);
 	rfree(plan);
 }
+EXPORT_SYMBOL(fft_plan_free);
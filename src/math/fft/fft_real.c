@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <rtos/alloc.h>
+#include <rtos/symbol.h>
+#include <sof/math/fft.h>
+#include <ipc/topology.h>
+
+/*
+ * The N real samples are transformed as M = N / 2 complex samples
+ * z[n] = x[2n] + j * x[2n + 1]. With A = Z[k], B = conj(Z[M - k]) and the
+ * twiddle factor W^k = exp(-j * 2 * pi * k / N) of the real size, the
+ * spectrum is
+ *
+ *   X[k] = ((A + B) - j * W^k * (A - B)) / 2
+ *
+ * and X[M - k] is computed from the same pair. The inverse combines the even
+ * and odd sample spectra the opposite way into Z[k] before a complex IFFT.
+ */
+
+struct fft_real_plan *fft_real_plan_new(void *inb, void *outb, uint32_t size, int bits)
+{
+	struct fft_real_plan *plan;
+
+	/* the twiddle factors of the real size are from the shared tables */
+	if (size < 2 || size > FFT_SIZE_MAX || (size & (size - 1)))
+		return NULL;
+
+	plan = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, sizeof(struct fft_real_plan));
+	if (!plan)
+		return NULL;
+
+	plan->plan = fft_plan_new(inb, outb, size >> 1, bits);
+	if (!plan->plan) {
+		rfree(plan);
+		return NULL;
+	}
+
+	plan->size = size;
+	plan->len = plan->plan->len + 1;
+	return plan;
+}
+EXPORT_SYMBOL(fft_real_plan_new);
+
+void fft_real_plan_free(struct fft_real_plan *plan)
+{
+	if (!plan)
+		return;
+
+	fft_plan_free(plan->plan);
+	rfree(plan);
+}
+EXPORT_SYMBOL(fft_real_plan_free);
+
+#if CONFIG_MATH_16BIT_FFT
+/* Split the half size FFT output to bins 0 .. M */
+static void fft_real_split_16(struct fft_real_plan *plan)
+{
+	struct fft_plan *cplan = plan->plan;
+	struct icomplex16 *z = cplan->outb16;
+	const int step = FFT_SIZE_MAX >> plan->len;
+	const int m = cplan->size;
+	struct icomplex16 a;
+	struct icomplex16 b;
+	int32_t e_re, e_im;
+	int32_t o_re, o_im;
+	int32_t t_re, t_im;
+	int32_t w_re, w_im;
+	int idx = step;
+	int k;
+
+	a = z[0];
+	z[0].real = ((int32_t)a.real + a.imag) >> 1;
+	z[0].imag = 0;
+	z[m].real = ((int32_t)a.real - a.imag) >> 1;
+	z[m].imag = 0;
+
+	for (k = 1; k <= m >> 1; k++) {
+		a = z[k];
+		b = z[m - k];
+		/* E = A + B and O / 2 = (A - B) / 2, with B = conj(Z[M - k]) */
+		e_re = (int32_t)a.real + b.real;
+		e_im = (int32_t)a.imag - b.imag;
+		o_re = ((int32_t)a.real - b.real) >> 1;
+		o_im = ((int32_t)a.imag + b.imag) >> 1;
+
+		/* T = W^k * O */
+		w_re = cplan->twiddle_real_16[idx];
+		w_im = cplan->twiddle_imag_16[idx];
+		t_re = (w_re * o_re - w_im * o_im) >> 14;
+		t_im = (w_re * o_im + w_im * o_re) >> 14;
+		idx += step;
+
+		z[k].real = (e_re + t_im) >> 2;
+		z[k].imag = (e_im - t_re) >> 2;
+		z[m - k].real = (e_re - t_im) >> 2;
+		z[m - k].imag = (-e_im - t_re) >> 2;
+	}
+}
+
+/* Combine bins 0 .. M to the half size IFFT input, scaled by 1/2 */
+static void fft_real_merge_16(struct fft_real_plan *plan)
+{
+	struct fft_plan *cplan = plan->plan;
+	struct icomplex16 *x = cplan->inb16;
+	const int step = FFT_SIZE_MAX >> plan->len;
+	const int m = cplan->size;
+	struct icomplex16 a;
+	struct icomplex16 b;
+	int32_t e_re, e_im;
+	int32_t o_re, o_im;
+	int32_t t_re, t_im;
+	int32_t w_re, w_im;
+	int idx = 0;
+	int k;
+
+	for (k = 0; k <= m >> 1; k++) {
+		a = x[k];
+		b = x[m - k];
+		/* E / 2 and O / 2, with B = conj(X[M - k]) */
+		e_re = ((int32_t)a.real + b.real) >> 1;
+		e_im = ((int32_t)a.imag - b.imag) >> 1;
+		o_re = ((int32_t)a.real - b.real) >> 1;
+		o_im = ((int32_t)a.imag + b.imag) >> 1;
+
+		/* T / 2 = conj(W^k) * O / 2 */
+		w_re = cplan->twiddle_real_16[idx];
+		w_im = cplan->twiddle_imag_16[idx];
+		t_re = (w_re * o_re + w_im * o_im) >> 15;
+		t_im = (w_re * o_im - w_im * o_re) >> 15;
+		idx += step;
+
+		x[k].real = sat_int16(e_re - t_im);
+		x[k].imag = sat_int16(e_im + t_re);
+		if (k) {
+			x[m - k].real = sat_int16(e_re + t_im);
+			x[m - k].imag = sat_int16(t_re - e_im);
+		}
+	}
+}
+
+/**
+ * \brief Execute the 16-bits real input Fast Fourier Transform (FFT) or the
+ *	  inverse (IFFT) with real output for the configured fft_real_plan.
+ * \param[in] plan - pointer to fft_real_plan which will be executed.
+ * \param[in] ifft - set to 1 for IFFT and 0 for FFT.
+ */
+void fft_execute_real_16(struct fft_real_plan *plan, bool ifft)
+{
+	int16_t *y;
+	int i;
+
+	if (!plan || !plan->plan)
+		return;
+
+	if (!ifft) {
+		fft_execute_16(plan->plan, false);
+		fft_real_split_16(plan);
+		return;
+	}
+
+	fft_real_merge_16(plan);
+	fft_execute_16(plan->plan, true);
+
+	/* compensate the 1/2 scale of the merge, the complex IFFT output is
+	 * conjugated so the odd samples in the imaginary part are negated
+	 */
+	y = (int16_t *)plan->plan->outb16;
+	for (i = 0; i < plan->size; i += 2) {
+		y[i] = sat_int16((int32_t)y[i] << 1);
+		y[i + 1] = sat_int16(-((int32_t)y[i + 1] << 1));
+	}
+}
+EXPORT_SYMBOL(fft_execute_real_16);
+#endif /* CONFIG_MATH_16BIT_FFT */
+
+#if CONFIG_MATH_32BIT_FFT
+/* Split the half size FFT output to bins 0 .. M */
+static void fft_real_split_32(struct fft_real_plan *plan)
+{
+	struct fft_plan *cplan = plan->plan;
+	struct icomplex32 *z = cplan->outb32;
+	const int step = FFT_SIZE_MAX >> plan->len;
+	const int m = cplan->size;
+	struct icomplex32 a;
+	struct icomplex32 b;
+	int64_t e_re, e_im;
+	int64_t t_re, t_im;
+	int32_t o_re, o_im;
+	int32_t w_re, w_im;
+	int idx = step;
+	int k;
+
+	a = z[0];
+	z[0].real = ((int64_t)a.real + a.imag) >> 1;
+	z[0].imag = 0;
+	z[m].real = ((int64_t)a.real - a.imag) >> 1;
+	z[m].imag = 0;
+
+	for (k = 1; k <= m >> 1; k++) {
+		a = z[k];
+		b = z[m - k];
+		/* E = A + B and O / 2 = (A - B) / 2, with B = conj(Z[M - k]) */
+		e_re = (int64_t)a.real + b.real;
+		e_im = (int64_t)a.imag - b.imag;
+		o_re = ((int64_t)a.real - b.real) >> 1;
+		o_im = ((int64_t)a.imag + b.imag) >> 1;
+
+		/* T = W^k * O */
+		w_re = cplan->twiddle_real_32[idx];
+		w_im = cplan->twiddle_imag_32[idx];
+		t_re = ((int64_t)w_re * o_re - (int64_t)w_im * o_im) >> 30;
+		t_im = ((int64_t)w_re * o_im + (int64_t)w_im * o_re) >> 30;
+		idx += step;
+
+		z[k].real = (e_re + t_im) >> 2;
+		z[k].imag = (e_im - t_re) >> 2;
+		z[m - k].real = (e_re - t_im) >> 2;
+		z[m - k].imag = (-e_im - t_re) >> 2;
+	}
+}
+
+/* Combine bins 0 .. M to the half size IFFT input, scaled by 1/2 */
+static void fft_real_merge_32(struct fft_real_plan *plan)
+{
+	struct fft_plan *cplan = plan->plan;
+	struct icomplex32 *x = cplan->inb32;
+	const int step = FFT_SIZE_MAX >> plan->len;
+	const int m = cplan->size;
+	struct icomplex32 a;
+	struct icomplex32 b;
+	int64_t e_re, e_im;
+	int64_t t_re, t_im;
+	int32_t o_re, o_im;
+	int32_t w_re, w_im;
+	int idx = 0;
+	int k;
+
+	for (k = 0; k <= m >> 1; k++) {
+		a = x[k];
+		b = x[m - k];
+		/* E / 2 and O / 2, with B = conj(X[M - k]) */
+		e_re = ((int64_t)a.real + b.real) >> 1;
+		e_im = ((int64_t)a.imag - b.imag) >> 1;
+		o_re = ((int64_t)a.real - b.real) >> 1;
+		o_im = ((int64_t)a.imag + b.imag) >> 1;
+
+		/* T / 2 = conj(W^k) * O / 2 */
+		w_re = cplan->twiddle_real_32[idx];
+		w_im = cplan->twiddle_imag_32[idx];
+		t_re = ((int64_t)w_re * o_re + (int64_t)w_im * o_im) >> 31;
+		t_im = ((int64_t)w_re * o_im - (int64_t)w_im * o_re) >> 31;
+		idx += step;
+
+		x[k].real = sat_int32(e_re - t_im);
+		x[k].imag = sat_int32(e_im + t_re);
+		if (k) {
+			x[m - k].real = sat_int32(e_re + t_im);
+			x[m - k].imag = sat_int32(t_re - e_im);
+		}
+	}
+}
+
+/**
+ * \brief Execute the 32-bits real input Fast Fourier Transform (FFT) or the
+ *	  inverse (IFFT) with real output for the configured fft_real_plan.
+ * \param[in] plan - pointer to fft_real_plan which will be executed.
+ * \param[in] ifft - set to 1 for IFFT and 0 for FFT.
+ */
+void fft_execute_real_32(struct fft_real_plan *plan, bool ifft)
+{
+	int32_t *y;
+	int i;
+
+	if (!plan || !plan->plan)
+		return;
+
+	if (!ifft) {
+		fft_execute_32(plan->plan, false);
+		fft_real_split_32(plan);
+		return;
+	}
+
+	fft_real_merge_32(plan);
+	fft_execute_32(plan->plan, true);
+
+	/* compensate the 1/2 scale of the merge, the complex IFFT output is
+	 * conjugated so the odd samples in the imaginary part are negated
+	 */
+	y = (int32_t *)plan->plan->outb32;
+	for (i = 0; i < plan->size; i += 2) {
+		y[i] = sat_int32((int64_t)y[i] << 1);
+		y[i + 1] = sat_int32(-((int64_t)y[i + 1] << 1));
+	}
+}
+EXPORT_SYMBOL(fft_execute_real_32);
+#endif /* CONFIG_MATH_32BIT_FFT */
@@ -56,3 +56,126 @@ void iir_reset_df1(struct iir_state_df1 *iir)
 	 */
 }
 EXPORT_SYMBOL(iir_reset_df1);
+
+#if !SOF_USE_HIFI(NONE, FILTER)
+/* The HiFi versions of iir_df1() already process a sample with SIMD, the
+ * block versions only loop them.
+ */
+void iir_df1_block(struct iir_state_df1 *iir, int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		x[i] = iir_df1(iir, x[i]);
+}
+EXPORT_SYMBOL(iir_df1_block);
+
+void iir_df1_4th_block(struct iir_state_df1 *iir, int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < n; i++)
+		x[i] = iir_df1_4th(iir, x[i]);
+}
+EXPORT_SYMBOL(iir_df1_4th_block);
+#endif
+
+#if CONFIG_MATH_IIR_DF1_MULTICHANNEL
+size_t iir_df1_multi_size(int channels, int biquads)
+{
+	return (size_t)channels * biquads *
+		(SOF_EQ_IIR_NBIQUAD + IIR_DF1_NUM_STATE) * sizeof(int32_t);
+}
+EXPORT_SYMBOL(iir_df1_multi_size);
+
+int iir_df1_multi_init(struct iir_df1_multi *multi, const struct iir_state_df1 *iir,
+		       int channels, int32_t *data)
+{
+	const int biquads = iir[0].biquads;
+	int32_t *coef = data;
+	int32_t *delay = data + channels * biquads * SOF_EQ_IIR_NBIQUAD;
+	int ch;
+	int b;
+	int k;
+
+	multi->channels = 0;
+
+	/* Bypass and parallel sections need the per channel filters */
+	for (ch = 0; ch < channels; ch++) {
+		if (!iir[ch].biquads || iir[ch].biquads != biquads ||
+		    iir[ch].biquads_in_series != biquads)
+			return -EINVAL;
+	}
+
+	for (b = 0; b < biquads; b++) {
+		for (ch = 0; ch < channels; ch++) {
+			for (k = 0; k < SOF_EQ_IIR_NBIQUAD; k++)
+				coef[(b * SOF_EQ_IIR_NBIQUAD + k) * channels + ch] =
+					iir[ch].coef[b * SOF_EQ_IIR_NBIQUAD + k];
+
+			for (k = 0; k < IIR_DF1_NUM_STATE; k++)
+				delay[(b * IIR_DF1_NUM_STATE + k) * channels + ch] =
+					iir[ch].delay[b * IIR_DF1_NUM_STATE + k];
+		}
+	}
+
+	multi->channels = channels;
+	multi->biquads = biquads;
+	multi->coef = coef;
+	multi->delay = delay;
+	return 0;
+}
+EXPORT_SYMBOL(iir_df1_multi_init);
+
+/* One biquad of all channels over a block, same arithmetic as in iir_df1() */
+static void iir_df1_multi_biquad(const int32_t *coef, int32_t *delay, int32_t *x,
+				 int frames, int nch)
+{
+	const int32_t *a2 = coef;
+	const int32_t *a1 = coef + nch;
+	const int32_t *b2 = coef + 2 * nch;
+	const int32_t *b1 = coef + 3 * nch;
+	const int32_t *b0 = coef + 4 * nch;
+	const int32_t *shift = coef + 5 * nch;
+	const int32_t *gain = coef + 6 * nch;
+	int32_t *y2 = delay;
+	int32_t *y1 = delay + nch;
+	int32_t *x2 = delay + 2 * nch;
+	int32_t *x1 = delay + 3 * nch;
+	int32_t in;
+	int64_t acc;
+	int ch;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		for (ch = 0; ch < nch; ch++) {
+			in = x[ch];
+			acc = (int64_t)a2[ch] * y2[ch];
+			acc += (int64_t)a1[ch] * y1[ch];
+			acc += (int64_t)b2[ch] * x2[ch];
+			acc += (int64_t)b1[ch] * x1[ch];
+			acc += (int64_t)b0[ch] * in;
+			y2[ch] = y1[ch];
+			y1[ch] = sat_int32(Q_SHIFT_RND(acc, 61, 31));
+			x2[ch] = x1[ch];
+			x1[ch] = in;
+
+			/* Gain Q2.14 x Q1.31 -> Q3.45, then shift to Q1.31 */
+			acc = (int64_t)gain[ch] * y1[ch];
+			x[ch] = sat_int32(Q_SHIFT_RND(acc, 45 + shift[ch], 31));
+		}
+		x += nch;
+	}
+}
+
+void iir_df1_multi_block(struct iir_df1_multi *multi, int32_t *x, int frames)
+{
+	const int nch = multi->channels;
+	int b;
+
+	for (b = 0; b < multi->biquads; b++)
+		iir_df1_multi_biquad(multi->coef + b * SOF_EQ_IIR_NBIQUAD * nch,
+				     multi->delay + b * IIR_DF1_NUM_STATE * nch, x, frames, nch);
+}
+EXPORT_SYMBOL(iir_df1_multi_block);
+#endif /* CONFIG_MATH_IIR_DF1_MULTICHANNEL */
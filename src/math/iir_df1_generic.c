@@ -163,4 +163,77 @@ int32_t iir_df1_4th(struct iir_state_df1 *iir, int32_t x)
 }
 EXPORT_SYMBOL(iir_df1_4th);
 
+/* One biquad over a block, same arithmetic as in iir_df1() */
+static void iir_df1_biquad_block(const int32_t *coefp, int32_t *delay, int32_t *x, int n)
+{
+	const int32_t a2 = coefp[0];
+	const int32_t a1 = coefp[1];
+	const int32_t b2 = coefp[2];
+	const int32_t b1 = coefp[3];
+	const int32_t b0 = coefp[4];
+	const int32_t shift = coefp[5];
+	const int32_t gain = coefp[6];
+	int32_t y2 = delay[0];
+	int32_t y1 = delay[1];
+	int32_t x2 = delay[2];
+	int32_t x1 = delay[3];
+	int32_t in;
+	int64_t acc;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		in = x[i];
+		acc = (int64_t)a2 * y2;
+		acc += (int64_t)a1 * y1;
+		acc += (int64_t)b2 * x2;
+		acc += (int64_t)b1 * x1;
+		acc += (int64_t)b0 * in;
+		y2 = y1;
+		y1 = sat_int32(Q_SHIFT_RND(acc, 61, 31));
+		x2 = x1;
+		x1 = in;
+
+		/* Gain Q2.14 x Q1.31 -> Q3.45, then shift to Q1.31 */
+		acc = (int64_t)gain * y1;
+		x[i] = sat_int32(Q_SHIFT_RND(acc, 45 + shift, 31));
+	}
+
+	delay[0] = y2;
+	delay[1] = y1;
+	delay[2] = x2;
+	delay[3] = x1;
+}
+
+void iir_df1_block(struct iir_state_df1 *iir, int32_t *x, int n)
+{
+	int i;
+
+	/* Bypass is set with number of biquads set to zero. */
+	if (!iir->biquads)
+		return;
+
+	/* Parallel sections need the input of each, use the sample version */
+	if (iir->biquads_in_series != iir->biquads) {
+		for (i = 0; i < n; i++)
+			x[i] = iir_df1(iir, x[i]);
+
+		return;
+	}
+
+	for (i = 0; i < iir->biquads; i++)
+		iir_df1_biquad_block(iir->coef + i * SOF_EQ_IIR_NBIQUAD,
+				     iir->delay + i * IIR_DF1_NUM_STATE, x, n);
+}
+EXPORT_SYMBOL(iir_df1_block);
+
+void iir_df1_4th_block(struct iir_state_df1 *iir, int32_t *x, int n)
+{
+	int i;
+
+	for (i = 0; i < SOF_IIR_DF1_4TH_NUM_BIQUADS; i++)
+		iir_df1_biquad_block(iir->coef + i * SOF_EQ_IIR_NBIQUAD,
+				     iir->delay + i * IIR_DF1_NUM_STATE, x, n);
+}
+EXPORT_SYMBOL(iir_df1_4th_block);
+
 #endif
@@ -58,6 +58,47 @@ int sink_commit_buffer(struct sof_sink *sink, size_t commit_size)
 }
 EXPORT_SYMBOL(sink_commit_buffer);
 
+int sink_get_buffer_batch(struct sof_sink *sink, size_t period_frames, size_t max_periods,
+			  struct sof_sink_batch *batch)
+{
+	size_t period_bytes = period_frames * sink_get_frame_bytes(sink);
+	void *data_ptr;
+	void *buffer_start;
+	size_t buffer_size;
+	size_t req_size;
+	size_t periods;
+	size_t head;
+	int ret;
+
+	if (!period_bytes)
+		return -EINVAL;
+
+	periods = sink_get_free_size(sink) / period_bytes;
+	if (periods > max_periods)
+		periods = max_periods;
+	if (!periods)
+		return -ENODATA;
+
+	req_size = periods * period_bytes;
+	ret = sink_get_buffer(sink, req_size, &data_ptr, &buffer_start, &buffer_size);
+	if (ret)
+		return ret;
+
+	/* split the space at the circular buffer wrap point */
+	head = (uintptr_t)buffer_start + buffer_size - (uintptr_t)data_ptr;
+	if (head > req_size)
+		head = req_size;
+
+	batch->seg_ptr[0] = data_ptr;
+	batch->seg_size[0] = head;
+	batch->seg_ptr[1] = req_size > head ? buffer_start : NULL;
+	batch->seg_size[1] = req_size - head;
+	batch->frames = periods * period_frames;
+	batch->periods = periods;
+	return 0;
+}
+EXPORT_SYMBOL(sink_get_buffer_batch);
+
 int sink_set_frm_fmt(struct sof_sink *sink, enum sof_ipc_frame frame_fmt)
 {
 	sink->audio_stream_params->frame_fmt = frame_fmt;
@@ -57,6 +57,47 @@ int source_release_data(struct sof_source *source, size_t free_size)
 }
 EXPORT_SYMBOL(source_release_data);
 
+int source_get_data_batch(struct sof_source *source, size_t period_frames, size_t max_periods,
+			  struct sof_source_batch *batch)
+{
+	size_t period_bytes = period_frames * source_get_frame_bytes(source);
+	void const *data_ptr;
+	void const *buffer_start;
+	size_t buffer_size;
+	size_t req_size;
+	size_t periods;
+	size_t head;
+	int ret;
+
+	if (!period_bytes)
+		return -EINVAL;
+
+	periods = source_get_data_available(source) / period_bytes;
+	if (periods > max_periods)
+		periods = max_periods;
+	if (!periods)
+		return -ENODATA;
+
+	req_size = periods * period_bytes;
+	ret = source_get_data(source, req_size, &data_ptr, &buffer_start, &buffer_size);
+	if (ret)
+		return ret;
+
+	/* split the data at the circular buffer wrap point */
+	head = (uintptr_t)buffer_start + buffer_size - (uintptr_t)data_ptr;
+	if (head > req_size)
+		head = req_size;
+
+	batch->seg_ptr[0] = data_ptr;
+	batch->seg_size[0] = head;
+	batch->seg_ptr[1] = req_size > head ? buffer_start : NULL;
+	batch->seg_size[1] = req_size - head;
+	batch->frames = periods * period_frames;
+	batch->periods = periods;
+	return 0;
+}
+EXPORT_SYMBOL(source_get_data_batch);
+
 size_t source_get_frame_bytes(struct sof_source *source)
 {
 	return get_frame_bytes(source_get_frm_fmt(source),
@@ -7,6 +7,7 @@
 #define __LIBRARY_INCLUDE_LIB_SCHEDULE_H__
 
 #include <rtos/task.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 struct task;
@@ -15,6 +16,25 @@ struct ll_schedule_domain;
 
 void schedule_ll_run_tasks(void);
 
+/**
+ * \brief Runs a single LL task if it is queued.
+ *
+ * Lets a host run the tasks of different pipelines from different threads,
+ * like the LL schedulers of different cores.
+ *
+ * \param[in,out] task The task to run.
+ * \return True if the task was run.
+ */
+bool schedule_ll_run_task(struct task *task);
+
+/**
+ * \brief Gets the LL tasks in the order schedule_ll_run_tasks() runs them.
+ * \param[out] tasks Array for the tasks.
+ * \param[in] max Size of the array.
+ * \return Number of tasks or -ENOSPC if they don't fit.
+ */
+int schedule_ll_tasks_get(struct task **tasks, int max);
+
 int scheduler_init_ll(struct ll_schedule_domain *domain);
 
 int schedule_task_init_ll(struct task *task,
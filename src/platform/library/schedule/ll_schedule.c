@@ -12,11 +12,15 @@
 #include <platform/lib/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
 #include <rtos/wait.h>
+#include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <stdint.h>
+#if !defined __XCC__
+#include <pthread.h>
+#endif
 
  /* scheduler testbench definition */
 
@@ -27,6 +31,49 @@ DECLARE_TR_CTX(ll_tr, SOF_UUID(ll_sched_lib_uuid), LOG_LEVEL_INFO);
 /* list of all tasks */
 static struct list_item sched_list;
 
+#if !defined __XCC__
+/*
+ * The testbench can run tasks from several host threads, so the task list
+ * and task state changes are serialized. Tasks themselves run unlocked.
+ */
+static pthread_mutex_t sched_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static inline void sched_list_lock(void)
+{
+	pthread_mutex_lock(&sched_lock);
+}
+
+static inline void sched_list_unlock(void)
+{
+	pthread_mutex_unlock(&sched_lock);
+}
+#else
+static inline void sched_list_lock(void) {}
+static inline void sched_list_unlock(void) {}
+#endif
+
+bool schedule_ll_run_task(struct task *task)
+{
+	/* only run queued tasks */
+	sched_list_lock();
+	if (task->state != SOF_TASK_STATE_QUEUED) {
+		sched_list_unlock();
+		return false;
+	}
+	task->state = SOF_TASK_STATE_RUNNING;
+	sched_list_unlock();
+
+	task->ops.run(task->data);
+
+	/* only re-queue if not cancelled */
+	sched_list_lock();
+	if (task->state == SOF_TASK_STATE_RUNNING)
+		task->state = SOF_TASK_STATE_QUEUED;
+	sched_list_unlock();
+
+	return true;
+}
+
 void schedule_ll_run_tasks(void)
 {
 	struct list_item *tlist, *tlist_;
@@ -39,19 +86,26 @@ void schedule_ll_run_tasks(void)
 	/* iterate through the task list */
 	list_for_item_safe(tlist, tlist_, &sched_list) {
 		task = container_of(tlist, struct task, list);
+		schedule_ll_run_task(task);
+	}
+}
 
-		/* only run queued tasks */
-		if (task->state == SOF_TASK_STATE_QUEUED) {
-			task->state = SOF_TASK_STATE_RUNNING;
-
-			task->ops.run(task->data);
-
-			/* only re-queue if not cancelled */
-			if (task->state == SOF_TASK_STATE_RUNNING)
-				task->state = SOF_TASK_STATE_QUEUED;
-
+int schedule_ll_tasks_get(struct task **tasks, int max)
+{
+	struct list_item *tlist;
+	int count = 0;
+
+	sched_list_lock();
+	list_for_item(tlist, &sched_list) {
+		if (count == max) {
+			count = -ENOSPC;
+			break;
 		}
+		tasks[count++] = container_of(tlist, struct task, list);
 	}
+	sched_list_unlock();
+
+	return count;
 }
 
 /* schedule new LL task */
@@ -59,9 +113,11 @@ static int schedule_ll_task(void *data, struct task *task, uint64_t start,
 			    uint64_t period)
 {
 	/* add task to list */
+	sched_list_lock();
 	list_item_prepend(&task->list, &sched_list);
 	task->state = SOF_TASK_STATE_QUEUED;
 	task->start = 0;
+	sched_list_unlock();
 
 	return 0;
 }
@@ -75,8 +131,10 @@ static void ll_scheduler_free(void *data, uint32_t flags)
 static int schedule_ll_task_cancel(void *data, struct task *task)
 {
 	/* delete task */
+	sched_list_lock();
 	task->state = SOF_TASK_STATE_CANCEL;
 	list_item_del(&task->list);
+	sched_list_unlock();
 
 	return 0;
 }
@@ -84,8 +142,10 @@ static int schedule_ll_task_cancel(void *data, struct task *task)
 /* TODO: scheduler free and cancel APIs can merge as part of Zephyr */
 static int schedule_ll_task_free(void *data, struct task *task)
 {
+	sched_list_lock();
 	task->state = SOF_TASK_STATE_FREE;
 	list_item_del(&task->list);
+	sched_list_unlock();
 
 	return 0;
 }
@@ -9,15 +9,19 @@
 #include <sof/audio/module_adapter/module/generic.h>
 #include <rtos/task.h>
 #include <stdint.h>
+#include <sof/schedule/dp_admission.h>
 #include <sof/schedule/dp_schedule.h>
+#include <sof/schedule/dp_steal.h>
 #include <sof/schedule/ll_schedule.h>
 #include <sof/schedule/ll_schedule_domain.h>
 #include <sof/trace/trace.h>
 #include <rtos/wait.h>
 #include <rtos/interrupt.h>
+#include <zephyr/cache.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys_clock.h>
 #include <sof/lib/notifier.h>
+#include <rtos/clk.h>
 #include <ipc4/base_fw.h>
 
 #include <zephyr/kernel/thread.h>
@@ -46,11 +50,37 @@ struct task_dp_pdata {
 	struct k_sem sem;		/* semaphore for task scheduling */
 	struct processing_module *mod;	/* the module to be scheduled */
 	uint32_t ll_cycles_to_start;    /* current number of LL cycles till delayed start */
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	struct task *task;		/* the task, for workers of other cores */
+	uint32_t period;		/* task period in us */
+	struct dp_steal_entry steal;	/* shared queue membership */
+	bool stolen;			/* being run by a worker of another core */
+	int last_core;			/* core the task was last run on */
+#endif
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	uint32_t kcps;			/* admitted load of the module */
+#endif
 };
 
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+/* worker running DP tasks of other cores, one per core */
+struct dp_steal_worker {
+	struct k_thread thread;
+	struct k_sem sem;
+	uint32_t running;		/* DP tasks being run on the core */
+};
+
+static struct list_item dp_steal_queue = LIST_INIT(dp_steal_queue);
+static struct dp_steal_worker dp_steal_workers[CONFIG_CORE_COUNT];
+static K_THREAD_STACK_ARRAY_DEFINE(dp_steal_stacks, CONFIG_CORE_COUNT,
+				   CONFIG_DP_SCHEDULER_STEAL_STACK_SIZE);
+#endif
+
 /* Single CPU-wide lock
  * as each per-core instance if dp-scheduler has separate structures, it is enough to
- * use irq_lock instead of cross-core spinlocks
+ * use irq_lock instead of cross-core spinlocks.
+ * With work stealing the shared queue and tasks are accessed by all cores, on SMP
+ * irq_lock() is the global kernel lock, which serializes them as well.
  */
 static inline unsigned int scheduler_dp_lock(void)
 {
@@ -62,6 +92,207 @@ static inline void scheduler_dp_unlock(unsigned int key)
 	irq_unlock(key);
 }
 
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+static bool scheduler_dp_stealable(struct task_dp_pdata *pdata, bool home_busy)
+{
+	return dp_steal_allowed(pdata->mod->dp_stealable, pdata->period, pdata->stack_size,
+				K_THREAD_STACK_SIZEOF(dp_steal_stacks[0]), home_busy);
+}
+
+/* checks if the core already has DP work for this tick, called with the lock held */
+static bool scheduler_dp_core_busy(struct scheduler_dp_data *dp_sch, int core)
+{
+	struct list_item *tlist;
+	struct task *task;
+	struct task_dp_pdata *pdata;
+
+	if (dp_steal_workers[core].running)
+		return true;
+
+	list_for_item(tlist, &dp_sch->tasks) {
+		task = container_of(tlist, struct task, list);
+		pdata = task->priv_data;
+		if (task->state == SOF_TASK_STATE_RUNNING && !pdata->stolen)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * writes back or invalidates the memory the module allocated through the module
+ * memory API, the module and its buffers are in shared memory already
+ */
+static void scheduler_dp_mod_cache(struct processing_module *mod, bool invalidate)
+{
+	struct list_item *mem_list;
+	struct module_memory *mem;
+
+	list_for_item(mem_list, &mod->priv.memory.mem_list) {
+		mem = container_of(mem_list, struct module_memory, mem_list);
+		if (invalidate)
+			sys_cache_data_invd_range(mem->ptr, mem->size);
+		else
+			sys_cache_data_flush_range(mem->ptr, mem->size);
+	}
+}
+
+/* offers a triggered task to idle cores, called with the lock held */
+static void scheduler_dp_offer(struct task_dp_pdata *pdata, int core)
+{
+	int mask = cpu_enabled_cores();
+	int i;
+
+	/* the last run was here, let the core taking the task see its results */
+	if (pdata->last_core == core)
+		scheduler_dp_mod_cache(pdata->mod, false);
+
+	dp_steal_push(&dp_steal_queue, &pdata->steal,
+		      k_uptime_ticks() + pdata->deadline_clock_ticks);
+
+	for (i = 0; i < CONFIG_CORE_COUNT; i++)
+		if (i != core && (mask & BIT(i)) && !dp_steal_workers[i].running)
+			k_sem_give(&dp_steal_workers[i].sem);
+}
+#endif
+
+/* runs the task on the current core, the task has been claimed by the caller */
+static enum task_state scheduler_dp_task_run(struct task *task)
+{
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	struct task_dp_pdata *pdata = task->priv_data;
+	int core = cpu_get_id();
+	enum task_state state;
+
+	/*
+	 * Nothing to do while the task stays on one core. Results of a run on its
+	 * own core are written back only when the task is offered to other cores.
+	 */
+	if (pdata->last_core != core)
+		scheduler_dp_mod_cache(pdata->mod, true);
+
+	state = task_run(task);
+
+	/* hand the results of a stolen run back to the own core of the task */
+	if (core != task->core)
+		scheduler_dp_mod_cache(pdata->mod, false);
+	pdata->last_core = core;
+
+	return state;
+#else
+	return task_run(task);
+#endif
+}
+
+/* applies the state returned by a run, called with the lock held */
+static void scheduler_dp_task_ran(struct task *task, enum task_state state)
+{
+	/*
+	 * check if task is still running, may have been canceled by external call
+	 * if not, set the state returned by run procedure
+	 */
+	if (task->state != SOF_TASK_STATE_RUNNING)
+		return;
+
+	task->state = state;
+	switch (state) {
+	case SOF_TASK_STATE_RESCHEDULE:
+		/* mark to reschedule, schedule time is already calculated */
+		task->state = SOF_TASK_STATE_QUEUED;
+		break;
+
+	case SOF_TASK_STATE_CANCEL:
+	case SOF_TASK_STATE_COMPLETED:
+		/* remove from scheduling */
+		list_item_del(&task->list);
+		break;
+
+	default:
+		/* illegal state, serious defect, won't happen */
+		k_panic();
+	}
+}
+
+#if CONFIG_DP_SCHEDULER_ADMISSION
+#define DP_ADMISSION_BUDGET_KCPS \
+	((uint32_t)((uint64_t)CLK_MAX_CPU_HZ / 1000 * CONFIG_DP_SCHEDULER_ADMISSION_BUDGET / 100))
+
+/* admitted load and number of DP modules of each core, under the scheduler lock */
+static uint32_t dp_admitted_kcps[CONFIG_CORE_COUNT];
+static uint32_t dp_admitted_tasks[CONFIG_CORE_COUNT];
+
+/* reserves the declared load of the module on the core, if it fits */
+static int scheduler_dp_admit(struct processing_module *mod, uint16_t core, uint32_t *kcps)
+{
+	const struct ipc4_base_module_cfg *cfg = &mod->priv.cfg.base_cfg;
+	uint32_t frame_bytes = (cfg->audio_fmt.depth >> 3) * cfg->audio_fmt.channels_count;
+	uint32_t period = dp_admission_period_us(cfg->obs, frame_bytes,
+						 cfg->audio_fmt.sampling_frequency);
+	uint32_t headroom;
+	unsigned int lock_key;
+	int best;
+
+	*kcps = dp_admission_kcps(cfg->cpc, period);
+
+	lock_key = scheduler_dp_lock();
+	headroom = dp_admission_headroom(DP_ADMISSION_BUDGET_KCPS, dp_admitted_kcps[core]);
+	if (*kcps > headroom) {
+		best = dp_admission_best_core(dp_admitted_kcps, DP_ADMISSION_BUDGET_KCPS,
+					      cpu_enabled_cores(), CONFIG_CORE_COUNT);
+		scheduler_dp_unlock(lock_key);
+		tr_err(&dp_tr, "DP module needs %u KCPS, core %u has %u left, most left on core %d",
+		       *kcps, core, headroom, best);
+		return -EBUSY;
+	}
+
+	dp_admitted_kcps[core] += *kcps;
+	dp_admitted_tasks[core]++;
+	scheduler_dp_unlock(lock_key);
+
+	tr_info(&dp_tr, "DP module admitted on core %u with %u KCPS, %u left",
+		core, *kcps, headroom - *kcps);
+	return 0;
+}
+
+/*
+ * updates the load of the module with the period it is scheduled with, which is known
+ * only once it is bound, called with the lock held
+ */
+static bool scheduler_dp_readmit(struct task_dp_pdata *pdata, uint16_t core, uint32_t period)
+{
+	uint32_t kcps = dp_admission_kcps(pdata->mod->priv.cfg.base_cfg.cpc, period);
+
+	dp_admitted_kcps[core] = dp_admitted_kcps[core] - pdata->kcps + kcps;
+	pdata->kcps = kcps;
+
+	return dp_admitted_kcps[core] > DP_ADMISSION_BUDGET_KCPS;
+}
+
+static void scheduler_dp_release(uint16_t core, uint32_t kcps)
+{
+	unsigned int lock_key;
+
+	lock_key = scheduler_dp_lock();
+	dp_admitted_kcps[core] -= kcps;
+	dp_admitted_tasks[core]--;
+	scheduler_dp_unlock(lock_key);
+}
+
+void scheduler_dp_load_get(int core, struct ipc4_dp_core_load *load)
+{
+	unsigned int lock_key;
+
+	lock_key = scheduler_dp_lock();
+	load->core_id = core;
+	load->task_count = dp_admitted_tasks[core];
+	load->budget_kcps = DP_ADMISSION_BUDGET_KCPS;
+	load->load_kcps = dp_admitted_kcps[core];
+	load->headroom_kcps = dp_admission_headroom(DP_ADMISSION_BUDGET_KCPS,
+						    dp_admitted_kcps[core]);
+	scheduler_dp_unlock(lock_key);
+}
+#endif
+
 /* dummy LL task - to start LL on secondary cores */
 static enum task_state scheduler_dp_ll_tick_dummy(void *data)
 {
@@ -230,8 +461,15 @@ void scheduler_dp_ll_tick(void *receiver_data, enum notify_id event_type, void *
 	struct task_dp_pdata *pdata;
 	unsigned int lock_key;
 	struct scheduler_dp_data *dp_sch = scheduler_get_data(SOF_SCHEDULE_DP);
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	int core = cpu_get_id();
+	bool busy;
+#endif
 
 	lock_key = scheduler_dp_lock();
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	busy = scheduler_dp_core_busy(dp_sch, core);
+#endif
 	list_for_item(tlist, &dp_sch->tasks) {
 		curr_task = container_of(tlist, struct task, list);
 		pdata = curr_task->priv_data;
@@ -262,6 +500,13 @@ void scheduler_dp_ll_tick(void *receiver_data, enum notify_id event_type, void *
 				/* trigger the task */
 				curr_task->state = SOF_TASK_STATE_RUNNING;
 				k_sem_give(&pdata->sem);
+
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+				/* let an idle core take it if this one has other DP work */
+				if (scheduler_dp_stealable(pdata, busy))
+					scheduler_dp_offer(pdata, core);
+				busy = true;
+#endif
 			}
 		}
 	}
@@ -280,6 +525,9 @@ static int scheduler_dp_task_cancel(void *data, struct task *task)
 
 	task->state = SOF_TASK_STATE_CANCEL;
 	list_item_del(&task->list);
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	dp_steal_remove(&pdata->steal);
+#endif
 
 	/* if there're no more  DP task, stop LL tick source */
 	if (list_is_empty(&dp_sch->tasks))
@@ -314,6 +562,10 @@ static int scheduler_dp_task_free(void *data, struct task *task)
 	rfree((__sparse_force void *)pdata->p_stack);
 	pdata->p_stack = NULL;
 
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	scheduler_dp_release(task->core, pdata->kcps);
+#endif
+
 	/* all other memory has been allocated as a single malloc, will be freed later by caller */
 	return 0;
 }
@@ -327,6 +579,7 @@ static void dp_thread_fn(void *p1, void *p2, void *p3)
 	struct task_dp_pdata *task_pdata = task->priv_data;
 	unsigned int lock_key;
 	enum task_state state;
+	bool run;
 
 	while (1) {
 		/*
@@ -335,35 +588,39 @@ static void dp_thread_fn(void *p1, void *p2, void *p3)
 		 */
 		k_sem_take(&task_pdata->sem, K_FOREVER);
 
-		if (task->state == SOF_TASK_STATE_RUNNING)
-			state = task_run(task);
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+		/* claim the task unless a worker of another core has already done so */
+		lock_key = scheduler_dp_lock();
+		run = task->state == SOF_TASK_STATE_RUNNING && !task_pdata->stolen;
+		if (run) {
+			dp_steal_remove(&task_pdata->steal);
+			dp_steal_workers[task->core].running++;
+		}
+		scheduler_dp_unlock(lock_key);
+#else
+		run = task->state == SOF_TASK_STATE_RUNNING;
+#endif
+
+		if (run)
+			state = scheduler_dp_task_run(task);
 		else
 			state = task->state;	/* to avoid undefined variable warning */
 
 		lock_key = scheduler_dp_lock();
-		/*
-		 * check if task is still running, may have been canceled by external call
-		 * if not, set the state returned by run procedure
-		 */
-		if (task->state == SOF_TASK_STATE_RUNNING) {
-			task->state = state;
-			switch (state) {
-			case SOF_TASK_STATE_RESCHEDULE:
-				/* mark to reschedule, schedule time is already calculated */
-				task->state = SOF_TASK_STATE_QUEUED;
-				break;
-
-			case SOF_TASK_STATE_CANCEL:
-			case SOF_TASK_STATE_COMPLETED:
-				/* remove from scheduling */
-				list_item_del(&task->list);
-				break;
+		if (run) {
+			scheduler_dp_task_ran(task, state);
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+			dp_steal_workers[task->core].running--;
+#endif
+		}
 
-			default:
-				/* illegal state, serious defect, won't happen */
-				k_panic();
-			}
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+		/* a stolen run is finished by the worker, which then wakes us up again */
+		if (task_pdata->stolen) {
+			scheduler_dp_unlock(lock_key);
+			continue;
 		}
+#endif
 
 		if (task->state == SOF_TASK_STATE_COMPLETED ||
 		    task->state == SOF_TASK_STATE_CANCEL)
@@ -378,6 +635,81 @@ static void dp_thread_fn(void *p1, void *p2, void *p3)
 		task_complete(task);
 }
 
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+/* Worker thread running DP tasks of other cores on the core it is pinned to */
+static void dp_steal_worker_fn(void *p1, void *p2, void *p3)
+{
+	struct dp_steal_worker *worker = p1;
+	int core = (int)(uintptr_t)p2;
+	(void)p3;
+	struct dp_steal_entry *entry;
+	struct task_dp_pdata *pdata;
+	struct task *task;
+	unsigned int lock_key;
+	enum task_state state;
+	int64_t deadline;
+
+	while (1) {
+		k_sem_take(&worker->sem, K_FOREVER);
+
+		while (1) {
+			lock_key = scheduler_dp_lock();
+			entry = dp_steal_pop(&dp_steal_queue, core);
+			if (!entry) {
+				scheduler_dp_unlock(lock_key);
+				break;
+			}
+
+			pdata = container_of(entry, struct task_dp_pdata, steal);
+			task = pdata->task;
+			pdata->stolen = true;
+			worker->running++;
+			scheduler_dp_unlock(lock_key);
+
+			/* inherit what is left of the deadline of the task */
+			deadline = (int64_t)(entry->deadline - k_uptime_ticks());
+			k_thread_deadline_set(k_current_get(), MAX(deadline, 0));
+
+			state = scheduler_dp_task_run(task);
+
+			lock_key = scheduler_dp_lock();
+			scheduler_dp_task_ran(task, state);
+			worker->running--;
+			pdata->stolen = false;
+			/* let the own thread of the task terminate if it has to */
+			if (task->state == SOF_TASK_STATE_COMPLETED ||
+			    task->state == SOF_TASK_STATE_CANCEL)
+				k_sem_give(&pdata->sem);
+			scheduler_dp_unlock(lock_key);
+		}
+	}
+}
+
+static int scheduler_dp_steal_init(void)
+{
+	int core = cpu_get_id();
+	struct dp_steal_worker *worker = &dp_steal_workers[core];
+	k_tid_t tid;
+	int ret;
+
+	k_sem_init(&worker->sem, 0, 1);
+	tid = k_thread_create(&worker->thread, dp_steal_stacks[core],
+			      K_THREAD_STACK_SIZEOF(dp_steal_stacks[core]), dp_steal_worker_fn,
+			      worker, (void *)(uintptr_t)core, NULL,
+			      ZEPHYR_DP_THREAD_PRIORITY, 0, K_FOREVER);
+
+	ret = k_thread_cpu_pin(tid, core);
+	if (ret < 0) {
+		tr_err(&dp_tr, "scheduler_dp_steal_init(): worker pin to core %d failed", core);
+		k_thread_abort(tid);
+		return ret;
+	}
+
+	k_thread_start(tid);
+	return 0;
+}
+#endif
+
 static int scheduler_dp_task_shedule(void *data, struct task *task, uint64_t start,
 				     uint64_t period)
 {
@@ -385,6 +717,7 @@ static int scheduler_dp_task_shedule(void *data, struct task *task, uint64_t sta
 	struct task_dp_pdata *pdata = task->priv_data;
 	unsigned int lock_key;
 	uint64_t deadline_clock_ticks;
+	bool overload = false;
 	int ret;
 
 	lock_key = scheduler_dp_lock();
@@ -429,8 +762,19 @@ static int scheduler_dp_task_shedule(void *data, struct task *task, uint64_t sta
 	pdata->deadline_clock_ticks = deadline_clock_ticks;
 	pdata->ll_cycles_to_start = period / LL_TIMER_PERIOD_US;
 	pdata->mod->dp_startup_delay = true;
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	pdata->period = period;
+	pdata->last_core = task->core;
+#endif
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	overload = scheduler_dp_readmit(pdata, task->core, period);
+#endif
 	scheduler_dp_unlock(lock_key);
 
+	if (overload)
+		tr_warn(&dp_tr, "DP modules of core %u exceed their budget with period %u [us]",
+			task->core, (uint32_t)period);
+
 	tr_dbg(&dp_tr, "DP task scheduled with period %u [us]", (uint32_t)period);
 	return 0;
 
@@ -471,7 +815,11 @@ int scheduler_dp_init(void)
 
 	notifier_register(NULL, NULL, NOTIFIER_ID_LL_POST_RUN, scheduler_dp_ll_tick, 0);
 
-	return 0;
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	ret = scheduler_dp_steal_init();
+#endif
+
+	return ret;
 }
 
 int scheduler_dp_task_init(struct task **task,
@@ -482,6 +830,9 @@ int scheduler_dp_task_init(struct task **task,
 			   size_t stack_size)
 {
 	void __sparse_cache *p_stack = NULL;
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	uint32_t kcps;
+#endif
 
 	/* memory allocation helper structure */
 	struct {
@@ -494,6 +845,12 @@ int scheduler_dp_task_init(struct task **task,
 	/* must be called on the same core the task will be binded to */
 	assert(cpu_get_id() == core);
 
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	ret = scheduler_dp_admit(mod, core, &kcps);
+	if (ret < 0)
+		return ret;
+#endif
+
 	/*
 	 * allocate memory
 	 * to avoid multiple malloc operations allocate all required memory as a single structure
@@ -540,6 +897,14 @@ int scheduler_dp_task_init(struct task **task,
 	task_memory->pdata.p_stack = p_stack;
 	task_memory->pdata.stack_size = stack_size;
 	task_memory->pdata.mod = mod;
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	task_memory->pdata.kcps = kcps;
+#endif
+#if CONFIG_DP_SCHEDULER_WORK_STEALING
+	task_memory->pdata.task = &task_memory->task;
+	list_init(&task_memory->pdata.steal.list);
+	task_memory->pdata.steal.core = core;
+#endif
 	*task = &task_memory->task;
 
 
@@ -548,6 +913,9 @@ err:
 	/* cleanup - free all allocated resources */
 	rfree((__sparse_force void *)p_stack);
 	rfree(task_memory);
+#if CONFIG_DP_SCHEDULER_ADMISSION
+	scheduler_dp_release(core, kcps);
+#endif
 	return ret;
 }
 
@@ -0,0 +1,12 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2025 Intel Corporation. All rights reserved.
+ */
+
+/*
+ * The unit tests are configured for IPC3. Passed with -imacros after
+ * autoconfig.h by the ipc4_options library to build IPC4 only code.
+ */
+
+#undef CONFIG_IPC_MAJOR_3
+#define CONFIG_IPC_MAJOR_4 1
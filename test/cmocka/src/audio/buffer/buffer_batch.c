@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/sink_api.h>
+#include <sof/audio/source_api.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/ipc/schedule.h>
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* 2 channels of s16 - 4 bytes per frame, 10 frames in the buffer */
+#define TEST_FRAME_BYTES	4
+#define TEST_BUFFER_FRAMES	10
+#define TEST_PERIOD_FRAMES	3
+
+static struct comp_buffer *test_batch_buffer_new(void)
+{
+	struct sof_ipc_buffer test_buf_desc = {
+		.size = TEST_BUFFER_FRAMES * TEST_FRAME_BYTES
+	};
+	struct comp_buffer *buf = buffer_new(&test_buf_desc, false);
+
+	assert_non_null(buf);
+	audio_stream_set_frm_fmt(&buf->stream, SOF_IPC_FRAME_S16_LE);
+	audio_stream_set_channels(&buf->stream, 2);
+	return buf;
+}
+
+static void test_batch_fill(struct sof_sink_batch *batch, uint8_t *value)
+{
+	uint8_t *ptr;
+	size_t i, j;
+
+	for (i = 0; i < 2; i++) {
+		ptr = batch->seg_ptr[i];
+		for (j = 0; j < batch->seg_size[i]; j++)
+			ptr[j] = (*value)++;
+	}
+}
+
+static void test_batch_check(struct sof_source_batch *batch, uint8_t *value)
+{
+	const uint8_t *ptr;
+	size_t i, j;
+
+	for (i = 0; i < 2; i++) {
+		ptr = batch->seg_ptr[i];
+		for (j = 0; j < batch->seg_size[i]; j++)
+			assert_int_equal(ptr[j], (*value)++);
+	}
+}
+
+static void test_audio_buffer_batch_no_data(void **state)
+{
+	struct comp_buffer *buf = test_batch_buffer_new();
+	struct sof_source *source = audio_buffer_get_source(&buf->audio_buffer);
+	struct sof_sink *sink = audio_buffer_get_sink(&buf->audio_buffer);
+	struct sof_source_batch src_batch;
+	struct sof_sink_batch sink_batch;
+
+	(void)state;
+
+	assert_int_equal(source_get_data_batch(source, TEST_PERIOD_FRAMES, 8, &src_batch),
+			 -ENODATA);
+	assert_int_equal(source_get_data_batch(source, 0, 8, &src_batch), -EINVAL);
+	assert_int_equal(sink_get_buffer_batch(sink, TEST_PERIOD_FRAMES, 0, &sink_batch),
+			 -ENODATA);
+
+	buffer_free(buf);
+}
+
+static void test_audio_buffer_batch_wrap(void **state)
+{
+	struct comp_buffer *buf = test_batch_buffer_new();
+	struct sof_source *source = audio_buffer_get_source(&buf->audio_buffer);
+	struct sof_sink *sink = audio_buffer_get_sink(&buf->audio_buffer);
+	const size_t period_bytes = TEST_PERIOD_FRAMES * TEST_FRAME_BYTES;
+	struct sof_source_batch src_batch;
+	struct sof_sink_batch sink_batch;
+	uint8_t wr_value = 0;
+	uint8_t rd_value = 0;
+
+	(void)state;
+
+	/* empty buffer, 3 whole periods fit, no wrap */
+	assert_int_equal(sink_get_buffer_batch(sink, TEST_PERIOD_FRAMES, 8, &sink_batch), 0);
+	assert_int_equal(sink_batch.periods, 3);
+	assert_int_equal(sink_batch.frames, 3 * TEST_PERIOD_FRAMES);
+	assert_int_equal(sink_batch.seg_size[0], 3 * period_bytes);
+	assert_int_equal(sink_batch.seg_size[1], 0);
+	test_batch_fill(&sink_batch, &wr_value);
+	assert_int_equal(sink_commit_buffer(sink, INT_MAX), 0);
+
+	/* consume 2 periods only, limited by max_periods */
+	assert_int_equal(source_get_data_batch(source, TEST_PERIOD_FRAMES, 2, &src_batch), 0);
+	assert_int_equal(src_batch.periods, 2);
+	assert_int_equal(src_batch.seg_size[0], 2 * period_bytes);
+	assert_int_equal(src_batch.seg_size[1], 0);
+	test_batch_check(&src_batch, &rd_value);
+	assert_int_equal(source_release_data(source, INT_MAX), 0);
+
+	/* 28 bytes free, 2 periods fit and wrap 4 bytes before the buffer end */
+	assert_int_equal(sink_get_buffer_batch(sink, TEST_PERIOD_FRAMES, 8, &sink_batch), 0);
+	assert_int_equal(sink_batch.periods, 2);
+	assert_int_equal(sink_batch.seg_size[0], TEST_FRAME_BYTES);
+	assert_int_equal(sink_batch.seg_size[1], 2 * period_bytes - TEST_FRAME_BYTES);
+	assert_ptr_equal(sink_batch.seg_ptr[1], buf->stream.addr);
+	test_batch_fill(&sink_batch, &wr_value);
+	assert_int_equal(sink_commit_buffer(sink, INT_MAX), 0);
+
+	/* all 3 remaining periods are obtained at once across the wrap */
+	assert_int_equal(source_get_data_batch(source, TEST_PERIOD_FRAMES, 8, &src_batch), 0);
+	assert_int_equal(src_batch.periods, 3);
+	assert_int_equal(src_batch.seg_size[0], period_bytes + TEST_FRAME_BYTES);
+	assert_int_equal(src_batch.seg_size[1], 2 * period_bytes - TEST_FRAME_BYTES);
+	test_batch_check(&src_batch, &rd_value);
+	assert_int_equal(source_release_data(source, INT_MAX), 0);
+
+	assert_int_equal(wr_value, rd_value);
+	assert_int_equal(audio_stream_get_avail_bytes(&buf->stream), 0);
+
+	buffer_free(buf);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_buffer_batch_no_data),
+		cmocka_unit_test(test_audio_buffer_batch_wrap),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2024 Intel Corporation. All rights reserved.
+
+#include <sof/audio/ring_buffer.h>
+#include <sof/audio/sink_api.h>
+#include <sof/audio/source_api.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* producer and consumer use different, co-prime chunk sizes to exercise all wrap positions */
+#define TEST_PRODUCER_CHUNK	48
+#define TEST_CONSUMER_CHUNK	35
+#define TEST_TOTAL_BYTES	(4 * 1024 * 1024)
+
+struct test_spsc_ctx {
+	struct ring_buffer *ring_buffer;
+	size_t errors;
+};
+
+static void *test_spsc_producer(void *arg)
+{
+	struct test_spsc_ctx *ctx = arg;
+	struct sof_sink *sink = audio_buffer_get_sink(&ctx->ring_buffer->audio_buffer);
+	uint8_t value = 0;
+	size_t produced = 0;
+	uint8_t *buffer_start;
+	uint8_t *ptr;
+	size_t buffer_size;
+	size_t chunk;
+	size_t i;
+
+	while (produced < TEST_TOTAL_BYTES) {
+		chunk = MIN(TEST_PRODUCER_CHUNK, TEST_TOTAL_BYTES - produced);
+		if (sink_get_buffer(sink, chunk, (void **)&ptr, (void **)&buffer_start,
+				    &buffer_size)) {
+			sched_yield();
+			continue;
+		}
+
+		for (i = 0; i < chunk; i++) {
+			*ptr++ = value++;
+			if (ptr >= buffer_start + buffer_size)
+				ptr = buffer_start;
+		}
+
+		sink_commit_buffer(sink, chunk);
+		produced += chunk;
+	}
+
+	return NULL;
+}
+
+static void *test_spsc_consumer(void *arg)
+{
+	struct test_spsc_ctx *ctx = arg;
+	struct sof_source *source = audio_buffer_get_source(&ctx->ring_buffer->audio_buffer);
+	uint8_t value = 0;
+	size_t consumed = 0;
+	const uint8_t *buffer_start;
+	const uint8_t *ptr;
+	size_t buffer_size;
+	size_t chunk;
+	size_t i;
+
+	while (consumed < TEST_TOTAL_BYTES) {
+		chunk = MIN(TEST_CONSUMER_CHUNK, TEST_TOTAL_BYTES - consumed);
+		if (source_get_data(source, chunk, (void const **)&ptr,
+				    (void const **)&buffer_start, &buffer_size)) {
+			sched_yield();
+			continue;
+		}
+
+		for (i = 0; i < chunk; i++) {
+			if (*ptr++ != value++)
+				ctx->errors++;
+			if (ptr >= buffer_start + buffer_size)
+				ptr = buffer_start;
+		}
+
+		source_release_data(source, chunk);
+		consumed += chunk;
+	}
+
+	return NULL;
+}
+
+static void test_ring_buffer_spsc_stress(void **state)
+{
+	struct test_spsc_ctx ctx = { 0 };
+	pthread_t producer;
+	pthread_t consumer;
+
+	(void)state;
+
+	ctx.ring_buffer = ring_buffer_create(TEST_CONSUMER_CHUNK, TEST_PRODUCER_CHUNK, true, 0);
+	assert_non_null(ctx.ring_buffer);
+
+	assert_int_equal(pthread_create(&consumer, NULL, test_spsc_consumer, &ctx), 0);
+	assert_int_equal(pthread_create(&producer, NULL, test_spsc_producer, &ctx), 0);
+	assert_int_equal(pthread_join(producer, NULL), 0);
+	assert_int_equal(pthread_join(consumer, NULL), 0);
+
+	assert_int_equal(ctx.errors, 0);
+	assert_int_equal(source_get_data_available
+				(audio_buffer_get_source(&ctx.ring_buffer->audio_buffer)), 0);
+
+	audio_buffer_free(&ctx.ring_buffer->audio_buffer);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_ring_buffer_spsc_stress),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <sof/audio/component.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+static int setup(void **state)
+{
+	comp_profile_enable(true);
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	comp_profile_enable(false);
+	return 0;
+}
+
+static void test_comp_profile_stats(void **state)
+{
+	struct comp_profile_stats stats;
+
+	memset(&stats, 0, sizeof(stats));
+
+	comp_profile_stats_add(&stats, 10);
+	comp_profile_stats_add(&stats, 64);
+	comp_profile_stats_add(&stats, 127);
+	comp_profile_stats_add(&stats, 1000);
+	comp_profile_stats_add(&stats, UINT32_MAX);
+
+	assert_int_equal(stats.count, 5);
+	assert_int_equal(stats.min, 10);
+	assert_int_equal(stats.max, UINT32_MAX);
+	assert_true(stats.total == 10ULL + 64 + 127 + 1000 + UINT32_MAX);
+
+	/* < 64, [64, 128), [512, 1024) and the open ended last bucket */
+	assert_int_equal(stats.hist[0], 1);
+	assert_int_equal(stats.hist[1], 2);
+	assert_int_equal(stats.hist[4], 1);
+	assert_int_equal(stats.hist[COMP_PROFILE_HIST_BUCKETS - 1], 1);
+}
+
+static void test_comp_profile_percentile(void **state)
+{
+	struct comp_profile_stats stats;
+	int i;
+
+	memset(&stats, 0, sizeof(stats));
+	assert_int_equal(comp_profile_percentile(&stats, 990), 0);
+
+	/* 99 short ticks and a single long one */
+	for (i = 0; i < 99; i++)
+		comp_profile_stats_add(&stats, 100);
+	comp_profile_stats_add(&stats, 5000);
+
+	/* p99 is the upper bound of the [64, 128) bucket */
+	assert_int_equal(comp_profile_percentile(&stats, 990), 127);
+	/* p100 lands in [4096, 8192) which is clamped to the maximum */
+	assert_int_equal(comp_profile_percentile(&stats, 1000), 5000);
+
+	/* percentiles in the last bucket report the maximum */
+	comp_profile_stats_add(&stats, UINT32_MAX - 1);
+	assert_int_equal(comp_profile_percentile(&stats, 1000), UINT32_MAX - 1);
+}
+
+static void test_comp_profile_phases(void **state)
+{
+	struct comp_profile prof;
+	uint64_t phases;
+
+	memset(&prof, 0, sizeof(prof));
+
+	/* module adapter like tick: get_data, process, then commit */
+	comp_profile_begin(&prof);
+	comp_profile_mark(&prof, COMP_PROFILE_GET_DATA);
+	comp_profile_mark(&prof, COMP_PROFILE_PROCESS);
+	comp_profile_add_bytes(&prof, 384);
+	comp_profile_end(&prof);
+
+	assert_int_equal(prof.phase[COMP_PROFILE_GET_DATA].count, 1);
+	assert_int_equal(prof.phase[COMP_PROFILE_PROCESS].count, 1);
+	assert_int_equal(prof.phase[COMP_PROFILE_COMMIT].count, 1);
+	assert_int_equal(prof.phase[COMP_PROFILE_COPY].count, 1);
+
+	/* phases add up to the whole copy */
+	phases = prof.phase[COMP_PROFILE_GET_DATA].total +
+		 prof.phase[COMP_PROFILE_PROCESS].total +
+		 prof.phase[COMP_PROFILE_COMMIT].total;
+	assert_true(phases == prof.phase[COMP_PROFILE_COPY].total);
+
+	/* a tick without marks is accounted as processing */
+	comp_profile_begin(&prof);
+	comp_profile_add_bytes(&prof, 128);
+	comp_profile_end(&prof);
+
+	assert_int_equal(prof.phase[COMP_PROFILE_PROCESS].count, 2);
+	assert_int_equal(prof.phase[COMP_PROFILE_COMMIT].count, 1);
+	assert_int_equal(prof.phase[COMP_PROFILE_COPY].count, 2);
+	assert_true(prof.total_bytes == 512);
+	assert_int_equal(prof.peak_bytes, 384);
+
+	/* marks outside of a tick are ignored */
+	comp_profile_mark(&prof, COMP_PROFILE_PROCESS);
+	assert_int_equal(prof.phase[COMP_PROFILE_PROCESS].count, 2);
+
+	/* nothing is collected while disabled */
+	comp_profile_enable(false);
+	comp_profile_begin(&prof);
+	comp_profile_end(&prof);
+	assert_int_equal(prof.phase[COMP_PROFILE_COPY].count, 2);
+
+	comp_profile_reset(&prof);
+	assert_int_equal(prof.phase[COMP_PROFILE_COPY].count, 0);
+	assert_true(prof.total_bytes == 0);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test_setup_teardown(test_comp_profile_stats, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_profile_percentile, setup, teardown),
+		cmocka_unit_test_setup_teardown(test_comp_profile_phases, setup, teardown),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/buffer.h>
+#include <sof/audio/pcm_converter.h>
+#include <copier/copier.h>
+#include <copier/copier_gain.h>
+
+/*
+ * A fused conversion and gain function must give the very same local buffer
+ * data as its PCM converter followed by the static gain of copier_gain_input16()
+ * or copier_gain_input32(), for every wrap position of the DMA and the local
+ * buffer.
+ */
+
+/* ring sizes in frames, odd so that the rings wrap at different places */
+#define TEST_SOURCE_FRAMES	53
+#define TEST_SINK_FRAMES	47
+#define TEST_FRAMES		40
+#define TEST_ROUNDS		50
+
+/* the copier buffer setup of copier_generic.c is not under test */
+struct comp_buffer *buffer_new(const struct sof_ipc_buffer *desc, bool is_shared)
+{
+	return NULL;
+}
+
+void ipc4_update_buffer_format(struct comp_buffer *buf_c,
+			       const struct ipc4_audio_format *fmt)
+{
+}
+
+static const int16_t test_gains[] = { 0, 1, 333, 1023, 2047, INT16_MAX };
+
+static uint32_t test_seed;
+
+static int32_t test_rand(void)
+{
+	test_seed = test_seed * 1664525 + 1013904223;
+	return (int32_t)test_seed;
+}
+
+static void test_stream_init(struct audio_stream *stream, void *buf, int frames, int channels,
+			     size_t sample_bytes, int offset)
+{
+	uint32_t frame_bytes = channels * sample_bytes;
+
+	memset(stream, 0, sizeof(*stream));
+	audio_stream_init(stream, buf, frames * frame_bytes);
+	audio_stream_set_frm_fmt(stream, sample_bytes == sizeof(int16_t) ?
+				 SOF_IPC_FRAME_S16_LE : SOF_IPC_FRAME_S32_LE);
+	audio_stream_set_valid_fmt(stream, audio_stream_get_frm_fmt(stream));
+	audio_stream_set_channels(stream, channels);
+	audio_stream_set_rptr(stream, (uint8_t *)buf + offset * frame_bytes);
+	audio_stream_set_wptr(stream, (uint8_t *)buf + offset * frame_bytes);
+}
+
+/* a random channel map of the sink, a remap may also mute channels */
+static uint32_t test_chmap(int channels, bool remap)
+{
+	uint32_t chmap = 0;
+	int src_ch;
+	int ch;
+
+	for (ch = 0; ch < channels; ch++) {
+		src_ch = ch;
+		if (remap) {
+			src_ch = (uint32_t)test_rand() % (channels + 1);
+			if (src_ch == channels)
+				src_ch = 0xf;
+		}
+		chmap |= src_ch << (ch * 4);
+	}
+
+	return chmap;
+}
+
+static void test_gain_convert(const struct copier_gain_convert_map *map,
+			      pcm_converter_func process, int channels)
+{
+	const size_t sample_bytes = map->depth / 8;
+	const int samples = TEST_FRAMES * channels;
+	int32_t source_buf[TEST_SOURCE_FRAMES * MAX_GAIN_COEFFS_CNT];
+	int32_t ref_buf[TEST_SINK_FRAMES * MAX_GAIN_COEFFS_CNT];
+	int32_t sink_buf[TEST_SINK_FRAMES * MAX_GAIN_COEFFS_CNT];
+	struct copier_gain_params gain_params;
+	struct comp_buffer ref;
+	struct audio_stream source;
+	struct audio_stream sink;
+	uint32_t chmap;
+	int sink_offset;
+	int round;
+	int ch;
+	int i;
+
+	for (round = 0; round < TEST_ROUNDS; round++) {
+		for (i = 0; i < ARRAY_SIZE(source_buf); i++)
+			source_buf[i] = test_rand();
+		for (i = 0; i < ARRAY_SIZE(ref_buf); i++)
+			ref_buf[i] = test_rand();
+		memcpy_s(sink_buf, sizeof(sink_buf), ref_buf, sizeof(ref_buf));
+
+		memset(&gain_params, 0, sizeof(gain_params));
+		for (ch = 0; ch < MAX_GAIN_COEFFS_CNT; ch++)
+			gain_params.gain_coeffs[ch] =
+				test_gains[(uint32_t)test_rand() % ARRAY_SIZE(test_gains)];
+		chmap = test_chmap(channels, map->remap);
+
+		/* the fused function only runs on an empty local buffer */
+		test_stream_init(&source, source_buf, TEST_SOURCE_FRAMES, channels, sample_bytes,
+				 (uint32_t)test_rand() % TEST_SOURCE_FRAMES);
+		sink_offset = (uint32_t)test_rand() % TEST_SINK_FRAMES;
+		test_stream_init(&ref.stream, ref_buf, TEST_SINK_FRAMES, channels, sample_bytes,
+				 sink_offset);
+		test_stream_init(&sink, sink_buf, TEST_SINK_FRAMES, channels, sample_bytes,
+				 sink_offset);
+
+		/* reference, the conversion and then the gain from the read pointer */
+		assert_int_equal(process(&source, 0, &ref.stream, 0, samples, chmap), samples);
+		if (sample_bytes == sizeof(int16_t))
+			copier_gain_input16(&ref, STATIC_GAIN, GAIN_ADD, &gain_params,
+					    TEST_FRAMES);
+		else
+			copier_gain_input32(&ref, STATIC_GAIN, GAIN_ADD, &gain_params,
+					    TEST_FRAMES);
+
+		assert_int_equal(map->func(&source, &sink, &gain_params, samples, chmap),
+				 samples);
+		assert_memory_equal(sink_buf, ref_buf, sizeof(ref_buf));
+	}
+}
+
+static void test_copier_gain_convert(void **state)
+{
+	const struct copier_gain_convert_map *map;
+	pcm_converter_func process;
+	int channels;
+	int i;
+
+	(void)state;
+
+	test_seed = 1;
+	for (i = 0; i < copier_gain_convert_count; i++) {
+		map = &copier_gain_convert_map[i];
+		if (map->remap)
+			process = pcm_get_remap_function(map->source, map->sink);
+		else
+			process = pcm_get_conversion_function(map->source, map->sink);
+
+		/* formats not enabled in this build */
+		if (!process)
+			continue;
+
+		for (channels = 1; channels <= MAX_GAIN_COEFFS_CNT; channels++)
+			test_gain_convert(map, process, channels);
+	}
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_copier_gain_convert),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cmocka.h>
+#include <kernel/header.h>
+#include <sof/audio/component_ext.h>
+#include <eq_fir/eq_fir.h>
+#include <sof/audio/module_adapter/module/generic.h>
+#include <user/eq.h>
+
+#include "../../util.h"
+
+#define TEST_CHANNELS		2
+#define TEST_PERIOD_FRAMES	48
+#define TEST_FRAMES		4800
+
+/* Allow some small error from the fixed point FFT */
+#define ERROR_TOLERANCE_S24	1
+
+struct test_parameters {
+	int taps;
+};
+
+struct test_data {
+	struct comp_dev *dev;
+	struct comp_buffer *sink;
+	struct comp_buffer *source;
+	int32_t *coef;
+	int32_t *input;
+	int32_t *ref;
+	int taps;
+	int frames_in;
+	int frames_out;
+};
+
+static uint32_t lcg = 1;
+
+static int32_t test_rand(void)
+{
+	lcg = lcg * 1664525 + 1013904223;
+	return (int32_t)lcg;
+}
+
+static int setup_group(void **state)
+{
+	sys_comp_init(sof_get());
+	sys_comp_module_eq_fir_interface_init();
+	return 0;
+}
+
+/* Channel 0 is filtered with a long response, channel 1 is bypass */
+static struct sof_ipc_comp_process *create_eq_fir_comp_ipc(struct test_data *td)
+{
+	struct sof_ipc_comp_process *ipc;
+	struct sof_eq_fir_config *eq;
+	struct sof_fir_coef_data *fir;
+	size_t ipc_size = sizeof(struct sof_ipc_comp_process);
+	size_t blob_size = sizeof(*eq) + TEST_CHANNELS * sizeof(int16_t) + sizeof(*fir) +
+			   td->taps * sizeof(int16_t);
+	int i;
+	const struct sof_uuid uuid = {
+		.a = 0x43a90ce7, .b = 0xf3a5, .c = 0x41df,
+		.d = {0xac, 0x06, 0xba, 0x98, 0x65, 0x1a, 0xe6, 0xa3}
+	};
+
+	ipc = calloc(1, ipc_size + blob_size + SOF_UUID_SIZE);
+	memcpy_s(ipc + 1, SOF_UUID_SIZE, &uuid, SOF_UUID_SIZE);
+	eq = (struct sof_eq_fir_config *)((char *)(ipc + 1) + SOF_UUID_SIZE);
+	ipc->comp.hdr.size = ipc_size + SOF_UUID_SIZE;
+	ipc->comp.type = SOF_COMP_MODULE_ADAPTER;
+	ipc->config.hdr.size = sizeof(struct sof_ipc_comp_config);
+	ipc->size = blob_size;
+	ipc->comp.ext_data_length = SOF_UUID_SIZE;
+
+	eq->size = blob_size;
+	eq->channels_in_config = TEST_CHANNELS;
+	eq->number_of_responses = 1;
+	eq->data[0] = 0;
+	eq->data[1] = -1;
+	fir = (struct sof_fir_coef_data *)&eq->data[TEST_CHANNELS];
+	fir->length = td->taps;
+	fir->out_shift = 1;
+
+	/* Noise with a linearly decaying envelope */
+	for (i = 0; i < td->taps; i++) {
+		fir->coef[i] = (int64_t)(test_rand() >> 18) * (td->taps - i) / td->taps;
+		td->coef[i] = fir->coef[i];
+	}
+
+	return ipc;
+}
+
+static int setup(void **state)
+{
+	struct test_parameters *params = *state;
+	struct sof_ipc_comp_process *ipc;
+	struct processing_module *mod;
+	struct test_data *td;
+	struct comp_dev *dev;
+	size_t size;
+	int ret;
+	int i;
+
+	td = test_calloc(1, sizeof(*td));
+	td->taps = params->taps;
+	td->coef = test_calloc(td->taps, sizeof(int32_t));
+	td->input = test_calloc(TEST_FRAMES, sizeof(int32_t));
+	td->ref = test_calloc(TEST_FRAMES, sizeof(int32_t));
+
+	ipc = create_eq_fir_comp_ipc(td);
+	dev = comp_new((struct sof_ipc_comp *)ipc);
+	free(ipc);
+	if (!dev)
+		return -EINVAL;
+
+	td->dev = dev;
+	dev->frames = TEST_PERIOD_FRAMES;
+	mod = comp_mod(dev);
+
+	size = TEST_PERIOD_FRAMES * TEST_CHANNELS * sizeof(int32_t);
+	mod->priv.mpd.in_buff_size = size;
+	mod->priv.mpd.out_buff_size = size;
+	td->source = create_test_source(dev, 0, SOF_IPC_FRAME_S24_4LE, TEST_CHANNELS, 2 * size);
+	td->sink = create_test_sink(dev, 0, SOF_IPC_FRAME_S24_4LE, TEST_CHANNELS, 2 * size);
+
+	mod->input_buffers = test_malloc(sizeof(struct input_stream_buffer));
+	mod->input_buffers[0].data = &td->source->stream;
+	mod->output_buffers = test_malloc(sizeof(struct output_stream_buffer));
+	mod->output_buffers[0].data = &td->sink->stream;
+	mod->stream_params = test_malloc(sizeof(struct sof_ipc_stream_params));
+	mod->stream_params->channels = TEST_CHANNELS;
+	mod->period_bytes = size;
+
+	ret = module_prepare(mod, NULL, 0, NULL, 0);
+	if (ret)
+		return ret;
+
+	/* Input is noise with -30 dBFS peaks, the reference is direct convolution
+	 * with the same Q1.15 coefficients and output shift.
+	 */
+	for (i = 0; i < TEST_FRAMES; i++)
+		td->input[i] = test_rand() >> 13;
+
+	for (i = 0; i < TEST_FRAMES; i++) {
+		int64_t acc = 0;
+		int k;
+
+		for (k = 0; k < td->taps && k <= i; k++)
+			acc += (int64_t)td->coef[k] * td->input[i - k];
+
+		td->ref[i] = sat_int24(Q_SHIFT_RND(acc, 15 + 1, 0));
+	}
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct test_data *td = *state;
+	struct processing_module *mod = comp_mod(td->dev);
+
+	test_free(mod->input_buffers);
+	test_free(mod->output_buffers);
+	test_free(mod->stream_params);
+	free_test_source(td->source);
+	free_test_sink(td->sink);
+	comp_free(td->dev);
+	test_free(td->coef);
+	test_free(td->input);
+	test_free(td->ref);
+	test_free(td);
+	return 0;
+}
+
+static void fill_source_s24(struct test_data *td, int frames)
+{
+	struct processing_module *mod = comp_mod(td->dev);
+	struct audio_stream *ss = &td->source->stream;
+	int32_t *x;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		x = audio_stream_write_frag_s32(ss, 2 * i);
+		*x = td->input[td->frames_in];
+		x = audio_stream_write_frag_s32(ss, 2 * i + 1);
+		*x = td->input[td->frames_in];
+		td->frames_in++;
+	}
+
+	comp_update_buffer_produce(td->source, frames * audio_stream_frame_bytes(ss));
+	mod->input_buffers[0].size = frames;
+}
+
+/* Both channels are delayed by one FFT block */
+static void verify_sink_s24(struct test_data *td, int frames)
+{
+	struct audio_stream *ss = &td->sink->stream;
+	int32_t *y;
+	int32_t ref_fir;
+	int32_t ref_bypass;
+	int i;
+
+	for (i = 0; i < frames; i++) {
+		ref_fir = 0;
+		ref_bypass = 0;
+		if (td->frames_out >= EQ_FIR_FFT_BLOCK) {
+			ref_fir = td->ref[td->frames_out - EQ_FIR_FFT_BLOCK];
+			ref_bypass = td->input[td->frames_out - EQ_FIR_FFT_BLOCK];
+		}
+
+		y = audio_stream_read_frag_s32(ss, 2 * i);
+		assert_true(abs(*y - ref_fir) <= ERROR_TOLERANCE_S24);
+		y = audio_stream_read_frag_s32(ss, 2 * i + 1);
+		assert_int_equal(*y, ref_bypass);
+		td->frames_out++;
+	}
+}
+
+static void test_audio_eq_fir_fft(void **state)
+{
+	struct test_data *td = *state;
+	struct processing_module *mod = comp_mod(td->dev);
+	int ret;
+
+	while (td->frames_in < TEST_FRAMES) {
+		fill_source_s24(td, TEST_PERIOD_FRAMES);
+		mod->input_buffers[0].consumed = 0;
+		mod->output_buffers[0].size = 0;
+
+		ret = module_process_legacy(mod, mod->input_buffers, 1,
+					    mod->output_buffers, 1);
+		assert_int_equal(ret, 0);
+
+		comp_update_buffer_consume(td->source, mod->input_buffers[0].consumed);
+		comp_update_buffer_produce(td->sink, mod->output_buffers[0].size);
+		verify_sink_s24(td, TEST_PERIOD_FRAMES);
+		comp_update_buffer_consume(td->sink, mod->output_buffers[0].size);
+	}
+}
+
+/* Responses longer than the direct form FIR can run, up to the max length
+ * that needs a blob larger than SOF_EQ_FIR_MAX_SIZE.
+ */
+static struct test_parameters parameters[] = {
+	{ 1000 },
+	{ EQ_FIR_FFT_MAX_LENGTH },
+};
+
+int main(void)
+{
+	int i;
+
+	struct CMUnitTest tests[ARRAY_SIZE(parameters)];
+
+	for (i = 0; i < ARRAY_SIZE(parameters); i++) {
+		tests[i].name = "test_audio_eq_fir_fft";
+		tests[i].test_func = test_audio_eq_fir_fft;
+		tests[i].setup_func = setup;
+		tests[i].teardown_func = teardown;
+		tests[i].initial_state = &parameters[i];
+	}
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup_group, NULL);
+}
@@ -0,0 +1,466 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <sof/audio/component_ext.h>
+#include <sof/audio/format.h>
+#include <sof/audio/module_adapter/module/generic.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <ipc4/base-config.h>
+#include <ipc4/module.h>
+#include <mixin_mixout/mixin_mixout.h>
+
+#include "../../util.h"
+
+/*
+ * Two mixins are mixed into the same three mixouts through mixin_process() and
+ * mixout_process(). Mixouts that share a non unity gain of a mixin are mixed
+ * through its gain buffer, a period at a time, the others directly. Either way
+ * every mixout sink must get the sum of the gained sources, sample by sample.
+ */
+
+#define TEST_MIXINS		2
+#define TEST_MIXOUTS		IPC4_MIXIN_MODULE_MAX_OUTPUT_QUEUES
+#define TEST_CHANNELS		2
+#define TEST_RATE		48000
+#define TEST_PERIOD_US		1000
+#define TEST_PERIOD_FRAMES	48
+/* up to two periods per round, so that the gain buffer is used in chunks */
+#define TEST_MAX_FRAMES		(2 * TEST_PERIOD_FRAMES + 5)
+/* odd ring sizes, so that the buffers wrap at different places */
+#define TEST_SOURCE_FRAMES	(TEST_MAX_FRAMES + 7)
+#define TEST_SINK_FRAMES	(TEST_MAX_FRAMES + 13)
+#define TEST_ROUNDS		20
+
+#define TEST_MIXIN_ID(i)	IPC4_COMP_ID(1, i)
+#define TEST_MIXOUT_ID(i)	IPC4_COMP_ID(2, i)
+
+struct test_parameters {
+	uint32_t depth;
+	uint32_t valid_depth;
+	/* gains of the mixouts, per mixin */
+	uint16_t gains[TEST_MIXINS][TEST_MIXOUTS];
+};
+
+struct test_data {
+	struct test_parameters *params;
+	struct comp_dev *mixin[TEST_MIXINS];
+	struct comp_dev *mixout[TEST_MIXOUTS];
+	struct comp_buffer *source[TEST_MIXINS];
+	struct comp_buffer *link[TEST_MIXINS][TEST_MIXOUTS];
+	struct comp_buffer *sink[TEST_MIXOUTS];
+	int32_t input[TEST_MIXINS][TEST_MAX_FRAMES * TEST_CHANNELS];
+};
+
+static struct test_data *test_td;
+
+static uint32_t test_seed;
+
+static int32_t test_rand(void)
+{
+	test_seed = test_seed * 1664525 + 1013904223;
+	return (int32_t)test_seed;
+}
+
+/* the IPC4 helpers used by mixin, mixout and the module adapter */
+void ipc4_base_module_cfg_to_stream_params(const struct ipc4_base_module_cfg *base_cfg,
+					   struct sof_ipc_stream_params *params)
+{
+	enum sof_ipc_frame valid_fmt;
+
+	memset(params, 0, sizeof(*params));
+	params->channels = base_cfg->audio_fmt.channels_count;
+	params->rate = base_cfg->audio_fmt.sampling_frequency;
+	params->sample_container_bytes = base_cfg->audio_fmt.depth / 8;
+	params->sample_valid_bytes = base_cfg->audio_fmt.valid_bit_depth / 8;
+	audio_stream_fmt_conversion(base_cfg->audio_fmt.depth, base_cfg->audio_fmt.valid_bit_depth,
+				    &params->frame_fmt, &valid_fmt, base_cfg->audio_fmt.s_type);
+}
+
+struct comp_dev *ipc4_get_comp_dev(uint32_t comp_id)
+{
+	int i;
+
+	for (i = 0; i < TEST_MIXINS; i++)
+		if (test_td->mixin[i]->ipc_config.id == comp_id)
+			return test_td->mixin[i];
+
+	return NULL;
+}
+
+void ipc_build_stream_posn(struct sof_ipc_stream_posn *posn, uint32_t type, uint32_t id)
+{
+	memset(posn, 0, sizeof(*posn));
+}
+
+static int setup_group(void **state)
+{
+	sys_comp_init(sof_get());
+	sys_comp_module_mixin_interface_init();
+	sys_comp_module_mixout_interface_init();
+	return 0;
+}
+
+static struct comp_dev *test_comp_new(const struct sof_uuid *uuid, uint32_t id,
+				      const struct test_parameters *params)
+{
+	struct comp_driver_list *drivers = comp_drivers_get();
+	struct ipc4_base_module_cfg base_cfg = {
+		.audio_fmt = {
+			.sampling_frequency = TEST_RATE,
+			.depth = params->depth,
+			.channels_count = TEST_CHANNELS,
+			.valid_bit_depth = params->valid_depth,
+			.s_type = IPC4_TYPE_LSB_INTEGER,
+		},
+	};
+	struct ipc_config_process spec = {
+		.size = sizeof(base_cfg),
+		.data = (const unsigned char *)&base_cfg,
+	};
+	struct comp_ipc_config config = {
+		.id = id,
+		.type = SOF_COMP_MODULE_ADAPTER,
+		.proc_domain = COMP_PROCESSING_DOMAIN_LL,
+	};
+	const struct comp_driver *drv = NULL;
+	struct comp_driver_info *info;
+	struct list_item *clist;
+	struct comp_dev *dev;
+
+	list_for_item(clist, &drivers->list) {
+		info = container_of(clist, struct comp_driver_info, list);
+		if (!memcmp(info->drv->uid, uuid, sizeof(*uuid)))
+			drv = info->drv;
+	}
+
+	if (!drv)
+		return NULL;
+
+	dev = drv->ops.create(drv, &config, &spec);
+	if (!dev)
+		return NULL;
+
+	dev->period = TEST_PERIOD_US;
+	dev->direction = SOF_IPC_STREAM_PLAYBACK;
+	comp_mod(dev)->stream_params = test_calloc(1, sizeof(struct sof_ipc_stream_params));
+
+	return dev;
+}
+
+static void test_comp_free(struct comp_dev *dev)
+{
+	test_free(comp_mod(dev)->stream_params);
+	comp_mod(dev)->stream_params = NULL;
+	comp_free(dev);
+}
+
+/* buffer from mixin i to mixout j, its queue ids are the mixin output and mixout input */
+static struct comp_buffer *test_link_new(struct test_data *td, int i, int j)
+{
+	struct sof_ipc_buffer desc = {
+		.size = TEST_SINK_FRAMES * TEST_CHANNELS * sizeof(int32_t),
+	};
+	struct comp_buffer *buffer = buffer_new(&desc, false);
+
+	buffer->stream.runtime_stream_params.id = IPC4_COMP_ID(j, i);
+	buffer->source = td->mixin[i];
+	buffer->sink = td->mixout[j];
+	list_item_append(&buffer->source_list, &td->mixin[i]->bsink_list);
+	list_item_append(&buffer->sink_list, &td->mixout[j]->bsource_list);
+
+	return buffer;
+}
+
+static void test_set_gains(struct processing_module *mod, const uint16_t *gains)
+{
+	const struct module_interface *ops = mod->dev->drv->adapter_ops;
+	size_t size = sizeof(struct ipc4_mixer_mode_config) +
+		      (TEST_MIXOUTS - 1) * sizeof(struct ipc4_mixer_mode_sink_config);
+	struct ipc4_mixer_mode_config *cfg = test_calloc(1, size);
+	int j;
+
+	cfg->mixer_mode_config_count = TEST_MIXOUTS;
+	for (j = 0; j < TEST_MIXOUTS; j++) {
+		cfg->mixer_mode_sink_configs[j].output_queue_id = j;
+		cfg->mixer_mode_sink_configs[j].mixer_mode = IPC4_MIXER_NORMAL_MODE;
+		cfg->mixer_mode_sink_configs[j].gain = gains[j];
+	}
+
+	assert_int_equal(ops->set_configuration(mod, IPC4_MIXER_MODE, MODULE_CFG_FRAGMENT_SINGLE,
+						size, (const uint8_t *)cfg, size, NULL, 0), 0);
+	test_free(cfg);
+}
+
+static int setup(void **state)
+{
+	struct test_parameters *params = *state;
+	const struct sof_uuid mixin_uuid = {
+		.a = 0x39656eb2, .b = 0x3b71, .c = 0x4049,
+		.d = {0x8d, 0x3f, 0xf9, 0x2c, 0xd5, 0xc4, 0x3c, 0x09}
+	};
+	const struct sof_uuid mixout_uuid = {
+		.a = 0x3c56505a, .b = 0x24d7, .c = 0x418f,
+		.d = {0xbd, 0xdc, 0xc1, 0xf5, 0xa3, 0xac, 0x2a, 0xe0}
+	};
+	struct ipc4_module_bind_unbind bu;
+	enum sof_ipc_frame frame_fmt, valid_fmt;
+	struct processing_module *mod;
+	struct test_data *td;
+	size_t frame_bytes = params->depth / 8 * TEST_CHANNELS;
+	int i, j;
+
+	audio_stream_fmt_conversion(params->depth, params->valid_depth, &frame_fmt, &valid_fmt,
+				    IPC4_TYPE_LSB_INTEGER);
+
+	td = test_calloc(1, sizeof(*td));
+	td->params = params;
+	test_td = td;
+
+	for (i = 0; i < TEST_MIXINS; i++) {
+		td->mixin[i] = test_comp_new(&mixin_uuid, TEST_MIXIN_ID(i), params);
+		if (!td->mixin[i])
+			return -EINVAL;
+	}
+
+	for (j = 0; j < TEST_MIXOUTS; j++) {
+		td->mixout[j] = test_comp_new(&mixout_uuid, TEST_MIXOUT_ID(j), params);
+		if (!td->mixout[j])
+			return -EINVAL;
+	}
+
+	for (i = 0; i < TEST_MIXINS; i++) {
+		mod = comp_mod(td->mixin[i]);
+		td->source[i] = create_test_source(td->mixin[i], 0, frame_fmt,
+						   TEST_CHANNELS, TEST_SOURCE_FRAMES * frame_bytes);
+		mod->sources[0] = audio_buffer_get_source(&td->source[i]->audio_buffer);
+		mod->num_of_sources = 1;
+
+		for (j = 0; j < TEST_MIXOUTS; j++) {
+			td->link[i][j] = test_link_new(td, i, j);
+			mod->sinks[j] = audio_buffer_get_sink(&td->link[i][j]->audio_buffer);
+		}
+		mod->num_of_sinks = TEST_MIXOUTS;
+
+		test_set_gains(mod, params->gains[i]);
+	}
+
+	for (j = 0; j < TEST_MIXOUTS; j++) {
+		mod = comp_mod(td->mixout[j]);
+		td->sink[j] = create_test_sink(td->mixout[j], 0, frame_fmt,
+					       TEST_CHANNELS, TEST_SINK_FRAMES * frame_bytes);
+		mod->sinks[0] = audio_buffer_get_sink(&td->sink[j]->audio_buffer);
+		mod->num_of_sinks = 1;
+
+		for (i = 0; i < TEST_MIXINS; i++) {
+			mod->sources[i] = audio_buffer_get_source(&td->link[i][j]->audio_buffer);
+
+			memset(&bu, 0, sizeof(bu));
+			bu.primary.r.module_id = TEST_MIXIN_ID(i) & 0xffff;
+			bu.primary.r.instance_id = TEST_MIXIN_ID(i) >> 16;
+			assert_int_equal(module_bind(mod, &bu), 0);
+		}
+		mod->num_of_sources = TEST_MIXINS;
+
+		assert_int_equal(module_prepare(mod, mod->sources, mod->num_of_sources,
+						mod->sinks, mod->num_of_sinks), 0);
+		td->mixout[j]->state = COMP_STATE_ACTIVE;
+	}
+
+	for (i = 0; i < TEST_MIXINS; i++) {
+		mod = comp_mod(td->mixin[i]);
+		assert_int_equal(module_prepare(mod, mod->sources, mod->num_of_sources,
+						mod->sinks, mod->num_of_sinks), 0);
+		assert_int_equal(td->mixin[i]->frames, TEST_PERIOD_FRAMES);
+		td->mixin[i]->state = COMP_STATE_ACTIVE;
+	}
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct test_data *td = *state;
+	int i, j;
+
+	for (i = 0; i < TEST_MIXINS; i++) {
+		for (j = 0; j < TEST_MIXOUTS; j++)
+			buffer_free(td->link[i][j]);
+		free_test_source(td->source[i]);
+		test_comp_free(td->mixin[i]);
+	}
+
+	for (j = 0; j < TEST_MIXOUTS; j++) {
+		free_test_sink(td->sink[j]);
+		test_comp_free(td->mixout[j]);
+	}
+
+	test_free(td);
+	return 0;
+}
+
+static int32_t test_sample(uint32_t valid_depth)
+{
+	switch (valid_depth) {
+	case 16:
+		return test_rand() >> 16;
+	case 24:
+		return test_rand() >> 8;
+	default:
+		return test_rand();
+	}
+}
+
+static void test_fill_source(struct test_data *td, int i, int frames)
+{
+	struct audio_stream *stream = &td->source[i]->stream;
+	int samples = frames * TEST_CHANNELS;
+	int16_t *x16;
+	int32_t *x32;
+	int k;
+
+	for (k = 0; k < samples; k++) {
+		td->input[i][k] = test_sample(td->params->valid_depth);
+		if (td->params->depth == 16) {
+			x16 = audio_stream_write_frag_s16(stream, k);
+			*x16 = td->input[i][k];
+		} else {
+			x32 = audio_stream_write_frag_s32(stream, k);
+			*x32 = td->input[i][k];
+		}
+	}
+
+	comp_update_buffer_produce(td->source[i], samples * audio_stream_sample_bytes(stream));
+}
+
+/* the first mixin copies with gain, the others mix with gain and saturate */
+static int32_t test_mix_ref(uint32_t valid_depth, int32_t acc, int32_t x, uint16_t gain,
+			    bool copy)
+{
+	switch (valid_depth) {
+	case 16:
+		x = q_mults_16x16(x, gain, IPC4_MIXIN_GAIN_SHIFT);
+		return copy ? x : sat_int16(acc + x);
+	case 24:
+		x = q_mults_32x32(x, gain, IPC4_MIXIN_GAIN_SHIFT);
+		return copy ? x : sat_int24(acc + x);
+	default:
+		x = q_mults_32x32(x, gain, IPC4_MIXIN_GAIN_SHIFT);
+		return copy ? x : sat_int32((int64_t)acc + x);
+	}
+}
+
+static void test_verify_sink(struct test_data *td, int j, int frames)
+{
+	struct test_parameters *params = td->params;
+	struct audio_stream *stream = &td->sink[j]->stream;
+	int samples = frames * TEST_CHANNELS;
+	int32_t ref, out;
+	int16_t *y16;
+	int32_t *y32;
+	int i, k;
+
+	assert_int_equal(audio_stream_get_avail_frames(stream), frames);
+
+	for (k = 0; k < samples; k++) {
+		ref = 0;
+		for (i = 0; i < TEST_MIXINS; i++)
+			ref = test_mix_ref(params->valid_depth, ref, td->input[i][k],
+					   params->gains[i][j], !i);
+
+		if (params->depth == 16) {
+			y16 = audio_stream_read_frag_s16(stream, k);
+			out = *y16;
+		} else {
+			y32 = audio_stream_read_frag_s32(stream, k);
+			out = *y32;
+		}
+
+		assert_int_equal(out, ref);
+	}
+
+	comp_update_buffer_consume(td->sink[j], samples * audio_stream_sample_bytes(stream));
+}
+
+static void test_mixin_mixout_process(void **state)
+{
+	struct test_data *td = *state;
+	struct processing_module *mod;
+	int frames;
+	int round;
+	int i, j;
+
+	test_seed = 1;
+	for (round = 0; round < TEST_ROUNDS; round++) {
+		frames = 1 + (uint32_t)test_rand() % TEST_MAX_FRAMES;
+
+		for (i = 0; i < TEST_MIXINS; i++) {
+			test_fill_source(td, i, frames);
+			mod = comp_mod(td->mixin[i]);
+			assert_int_equal(module_process_sink_src(mod, mod->sources,
+								 mod->num_of_sources, mod->sinks,
+								 mod->num_of_sinks), 0);
+			assert_int_equal(audio_stream_get_avail_frames(&td->source[i]->stream), 0);
+		}
+
+		for (j = 0; j < TEST_MIXOUTS; j++) {
+			mod = comp_mod(td->mixout[j]);
+			assert_int_equal(module_process_sink_src(mod, mod->sources,
+								 mod->num_of_sources, mod->sinks,
+								 mod->num_of_sinks), 0);
+			test_verify_sink(td, j, frames);
+		}
+	}
+}
+
+#define UNITY	IPC4_MIXIN_UNITY_GAIN
+
+static struct test_parameters parameters[] = {
+#if CONFIG_FORMAT_S16LE
+	/* all three mixouts of a mixin share the gain */
+	{ 16, 16, { { 333, 333, 333 }, { 700, 700, 700 } } },
+	/* two share the gain, the same mixouts and others */
+	{ 16, 16, { { 333, 333, UNITY }, { UNITY, 512, 512 } } },
+	/* the first and the last share the gain, no shared gain at all */
+	{ 16, 16, { { 1000, 1, 1000 }, { 0, 1, UNITY } } },
+#endif
+#if CONFIG_FORMAT_S24LE
+	{ 32, 24, { { 333, 333, 333 }, { 700, 700, 700 } } },
+	{ 32, 24, { { 333, 333, UNITY }, { UNITY, 512, 512 } } },
+	{ 32, 24, { { 1000, 1, 1000 }, { 0, 1, UNITY } } },
+#endif
+#if CONFIG_FORMAT_S32LE
+	/* no gain buffer for S32 */
+	{ 32, 32, { { 333, 333, 333 }, { 700, 700, 700 } } },
+	{ 32, 32, { { 333, 333, UNITY }, { UNITY, 512, 512 } } },
+#endif
+};
+
+int main(void)
+{
+	int i;
+
+	struct CMUnitTest tests[ARRAY_SIZE(parameters)];
+
+	for (i = 0; i < ARRAY_SIZE(parameters); i++) {
+		tests[i].name = "test_mixin_mixout_process";
+		tests[i].test_func = test_mixin_mixout_process;
+		tests[i].setup_func = setup;
+		tests[i].teardown_func = teardown;
+		tests[i].initial_state = &parameters[i];
+	}
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup_group, NULL);
+}
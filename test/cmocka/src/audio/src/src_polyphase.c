@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <src/src_common.h>
+#include <src/src_config.h>
+#include <src/coef/src_std_int32_define.h>
+#include <src/coef/src_std_int32_table.h>
+
+/* The stages of 44.1 to 48 kHz conversion */
+#define TEST_FS_IN	44100
+#define TEST_FS_OUT	48000
+
+/* Blocks to process, enough for several delay line wraps */
+#define TEST_BLOCKS	200
+
+/* Channel counts of the golden output */
+#define TEST_GOLDEN_CHANNELS	8
+
+/* FNV-1a hashes of the output of the 1 to 8 channel stages for the input of
+ * test_golden(). They were computed with the per channel fir_filter_generic()
+ * before the FIR core processed all channels of a frame, from
+ * git show 8d5b481^:src/audio/src/src_generic.c.
+ */
+static const uint32_t test_golden_hash[2][TEST_GOLDEN_CHANNELS] = {
+	{ 0x86b6d223, 0x2fa7dddb, 0x79a65095, 0x03fbd78b,
+	  0x92da3a0e, 0x10909c2b, 0x9e492948, 0x4d3b672c },
+	{ 0xcd397913, 0x02738dcd, 0xe80a243b, 0xda3feeb5,
+	  0x5faadbc9, 0x796e2dca, 0x2f3ee680, 0xff1e543b },
+};
+
+struct test_stage {
+	struct src_state state;
+	struct src_stage_prm prm;
+	int32_t *delay;
+	int32_t *x;
+	int32_t *y;
+};
+
+static uint32_t lcg = 1;
+
+static int32_t test_rand(void)
+{
+	lcg = lcg * 1664525 + 1013904223;
+	return (int32_t)lcg;
+}
+
+static void test_stage_init(struct test_stage *ts, const struct src_stage *stage, int nch)
+{
+	size_t x_words = nch * stage->blk_in * TEST_BLOCKS;
+	size_t y_words = nch * stage->blk_out * TEST_BLOCKS;
+
+	ts->state.fir_delay_size = nch * src_fir_delay_length(stage);
+	ts->state.out_delay_size = nch * src_out_delay_length(stage);
+	ts->delay = test_calloc(ts->state.fir_delay_size + ts->state.out_delay_size,
+				sizeof(int32_t));
+	ts->state.fir_delay = ts->delay;
+	ts->state.out_delay = ts->delay + ts->state.fir_delay_size;
+	ts->state.fir_wp = &ts->state.fir_delay[ts->state.fir_delay_size - 1];
+	ts->state.out_rp = ts->state.out_delay;
+
+	ts->x = test_calloc(x_words, sizeof(int32_t));
+	ts->y = test_calloc(y_words, sizeof(int32_t));
+	ts->prm.nch = nch;
+	ts->prm.times = 1;
+	ts->prm.x_rptr = ts->x;
+	ts->prm.x_end_addr = ts->x + x_words;
+	ts->prm.x_size = x_words * sizeof(int32_t);
+	ts->prm.y_wptr = ts->y;
+	ts->prm.y_addr = ts->y;
+	ts->prm.y_end_addr = ts->y + y_words;
+	ts->prm.y_size = y_words * sizeof(int32_t);
+	ts->prm.shift = 0;
+	ts->prm.state = &ts->state;
+	ts->prm.stage = stage;
+}
+
+static void test_stage_free(struct test_stage *ts)
+{
+	test_free(ts->delay);
+	test_free(ts->x);
+	test_free(ts->y);
+}
+
+static void test_stage_run(struct test_stage *ts)
+{
+	int i;
+
+	for (i = 0; i < TEST_BLOCKS; i++)
+		src_polyphase_stage_cir(&ts->prm);
+}
+
+/* Each channel of a multi-channel stage must match a mono stage with the
+ * same input bit exactly.
+ */
+static void test_channels(const struct src_stage *stage, int nch)
+{
+	struct test_stage multi;
+	struct test_stage mono;
+	int frames_in = stage->blk_in * TEST_BLOCKS;
+	int frames_out = stage->blk_out * TEST_BLOCKS;
+	int ch;
+	int i;
+
+	test_stage_init(&multi, stage, nch);
+	for (i = 0; i < frames_in * nch; i++)
+		multi.x[i] = test_rand() >> 1;
+
+	test_stage_run(&multi);
+
+	for (ch = 0; ch < nch; ch++) {
+		test_stage_init(&mono, stage, 1);
+		for (i = 0; i < frames_in; i++)
+			mono.x[i] = multi.x[i * nch + ch];
+
+		test_stage_run(&mono);
+		for (i = 0; i < frames_out; i++)
+			assert_int_equal(multi.y[i * nch + ch], mono.y[i]);
+
+		test_stage_free(&mono);
+	}
+
+	test_stage_free(&multi);
+}
+
+/* The output must match the previous generic FIR core bit exactly */
+static void test_golden(const struct src_stage *stage, int nch, uint32_t golden)
+{
+	struct test_stage ts;
+	int samples_in = stage->blk_in * TEST_BLOCKS * nch;
+	int samples_out = stage->blk_out * TEST_BLOCKS * nch;
+	uint32_t hash = 2166136261u;
+	int i;
+
+	lcg = 1;
+	test_stage_init(&ts, stage, nch);
+	for (i = 0; i < samples_in; i++)
+		ts.x[i] = test_rand() >> 1;
+
+	test_stage_run(&ts);
+	for (i = 0; i < samples_out; i++)
+		hash = (hash ^ (uint32_t)ts.y[i]) * 16777619u;
+
+	assert_int_equal(hash, golden);
+	test_stage_free(&ts);
+}
+
+static void test_stages(const struct src_stage *stage[2])
+{
+	int i, j;
+
+	for (i = 0; src_out_fs[i] != TEST_FS_OUT; i++)
+		;
+
+	for (j = 0; src_in_fs[j] != TEST_FS_IN; j++)
+		;
+
+	stage[0] = src_table1[i][j];
+	stage[1] = src_table2[i][j];
+}
+
+static void test_audio_src_polyphase_channels(void **state)
+{
+	const struct src_stage *stage[2];
+	int nch;
+	int k;
+
+	test_stages(stage);
+	for (k = 0; k < 2; k++)
+		for (nch = 1; nch <= PLATFORM_MAX_CHANNELS; nch++)
+			test_channels(stage[k], nch);
+}
+
+static void test_audio_src_polyphase_golden(void **state)
+{
+	const struct src_stage *stage[2];
+	int nch;
+	int k;
+
+	test_stages(stage);
+	for (k = 0; k < 2; k++)
+		for (nch = 1; nch <= MIN(TEST_GOLDEN_CHANNELS, PLATFORM_MAX_CHANNELS); nch++)
+			test_golden(stage[k], nch, test_golden_hash[k][nch - 1]);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_src_polyphase_channels),
+		cmocka_unit_test(test_audio_src_polyphase_golden),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <math.h>
+#include <cmocka.h>
+
+#include <sof/audio/component.h>
+#include <src/src_common.h>
+#include <src/src_config.h>
+#include <src/coef/src_std_int32_define.h>
+#include <src/coef/src_std_int32_table.h>
+
+/* Frequency response points for the stopband and passband checks */
+#define TEST_POINTS		2000
+
+/* The synthesized filters are designed for 70 dB stopband attenuation while
+ * the tables have 69 - 76 dB from the THD+N tuning. The stopband may be max.
+ * 1 dB worse than in the table or than the design target if the table
+ * exceeds it. The passband ripple may be max. 0.05 dB more than in the
+ * table and the gain at 0 Hz must be exact.
+ */
+#define TEST_SB_TARGET_DB	70.0
+#define TEST_SB_TOLERANCE_DB	1.0
+#define TEST_PB_TOLERANCE_DB	0.05
+#define TEST_DC_TOLERANCE_DB	0.01
+
+/* The lengths may be max. 25% longer than with the tables */
+#define TEST_LENGTH_MAX_RATIO	1.25
+
+/* A conversion that the tables do not support */
+#define TEST_FS_IN		37800
+#define TEST_FS_OUT		48000
+#define TEST_SB_MIN_DB		69.0
+#define TEST_PB_MAX_DB		0.1
+
+struct test_response {
+	double dc_db;
+	double pb_db;
+	double sb_db;
+};
+
+/* Returns the prototype filter response magnitude at frequency f relative to
+ * the upsampled rate, the gain l of the interpolation is removed.
+ */
+static double stage_magnitude(const struct src_stage *s, double f)
+{
+	const int32_t *coefs = s->coefs;
+	double re = 0;
+	double im = 0;
+	double c;
+	int sub, j, n;
+
+	for (sub = 0; sub < s->num_of_subfilters; sub++) {
+		for (j = 0; j < s->subfilter_length; j++) {
+			n = j * s->num_of_subfilters + sub;
+			c = coefs[sub * s->subfilter_length + j] / 2147483648.0;
+			re += c * cos(2 * M_PI * f * n);
+			im -= c * sin(2 * M_PI * f * n);
+		}
+	}
+
+	return sqrt(re * re + im * im) * pow(2, -s->shift) / s->blk_out;
+}
+
+/* Measures the stage response for the passband edge pb_hz when the stage
+ * input rate is fs.
+ */
+static void stage_response(const struct src_stage *s, int fs, double pb_hz,
+			   struct test_response *r)
+{
+	double fs_up = (double)fs * s->blk_out;
+	double f_pb = pb_hz / fs_up;
+	double f_sb = 0.5 / MAX(s->blk_in, s->blk_out);
+	double dc = stage_magnitude(s, 0);
+	double pb_min = dc;
+	double pb_max = dc;
+	double sb_max = 0;
+	double a;
+	int i;
+
+	for (i = 0; i <= TEST_POINTS; i++) {
+		a = stage_magnitude(s, f_pb * i / TEST_POINTS);
+		pb_min = MIN(pb_min, a);
+		pb_max = MAX(pb_max, a);
+		a = stage_magnitude(s, f_sb + (0.5 - f_sb) * i / TEST_POINTS);
+		sb_max = MAX(sb_max, a);
+	}
+
+	r->dc_db = 20 * log10(dc);
+	r->pb_db = 20 * log10(pb_max / pb_min);
+	r->sb_db = 20 * log10(dc / sb_max);
+}
+
+static double pb_edge_hz(int fs_in, int fs_out)
+{
+	int fs_min = MIN(fs_in, fs_out);
+
+	return fs_min > 80000 ? 24000.0 : fs_min * 20000.0 / 44100;
+}
+
+static void test_audio_src_synth_vs_table(void **state)
+{
+	struct src_param prm = { 0 };
+	struct comp_dev dev = { 0 };
+	struct test_response rt, rs;
+	const struct src_stage *t[2];
+	const struct src_stage *s[2];
+	double dc_db;
+	double pb_hz;
+	int fs_in, fs_out;
+	int fs[2];
+	int ret;
+	int i, j, k;
+
+	for (i = 0; i < NUM_OUT_FS; i++) {
+		for (j = 0; j < NUM_IN_FS; j++) {
+			t[0] = src_table1[i][j];
+			t[1] = src_table2[i][j];
+			fs_in = src_in_fs[j];
+			fs_out = src_out_fs[i];
+			if (!t[0]->filter_length || fs_in == fs_out)
+				continue;
+
+			ret = src_synth_stages(&dev, &prm, fs_in, fs_out);
+			assert_int_equal(ret, 0);
+			s[0] = prm.stage1;
+			s[1] = prm.stage2;
+			fs[0] = fs_in;
+			fs[1] = fs_in / s[0]->blk_in * s[0]->blk_out;
+			pb_hz = pb_edge_hz(fs_in, fs_out);
+			dc_db = 0;
+
+			for (k = 0; k < 2; k++) {
+				/* same factoring as in the tables */
+				assert_int_equal(s[k]->blk_in, t[k]->blk_in);
+				assert_int_equal(s[k]->blk_out, t[k]->blk_out);
+				assert_int_equal(s[k]->idm, t[k]->idm);
+				assert_int_equal(s[k]->odm, t[k]->odm);
+				if (s[k]->filter_length == 1)
+					continue;
+
+				stage_response(t[k], fs[k], pb_hz, &rt);
+				stage_response(s[k], fs[k], pb_hz, &rs);
+				assert_true(rs.sb_db > MIN(rt.sb_db, TEST_SB_TARGET_DB) -
+					    TEST_SB_TOLERANCE_DB);
+				assert_true(rs.pb_db < rt.pb_db + TEST_PB_TOLERANCE_DB);
+				assert_true(s[k]->filter_length <=
+					    t[k]->filter_length * TEST_LENGTH_MAX_RATIO);
+				dc_db += rs.dc_db;
+			}
+
+			assert_true(fabs(dc_db + 1.0) < TEST_DC_TOLERANCE_DB);
+		}
+	}
+
+	src_synth_put_stages(&prm);
+}
+
+static void test_audio_src_synth_shared(void **state)
+{
+	struct src_param prm1 = { 0 };
+	struct src_param prm2 = { 0 };
+	struct comp_dev dev = { 0 };
+	const int32_t *coefs;
+	int ret;
+
+	ret = src_synth_stages(&dev, &prm1, 48000, 44100);
+	assert_int_equal(ret, 0);
+	ret = src_synth_stages(&dev, &prm2, 48000, 44100);
+	assert_int_equal(ret, 0);
+
+	/* the second instance uses the same coefficients */
+	assert_ptr_equal(prm1.stage1->coefs, prm2.stage1->coefs);
+	assert_ptr_equal(prm1.stage2->coefs, prm2.stage2->coefs);
+
+	/* and they are kept when the first instance releases them */
+	coefs = prm2.stage1->coefs;
+	src_synth_put_stages(&prm1);
+	assert_null(prm1.stage1);
+	assert_ptr_equal(prm2.stage1->coefs, coefs);
+
+	/* another conversion gets other coefficients */
+	ret = src_synth_stages(&dev, &prm1, 44100, 48000);
+	assert_int_equal(ret, 0);
+	assert_ptr_not_equal(prm1.stage1->coefs, prm2.stage1->coefs);
+
+	src_synth_put_stages(&prm1);
+	src_synth_put_stages(&prm2);
+}
+
+static void test_audio_src_synth_new_rate(void **state)
+{
+	struct src_param prm = { 0 };
+	struct comp_dev dev = { 0 };
+	struct test_response r;
+	const struct src_stage *s;
+	double dc_db = 0;
+	double pb_hz = pb_edge_hz(TEST_FS_IN, TEST_FS_OUT);
+	int fs = TEST_FS_IN;
+	int ret;
+	int k;
+
+	ret = src_synth_stages(&dev, &prm, TEST_FS_IN, TEST_FS_OUT);
+	assert_int_equal(ret, 0);
+
+	for (k = 0; k < 2; k++) {
+		s = k ? prm.stage2 : prm.stage1;
+		if (s->filter_length > 1) {
+			stage_response(s, fs, pb_hz, &r);
+			assert_true(r.sb_db > TEST_SB_MIN_DB);
+			assert_true(r.pb_db < TEST_PB_MAX_DB);
+			dc_db += r.dc_db;
+		}
+
+		fs = fs / s->blk_in * s->blk_out;
+	}
+
+	assert_int_equal(fs, TEST_FS_OUT);
+	assert_true(fabs(dc_db + 1.0) < TEST_DC_TOLERANCE_DB);
+	src_synth_put_stages(&prm);
+
+	/* too large factors are not supported */
+	ret = src_synth_stages(&dev, &prm, 44100, 44099);
+	assert_int_equal(ret, -EINVAL);
+	src_synth_put_stages(&prm);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_audio_src_synth_vs_table),
+		cmocka_unit_test(test_audio_src_synth_shared),
+		cmocka_unit_test(test_audio_src_synth_new_rate),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,218 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include "../../util.h"
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/module_adapter/module/generic.h>
+#include <volume/volume.h>
+#include "../module_adapter.h"
+
+/*
+ * The windows fade ramp is run through volume process once with the shared
+ * shape attached by volume_prepare_ramp() and once without it. The gains and
+ * the output must be bit exact.
+ */
+
+#define TEST_CHANNELS		2
+#define TEST_RATE		48000
+#define TEST_FRAMES		48
+#define TEST_PERIOD_US		1000
+#define TEST_MAX_PERIODS	600
+#define TEST_SAMPLES		(TEST_FRAMES * TEST_CHANNELS)
+
+#define VOL_MINUS_80DB		(VOL_ZERO_DB / 10000)
+
+struct test_parameters {
+	uint32_t initial_ramp;	/* ramp length in ms */
+	uint32_t periods;	/* processed periods, the ramp ends before */
+};
+
+struct test_ramp {
+	int32_t gain[TEST_MAX_PERIODS][TEST_CHANNELS];
+	int32_t out[TEST_MAX_PERIODS][TEST_SAMPLES];
+};
+
+struct test_data {
+	struct processing_module_test_data vol_state;
+	const struct module_interface *ops;
+	const struct test_parameters *params;
+	struct test_ramp cached;
+	struct test_ramp direct;
+};
+
+static int setup_group(void **state)
+{
+	sys_comp_init(sof_get());
+	sys_comp_module_volume_interface_init();
+	return 0;
+}
+
+static int setup(void **state)
+{
+	struct processing_module_test_parameters module_parameters = {
+		TEST_CHANNELS, TEST_FRAMES, 1, SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, NULL
+	};
+	struct comp_driver_list *drivers = comp_drivers_get();
+	struct comp_driver_info *info;
+	struct processing_module_test_data *vol_state;
+	struct test_data *td;
+	struct vol_data *cd;
+	int32_t *src;
+	int i;
+
+	td = test_calloc(1, sizeof(*td));
+	td->params = *state;
+
+	/* volume is the only registered driver */
+	info = container_of(drivers->list.next, struct comp_driver_info, list);
+	td->ops = info->drv->adapter_ops;
+
+	vol_state = &td->vol_state;
+	vol_state->parameters = module_parameters;
+	vol_state->num_sources = 1;
+	vol_state->num_sinks = 1;
+	module_adapter_test_setup(vol_state);
+	vol_state->mod->dev->period = TEST_PERIOD_US;
+
+	cd = test_calloc(1, sizeof(*cd));
+	vol_state->mod->priv.private = cd;
+	cd->vol = test_calloc(SOF_IPC_MAX_CHANNELS * 4, sizeof(int32_t));
+	cd->vol_min = VOL_MINUS_80DB;
+	cd->vol_max = VOL_MAX;
+	cd->ramp_type = SOF_VOLUME_WINDOWS_FADE;
+	cd->initial_ramp = td->params->initial_ramp;
+	cd->channels = TEST_CHANNELS;
+	cd->sample_rate_inv = (int32_t)(1000LL * INT32_MAX / TEST_RATE);
+#if CONFIG_IPC_MAJOR_4
+	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev, cd);
+#else
+	cd->scale_vol = vol_get_processing_function(vol_state->mod->dev,
+						    vol_state->sinks[0], cd);
+#endif
+
+	/* full scale input alternating in sign */
+	src = (int32_t *)vol_state->sources[0]->stream.r_ptr;
+	for (i = 0; i < TEST_SAMPLES; i++)
+		src[i] = i & 1 ? INT32_MIN + i : INT32_MAX - i;
+
+	*state = td;
+	return 0;
+}
+
+static int teardown(void **state)
+{
+	struct test_data *td = *state;
+	struct vol_data *cd = module_get_private_data(td->vol_state.mod);
+
+	volume_reset_state(cd);
+	test_free(cd->vol);
+	test_free(cd);
+	module_adapter_test_free(&td->vol_state);
+	test_free(td);
+	return 0;
+}
+
+static void test_ramp_run(struct test_data *td, struct test_ramp *ramp, bool cached)
+{
+	struct processing_module_test_data *vol_state = &td->vol_state;
+	struct processing_module *mod = vol_state->mod;
+	struct vol_data *cd = module_get_private_data(mod);
+	int32_t *dst = (int32_t *)vol_state->sinks[0]->stream.w_ptr;
+	int i;
+
+	/* channel 0 ramps up and channel 1 down */
+	cd->volume[0] = VOL_MINUS_80DB;
+	cd->volume[1] = VOL_ZERO_DB;
+	volume_set_chan(mod, 0, VOL_ZERO_DB / 2, false);
+	volume_set_chan(mod, 1, VOL_MINUS_80DB, false);
+	volume_set_ramp_channel_counter(cd, TEST_CHANNELS);
+	cd->ramp_finished = false;
+
+	/* the shape is only attached for the windows fade */
+	if (!cached)
+		cd->ramp_type = SOF_VOLUME_LINEAR;
+	volume_prepare_ramp(mod->dev, cd);
+	cd->ramp_type = SOF_VOLUME_WINDOWS_FADE;
+
+	if (cached)
+		assert_non_null(cd->ramp_curve);
+	else
+		assert_null(cd->ramp_curve);
+
+	for (i = 0; i < td->params->periods; i++) {
+		vol_state->input_buffers[0]->size = TEST_FRAMES;
+		vol_state->input_buffers[0]->consumed = 0;
+		vol_state->output_buffers[0]->size = 0;
+
+		td->ops->process_audio_stream(mod, vol_state->input_buffers[0], 1,
+					      vol_state->output_buffers[0], 1);
+
+		memcpy_s(ramp->gain[i], sizeof(ramp->gain[i]), cd->volume, sizeof(ramp->gain[i]));
+		memcpy_s(ramp->out[i], sizeof(ramp->out[i]), dst, sizeof(ramp->out[i]));
+	}
+
+	/* the ramp has reached the targets */
+	assert_true(cd->ramp_finished);
+	assert_int_equal(cd->volume[0], VOL_ZERO_DB / 2);
+	assert_int_equal(cd->volume[1], VOL_MINUS_80DB);
+
+	volume_reset_state(cd);
+	cd->channels = TEST_CHANNELS;
+	cd->sample_rate_inv = (int32_t)(1000LL * INT32_MAX / TEST_RATE);
+}
+
+static void test_audio_vol_ramp_curve(void **state)
+{
+	struct test_data *td = *state;
+	uint32_t half = td->params->initial_ramp * 1000 / TEST_PERIOD_US / 2;
+
+	test_ramp_run(td, &td->cached, true);
+	test_ramp_run(td, &td->direct, false);
+
+	/* the gains are ramping half way */
+	assert_true(td->cached.gain[half][0] > VOL_MINUS_80DB);
+	assert_true(td->cached.gain[half][0] < VOL_ZERO_DB / 2);
+	assert_true(td->cached.gain[half][1] > VOL_MINUS_80DB);
+	assert_true(td->cached.gain[half][1] < VOL_ZERO_DB);
+
+	assert_memory_equal(td->cached.gain, td->direct.gain,
+			    td->params->periods * sizeof(td->cached.gain[0]));
+	assert_memory_equal(td->cached.out, td->direct.out,
+			    td->params->periods * sizeof(td->cached.out[0]));
+}
+
+static struct test_parameters parameters[] = {
+	/* 125 us updates, 160 steps */
+	{ 20, 25 },
+	/* 500 us updates */
+	{ 100, 110 },
+	/* 1 ms updates, the steps past the shape length are not cached */
+	{ 500, 520 },
+};
+
+int main(void)
+{
+	int i;
+
+	struct CMUnitTest tests[ARRAY_SIZE(parameters)];
+
+	for (i = 0; i < ARRAY_SIZE(parameters); i++) {
+		tests[i].name = "test_audio_vol_ramp_curve";
+		tests[i].test_func = test_audio_vol_ramp_curve;
+		tests[i].setup_func = setup;
+		tests[i].teardown_func = teardown;
+		tests[i].initial_state = &parameters[i];
+	}
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, setup_group, NULL);
+}
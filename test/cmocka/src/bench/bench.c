@@ -0,0 +1,612 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/*
+ * Throughput benchmark of the audio processing kernels.
+ *
+ * Every kernel is run over a sweep of channel counts and frame counts. For
+ * each point the number of back to back calls is doubled until a measurement
+ * takes at least the minimum duration, then the best of several measurements
+ * is kept. The whole sweep is run several times, so that a point disturbed
+ * by other load in one sweep is not disturbed in the others, and the minimum
+ * and the median over the sweeps are reported. Host builds measure
+ * nanoseconds, xtensa builds core cycles.
+ *
+ * Results are written as CSV. When a baseline CSV from an earlier run is
+ * given, points whose median got slower than the threshold are reported and
+ * the program exits with failure, e.g.
+ *
+ *	audio_bench -o base.csv			(on the reference tree)
+ *	audio_bench -b base.csv			(on the tree under review)
+ */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined __XTENSA__
+#include <xtensa/hal.h>
+#define BENCH_UNIT		"cycles"
+#define BENCH_MIN_DEFAULT	1000000
+#else
+#include <time.h>
+#define BENCH_UNIT		"ns"
+#define BENCH_MIN_DEFAULT	10000000
+#endif
+
+#include "bench.h"
+
+#define BENCH_SWEEP_MAX		16
+#define BENCH_REPEATS		5
+#define BENCH_THRESHOLD		25
+#define BENCH_RUNS		3
+#define BENCH_RUNS_MAX		16
+#define BENCH_ITERATIONS_MAX	(1 << 24)
+#define BENCH_NAME_MAX		48
+#define BENCH_FMT_MAX		24
+#define BENCH_RESULTS_MAX	4096
+
+struct bench_result {
+	char name[BENCH_NAME_MAX];
+	char fmt[BENCH_FMT_MAX];
+	int channels;
+	int frames;
+	double per_frame[BENCH_RUNS_MAX];	/* best of each sweep */
+	int runs;
+};
+
+struct bench_prm {
+	const char *filter;
+	const char *output;
+	const char *baseline;
+	int channels[BENCH_SWEEP_MAX];
+	int channels_count;
+	int frames[BENCH_SWEEP_MAX];
+	int frames_count;
+	int repeats;
+	int runs;
+	uint64_t min_time;
+	int threshold;
+	bool list;
+};
+
+static const struct bench_kernel *const bench_groups[] = {
+	bench_filter_kernels,
+	bench_src_kernels,
+	bench_fft_kernels,
+	bench_pcm_kernels,
+};
+
+static const int bench_default_channels[] = {1, 2, 8};
+static const int bench_default_frames[] = {48, 256, 1024};
+
+static struct bench_result bench_results[BENCH_RESULTS_MAX];
+static int bench_result_count;
+
+static uint64_t bench_now(void)
+{
+#if defined __XTENSA__
+	return xthal_get_ccount();
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+static const char *bench_fmt_name(enum sof_ipc_frame fmt)
+{
+	switch (fmt) {
+	case SOF_IPC_FRAME_S16_LE:
+		return "s16";
+	case SOF_IPC_FRAME_S24_4LE:
+		return "s24";
+	case SOF_IPC_FRAME_S32_LE:
+		return "s32";
+	case SOF_IPC_FRAME_FLOAT:
+		return "float";
+	case SOF_IPC_FRAME_S24_3LE:
+		return "s24_3";
+	case SOF_IPC_FRAME_S24_4LE_MSB:
+		return "s24_msb";
+	case SOF_IPC_FRAME_U8:
+		return "u8";
+	case SOF_IPC_FRAME_S16_4LE:
+		return "s16_4";
+	default:
+		return "unknown";
+	}
+}
+
+/* fills a stream with deterministic noise at -6 dBFS */
+static void bench_fill(struct audio_stream *s, uint32_t seed)
+{
+	enum sof_ipc_frame fmt = audio_stream_get_frm_fmt(s);
+	size_t sample_bytes = get_sample_bytes(fmt);
+	size_t samples = audio_stream_get_size(s) / sample_bytes;
+	uint8_t *p = audio_stream_get_addr(s);
+	uint32_t r = seed;
+	int32_t v;
+	size_t i;
+
+	for (i = 0; i < samples; i++, p += sample_bytes) {
+		r = r * 1664525 + 1013904223;
+		v = (int32_t)r >> 1;
+
+		switch (fmt) {
+		case SOF_IPC_FRAME_S16_LE:
+			*(int16_t *)p = v >> 16;
+			break;
+		case SOF_IPC_FRAME_S24_4LE:
+			*(int32_t *)p = v >> 8;
+			break;
+		case SOF_IPC_FRAME_S24_4LE_MSB:
+			*(int32_t *)p = v & 0xffffff00;
+			break;
+		case SOF_IPC_FRAME_S16_4LE:
+			*(int32_t *)p = v >> 16;
+			break;
+		case SOF_IPC_FRAME_FLOAT:
+			*(float *)p = (float)v / 2147483648.0f;
+			break;
+		case SOF_IPC_FRAME_S24_3LE:
+			p[0] = v >> 8;
+			p[1] = v >> 16;
+			p[2] = v >> 24;
+			break;
+		case SOF_IPC_FRAME_U8:
+			*p = (v >> 24) + 128;
+			break;
+		default:
+			*(int32_t *)p = v;
+			break;
+		}
+	}
+}
+
+int bench_stream_alloc(struct audio_stream *s, enum sof_ipc_frame fmt, int channels,
+		       int frames)
+{
+	uint32_t size = get_frame_bytes(fmt, channels) * frames;
+	void *buf;
+
+	buf = malloc(size);
+	if (!buf)
+		return -ENOMEM;
+
+	free(audio_stream_get_addr(s));
+	memset(s, 0, sizeof(*s));
+	audio_stream_init(s, buf, size);
+	audio_stream_set_frm_fmt(s, fmt);
+	audio_stream_set_valid_fmt(s, fmt);
+	audio_stream_set_channels(s, channels);
+	bench_fill(s, (uint32_t)size);
+
+	return 0;
+}
+
+static void bench_case_free(struct bench_case *bc)
+{
+	free(audio_stream_get_addr(&bc->source));
+	free(audio_stream_get_addr(&bc->sink));
+	memset(bc, 0, sizeof(*bc));
+}
+
+static uint64_t bench_measure(const struct bench_kernel *k, struct bench_case *bc,
+			      int iterations)
+{
+	uint64_t start = bench_now();
+	int i;
+
+	for (i = 0; i < iterations; i++)
+		k->run(k, bc);
+
+	return bench_now() - start;
+}
+
+static struct bench_result *bench_find(const char *name, const char *fmt, int channels,
+				       int frames)
+{
+	struct bench_result *res;
+	int i;
+
+	for (i = 0; i < bench_result_count; i++) {
+		res = &bench_results[i];
+		if (res->channels == channels && res->frames == frames &&
+		    !strcmp(res->name, name) && !strcmp(res->fmt, fmt))
+			return res;
+	}
+
+	return NULL;
+}
+
+static int bench_add_result(const struct bench_kernel *k, struct bench_case *bc,
+			    double per_frame)
+{
+	struct bench_result *res;
+	char fmt[BENCH_FMT_MAX];
+
+	if (k->source_fmt == k->sink_fmt)
+		snprintf(fmt, sizeof(fmt), "%s", bench_fmt_name(k->source_fmt));
+	else
+		snprintf(fmt, sizeof(fmt), "%s_%s", bench_fmt_name(k->source_fmt),
+			 bench_fmt_name(k->sink_fmt));
+
+	/* later sweeps add to the result of the first one */
+	res = bench_find(k->name, fmt, bc->channels, bc->frames);
+	if (!res) {
+		if (bench_result_count == BENCH_RESULTS_MAX)
+			return -ENOSPC;
+
+		res = &bench_results[bench_result_count++];
+		snprintf(res->name, sizeof(res->name), "%s", k->name);
+		snprintf(res->fmt, sizeof(res->fmt), "%s", fmt);
+		res->channels = bc->channels;
+		res->frames = bc->frames;
+		res->runs = 0;
+	}
+
+	res->per_frame[res->runs++] = per_frame;
+
+	return 0;
+}
+
+static int bench_run_case(struct bench_prm *bp, const struct bench_kernel *k,
+			  int channels, int frames)
+{
+	struct bench_case bc;
+	uint64_t elapsed;
+	double best;
+	int iterations = 1;
+	int ret;
+	int i;
+
+	if ((k->flags & BENCH_MONO) && channels != 1)
+		return 0;
+	if ((k->flags & BENCH_POW2) && (frames & (frames - 1)))
+		return 0;
+
+	memset(&bc, 0, sizeof(bc));
+	bc.channels = channels;
+	bc.frames = frames;
+	ret = bench_stream_alloc(&bc.source, k->source_fmt, channels, frames);
+	if (!ret)
+		ret = bench_stream_alloc(&bc.sink, k->sink_fmt, channels, frames);
+	if (ret < 0)
+		goto out;
+
+	audio_stream_produce(&bc.source, audio_stream_get_size(&bc.source));
+
+	ret = k->init(k, &bc);
+	if (ret == -EINVAL) {
+		/* combination not supported by the kernel */
+		ret = 0;
+		goto out;
+	}
+	if (ret < 0)
+		goto out;
+
+	/* warm up caches and branch predictors */
+	k->run(k, &bc);
+
+	do {
+		elapsed = bench_measure(k, &bc, iterations);
+		if (elapsed >= bp->min_time || iterations >= BENCH_ITERATIONS_MAX)
+			break;
+		iterations <<= 1;
+	} while (true);
+
+	best = (double)elapsed / iterations;
+	for (i = 1; i < bp->repeats; i++) {
+		elapsed = bench_measure(k, &bc, iterations);
+		if ((double)elapsed / iterations < best)
+			best = (double)elapsed / iterations;
+	}
+
+	if (k->free)
+		k->free(k, &bc);
+
+	ret = bench_add_result(k, &bc, best / frames);
+out:
+	bench_case_free(&bc);
+	return ret;
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* sorts the sweeps of a result, the minimum is first */
+static double bench_median(struct bench_result *res)
+{
+	qsort(res->per_frame, res->runs, sizeof(res->per_frame[0]), bench_cmp_double);
+
+	if (res->runs & 1)
+		return res->per_frame[res->runs / 2];
+
+	return (res->per_frame[res->runs / 2 - 1] + res->per_frame[res->runs / 2]) / 2;
+}
+
+static void bench_write(FILE *f)
+{
+	struct bench_result *res;
+	double median;
+	int i;
+
+	fprintf(f, "kernel,format,channels,frames,unit,per_frame,per_sample,median_per_frame\n");
+	for (i = 0; i < bench_result_count; i++) {
+		res = &bench_results[i];
+		median = bench_median(res);
+		fprintf(f, "%s,%s,%d,%d,%s,%.3f,%.3f,%.3f\n", res->name, res->fmt,
+			res->channels, res->frames, BENCH_UNIT, res->per_frame[0],
+			res->per_frame[0] / res->channels, median);
+	}
+}
+
+/* returns number of regressions or negative error code */
+static int bench_compare(struct bench_prm *bp)
+{
+	struct bench_result *res;
+	char line[256];
+	char name[BENCH_NAME_MAX];
+	char fmt[BENCH_FMT_MAX];
+	char unit[8];
+	double per_frame;
+	double per_sample;
+	double median;
+	double limit;
+	double now;
+	int fields;
+	int channels;
+	int frames;
+	int regressions = 0;
+	int compared = 0;
+	FILE *f;
+
+	f = fopen(bp->baseline, "r");
+	if (!f) {
+		fprintf(stderr, "error: can't open baseline %s\n", bp->baseline);
+		return -ENOENT;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		fields = sscanf(line, "%47[^,],%23[^,],%d,%d,%7[^,],%lf,%lf,%lf", name, fmt,
+				&channels, &frames, unit, &per_frame, &per_sample, &median);
+		if (fields < 6)
+			continue; /* header or comment */
+
+		/* baseline of a single sweep */
+		if (fields < 8)
+			median = per_frame;
+
+		if (strcmp(unit, BENCH_UNIT)) {
+			fprintf(stderr, "error: baseline is in %s, this build measures %s\n",
+				unit, BENCH_UNIT);
+			fclose(f);
+			return -EINVAL;
+		}
+
+		res = bench_find(name, fmt, channels, frames);
+		if (!res)
+			continue;
+
+		compared++;
+		now = bench_median(res);
+		limit = median * (100 + bp->threshold) / 100;
+		if (now > limit) {
+			fprintf(stderr, "regression: %s %s %dch %d: %.3f -> %.3f (%+.1f%%)\n",
+				name, fmt, channels, frames, median, now,
+				100 * (now - median) / median);
+			regressions++;
+		}
+	}
+
+	fclose(f);
+	fprintf(stderr, "compared %d of %d results, %d regressions over %d%%\n",
+		compared, bench_result_count, regressions, bp->threshold);
+
+	return regressions;
+}
+
+static int bench_parse_list(const char *arg, int *list, int *count)
+{
+	char *end;
+	long v;
+
+	*count = 0;
+	do {
+		v = strtol(arg, &end, 0);
+		if (end == arg || v <= 0 || v > INT16_MAX || *count == BENCH_SWEEP_MAX)
+			return -EINVAL;
+
+		list[(*count)++] = v;
+		arg = end + 1;
+	} while (*end == ',');
+
+	return *end ? -EINVAL : 0;
+}
+
+static void bench_usage(const char *name)
+{
+	fprintf(stderr, "Usage: %s [options]\n", name);
+	fprintf(stderr, "  -k <name>        run only kernels whose name contains <name>\n");
+	fprintf(stderr, "  -c <n[,n...]>    channel counts, default 1,2,8\n");
+	fprintf(stderr, "  -f <n[,n...]>    frame counts, default 48,256,1024\n");
+	fprintf(stderr, "  -r <n>           measurements per point, default %d\n", BENCH_REPEATS);
+	fprintf(stderr, "  -n <n>           sweeps, default %d, at least %d with -b\n",
+		BENCH_RUNS, BENCH_RUNS);
+	fprintf(stderr, "  -m <n>           minimum duration of a measurement in %s, default %d\n",
+		BENCH_UNIT, BENCH_MIN_DEFAULT);
+	fprintf(stderr, "  -o <file>        write CSV results to file instead of stdout\n");
+	fprintf(stderr, "  -b <file>        compare results against a baseline CSV\n");
+	fprintf(stderr, "  -t <percent>     regression threshold of the median, default %d\n",
+		BENCH_THRESHOLD);
+	fprintf(stderr, "  -l               list kernels\n");
+}
+
+static int bench_parse_args(int argc, char **argv, struct bench_prm *bp)
+{
+	int option;
+
+	memcpy_s(bp->channels, sizeof(bp->channels), bench_default_channels,
+		 sizeof(bench_default_channels));
+	bp->channels_count = ARRAY_SIZE(bench_default_channels);
+	memcpy_s(bp->frames, sizeof(bp->frames), bench_default_frames,
+		 sizeof(bench_default_frames));
+	bp->frames_count = ARRAY_SIZE(bench_default_frames);
+	bp->repeats = BENCH_REPEATS;
+	bp->runs = BENCH_RUNS;
+	bp->min_time = BENCH_MIN_DEFAULT;
+	bp->threshold = BENCH_THRESHOLD;
+
+	while ((option = getopt(argc, argv, "hk:c:f:r:n:m:o:b:t:l")) != -1) {
+		switch (option) {
+		case 'k':
+			bp->filter = optarg;
+			break;
+		case 'c':
+			if (bench_parse_list(optarg, bp->channels, &bp->channels_count) < 0)
+				return -EINVAL;
+			break;
+		case 'f':
+			if (bench_parse_list(optarg, bp->frames, &bp->frames_count) < 0)
+				return -EINVAL;
+			break;
+		case 'r':
+			bp->repeats = atoi(optarg);
+			if (bp->repeats < 1)
+				return -EINVAL;
+			break;
+		case 'n':
+			bp->runs = atoi(optarg);
+			if (bp->runs < 1 || bp->runs > BENCH_RUNS_MAX)
+				return -EINVAL;
+			break;
+		case 'm':
+			bp->min_time = strtoull(optarg, NULL, 0);
+			break;
+		case 'o':
+			bp->output = optarg;
+			break;
+		case 'b':
+			bp->baseline = optarg;
+			break;
+		case 't':
+			bp->threshold = atoi(optarg);
+			if (bp->threshold < 0)
+				return -EINVAL;
+			break;
+		case 'l':
+			bp->list = true;
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	/* a single sweep is too noisy to fail a review on */
+	if (bp->baseline && bp->runs < BENCH_RUNS)
+		return -EINVAL;
+
+	return 0;
+}
+
+static int bench_kernel_sweep(struct bench_prm *bp, const struct bench_kernel *k)
+{
+	int ret;
+	int c, n;
+
+	for (c = 0; c < bp->channels_count; c++) {
+		for (n = 0; n < bp->frames_count; n++) {
+			ret = bench_run_case(bp, k, bp->channels[c], bp->frames[n]);
+			if (ret < 0) {
+				fprintf(stderr, "error: %s %dch %d failed %d\n",
+					k->name, bp->channels[c], bp->frames[n], ret);
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* runs or lists every selected kernel over the channel and frame counts once */
+static int bench_sweep(struct bench_prm *bp)
+{
+	const struct bench_kernel *k;
+	int ret;
+	int g;
+
+	for (g = 0; g < ARRAY_SIZE(bench_groups); g++) {
+		for (k = bench_groups[g]; k->name; k++) {
+			if (bp->filter && !strstr(k->name, bp->filter))
+				continue;
+
+			if (bp->list) {
+				printf("%s %s %s\n", k->name, bench_fmt_name(k->source_fmt),
+				       bench_fmt_name(k->sink_fmt));
+				continue;
+			}
+
+			ret = bench_kernel_sweep(bp, k);
+			if (ret < 0)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	struct bench_prm bp;
+	FILE *f = stdout;
+	int ret;
+	int run;
+
+	memset(&bp, 0, sizeof(bp));
+	if (bench_parse_args(argc, argv, &bp) < 0) {
+		bench_usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	for (run = 0; run < (bp.list ? 1 : bp.runs); run++)
+		if (bench_sweep(&bp) < 0)
+			return EXIT_FAILURE;
+
+	if (bp.list)
+		return EXIT_SUCCESS;
+
+	if (bp.output) {
+		f = fopen(bp.output, "w");
+		if (!f) {
+			fprintf(stderr, "error: can't create %s\n", bp.output);
+			return EXIT_FAILURE;
+		}
+	}
+
+	bench_write(f);
+	if (f != stdout)
+		fclose(f);
+
+	if (bp.baseline) {
+		ret = bench_compare(&bp);
+		if (ret)
+			return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
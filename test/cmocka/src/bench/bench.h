@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright(c) 2025 Intel Corporation. All rights reserved.
+ */
+
+#ifndef __BENCH_BENCH_H__
+#define __BENCH_BENCH_H__
+
+#include <sof/audio/audio_stream.h>
+#include <ipc/stream.h>
+#include <stdint.h>
+
+/** \brief Kernel only runs with channel count of 1, e.g. FFT. */
+#define BENCH_MONO		BIT(0)
+
+/** \brief Kernel needs a power of two frame count. */
+#define BENCH_POW2		BIT(1)
+
+/**
+ * \brief One point of the sweep.
+ *
+ * The harness allocates source and sink streams that hold the requested
+ * number of frames in the source and sink formats of the kernel before
+ * calling its init. The source is filled with noise and full, the sink is
+ * empty. A kernel with other needs reallocates them with
+ * bench_stream_alloc().
+ */
+struct bench_case {
+	int channels;
+	int frames;
+	struct audio_stream source;
+	struct audio_stream sink;
+	void *priv;		/**< kernel private data */
+};
+
+/** \brief Benchmarked kernel. */
+struct bench_kernel {
+	const char *name;
+	enum sof_ipc_frame source_fmt;
+	enum sof_ipc_frame sink_fmt;
+	uint32_t flags;
+
+	/* Prepares a case, returns -EINVAL to skip it */
+	int (*init)(const struct bench_kernel *k, struct bench_case *bc);
+
+	/* Processes bc->frames frames, called repeatedly */
+	void (*run)(const struct bench_kernel *k, struct bench_case *bc);
+
+	void (*free)(const struct bench_kernel *k, struct bench_case *bc);
+
+	const void *data;	/**< kernel function or parameters */
+};
+
+/* NULL name terminated kernel tables of each group */
+extern const struct bench_kernel bench_filter_kernels[];
+extern const struct bench_kernel bench_src_kernels[];
+extern const struct bench_kernel bench_fft_kernels[];
+extern const struct bench_kernel bench_pcm_kernels[];
+
+/**
+ * \brief (Re)allocates a stream and fills it with noise.
+ * \param[in,out] s Stream, zeroed or allocated earlier by this function.
+ * \param[in] fmt Frame format.
+ * \param[in] channels Number of channels.
+ * \param[in] frames Number of frames the stream holds.
+ * \return 0 on success, -ENOMEM on allocation failure.
+ */
+int bench_stream_alloc(struct audio_stream *s, enum sof_ipc_frame fmt, int channels,
+		       int frames);
+
+#endif /* __BENCH_BENCH_H__ */
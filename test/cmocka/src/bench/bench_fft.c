@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/* FFT kernels, the frames count of a case is the FFT size */
+
+#include <sof/common.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if CONFIG_MATH_FFT
+#include <sof/math/fft.h>
+#endif
+
+#include "bench.h"
+
+#if CONFIG_MATH_FFT
+
+struct bench_fft {
+	struct fft_plan *plan;
+	void *in;
+	void *out;
+};
+
+static int bench_fft_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	int bits = k->source_fmt == SOF_IPC_FRAME_S16_LE ? 16 : 32;
+	size_t size = bits == 16 ? sizeof(struct icomplex16) : sizeof(struct icomplex32);
+	int32_t *x = audio_stream_get_addr(&bc->source);
+	struct icomplex16 *in16;
+	struct icomplex32 *in32;
+	struct bench_fft *b;
+	int i;
+
+	if (bc->frames > FFT_SIZE_MAX)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->in = calloc(bc->frames, size);
+	b->out = calloc(bc->frames, size);
+	if (!b->in || !b->out)
+		goto err;
+
+	/* real input from the noise filled source */
+	if (bits == 16) {
+		in16 = b->in;
+		for (i = 0; i < bc->frames; i++)
+			in16[i].real = ((int16_t *)x)[i];
+	} else {
+		in32 = b->in;
+		for (i = 0; i < bc->frames; i++)
+			in32[i].real = x[i];
+	}
+
+	b->plan = fft_plan_new(b->in, b->out, bc->frames, bits);
+	if (!b->plan)
+		goto err;
+
+	bc->priv = b;
+	return 0;
+
+err:
+	free(b->in);
+	free(b->out);
+	free(b);
+	return -ENOMEM;
+}
+
+static void bench_fft_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fft *b = bc->priv;
+	void (*func)(struct fft_plan *plan, bool ifft) = k->data;
+
+	func(b->plan, false);
+}
+
+static void bench_fft_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fft *b = bc->priv;
+
+	fft_plan_free(b->plan);
+	free(b->in);
+	free(b->out);
+	free(b);
+}
+
+struct bench_fft_real {
+	struct fft_real_plan *plan;
+	void *out;
+};
+
+/* the real FFT reads the noise filled source directly */
+static int bench_fft_real_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	int bits = k->source_fmt == SOF_IPC_FRAME_S16_LE ? 16 : 32;
+	size_t size = bits == 16 ? sizeof(struct icomplex16) : sizeof(struct icomplex32);
+	struct bench_fft_real *b;
+
+	if (bc->frames > FFT_SIZE_MAX)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->out = calloc(bc->frames / 2 + 1, size);
+	if (!b->out)
+		goto err;
+
+	b->plan = fft_real_plan_new(audio_stream_get_addr(&bc->source), b->out, bc->frames, bits);
+	if (!b->plan)
+		goto err;
+
+	bc->priv = b;
+	return 0;
+
+err:
+	free(b->out);
+	free(b);
+	return -ENOMEM;
+}
+
+static void bench_fft_real_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fft_real *b = bc->priv;
+	void (*func)(struct fft_real_plan *plan, bool ifft) = k->data;
+
+	func(b->plan, false);
+}
+
+static void bench_fft_real_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fft_real *b = bc->priv;
+
+	fft_real_plan_free(b->plan);
+	free(b->out);
+	free(b);
+}
+
+#endif /* CONFIG_MATH_FFT */
+
+const struct bench_kernel bench_fft_kernels[] = {
+#if CONFIG_MATH_FFT
+	{ "fft_execute_16", SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE, BENCH_MONO | BENCH_POW2,
+	  bench_fft_init, bench_fft_run, bench_fft_free, fft_execute_16 },
+	{ "fft_execute_32", SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, BENCH_MONO | BENCH_POW2,
+	  bench_fft_init, bench_fft_run, bench_fft_free, fft_execute_32 },
+	{ "fft_execute_real_16", SOF_IPC_FRAME_S16_LE, SOF_IPC_FRAME_S16_LE,
+	  BENCH_MONO | BENCH_POW2, bench_fft_real_init, bench_fft_real_run, bench_fft_real_free,
+	  fft_execute_real_16 },
+	{ "fft_execute_real_32", SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE,
+	  BENCH_MONO | BENCH_POW2, bench_fft_real_init, bench_fft_real_run, bench_fft_real_free,
+	  fft_execute_real_32 },
+#endif
+	{ NULL },
+};
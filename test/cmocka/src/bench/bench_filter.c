@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/* FIR and IIR filter kernels */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/format.h>
+#include <sof/common.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if CONFIG_COMP_FIR
+#include <sof/audio/module_adapter/module/generic.h>
+#include <eq_fir/eq_fir.h>
+#endif
+#if CONFIG_MATH_IIR_DF1
+#include <sof/math/iir_df1.h>
+#include <user/eq.h>
+#endif
+
+#include "bench.h"
+
+#if CONFIG_COMP_FIR
+
+/* Typical length of an EQ FIR */
+#define BENCH_FIR_TAPS		64
+
+typedef void (*bench_fir_func)(struct fir_state_32x16 fir[], struct input_stream_buffer *bsource,
+			       struct output_stream_buffer *bsink, int frames);
+
+struct bench_fir {
+	struct fir_state_32x16 fir[PLATFORM_MAX_CHANNELS];
+	struct input_stream_buffer in;
+	struct output_stream_buffer out;
+	struct sof_fir_coef_data *coef;
+	int32_t *delay;
+};
+
+static int bench_fir_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fir *b;
+	int32_t *delay;
+	int size;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->coef = calloc(1, sizeof(*b->coef) + BENCH_FIR_TAPS * sizeof(int16_t));
+	if (!b->coef)
+		goto err;
+
+	b->coef->length = BENCH_FIR_TAPS;
+	for (i = 0; i < BENCH_FIR_TAPS; i++)
+		b->coef->coef[i] = (i & 1 ? -1 : 1) * (INT16_MAX >> (1 + i / 8));
+
+	size = fir_delay_size(b->coef);
+	if (size < 0)
+		goto err;
+
+	b->delay = calloc(bc->channels, size);
+	if (!b->delay)
+		goto err;
+
+	delay = b->delay;
+	for (i = 0; i < bc->channels; i++) {
+		fir_init_coef(&b->fir[i], b->coef);
+		fir_init_delay(&b->fir[i], &delay);
+	}
+
+	b->in.data = &bc->source;
+	b->out.data = &bc->sink;
+	bc->priv = b;
+	return 0;
+
+err:
+	free(b->coef);
+	free(b);
+	return -ENOMEM;
+}
+
+static void bench_fir_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fir *b = bc->priv;
+	bench_fir_func func = (bench_fir_func)k->data;
+
+	func(b->fir, &b->in, &b->out, bc->frames);
+}
+
+static void bench_fir_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_fir *b = bc->priv;
+
+	free(b->delay);
+	free(b->coef);
+	free(b);
+}
+
+/* the HiFi versions process two samples per call */
+#if SOF_USE_MIN_HIFI(2, FILTER)
+#define BENCH_EQ_FIR(fmt, func) \
+	{ "eq_fir", fmt, fmt, 0, bench_fir_init, bench_fir_run, bench_fir_free, \
+	  eq_fir_2x_##func }
+#else
+#define BENCH_EQ_FIR(fmt, func) \
+	{ "eq_fir", fmt, fmt, 0, bench_fir_init, bench_fir_run, bench_fir_free, \
+	  eq_fir_##func }
+#endif
+
+#endif /* CONFIG_COMP_FIR */
+
+#if CONFIG_MATH_IIR_DF1
+
+/* Sections of a typical parametric EQ */
+#define BENCH_IIR_BIQUADS	4
+
+struct bench_iir {
+	struct iir_state_df1 iir[PLATFORM_MAX_CHANNELS];
+	struct sof_eq_iir_header *config;
+	int32_t *delay;
+};
+
+static int bench_iir_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_iir *b;
+	int32_t *coef;
+	int32_t *delay;
+	int size;
+	int i;
+
+	if (bc->channels > PLATFORM_MAX_CHANNELS)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->config = calloc(1, sizeof(*b->config) +
+			   BENCH_IIR_BIQUADS * SOF_EQ_IIR_NBIQUAD * sizeof(int32_t));
+	if (!b->config)
+		goto err;
+
+	/* a2, a1, b2, b1, b0, shift, gain of a mild lowpass */
+	b->config->num_sections = BENCH_IIR_BIQUADS;
+	b->config->num_sections_in_series = BENCH_IIR_BIQUADS;
+	coef = (int32_t *)(b->config + 1);
+	for (i = 0; i < BENCH_IIR_BIQUADS; i++, coef += SOF_EQ_IIR_NBIQUAD) {
+		coef[0] = -214748365;	/* -0.2 in Q2.30 */
+		coef[1] = 429496730;	/* 0.4 */
+		coef[2] = 214748365;	/* 0.2 */
+		coef[3] = 429496730;	/* 0.4 */
+		coef[4] = 214748365;	/* 0.2 */
+		coef[5] = 0;
+		coef[6] = 16384;	/* 1.0 in Q2.14 */
+	}
+
+	size = iir_delay_size_df1(b->config);
+	if (size < 0)
+		goto err;
+
+	b->delay = calloc(bc->channels, size);
+	if (!b->delay)
+		goto err;
+
+	delay = b->delay;
+	for (i = 0; i < bc->channels; i++) {
+		iir_init_coef_df1(&b->iir[i], b->config);
+		iir_init_delay_df1(&b->iir[i], &delay);
+	}
+
+	bc->priv = b;
+	return 0;
+
+err:
+	free(b->config);
+	free(b);
+	return -ENOMEM;
+}
+
+/* same loop as eq_iir_s32_default() */
+static void bench_iir_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_iir *b = bc->priv;
+	int32_t *x = audio_stream_get_rptr(&bc->source);
+	int32_t *y = audio_stream_get_wptr(&bc->sink);
+	int32_t *x0, *y0;
+	const int nch = bc->channels;
+	const int samples = bc->frames * nch;
+	int i, j;
+
+	for (j = 0; j < nch; j++) {
+		x0 = x + j;
+		y0 = y + j;
+		for (i = 0; i < samples; i += nch) {
+			*y0 = iir_df1(&b->iir[j], *x0);
+			x0 += nch;
+			y0 += nch;
+		}
+	}
+}
+
+static void bench_iir_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_iir *b = bc->priv;
+
+	free(b->delay);
+	free(b->config);
+	free(b);
+}
+
+#endif /* CONFIG_MATH_IIR_DF1 */
+
+const struct bench_kernel bench_filter_kernels[] = {
+#if CONFIG_COMP_FIR
+#if CONFIG_FORMAT_S16LE
+	BENCH_EQ_FIR(SOF_IPC_FRAME_S16_LE, s16),
+#endif
+#if CONFIG_FORMAT_S24LE
+	BENCH_EQ_FIR(SOF_IPC_FRAME_S24_4LE, s24),
+#endif
+#if CONFIG_FORMAT_S32LE
+	BENCH_EQ_FIR(SOF_IPC_FRAME_S32_LE, s32),
+#endif
+#endif /* CONFIG_COMP_FIR */
+#if CONFIG_MATH_IIR_DF1
+	{ "iir_df1", SOF_IPC_FRAME_S32_LE, SOF_IPC_FRAME_S32_LE, 0,
+	  bench_iir_init, bench_iir_run, bench_iir_free, NULL },
+#endif
+	{ NULL },
+};
@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/* Format conversion, volume and mixing kernels */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/audio/pcm_converter.h>
+#include <sof/common.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if CONFIG_COMP_VOLUME
+#include <sof/audio/module_adapter/module/generic.h>
+#include <volume/volume.h>
+#endif
+#if CONFIG_COMP_MIXIN_MIXOUT
+#include <mixin_mixout/mixin_mixout.h>
+#endif
+
+#include "bench.h"
+
+/* Kernels are looked up at init so that a format the build does not
+ * support is skipped instead of failing the build.
+ */
+
+static int bench_pcm_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	pcm_converter_func func = pcm_get_conversion_function(k->source_fmt, k->sink_fmt);
+
+	if (!func)
+		return -EINVAL;
+
+	bc->priv = func;
+	return 0;
+}
+
+static void bench_pcm_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	pcm_converter_func func = bc->priv;
+
+	func(&bc->source, 0, &bc->sink, 0, bc->frames * bc->channels, DUMMY_CHMAP);
+}
+
+#define BENCH_PCM(in, out) \
+	{ "pcm_convert", SOF_IPC_FRAME_##in, SOF_IPC_FRAME_##out, 0, \
+	  bench_pcm_init, bench_pcm_run, NULL, NULL }
+
+#if CONFIG_COMP_VOLUME
+
+struct bench_vol {
+	struct processing_module mod;
+	struct vol_data cd;
+	struct input_stream_buffer in;
+	struct output_stream_buffer out;
+	vol_scale_func func;
+};
+
+static int bench_vol_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_vol *b;
+	int i;
+
+	if (bc->channels > SOF_IPC_MAX_CHANNELS)
+		return -EINVAL;
+
+	for (i = 0; i < volume_func_count; i++)
+		if (volume_func_map[i].frame_fmt == k->source_fmt)
+			break;
+
+	if (i == volume_func_count)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->func = volume_func_map[i].func;
+	b->mod.priv.private = &b->cd;
+	b->cd.channels = bc->channels;
+	for (i = 0; i < bc->channels; i++)
+		b->cd.volume[i] = VOL_ZERO_DB >> 1;
+
+	b->in.data = &bc->source;
+	b->out.data = &bc->sink;
+	bc->priv = b;
+	return 0;
+}
+
+static void bench_vol_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_vol *b = bc->priv;
+
+	b->in.consumed = 0;
+	b->out.size = 0;
+	b->func(&b->mod, &b->in, &b->out, bc->frames, 0);
+}
+
+static void bench_vol_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	free(bc->priv);
+}
+
+#define BENCH_VOL(fmt) \
+	{ "volume", SOF_IPC_FRAME_##fmt, SOF_IPC_FRAME_##fmt, 0, \
+	  bench_vol_init, bench_vol_run, bench_vol_free, NULL }
+
+#endif /* CONFIG_COMP_VOLUME */
+
+#if CONFIG_COMP_MIXIN_MIXOUT
+
+struct bench_mix {
+	struct cir_buf_ptr source;
+	struct cir_buf_ptr sink;
+	mix_func func;
+	uint16_t gain;
+};
+
+static int bench_mix_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	bool with_gain = k->data;
+	struct bench_mix *b;
+	int i;
+
+	for (i = 0; i < mix_count; i++)
+		if (mix_func_map[i].frame_fmt == k->source_fmt)
+			break;
+
+	if (i == mix_count)
+		return -EINVAL;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->func = with_gain ? mix_func_map[i].gain_mix : mix_func_map[i].mix;
+	b->gain = with_gain ? IPC4_MIXIN_UNITY_GAIN >> 1 : IPC4_MIXIN_UNITY_GAIN;
+	b->source.buf_start = audio_stream_get_addr(&bc->source);
+	b->source.buf_end = audio_stream_get_end_addr(&bc->source);
+	b->source.ptr = b->source.buf_start;
+	b->sink.buf_start = audio_stream_get_addr(&bc->sink);
+	b->sink.buf_end = audio_stream_get_end_addr(&bc->sink);
+	b->sink.ptr = b->sink.buf_start;
+
+	bc->priv = b;
+	return 0;
+}
+
+/* mixes into a sink that already holds a full period, the common case */
+static void bench_mix_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_mix *b = bc->priv;
+	int32_t samples = bc->frames * bc->channels;
+
+	b->func(&b->sink, 0, samples, &b->source, samples, b->gain);
+}
+
+static void bench_mix_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	free(bc->priv);
+}
+
+#define BENCH_MIX(fmt, gain) \
+	{ (gain) ? "mix_gain" : "mix", SOF_IPC_FRAME_##fmt, SOF_IPC_FRAME_##fmt, 0, \
+	  bench_mix_init, bench_mix_run, bench_mix_free, (void *)(gain) }
+
+/* mixouts fed by one mixin with the same gain */
+#define BENCH_MIX_SINKS		3
+
+struct bench_mix_group {
+	struct cir_buf_ptr source;
+	struct cir_buf_ptr sink[BENCH_MIX_SINKS];
+	struct cir_buf_ptr scaled;
+	mix_func mix;
+	mix_func gain_mix;
+};
+
+static int bench_mix_group_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	size_t size = audio_stream_get_size(&bc->sink);
+	struct bench_mix_group *b;
+	int i;
+
+	for (i = 0; i < mix_count; i++)
+		if (mix_func_map[i].frame_fmt == k->source_fmt)
+			break;
+
+	if (i == mix_count)
+		return -EINVAL;
+
+	/* sinks and the scratch buffer follow the private data */
+	b = calloc(1, sizeof(*b) + BENCH_MIX_SINKS * size + size);
+	if (!b)
+		return -ENOMEM;
+
+	b->mix = mix_func_map[i].mix;
+	b->gain_mix = mix_func_map[i].gain_mix;
+	b->source.buf_start = audio_stream_get_addr(&bc->source);
+	b->source.buf_end = audio_stream_get_end_addr(&bc->source);
+	b->source.ptr = b->source.buf_start;
+	for (i = 0; i < BENCH_MIX_SINKS; i++) {
+		b->sink[i].buf_start = (uint8_t *)(b + 1) + i * size;
+		b->sink[i].buf_end = (uint8_t *)b->sink[i].buf_start + size;
+		b->sink[i].ptr = b->sink[i].buf_start;
+	}
+	b->scaled.buf_start = (uint8_t *)(b + 1) + BENCH_MIX_SINKS * size;
+	b->scaled.buf_end = (uint8_t *)b->scaled.buf_start + size;
+	b->scaled.ptr = b->scaled.buf_start;
+
+	bc->priv = b;
+	return 0;
+}
+
+/* each mixout mixed with the gain function, as mixin does for differing gains */
+static void bench_mix_each_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_mix_group *b = bc->priv;
+	int32_t samples = bc->frames * bc->channels;
+	int i;
+
+	for (i = 0; i < BENCH_MIX_SINKS; i++)
+		b->gain_mix(&b->sink[i], 0, samples, &b->source, samples,
+			    IPC4_MIXIN_UNITY_GAIN >> 1);
+}
+
+/* the gain applied once and mixed into each mixout with unity gain */
+static void bench_mix_shared_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_mix_group *b = bc->priv;
+	int32_t samples = bc->frames * bc->channels;
+	int i;
+
+	b->gain_mix(&b->scaled, 0, 0, &b->source, samples, IPC4_MIXIN_UNITY_GAIN >> 1);
+	for (i = 0; i < BENCH_MIX_SINKS; i++)
+		b->mix(&b->sink[i], 0, samples, &b->scaled, samples, IPC4_MIXIN_UNITY_GAIN);
+}
+
+#define BENCH_MIX_GROUP(fmt, shared) \
+	{ (shared) ? "mix_gain_shared" : "mix_gain_each", SOF_IPC_FRAME_##fmt, \
+	  SOF_IPC_FRAME_##fmt, 0, bench_mix_group_init, \
+	  (shared) ? bench_mix_shared_run : bench_mix_each_run, bench_mix_free, NULL }
+
+#endif /* CONFIG_COMP_MIXIN_MIXOUT */
+
+const struct bench_kernel bench_pcm_kernels[] = {
+	BENCH_PCM(S16_LE, S24_4LE),
+	BENCH_PCM(S16_LE, S32_LE),
+	BENCH_PCM(S24_4LE, S16_LE),
+	BENCH_PCM(S24_4LE, S32_LE),
+	BENCH_PCM(S32_LE, S16_LE),
+	BENCH_PCM(S32_LE, S24_4LE),
+	BENCH_PCM(S16_LE, FLOAT),
+	BENCH_PCM(FLOAT, S16_LE),
+	BENCH_PCM(S32_LE, FLOAT),
+	BENCH_PCM(FLOAT, S32_LE),
+#if CONFIG_COMP_VOLUME
+#if CONFIG_FORMAT_S16LE
+	BENCH_VOL(S16_LE),
+#endif
+#if CONFIG_FORMAT_S24LE
+	BENCH_VOL(S24_4LE),
+#endif
+#if CONFIG_FORMAT_S32LE
+	BENCH_VOL(S32_LE),
+#endif
+#endif /* CONFIG_COMP_VOLUME */
+#if CONFIG_COMP_MIXIN_MIXOUT
+#if CONFIG_FORMAT_S16LE
+	BENCH_MIX(S16_LE, 0),
+	BENCH_MIX(S16_LE, 1),
+	BENCH_MIX_GROUP(S16_LE, 0),
+	BENCH_MIX_GROUP(S16_LE, 1),
+#endif
+#if CONFIG_FORMAT_S24LE
+	BENCH_MIX(S24_4LE, 0),
+	BENCH_MIX(S24_4LE, 1),
+	BENCH_MIX_GROUP(S24_4LE, 0),
+	BENCH_MIX_GROUP(S24_4LE, 1),
+#endif
+#if CONFIG_FORMAT_S32LE
+	BENCH_MIX(S32_LE, 0),
+	BENCH_MIX(S32_LE, 1),
+	BENCH_MIX_GROUP(S32_LE, 0),
+	BENCH_MIX_GROUP(S32_LE, 1),
+#endif
+#endif /* CONFIG_COMP_MIXIN_MIXOUT */
+	{ NULL },
+};
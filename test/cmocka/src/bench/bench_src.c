@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/* Sample rate converter kernels, the frames count of a case is output frames */
+
+#include <sof/audio/audio_stream.h>
+#include <sof/common.h>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if CONFIG_COMP_SRC
+#include <src/src_common.h>
+#include <src/src_config.h>
+#if !SRC_SHORT
+#include <src/coef/src_ipc4_int32_2_1_4535_5000.h>
+#endif
+#endif
+
+#include "bench.h"
+
+#if CONFIG_COMP_SRC && !SRC_SHORT
+
+struct bench_src {
+	struct src_state state;
+	struct src_stage_prm prm;
+	int32_t *delay;
+};
+
+static const struct src_stage *const bench_src_stage = &src_int32_2_1_4535_5000;
+
+/* bc->frames is the output frames count */
+static int bench_src_init(const struct bench_kernel *k, struct bench_case *bc)
+{
+	const struct src_stage *stage = bench_src_stage;
+	struct bench_src *b;
+	int times;
+	int ret;
+
+	if (bc->frames % stage->blk_out)
+		return -EINVAL;
+
+	times = bc->frames / stage->blk_out;
+	ret = bench_stream_alloc(&bc->source, k->source_fmt, bc->channels,
+				 times * stage->blk_in);
+	if (ret < 0)
+		return ret;
+
+	b = calloc(1, sizeof(*b));
+	if (!b)
+		return -ENOMEM;
+
+	b->state.fir_delay_size = bc->channels * src_fir_delay_length(stage);
+	b->state.out_delay_size = bc->channels * src_out_delay_length(stage);
+	b->delay = calloc(b->state.fir_delay_size + b->state.out_delay_size, sizeof(int32_t));
+	if (!b->delay) {
+		free(b);
+		return -ENOMEM;
+	}
+
+	b->state.fir_delay = b->delay;
+	b->state.out_delay = b->delay + b->state.fir_delay_size;
+	b->state.fir_wp = &b->state.fir_delay[b->state.fir_delay_size - 1];
+	b->state.out_rp = b->state.out_delay;
+
+	b->prm.nch = bc->channels;
+	b->prm.times = times;
+	b->prm.x_size = audio_stream_get_size(&bc->source);
+	b->prm.x_end_addr = audio_stream_get_end_addr(&bc->source);
+	b->prm.y_addr = audio_stream_get_addr(&bc->sink);
+	b->prm.y_size = audio_stream_get_size(&bc->sink);
+	b->prm.y_end_addr = audio_stream_get_end_addr(&bc->sink);
+	b->prm.shift = k->source_fmt == SOF_IPC_FRAME_S24_4LE ? 8 : 0;
+	b->prm.state = &b->state;
+	b->prm.stage = stage;
+
+	bc->priv = b;
+	return 0;
+}
+
+static void bench_src_run(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_src *b = bc->priv;
+	void (*func)(struct src_stage_prm *s) = k->data;
+
+	b->prm.x_rptr = audio_stream_get_addr(&bc->source);
+	b->prm.y_wptr = audio_stream_get_addr(&bc->sink);
+	func(&b->prm);
+}
+
+static void bench_src_free(const struct bench_kernel *k, struct bench_case *bc)
+{
+	struct bench_src *b = bc->priv;
+
+	free(b->delay);
+	free(b);
+}
+
+#define BENCH_SRC(fmt, func) \
+	{ "src_polyphase_stage_cir", fmt, fmt, 0, bench_src_init, bench_src_run, \
+	  bench_src_free, func }
+
+#endif /* CONFIG_COMP_SRC && !SRC_SHORT */
+
+const struct bench_kernel bench_src_kernels[] = {
+#if CONFIG_COMP_SRC && !SRC_SHORT
+#if CONFIG_FORMAT_S16LE
+	BENCH_SRC(SOF_IPC_FRAME_S16_LE, src_polyphase_stage_cir_s16),
+#endif
+#if CONFIG_FORMAT_S24LE
+	BENCH_SRC(SOF_IPC_FRAME_S24_4LE, src_polyphase_stage_cir),
+#endif
+#if CONFIG_FORMAT_S32LE
+	BENCH_SRC(SOF_IPC_FRAME_S32_LE, src_polyphase_stage_cir),
+#endif
+#endif /* CONFIG_COMP_SRC && !SRC_SHORT */
+	{ NULL },
+};
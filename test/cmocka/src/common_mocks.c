@@ -63,6 +63,16 @@ void WEAK *rzalloc(enum mem_zone zone, uint32_t flags, uint32_t caps,
 	return calloc(bytes, 1);
 }
 
+void WEAK *rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps,
+		   size_t bytes)
+{
+	(void)zone;
+	(void)flags;
+	(void)caps;
+
+	return malloc(bytes);
+}
+
 void WEAK *rbrealloc_align(void *ptr, uint32_t flags, uint32_t caps,
 			   size_t bytes, size_t old_bytes, uint32_t alignment)
 {
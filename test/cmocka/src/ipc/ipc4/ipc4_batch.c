@@ -0,0 +1,315 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <rtos/sof.h>
+#include <sof/audio/component_ext.h>
+#include <sof/audio/pipeline.h>
+#include <sof/ipc/common.h>
+#include <sof/ipc/driver.h>
+#include <sof/ipc/msg.h>
+#include <sof/ipc/topology.h>
+#include <sof/lib/pm_runtime.h>
+#include <ipc4/error_status.h>
+#include <ipc4/header.h>
+#include <ipc4/module.h>
+#include <ipc4/pipeline.h>
+
+/*
+ * Batches are sent to ipc_cmd() of the IPC4 handler as the testbench does,
+ * with the topology helpers it calls for the operations mocked below. Each
+ * mocked operation returns the next status of test_status[].
+ */
+
+#define TEST_MODULE_ID		1
+#define TEST_INSTANCE_ID	2
+#define TEST_PAYLOAD		0xc0ffee
+
+enum test_op {
+	TEST_OP_CREATE_PIPELINE,
+	TEST_OP_INIT_INSTANCE,
+	TEST_OP_BIND,
+	TEST_OP_LARGE_CONFIG_SET,
+	TEST_OPS,
+};
+
+struct test_parameters {
+	/* statuses returned by the mocked operations, in order */
+	int status[TEST_OPS];
+	/* payload size of the operations, a size beyond the batch is malformed */
+	uint32_t data_size[TEST_OPS];
+	/* expected reply */
+	uint32_t reply_status;
+	uint32_t executed_ops;
+	uint32_t called_ops;
+};
+
+static uint32_t test_mailbox[SOF_IPC_MSG_MAX_SIZE / sizeof(uint32_t)];
+static struct ipc test_ipc;
+static struct comp_dev test_dev;
+
+static const int *test_status;
+static uint32_t test_called_ops;
+static uint32_t test_payload[TEST_OPS];
+
+static int test_next_status(const void *data)
+{
+	if (data)
+		test_payload[test_called_ops] = *(const uint32_t *)data;
+
+	return test_status[test_called_ops++];
+}
+
+int ipc_pipeline_new(struct ipc *ipc, ipc_pipe_new *pipeline)
+{
+	return test_next_status(NULL);
+}
+
+struct comp_dev *comp_new_ipc4(struct ipc4_module_init_instance *module_init, char *data)
+{
+	return test_next_status(data) ? NULL : &test_dev;
+}
+
+int ipc_comp_connect(struct ipc *ipc, ipc_pipe_comp_connect *connect)
+{
+	return test_next_status(NULL);
+}
+
+static int test_set_large_config(struct comp_dev *dev, uint32_t param_id, bool first_block,
+				 bool last_block, uint32_t data_offset, const char *data)
+{
+	return test_next_status(data);
+}
+
+static const struct comp_driver test_drv = {
+	.ops = {
+		.set_large_config = test_set_large_config,
+	},
+};
+
+struct comp_dev *ipc4_get_comp_dev(uint32_t comp_id)
+{
+	return &test_dev;
+}
+
+/* not used by a batch */
+const struct comp_driver *ipc4_get_comp_drv(uint32_t module_id)
+{
+	return NULL;
+}
+
+int ipc_comp_disconnect(struct ipc *ipc, ipc_pipe_comp_connect *connect)
+{
+	return -EINVAL;
+}
+
+int ipc_comp_free(struct ipc *ipc, uint32_t comp_id)
+{
+	return -EINVAL;
+}
+
+int ipc_pipeline_free(struct ipc *ipc, uint32_t comp_id)
+{
+	return -EINVAL;
+}
+
+int ipc4_pipeline_complete(struct ipc *ipc, uint32_t comp_id, uint32_t cmd)
+{
+	return -EINVAL;
+}
+
+int comp_verify_params(struct comp_dev *dev, uint32_t flag, struct sof_ipc_stream_params *params)
+{
+	return -EINVAL;
+}
+
+int pipeline_for_each_comp(struct comp_dev *current,
+			   struct pipeline_walk_context *ctx, int dir)
+{
+	return -EINVAL;
+}
+
+int pipeline_prepare(struct pipeline *p, struct comp_dev *cd)
+{
+	return -EINVAL;
+}
+
+int pipeline_reset(struct pipeline *p, struct comp_dev *host_cd)
+{
+	return -EINVAL;
+}
+
+int pipeline_trigger(struct pipeline *p, struct comp_dev *host, int cmd)
+{
+	return -EINVAL;
+}
+
+int platform_context_save(struct sof *sof)
+{
+	return 0;
+}
+
+void pm_runtime_enable(enum pm_runtime_context context, uint32_t index)
+{
+}
+
+void pm_runtime_disable(enum pm_runtime_context context, uint32_t index)
+{
+}
+
+void ipc_msg_send_direct(struct ipc_msg *msg, void *data)
+{
+}
+
+int ipc_platform_compact_read_msg(struct ipc_cmd_hdr *hdr, int words)
+{
+	return 0;
+}
+
+static int setup(void **state)
+{
+	memset(test_mailbox, 0, sizeof(test_mailbox));
+	memset(test_payload, 0, sizeof(test_payload));
+	test_called_ops = 0;
+
+	test_ipc.comp_data = test_mailbox;
+	list_init(&test_ipc.msg_list);
+	list_init(&test_ipc.comp_list);
+	sof_get()->ipc = &test_ipc;
+
+	test_dev.drv = &test_drv;
+	return 0;
+}
+
+/* appends an operation with a payload of data_size bytes, the payload is not copied
+ * past the end of the batch when data_size is malformed
+ */
+static uint32_t test_add_op(uint8_t *data, enum test_op op, uint32_t data_size)
+{
+	struct ipc4_batch_op *batch_op = (struct ipc4_batch_op *)data;
+	struct ipc4_pipeline_create *ppl = (struct ipc4_pipeline_create *)&batch_op->msg;
+	struct ipc4_module_init_instance *init = (struct ipc4_module_init_instance *)&batch_op->msg;
+	struct ipc4_module_bind_unbind *bu = (struct ipc4_module_bind_unbind *)&batch_op->msg;
+	struct ipc4_module_large_config *config = (struct ipc4_module_large_config *)&batch_op->msg;
+	uint32_t payload = TEST_PAYLOAD + op;
+
+	batch_op->data_size = data_size;
+
+	switch (op) {
+	case TEST_OP_CREATE_PIPELINE:
+		ppl->primary.r.type = SOF_IPC4_GLB_CREATE_PIPELINE;
+		ppl->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG;
+		ppl->primary.r.instance_id = TEST_INSTANCE_ID;
+		return sizeof(*batch_op);
+	case TEST_OP_INIT_INSTANCE:
+		init->primary.r.type = SOF_IPC4_MOD_INIT_INSTANCE;
+		init->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_MODULE_MSG;
+		init->primary.r.module_id = TEST_MODULE_ID;
+		init->primary.r.instance_id = TEST_INSTANCE_ID;
+		init->extension.r.param_block_size = sizeof(payload) / sizeof(uint32_t);
+		break;
+	case TEST_OP_BIND:
+		bu->primary.r.type = SOF_IPC4_MOD_BIND;
+		bu->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_MODULE_MSG;
+		bu->primary.r.module_id = TEST_MODULE_ID;
+		bu->extension.r.dst_module_id = TEST_MODULE_ID;
+		bu->extension.r.dst_instance_id = TEST_INSTANCE_ID;
+		return sizeof(*batch_op);
+	case TEST_OP_LARGE_CONFIG_SET:
+		config->primary.r.type = SOF_IPC4_MOD_LARGE_CONFIG_SET;
+		config->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_MODULE_MSG;
+		config->primary.r.module_id = TEST_MODULE_ID;
+		config->primary.r.instance_id = TEST_INSTANCE_ID;
+		config->extension.r.init_block = 1;
+		config->extension.r.final_block = 1;
+		config->extension.r.data_off_size = sizeof(payload);
+		break;
+	default:
+		return 0;
+	}
+
+	memcpy_s(batch_op + 1, sizeof(payload), &payload, sizeof(payload));
+	return sizeof(*batch_op) + (data_size == sizeof(payload) ? data_size : sizeof(payload));
+}
+
+static void test_ipc4_batch(void **state)
+{
+	struct test_parameters *params = *state;
+	struct ipc4_batch *batch = (struct ipc4_batch *)test_mailbox;
+	struct ipc4_message_reply *reply = (struct ipc4_message_reply *)test_mailbox;
+	uint8_t *data = (uint8_t *)(batch + 1);
+	uint32_t *status = (uint32_t *)(reply + 1);
+	uint32_t size = 0;
+	int op;
+
+	for (op = 0; op < TEST_OPS; op++)
+		size += test_add_op(data + size, op, params->data_size[op]);
+
+	batch->primary.r.num_ops = TEST_OPS;
+	batch->primary.r.type = SOF_IPC4_GLB_BATCH;
+	batch->primary.r.rsp = SOF_IPC4_MESSAGE_DIR_MSG_REQUEST;
+	batch->primary.r.msg_tgt = SOF_IPC4_MESSAGE_TARGET_FW_GEN_MSG;
+	batch->extension.r.data_size = size;
+
+	test_status = params->status;
+	ipc_cmd(NULL);
+
+	assert_int_equal(reply->primary.r.rsp, SOF_IPC4_MESSAGE_DIR_MSG_REPLY);
+	assert_int_equal(reply->primary.r.type, SOF_IPC4_GLB_BATCH);
+	assert_int_equal(reply->primary.r.status, params->reply_status);
+	assert_int_equal(reply->extension.dat, params->executed_ops);
+	assert_int_equal(test_called_ops, params->called_ops);
+
+	/* the operations run in order, only the last executed one may fail */
+	for (op = 0; op < params->executed_ops; op++)
+		assert_int_equal(status[op],
+				 op == params->executed_ops - 1 ? params->reply_status : 0);
+
+	/* each payload reached its operation */
+	if (test_called_ops > TEST_OP_INIT_INSTANCE)
+		assert_int_equal(test_payload[TEST_OP_INIT_INSTANCE],
+				 TEST_PAYLOAD + TEST_OP_INIT_INSTANCE);
+	if (test_called_ops > TEST_OP_LARGE_CONFIG_SET)
+		assert_int_equal(test_payload[TEST_OP_LARGE_CONFIG_SET],
+				 TEST_PAYLOAD + TEST_OP_LARGE_CONFIG_SET);
+}
+
+static struct test_parameters parameters[] = {
+	/* all succeed */
+	{ { 0, 0, 0, 0 }, { 0, 4, 0, 4 }, IPC4_SUCCESS, 4, 4 },
+	/* the bind fails, the config set is not executed */
+	{ { 0, 0, IPC4_INVALID_RESOURCE_ID, 0 }, { 0, 4, 0, 4 },
+	  IPC4_INVALID_RESOURCE_ID, 3, 3 },
+	/* the module init fails */
+	{ { 0, 1, 0, 0 }, { 0, 4, 0, 4 }, IPC4_MOD_NOT_INITIALIZED, 2, 2 },
+	/* the large config set fails */
+	{ { 0, 0, 0, -EINVAL }, { 0, 4, 0, 4 }, IPC4_INVALID_RESOURCE_ID, 4, 4 },
+	/* the init payload overruns the batch, nothing is executed after */
+	{ { 0, 0, 0, 0 }, { 0, 4096, 0, 4 }, IPC4_INVALID_CONFIG_DATA_LEN, 2, 1 },
+};
+
+int main(void)
+{
+	int i;
+
+	struct CMUnitTest tests[ARRAY_SIZE(parameters)];
+
+	for (i = 0; i < ARRAY_SIZE(parameters); i++) {
+		tests[i].name = "test_ipc4_batch";
+		tests[i].test_func = test_ipc4_batch;
+		tests[i].setup_func = setup;
+		tests[i].teardown_func = NULL;
+		tests[i].initial_state = &parameters[i];
+	}
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
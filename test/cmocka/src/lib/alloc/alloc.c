@@ -13,6 +13,7 @@
 
 #include <rtos/sof.h>
 #include <rtos/alloc.h>
+#include <sof/lib/cpu.h>
 #include <sof/lib/mm_heap.h>
 #include <sof/lib/memory.h>
 #include <ipc/header.h>
@@ -21,7 +22,10 @@
 enum test_type {
 	TEST_BULK = 0,
 	TEST_ZERO,
-	TEST_IMMEDIATE_FREE
+	TEST_IMMEDIATE_FREE,
+#if CONFIG_MM_SLAB
+	TEST_SLAB,
+#endif
 };
 
 struct test_case {
@@ -161,6 +165,17 @@ static struct test_case test_cases[] = {
 	TEST_CASE(256, SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM |
 		  SOF_MEM_CAPS_DMA, 2, TEST_ZERO, "rzalloc_dma"),
 
+#if CONFIG_MM_SLAB
+	/*
+	 * slab tests
+	 */
+
+	TEST_CASE(100, SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 4, TEST_SLAB,
+		  "slab"),
+	TEST_CASE(400, SOF_MEM_ZONE_RUNTIME, SOF_MEM_CAPS_RAM, 2, TEST_SLAB,
+		  "slab"),
+#endif
+
 	/*
 	 * rballoc tests
 	 */
@@ -304,6 +319,47 @@ static void test_lib_alloc_zero(struct test_case *tc)
 	free(all_mem);
 }
 
+#if CONFIG_MM_SLAB
+static void test_lib_alloc_slab(struct test_case *tc)
+{
+	size_t stride = ALIGN_UP(tc->alloc_size, MM_SLAB_ALIGN);
+	char **all_mem = malloc(sizeof(char *) * tc->alloc_num);
+	struct mm_slab_info before, info;
+	char *mem;
+	int i;
+
+	assert_int_equal(heap_slab_info(tc->alloc_zone, cpu_get_id(), &before), 0);
+
+	for (i = 0; i < tc->alloc_num; ++i) {
+		all_mem[i] = alloc(tc);
+		assert_non_null(all_mem[i]);
+
+		/* objects of a size are packed into a page */
+		if (i)
+			assert_int_equal(all_mem[i] - all_mem[i - 1], stride);
+	}
+
+	assert_int_equal(heap_slab_info(tc->alloc_zone, cpu_get_id(), &info), 0);
+	assert_int_equal(info.objs_used, before.objs_used + tc->alloc_num);
+	assert_int_equal(info.allocs, before.allocs + tc->alloc_num);
+	assert_int_equal(info.pages, before.pages + 1);
+
+	/* a freed slot is handed out again right away */
+	rfree(all_mem[0]);
+	mem = alloc(tc);
+	assert_ptr_equal(mem, all_mem[0]);
+
+	alloc_free((void **)all_mem, tc);
+
+	/* the empty page went back to the heap */
+	assert_int_equal(heap_slab_info(tc->alloc_zone, cpu_get_id(), &info), 0);
+	assert_int_equal(info.objs_used, before.objs_used);
+	assert_int_equal(info.pages, before.pages);
+
+	free(all_mem);
+}
+#endif
+
 static void test_lib_alloc(void **state)
 {
 	struct test_case *tc = *((struct test_case **)state);
@@ -320,6 +376,12 @@ static void test_lib_alloc(void **state)
 	case TEST_IMMEDIATE_FREE:
 		test_lib_alloc_immediate_free(tc);
 		break;
+
+#if CONFIG_MM_SLAB
+	case TEST_SLAB:
+		test_lib_alloc_slab(tc);
+		break;
+#endif
 	}
 }
 
@@ -66,6 +66,10 @@ static const int testdata[33][100] = {
 	{ 33 },
 };
 
+/* each SRAM copy takes two allocations, the entry and the copy itself */
+static int allocations;
+#define sram_copies (allocations / 2)
+
 static void test_simple_fast_get_put(void **state)
 {
 	const void *ret;
@@ -142,6 +146,45 @@ static void test_fast_get_refcounting(void **state)
 		fast_put(copy[1][i]);
 }
 
+#if CONFIG_FAST_GET_LRU_SIZE
+static void test_fast_get_lru(void **state)
+{
+	const size_t size = sizeof(testdata[0]);
+	const int retained = CONFIG_FAST_GET_LRU_SIZE / size;
+	const void *copy[ARRAY_SIZE(testdata)];
+	int others;
+	int i;
+
+	(void)state; /* unused */
+
+	/* testdata[0] is still referenced by the size mismatch test, skip it */
+	for (i = 1; i < ARRAY_SIZE(copy); i++)
+		copy[i] = fast_get(testdata[i], size);
+	others = sram_copies - (ARRAY_SIZE(copy) - 1);
+
+	/* released copies stay in SRAM up to the budget */
+	for (i = 1; i < ARRAY_SIZE(copy); i++)
+		fast_put(copy[i]);
+	assert(sram_copies == others + retained);
+
+	/* the most recently released copies are reused without copying */
+	for (i = ARRAY_SIZE(copy) - retained; i < ARRAY_SIZE(copy); i++) {
+		assert(fast_get(testdata[i], size) == copy[i]);
+		assert(sram_copies == others + retained);
+	}
+
+	/* an evicted one has to be copied again */
+	copy[1] = fast_get(testdata[1], size);
+	assert(!memcmp(copy[1], testdata[1], size));
+	assert(sram_copies == others + retained + 1);
+
+	fast_put(copy[1]);
+	for (i = ARRAY_SIZE(copy) - retained; i < ARRAY_SIZE(copy); i++)
+		fast_put(copy[i]);
+	assert(sram_copies == others + retained);
+}
+#endif
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -149,6 +192,9 @@ int main(void)
 		cmocka_unit_test(test_fast_get_size_missmatch_test),
 		cmocka_unit_test(test_over_32_fast_gets_and_puts),
 		cmocka_unit_test(test_fast_get_refcounting),
+#if CONFIG_FAST_GET_LRU_SIZE
+		cmocka_unit_test(test_fast_get_lru),
+#endif
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
@@ -172,6 +218,7 @@ void *__wrap_rzalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t b
 	assert(ret);
 
 	memset(ret, 0, bytes);
+	allocations++;
 
 	return ret;
 }
@@ -186,11 +233,14 @@ void *__wrap_rmalloc(enum mem_zone zone, uint32_t flags, uint32_t caps, size_t b
 	ret = malloc(bytes);
 
 	assert(ret);
+	allocations++;
 
 	return ret;
 }
 
 void __wrap_rfree(void *ptr)
 {
+	if (ptr)
+		allocations--;
 	free(ptr);
 }
@@ -786,6 +786,227 @@ static void test_math_fft_1024_ifft_16(void **state)
 	assert_int_equal(db < FFT_DB_TH_16, 0);
 }
 
+/* Real FFT round trip SNR threshold for a -6 dBFS sine with noise and DC */
+#define FFT_REAL_DB_TH	85.0
+
+static uint32_t lcg = 1;
+
+static int32_t rand_32(void)
+{
+	lcg = lcg * 1664525 + 1013904223;
+	return (int32_t)lcg;
+}
+
+/* RMS error of bins 0 .. N / 2 to the double precision DFT scaled by 1/N */
+static double dft_error(const struct icomplex32 *spec, const int32_t *x, int size)
+{
+	double err = 0;
+	double ref_re;
+	double ref_im;
+	int k;
+	int n;
+
+	for (k = 0; k <= size / 2; k++) {
+		ref_re = 0;
+		ref_im = 0;
+		for (n = 0; n < size; n++) {
+			ref_re += x[n] * cos(TWO_PI * k * n / size);
+			ref_im -= x[n] * sin(TWO_PI * k * n / size);
+		}
+
+		ref_re = spec[k].real - ref_re / size;
+		ref_im = spec[k].imag - ref_im / size;
+		err += ref_re * ref_re + ref_im * ref_im;
+	}
+
+	return sqrt(err / (size / 2 + 1));
+}
+
+/* Checks the real FFT against the complex FFT and the real IFFT round trip */
+static void test_fft_real_32(uint32_t size)
+{
+	struct fft_real_plan *rplan;
+	struct fft_real_plan *iplan;
+	struct fft_plan *plan;
+	struct icomplex32 *ref;
+	struct icomplex32 *cin;
+	struct icomplex32 *spec;
+	int32_t *x;
+	int32_t *y;
+	double err_real;
+	double err_complex;
+	int64_t signal = 0;
+	int64_t noise = 0;
+	float db;
+	int i;
+
+	x = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(int32_t));
+	y = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(int32_t));
+	cin = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(*cin));
+	ref = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(*ref));
+	spec = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		       (size / 2 + 1) * sizeof(*spec));
+	assert_non_null(x);
+	assert_non_null(y);
+	assert_non_null(cin);
+	assert_non_null(ref);
+	assert_non_null(spec);
+
+	/* sine with noise and a DC offset to excite all bins */
+	get_sine_32(x, SINE_FREQ, SINE_FS, size);
+	for (i = 0; i < size; i++) {
+		x[i] = (x[i] >> 1) + (rand_32() >> 8) + (1 << 28);
+		cin[i].real = x[i];
+	}
+
+	plan = fft_plan_new(cin, ref, size, 32);
+	rplan = fft_real_plan_new(x, spec, size, 32);
+	iplan = fft_real_plan_new(spec, y, size, 32);
+	assert_non_null(plan);
+	assert_non_null(rplan);
+	assert_non_null(iplan);
+	assert_int_equal(rplan->len, plan->len);
+
+	/* the real FFT should be at least as accurate as the complex FFT */
+	fft_execute_32(plan, false);
+	fft_execute_real_32(rplan, false);
+	err_real = dft_error(spec, x, size);
+	err_complex = dft_error(ref, x, size);
+	printf("%s: size %u, RMS error: real %.2f, complex %.2f\n", __func__, size,
+	       err_real, err_complex);
+	assert_true(err_real <= err_complex);
+
+	fft_execute_real_32(iplan, true);
+	for (i = 0; i < size; i++) {
+		signal += (int64_t)(x[i] / 32) * (x[i] / 32);
+		noise += (int64_t)((y[i] - x[i]) / 32) * ((y[i] - x[i]) / 32);
+	}
+
+	/* avoid division by zero with exact round trip */
+	db = 10 * log10((float)signal / (noise + 1));
+	printf("%s: size %u, SNR: %6.2f dB\n", __func__, size, db);
+	assert_int_equal(db < FFT_REAL_DB_TH, 0);
+
+	fft_real_plan_free(iplan);
+	fft_real_plan_free(rplan);
+	fft_plan_free(plan);
+	rfree(spec);
+	rfree(ref);
+	rfree(cin);
+	rfree(y);
+	rfree(x);
+}
+
+static void test_fft_real_16(uint32_t size)
+{
+	struct fft_real_plan *rplan;
+	struct fft_real_plan *iplan;
+	struct fft_plan *plan;
+	struct icomplex16 *ref;
+	struct icomplex16 *cin;
+	struct icomplex16 *spec;
+	struct icomplex32 *tmp;
+	int32_t *x32;
+	int16_t *x;
+	int16_t *y;
+	double err_real;
+	double err_complex;
+	int64_t signal = 0;
+	int64_t noise = 0;
+	float db;
+	int i;
+
+	x = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(int16_t));
+	y = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(int16_t));
+	cin = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(*cin));
+	ref = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(*ref));
+	spec = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM,
+		       (size / 2 + 1) * sizeof(*spec));
+	tmp = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, (size / 2 + 1) * sizeof(*tmp));
+	x32 = rzalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size * sizeof(int32_t));
+	assert_non_null(tmp);
+	assert_non_null(x32);
+	assert_non_null(x);
+	assert_non_null(y);
+	assert_non_null(cin);
+	assert_non_null(ref);
+	assert_non_null(spec);
+
+	get_sine_16(x, SINE_FREQ, SINE_FS, size);
+	for (i = 0; i < size; i++) {
+		x[i] = (x[i] >> 1) + (rand_32() >> 24) + (1 << 12);
+		x32[i] = x[i];
+		cin[i].real = x[i];
+	}
+
+	plan = fft_plan_new(cin, ref, size, 16);
+	rplan = fft_real_plan_new(x, spec, size, 16);
+	iplan = fft_real_plan_new(spec, y, size, 16);
+	assert_non_null(plan);
+	assert_non_null(rplan);
+	assert_non_null(iplan);
+
+	fft_execute_16(plan, false);
+	fft_execute_real_16(rplan, false);
+	for (i = 0; i <= size / 2; i++) {
+		tmp[i].real = spec[i].real;
+		tmp[i].imag = spec[i].imag;
+	}
+
+	err_real = dft_error(tmp, x32, size);
+	for (i = 0; i <= size / 2; i++) {
+		tmp[i].real = ref[i].real;
+		tmp[i].imag = ref[i].imag;
+	}
+
+	err_complex = dft_error(tmp, x32, size);
+	printf("%s: size %u, RMS error: real %.2f, complex %.2f\n", __func__, size,
+	       err_real, err_complex);
+	assert_true(err_real <= err_complex);
+
+	fft_execute_real_16(iplan, true);
+	for (i = 0; i < size; i++) {
+		signal += (int64_t)x[i] * x[i];
+		noise += (int64_t)(y[i] - x[i]) * (y[i] - x[i]);
+	}
+
+	db = 10 * log10((float)signal / (noise + 1));
+	printf("%s: size %u, SNR: %6.2f dB\n", __func__, size, db);
+	assert_int_equal(db < FFT_DB_TH_16, 0);
+
+	fft_real_plan_free(iplan);
+	fft_real_plan_free(rplan);
+	fft_plan_free(plan);
+	rfree(x32);
+	rfree(tmp);
+	rfree(spec);
+	rfree(ref);
+	rfree(cin);
+	rfree(y);
+	rfree(x);
+}
+
+static void test_math_fft_real_256(void **state)
+{
+	(void)state;
+
+	test_fft_real_32(256);
+}
+
+static void test_math_fft_real_1024(void **state)
+{
+	(void)state;
+
+	test_fft_real_32(1024);
+}
+
+static void test_math_fft_real_512_16(void **state)
+{
+	(void)state;
+
+	test_fft_real_16(512);
+}
+
 int main(void)
 {
 	const struct CMUnitTest tests[] = {
@@ -798,6 +1019,9 @@ int main(void)
 		cmocka_unit_test(test_math_fft_1024),
 		cmocka_unit_test(test_math_fft_1024_ifft),
 		cmocka_unit_test(test_math_fft_512_2ch),
+		cmocka_unit_test(test_math_fft_real_256),
+		cmocka_unit_test(test_math_fft_real_1024),
+		cmocka_unit_test(test_math_fft_real_512_16),
 	};
 
 	cmocka_set_message_output(CM_OUTPUT_TAP);
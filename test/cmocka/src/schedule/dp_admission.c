@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <sof/schedule/dp_admission.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+static void test_dp_admission_kcps(void **state)
+{
+	(void)state;
+
+	/* 1 ms chunks: CPC is the KCPS */
+	assert_int_equal(dp_admission_kcps(50000, 1000), 50000);
+	/* 10 ms chunks take a tenth */
+	assert_int_equal(dp_admission_kcps(50000, 10000), 5000);
+	/* rounded up */
+	assert_int_equal(dp_admission_kcps(1, 3000), 1);
+	/* no declared CPC, no period */
+	assert_int_equal(dp_admission_kcps(0, 1000), 0);
+	assert_int_equal(dp_admission_kcps(1000, 0), 0);
+	/* no overflow for large CPC */
+	assert_int_equal(dp_admission_kcps(4000000, 1000), 4000000);
+}
+
+static void test_dp_admission_period(void **state)
+{
+	(void)state;
+
+	/* 10 ms of 48 kHz stereo 32 bit */
+	assert_int_equal(dp_admission_period_us(3840, 8, 48000), 10000);
+	/* 1 ms of 16 kHz mono 16 bit */
+	assert_int_equal(dp_admission_period_us(32, 2, 16000), 1000);
+	assert_int_equal(dp_admission_period_us(3840, 0, 48000), 0);
+	assert_int_equal(dp_admission_period_us(3840, 8, 0), 0);
+}
+
+static void test_dp_admission_headroom(void **state)
+{
+	const uint32_t load[4] = { 300000, 100000, 400000, 0 };
+
+	(void)state;
+
+	assert_int_equal(dp_admission_headroom(320000, 300000), 20000);
+	assert_int_equal(dp_admission_headroom(320000, 320000), 0);
+	assert_int_equal(dp_admission_headroom(320000, 400000), 0);
+
+	/* core 3 is idle but disabled */
+	assert_int_equal(dp_admission_best_core(load, 320000, 0x7, 4), 1);
+	assert_int_equal(dp_admission_best_core(load, 320000, 0xf, 4), 3);
+	/* all candidates full, still a valid core */
+	assert_int_equal(dp_admission_best_core(load, 100000, 0x5, 4), 0);
+	assert_int_equal(dp_admission_best_core(load, 320000, 0, 4), -1);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_dp_admission_kcps),
+		cmocka_unit_test(test_dp_admission_period),
+		cmocka_unit_test(test_dp_admission_headroom),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
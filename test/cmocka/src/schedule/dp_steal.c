@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <sof/schedule/dp_steal.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+static void test_dp_steal_allowed(void **state)
+{
+	(void)state;
+
+	/* an idle core runs its own task */
+	assert_false(dp_steal_allowed(true, 10000, 4096, 8192, false));
+	assert_true(dp_steal_allowed(true, 10000, 4096, 8192, true));
+	assert_true(dp_steal_allowed(true, 4000, 8192, 8192, true));
+
+	/* the module did not opt in */
+	assert_false(dp_steal_allowed(false, 10000, 4096, 8192, true));
+	/* too short period to pay for the move */
+	assert_false(dp_steal_allowed(true, 1000, 4096, 8192, true));
+	/* does not fit into the worker stack */
+	assert_false(dp_steal_allowed(true, 10000, 16384, 8192, true));
+}
+
+static void test_dp_steal_order(void **state)
+{
+	struct list_item queue = LIST_INIT(queue);
+	struct dp_steal_entry e[4] = {
+		{ .core = 0 }, { .core = 1 }, { .core = 0 }, { .core = 2 },
+	};
+	int i;
+
+	(void)state;
+
+	for (i = 0; i < 4; i++)
+		list_init(&e[i].list);
+
+	dp_steal_push(&queue, &e[0], 300);
+	dp_steal_push(&queue, &e[1], 100);
+	dp_steal_push(&queue, &e[2], 200);
+	dp_steal_push(&queue, &e[3], 300);
+
+	/* earliest deadline of other cores first, equal deadlines in push order */
+	assert_ptr_equal(dp_steal_pop(&queue, 1), &e[2]);
+	assert_ptr_equal(dp_steal_pop(&queue, 1), &e[0]);
+	assert_false(e[0].queued);
+	assert_ptr_equal(dp_steal_pop(&queue, 1), &e[3]);
+
+	/* only own tasks left */
+	assert_null(dp_steal_pop(&queue, 1));
+	assert_ptr_equal(dp_steal_pop(&queue, 0), &e[1]);
+	assert_true(list_is_empty(&queue));
+}
+
+static void test_dp_steal_remove(void **state)
+{
+	struct list_item queue = LIST_INIT(queue);
+	struct dp_steal_entry a = { .core = 0 };
+	struct dp_steal_entry b = { .core = 0 };
+
+	(void)state;
+
+	list_init(&a.list);
+	list_init(&b.list);
+
+	dp_steal_push(&queue, &a, 10);
+	dp_steal_push(&queue, &b, 20);
+
+	/* the own thread claims a task nobody has taken yet */
+	assert_true(dp_steal_remove(&a));
+	assert_false(a.queued);
+
+	/* and loses one a worker of another core has taken */
+	assert_ptr_equal(dp_steal_pop(&queue, 1), &b);
+	assert_false(dp_steal_remove(&b));
+	assert_false(dp_steal_remove(&a));
+	assert_true(list_is_empty(&queue));
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_dp_steal_allowed),
+		cmocka_unit_test(test_dp_steal_order),
+		cmocka_unit_test(test_dp_steal_remove),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
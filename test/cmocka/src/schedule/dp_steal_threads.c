@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <sof/schedule/dp_steal.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <cmocka.h>
+
+/* tasks of core 0 are offered every round, workers of the other cores race its own thread */
+#define TEST_CORES	4
+#define TEST_TASKS	4
+#define TEST_ROUNDS	5000
+
+struct test_steal_ctx {
+	pthread_mutex_t lock;		/* stands in for the scheduler lock */
+	struct list_item queue;
+	struct dp_steal_entry entry[TEST_TASKS];
+	uint32_t runs[TEST_TASKS];	/* runs of each task, whoever claimed them */
+	uint32_t stolen;		/* runs claimed by workers */
+	uint32_t total;			/* runs of all tasks */
+	bool done;
+};
+
+struct test_steal_worker {
+	struct test_steal_ctx *ctx;
+	int core;
+};
+
+static void test_steal_run(struct test_steal_ctx *ctx, struct dp_steal_entry *entry, int core)
+{
+	int task = entry - ctx->entry;
+
+	/* the run itself happens outside of the lock, as in the scheduler */
+	pthread_mutex_unlock(&ctx->lock);
+	sched_yield();
+	pthread_mutex_lock(&ctx->lock);
+
+	ctx->runs[task]++;
+	ctx->total++;
+	if (core != entry->core)
+		ctx->stolen++;
+}
+
+static void *test_steal_worker(void *arg)
+{
+	struct test_steal_worker *worker = arg;
+	struct test_steal_ctx *ctx = worker->ctx;
+	int core = worker->core;
+	struct dp_steal_entry *entry;
+
+	pthread_mutex_lock(&ctx->lock);
+	while (!ctx->done) {
+		entry = dp_steal_pop(&ctx->queue, core);
+		if (entry) {
+			test_steal_run(ctx, entry, core);
+			continue;
+		}
+
+		pthread_mutex_unlock(&ctx->lock);
+		sched_yield();
+		pthread_mutex_lock(&ctx->lock);
+	}
+	pthread_mutex_unlock(&ctx->lock);
+
+	return NULL;
+}
+
+static void test_dp_steal_threads(void **state)
+{
+	struct test_steal_ctx ctx = { .lock = PTHREAD_MUTEX_INITIALIZER };
+	struct test_steal_worker worker[TEST_CORES - 1];
+	pthread_t workers[TEST_CORES - 1];
+	uint32_t round;
+	uint32_t target;
+	int i;
+
+	(void)state;
+
+	list_init(&ctx.queue);
+	for (i = 0; i < TEST_TASKS; i++) {
+		list_init(&ctx.entry[i].list);
+		ctx.entry[i].core = 0;
+	}
+
+	for (i = 0; i < TEST_CORES - 1; i++) {
+		worker[i].ctx = &ctx;
+		worker[i].core = i + 1;
+		assert_int_equal(pthread_create(&workers[i], NULL, test_steal_worker,
+						&worker[i]), 0);
+	}
+
+	for (round = 0; round < TEST_ROUNDS; round++) {
+		target = (round + 1) * TEST_TASKS;
+
+		/* the LL tick of core 0 offers all its ready tasks */
+		pthread_mutex_lock(&ctx.lock);
+		for (i = 0; i < TEST_TASKS; i++)
+			dp_steal_push(&ctx.queue, &ctx.entry[i], (uint64_t)round * TEST_TASKS + i);
+
+		/* and the own threads claim whatever the workers have not taken yet */
+		for (i = 0; i < TEST_TASKS; i++)
+			if (dp_steal_remove(&ctx.entry[i]))
+				test_steal_run(&ctx, &ctx.entry[i], 0);
+
+		while (ctx.total != target) {
+			pthread_mutex_unlock(&ctx.lock);
+			sched_yield();
+			pthread_mutex_lock(&ctx.lock);
+		}
+
+		/* every task ran exactly once this round, on one core */
+		for (i = 0; i < TEST_TASKS; i++)
+			assert_int_equal(ctx.runs[i], round + 1);
+		assert_true(list_is_empty(&ctx.queue));
+		pthread_mutex_unlock(&ctx.lock);
+	}
+
+	pthread_mutex_lock(&ctx.lock);
+	ctx.done = true;
+	pthread_mutex_unlock(&ctx.lock);
+
+	for (i = 0; i < TEST_CORES - 1; i++)
+		assert_int_equal(pthread_join(workers[i], NULL), 0);
+
+	/* the workers did take some of the runs */
+	assert_true(ctx.stolen > 0);
+	assert_true(ctx.stolen < ctx.total);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_dp_steal_threads),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
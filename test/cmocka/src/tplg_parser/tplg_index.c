@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+#include <tplg_parser/topology.h>
+#include <rtos/string.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cmocka.h>
+
+/*
+ * Synthetic topology: a widget section of pipeline 1 with a mixer-controlled
+ * "PGA1.0" and a "BUF1.0", and a graph section routing BUF1.0 to PGA1.0.
+ */
+#define TEST_CTL_PRIV	8
+
+struct test_tplg {
+	uint8_t *data;
+	size_t size;
+	size_t widget_section;	/* offset of the widget section header */
+	size_t graph_section;	/* offset of the graph section header */
+};
+
+static void test_put_hdr(uint8_t *data, size_t *offset, uint32_t type, uint32_t index,
+			 uint32_t count, uint32_t payload_size)
+{
+	struct snd_soc_tplg_hdr *hdr = (struct snd_soc_tplg_hdr *)(data + *offset);
+
+	hdr->magic = SND_SOC_TPLG_MAGIC;
+	hdr->size = sizeof(*hdr);
+	hdr->type = type;
+	hdr->index = index;
+	hdr->count = count;
+	hdr->payload_size = payload_size;
+	*offset += sizeof(*hdr);
+}
+
+static void test_put_widget(uint8_t *data, size_t *offset, const char *name,
+			    uint32_t num_kcontrols)
+{
+	struct snd_soc_tplg_dapm_widget *widget =
+		(struct snd_soc_tplg_dapm_widget *)(data + *offset);
+
+	widget->size = sizeof(*widget);
+	strcpy(widget->name, name);
+	widget->num_kcontrols = num_kcontrols;
+	*offset += sizeof(*widget);
+}
+
+static void test_tplg_build(struct test_tplg *tplg)
+{
+	const size_t widgets = 2 * sizeof(struct snd_soc_tplg_dapm_widget) +
+			       sizeof(struct snd_soc_tplg_mixer_control) + TEST_CTL_PRIV;
+	const size_t routes = sizeof(struct snd_soc_tplg_dapm_graph_elem);
+	struct snd_soc_tplg_mixer_control *mixer;
+	struct snd_soc_tplg_dapm_graph_elem *route;
+	size_t offset = 0;
+
+	tplg->size = 2 * sizeof(struct snd_soc_tplg_hdr) + widgets + routes;
+	tplg->data = calloc(1, tplg->size);
+	assert_non_null(tplg->data);
+
+	tplg->widget_section = offset;
+	test_put_hdr(tplg->data, &offset, SND_SOC_TPLG_TYPE_DAPM_WIDGET, 1, 2, widgets);
+	test_put_widget(tplg->data, &offset, "PGA1.0", 1);
+
+	mixer = (struct snd_soc_tplg_mixer_control *)(tplg->data + offset);
+	mixer->hdr.size = sizeof(mixer->hdr);
+	mixer->hdr.ops.info = SND_SOC_TPLG_CTL_VOLSW;
+	mixer->size = sizeof(*mixer);
+	mixer->priv.size = TEST_CTL_PRIV;
+	offset += sizeof(*mixer) + TEST_CTL_PRIV;
+
+	test_put_widget(tplg->data, &offset, "BUF1.0", 0);
+
+	tplg->graph_section = offset;
+	test_put_hdr(tplg->data, &offset, SND_SOC_TPLG_TYPE_DAPM_GRAPH, 1, 1, routes);
+	route = (struct snd_soc_tplg_dapm_graph_elem *)(tplg->data + offset);
+	strcpy(route->source, "BUF1.0");
+	strcpy(route->sink, "PGA1.0");
+	offset += sizeof(*route);
+
+	assert_int_equal(offset, tplg->size);
+}
+
+/* copies the first bytes of the topology to end right before an inaccessible page */
+static uint8_t *test_guarded_copy(const struct test_tplg *tplg, size_t size, void **map,
+				  size_t *map_size)
+{
+	const size_t page = sysconf(_SC_PAGESIZE);
+	uint8_t *data;
+
+	*map_size = ALIGN_UP(size, page) + page;
+	*map = mmap(NULL, *map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+		    -1, 0);
+	assert_true(*map != MAP_FAILED);
+	assert_int_equal(mprotect((uint8_t *)*map + *map_size - page, page, PROT_NONE), 0);
+
+	data = (uint8_t *)*map + *map_size - page - size;
+	assert_int_equal(memcpy_s(data, size, tplg->data, size), 0);
+
+	return data;
+}
+
+static void test_tplg_index_full(void **state)
+{
+	struct tplg_context ctx = { .ipc_major = 4 };
+	struct test_tplg tplg;
+	struct tplg_index index;
+	int pipeline = 1;
+
+	(void)state;
+
+	test_tplg_build(&tplg);
+	ctx.tplg_base = tplg.data;
+	ctx.tplg_size = tplg.size;
+
+	assert_int_equal(tplg_index_build(&ctx, &index), 0);
+	assert_int_equal(index.num_sections, 2);
+	assert_int_equal(index.num_widgets, 2);
+	assert_int_equal(index.num_routes, 1);
+	assert_int_equal(index.routes[0].source, 1);
+	assert_int_equal(index.routes[0].sink, 0);
+	assert_int_equal(tplg_index_select_pipelines(&index, &pipeline, 1), 0);
+	assert_true(index.widgets[0].selected);
+	tplg_index_free(&index);
+
+	free(tplg.data);
+}
+
+static void test_tplg_index_truncated(void **state)
+{
+	struct tplg_context ctx = { .ipc_major = 4 };
+	struct test_tplg tplg;
+	struct tplg_index index;
+	size_t map_size;
+	size_t size;
+	void *map;
+	int ret;
+
+	(void)state;
+
+	test_tplg_build(&tplg);
+
+	/* no cut may read past the end, only whole sections still index */
+	for (size = 1; size < tplg.size; size++) {
+		ctx.tplg_base = test_guarded_copy(&tplg, size, &map, &map_size);
+		ctx.tplg_size = size;
+
+		ret = tplg_index_build(&ctx, &index);
+		if (size == tplg.graph_section) {
+			assert_int_equal(ret, 0);
+			assert_int_equal(index.num_widgets, 2);
+			tplg_index_free(&index);
+		} else {
+			assert_int_equal(ret, -EINVAL);
+		}
+		assert_int_equal(ctx.tplg_offset, 0);
+
+		munmap(map, map_size);
+	}
+
+	free(tplg.data);
+}
+
+static void test_tplg_index_truncated_file(void **state)
+{
+	char path[] = "/tmp/tplg_index_XXXXXX";
+	struct tplg_context ctx = { .ipc_major = 4, .tplg_file = path };
+	struct test_tplg tplg;
+	struct tplg_index index;
+	int fd;
+
+	(void)state;
+
+	test_tplg_build(&tplg);
+
+	/* the file ends in the middle of the kcontrol of the first widget */
+	fd = mkstemp(path);
+	assert_true(fd >= 0);
+	assert_int_equal(write(fd, tplg.data, tplg.graph_section - 16),
+			 tplg.graph_section - 16);
+	close(fd);
+
+	assert_int_equal(tplg_map(&ctx), 0);
+	assert_int_equal(tplg_index_build(&ctx, &index), -EINVAL);
+	tplg_unmap(&ctx);
+
+	unlink(path);
+	free(tplg.data);
+}
+
+static void test_tplg_index_bad_counts(void **state)
+{
+	struct tplg_context ctx = { .ipc_major = 4 };
+	struct snd_soc_tplg_hdr *hdr;
+	struct test_tplg tplg;
+	struct tplg_index index;
+
+	(void)state;
+
+	test_tplg_build(&tplg);
+	ctx.tplg_base = tplg.data;
+	ctx.tplg_size = tplg.size;
+
+	/* more routes than the graph section holds */
+	hdr = (struct snd_soc_tplg_hdr *)(tplg.data + tplg.graph_section);
+	hdr->count = 2;
+	assert_int_equal(tplg_index_build(&ctx, &index), -EINVAL);
+	hdr->count = 1;
+
+	/* more widgets than the widget section holds */
+	hdr = (struct snd_soc_tplg_hdr *)(tplg.data + tplg.widget_section);
+	hdr->count = 3;
+	assert_int_equal(tplg_index_build(&ctx, &index), -EINVAL);
+	hdr->count = 2;
+
+	/* payload beyond the end of the file */
+	hdr->payload_size += tplg.size;
+	assert_int_equal(tplg_index_build(&ctx, &index), -EINVAL);
+
+	free(tplg.data);
+}
+
+static void test_tplg_index_ipc3_select(void **state)
+{
+	struct tplg_context ctx = { .ipc_major = 3 };
+	struct test_tplg tplg;
+	struct tplg_index index;
+	int pipeline = 1;
+
+	(void)state;
+
+	test_tplg_build(&tplg);
+	ctx.tplg_base = tplg.data;
+	ctx.tplg_size = tplg.size;
+
+	/* IPC3 loaders set up everything, a selection is an error */
+	assert_int_equal(tplg_index_build(&ctx, &index), 0);
+	assert_int_equal(tplg_index_select_pipelines(&index, &pipeline, 1), -EOPNOTSUPP);
+	assert_false(index.partial);
+	tplg_index_free(&index);
+
+	free(tplg.data);
+}
+
+int main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_tplg_index_full),
+		cmocka_unit_test(test_tplg_index_truncated),
+		cmocka_unit_test(test_tplg_index_truncated_file),
+		cmocka_unit_test(test_tplg_index_bad_counts),
+		cmocka_unit_test(test_tplg_index_ipc3_select),
+	};
+
+	cmocka_set_message_output(CM_OUTPUT_TAP);
+
+	return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -43,20 +43,58 @@ struct ldc_entry_header {
 	uint32_t text_len;
 };
 
-/** Dictionary entry + unformatted parameters */
+/** How a parameter of a dictionary entry is passed to fprintf() */
+enum ldc_param_type {
+	LDC_PARAM_RAW = 0,	/**< unmodified */
+	LDC_PARAM_STRING,	/**< %s, not supported, replaced with the address */
+	LDC_PARAM_UUID,		/**< %pUx, replaced with the formatted uuid */
+	LDC_PARAM_ENTRY,	/**< %pQ, replaced with the text of another entry */
+};
+
+#define LDC_UUID_BE		(1 << 0)
+#define LDC_UUID_UPPER		(1 << 1)
+#define LDC_UUID_COLORS		(1 << 2)
+#define LDC_UUID_VARIANTS	8
+
+/** Dictionary entry, parsed on first use and then kept in the dictionary
+ * hash table for all subsequent log statements with the same address.
+ */
 struct ldc_entry {
 	struct ldc_entry_header header;
+	uint32_t address;
 	char *file_name;
-	char *text;
-	uint32_t *params;
+	char *location;		/**< file_name shortened for printing */
+	char *text;		/**< format string as in the dictionary */
+	char *format;		/**< text with %pU and %pQ rewritten to %s */
+	struct {
+		uint8_t type;	/**< enum ldc_param_type */
+		uint8_t flags;	/**< LDC_UUID_ flags of a LDC_PARAM_UUID */
+	} params[TRACE_MAX_PARAMS_COUNT];
+	struct ldc_entry *next;	/**< in the hash bucket */
+};
+
+#define LDC_HASH_BUCKETS	4096
+
+/** Log entries section of the .ldc file, read once, and the entries parsed
+ * from it so far. Formatted uuid strings are cached as well, indexed by the
+ * uuid entry and the LDC_UUID_ formatting variant.
+ */
+struct ldc_dict {
+	uint8_t *data;
+	uint32_t size;
+	struct ldc_entry *buckets[LDC_HASH_BUCKETS];
+	char **uid_strs;
+	uint32_t uid_count;
 };
 
+static struct ldc_dict ldc_dict;
+
 /** Dictionary entry + formatted parameters */
 struct proc_ldc_entry {
 	int subst_mask;
 	struct ldc_entry_header header;
-	char *file_name;
-	char *text;
+	const char *file_name;
+	const char *text;
 	uintptr_t params[TRACE_MAX_PARAMS_COUNT];
 };
 
@@ -66,7 +104,7 @@ struct proc_ldc_entry {
 
 static const char *missing = "<missing>";
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address);
+static int ldc_entry_get(uint32_t log_entry_address, const struct ldc_entry **entry);
 
 char *format_uid_raw(const struct sof_uuid_entry *uid_entry, int use_colors, int name_first,
 		     bool be, bool upper)
@@ -120,7 +158,7 @@ uint32_t get_uuid_key(const struct sof_uuid_entry *entry)
 		uids_dict->data_offset + uids_dict->base_address;
 }
 
-static const char *format_uid(uint32_t uid_ptr, int use_colors, bool be, bool upper)
+static char *format_uid(uint32_t uid_ptr, int use_colors, bool be, bool upper)
 {
 	const struct snd_sof_uids_header *uids_dict = global_config->uids_dict;
 	const struct sof_uuid_entry *uid_entry;
@@ -142,82 +180,50 @@ static const char *format_uid(uint32_t uid_ptr, int use_colors, bool be, bool up
 	return str;
 }
 
-/* fmt should point '%pUx`, return pointer to UUID string or zero */
-static const char *asprintf_uuid(const char *fmt, uint32_t uuid_key, bool use_colors, int *fmt_len)
+/** Returns the formatted uuid string from the cache, formatting it on first
+ * use. Returns NULL for pointers which don't point to the start of an uuid
+ * entry, these have to be formatted by the caller.
+ */
+static const char *format_uid_cached(uint32_t uid_ptr, int use_colors, unsigned int flags)
 {
-	const char *fmt_end = fmt + strlen(fmt);
-	int be, upper;
-	int len = 4; /* assure full formating, with x */
+	const struct snd_sof_uids_header *uids_dict = global_config->uids_dict;
+	uint32_t offset = uid_ptr - uids_dict->base_address;
+	char **str;
 
-	if (fmt + 2 >= fmt_end || fmt[1] != 'p' || fmt[2] != 'U') {
-		*fmt_len = 0;
+	if (uid_ptr < uids_dict->base_address ||
+	    offset % sizeof(struct sof_uuid_entry) ||
+	    offset / sizeof(struct sof_uuid_entry) >= ldc_dict.uid_count)
 		return NULL;
-	}
-	/* check 'x' value */
-	switch (fmt + 3 < fmt_end ? fmt[3] : 0) {
-	case 'b':
-		be = 1;
-		upper = 0;
-		break;
-	case 'B':
-		be = 1;
-		upper = 1;
-		break;
-	case 'l':
-		be = 0;
-		upper = 0;
-		break;
-	case 'L':
-		be = 0;
-		upper = 1;
-		break;
-	default:
-		be = 0;
-		upper = 0;
-		--len;
-		break;
-	}
-	*fmt_len = len;
-	return format_uid(uuid_key, use_colors, be, upper);
-}
 
-static const char *asprintf_entry_text(uint32_t entry_address)
-{
-	struct ldc_entry entry;
-	int ret;
+	if (use_colors)
+		flags |= LDC_UUID_COLORS;
 
-	ret = read_entry_from_ldc_file(&entry, entry_address);
-	if (ret)
-		return NULL;
-
-	free(entry.file_name);
+	str = &ldc_dict.uid_strs[offset / sizeof(struct sof_uuid_entry) * LDC_UUID_VARIANTS +
+				 flags];
+	if (!*str) {
+		*str = format_uid(uid_ptr, use_colors, flags & LDC_UUID_BE,
+				  flags & LDC_UUID_UPPER);
+		if (!*str)
+			abort();
+	}
 
-	return entry.text;
+	return *str;
 }
 
-/** printf-like formatting from the binary ldc_entry input to the
- *  formatted proc_lpc_entry output. Also copies the unmodified
- *  ldc_entry_header from input to output.
+/** Scans the text of a dictionary entry for conversion specifiers once,
+ * records how each parameter has to be passed to fprintf() and rewrites
+ * the specifiers fprintf() doesn't know in entry->format.
  *
- * @param[out] pe copy of the header + formatted output
- * @param[in] e copy of the dictionary entry where unformatted,
-    uint32_t params have been inserted.
-   @param[in] use_colors whether to use ANSI terminal codes
-*/
-static void process_params(struct proc_ldc_entry *pe,
-			   const struct ldc_entry *e,
-			   int use_colors)
+ * @param[in,out] e dictionary entry with format holding a copy of text
+ */
+static void parse_format(struct ldc_entry *e)
 {
-	char *p = e->text;
-	const char *t_end = p + strlen(e->text);
-	int uuid_fmt_len;
+	char *p = e->format;
+	const char *t_end = p + strlen(e->format);
+	unsigned int flags;
+	int len;
 	int i = 0;
 
-	pe->subst_mask = 0;
-	pe->header =  e->header;
-	pe->file_name = e->file_name;
-	pe->text = e->text;
-
 	/*
 	 * Scan the text for possible replacements. We follow the Linux kernel
 	 * that uses %pUx formats for UUID / GUID printing, where 'x' is
@@ -225,15 +231,12 @@ static void process_params(struct proc_ldc_entry *pe,
 	 * For decoding log entry text from pointer %pQ is used.
 	 */
 	while ((p = strchr(p, '%'))) {
-		uint32_t raw_param;
-
 		if (i >= e->header.params_num) {
-			/* Don't read e->params[] out of bounds. */
+			/* Don't read params[] out of bounds. */
 			log_err("Too many %% conversion specifiers in '%s'\n",
 				e->text);
 			break;
 		}
-		raw_param = e->params[i];
 
 		/* % can't be the last char */
 		if (p + 1 >= t_end) {
@@ -249,49 +252,50 @@ static void process_params(struct proc_ldc_entry *pe,
 			/* %s format specifier */
 			/* check for string printing, because it leads to logger crash */
 			log_err("String printing is not supported\n");
-			pe->params[i] = (uintptr_t)log_asprintf("<String @ 0x%08x>", raw_param);
-			if (!pe->params[i])
-				abort();
-			pe->subst_mask |= 1 << i;
-			++i;
+			e->params[i++].type = LDC_PARAM_STRING;
 			p += 2;
 		} else if (p + 2 < t_end && p[1] == 'p' && p[2] == 'U') {
-			/* %pUx format specifier */
-			/* substitute UUID entry address with formatted string pointer from heap */
-			pe->params[i] = (uintptr_t)asprintf_uuid(p, raw_param, use_colors,
-								 &uuid_fmt_len);
-			if (!pe->params[i])
-				abort();
-			pe->subst_mask |= 1 << i;
+			/* %pUx format specifier, check 'x' value */
+			len = 4;
+			switch (p + 3 < t_end ? p[3] : 0) {
+			case 'b':
+				flags = LDC_UUID_BE;
+				break;
+			case 'B':
+				flags = LDC_UUID_BE | LDC_UUID_UPPER;
+				break;
+			case 'l':
+				flags = 0;
+				break;
+			case 'L':
+				flags = LDC_UUID_UPPER;
+				break;
+			default:
+				flags = 0;
+				--len;
+				break;
+			}
+			e->params[i].type = LDC_PARAM_UUID;
+			e->params[i].flags = flags;
 			++i;
 			/* replace uuid formatter with %s */
 			p[1] = 's';
-			memmove(&p[2], &p[uuid_fmt_len], (int)(t_end - &p[uuid_fmt_len]) + 1);
-			p += uuid_fmt_len - 2;
-			t_end -= uuid_fmt_len - 2;
+			memmove(&p[2], &p[len], (int)(t_end - &p[len]) + 1);
+			p += 2;
+			t_end -= len - 2;
 		} else if (p + 2 < t_end && p[1] == 'p' && p[2] == 'Q') {
 			/* %pQ format specifier */
-			/* substitute log entry address with formatted entry text */
-			pe->params[i] = (uintptr_t)asprintf_entry_text(raw_param);
-
-			if (pe->params[i])
-				pe->subst_mask |= 1 << i;
-			else
-				pe->params[i] = (uintptr_t)missing;
-
-			++i;
-
+			e->params[i++].type = LDC_PARAM_ENTRY;
 			/* replace entry formatter with %s */
 			p[1] = 's';
 			memmove(&p[2], &p[3], t_end - &p[2]);
-			p++;
+			p += 2;
 			t_end--;
 		} else {
 			/* arguments different from %pU and %pQ should be passed without
 			 * modification
 			 */
-			pe->params[i] = raw_param;
-			++i;
+			e->params[i++].type = LDC_PARAM_RAW;
 			p += 2;
 		}
 	}
@@ -299,6 +303,64 @@ static void process_params(struct proc_ldc_entry *pe,
 		log_err("Too few %% conversion specifiers in '%s'\n", e->text);
 }
 
+/** printf-like formatting of the parameters of a log statement, as parsed
+ *  by parse_format() from its dictionary entry. Also copies the unmodified
+ *  ldc_entry_header from input to output.
+ *
+ * @param[out] pe copy of the header + formatted output
+ * @param[in] e dictionary entry of the log statement
+ * @param[in] params unformatted uint32_t params read from the log
+   @param[in] use_colors whether to use ANSI terminal codes
+*/
+static void process_params(struct proc_ldc_entry *pe,
+			   const struct ldc_entry *e,
+			   const uint32_t *params,
+			   int use_colors)
+{
+	const struct ldc_entry *ref;
+	int i;
+
+	pe->subst_mask = 0;
+	pe->header =  e->header;
+	pe->file_name = e->file_name;
+	pe->text = e->format;
+
+	for (i = 0; i < e->header.params_num; i++) {
+		switch (e->params[i].type) {
+		case LDC_PARAM_STRING:
+			pe->params[i] = (uintptr_t)log_asprintf("<String @ 0x%08x>", params[i]);
+			if (!pe->params[i])
+				abort();
+			pe->subst_mask |= 1 << i;
+			break;
+		case LDC_PARAM_UUID:
+			/* substitute UUID entry address with formatted string pointer */
+			pe->params[i] = (uintptr_t)format_uid_cached(params[i], use_colors,
+								     e->params[i].flags);
+			if (pe->params[i])
+				break;
+
+			pe->params[i] = (uintptr_t)format_uid(params[i], use_colors,
+							      e->params[i].flags & LDC_UUID_BE,
+							      e->params[i].flags & LDC_UUID_UPPER);
+			if (!pe->params[i])
+				abort();
+			pe->subst_mask |= 1 << i;
+			break;
+		case LDC_PARAM_ENTRY:
+			/* substitute log entry address with entry text */
+			if (ldc_entry_get(params[i], &ref))
+				pe->params[i] = (uintptr_t)missing;
+			else
+				pe->params[i] = (uintptr_t)ref->text;
+			break;
+		default:
+			pe->params[i] = params[i];
+			break;
+		}
+	}
+}
+
 static void free_proc_ldc_entry(struct proc_ldc_entry *pe)
 {
 	int i;
@@ -455,11 +517,12 @@ static char *format_file_name(char *file_name_raw, int full_name)
 
 static int entry_number = 1;
 /** Formats and outputs one entry from the trace + the corresponding
- * ldc_entry from the dictionary passed as arguments. Expects the log
- * variables to have already been copied into the ldc_entry.
+ * ldc_entry from the dictionary passed as arguments, with the log
+ * variables read from the trace.
  */
 static void print_entry_params(const struct log_entry_header *dma_log,
-			       const struct ldc_entry *entry, uint64_t last_timestamp)
+			       const struct ldc_entry *entry, const uint32_t *params,
+			       uint64_t last_timestamp)
 {
 	static uint64_t timestamp_origin;
 
@@ -528,7 +591,7 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 
 		if (!hide_location)
 			fprintf(out_fd, "(%s:%u) ",
-				format_file_name(entry->file_name, raw_output),
+				entry->location,
 				entry->header.line_idx);
 	} else {
 		if (time_precision >= 0) {
@@ -555,7 +618,7 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 		/* location */
 		if (!hide_location)
 			fprintf(out_fd, "%24s:%-4u ",
-				format_file_name(entry->file_name, raw_output),
+				entry->location,
 				entry->header.line_idx);
 
 		/* level name */
@@ -565,7 +628,7 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 	}
 
 	/* Minimal, printf-like formatting */
-	process_params(&proc_entry, entry, use_colors);
+	process_params(&proc_entry, entry, params, use_colors);
 
 	switch (proc_entry.header.params_num) {
 	case 0:
@@ -599,93 +662,171 @@ static void print_entry_params(const struct log_entry_header *dma_log,
 	fflush(out_fd);
 }
 
-static int read_entry_from_ldc_file(struct ldc_entry *entry, uint32_t log_entry_address)
+static struct ldc_entry **ldc_bucket(uint32_t log_entry_address)
+{
+	/* Fibonacci hashing, entries are word aligned */
+	uint32_t hash = (log_entry_address >> 2) * 2654435761U;
+
+	return &ldc_dict.buckets[(hash >> 20) % LDC_HASH_BUCKETS];
+}
+
+/** Parses the dictionary entry at the given address from the log entries
+ * section read by ldc_dict_load().
+ */
+static int ldc_entry_parse(struct ldc_entry **entry, uint32_t log_entry_address)
 {
 	uint32_t base_address = global_config->logs_header->base_address;
 	uint32_t data_offset = global_config->logs_header->data_offset;
-
-	int ret;
+	struct ldc_entry_header header;
+	struct ldc_entry *e;
+	const uint8_t *src;
 
 	/* evaluate entry offset in input file */
 	uint32_t entry_offset = (log_entry_address - base_address) + data_offset;
+	uint32_t offset = log_entry_address - base_address;
 
-	entry->file_name = NULL;
-	entry->text = NULL;
-	entry->params = NULL;
-
-	/* set file position to beginning of processed entry */
-	ret = fseek(global_config->ldc_fd, entry_offset, SEEK_SET);
-	if (ret) {
-		log_err("Failed to seek to entry header for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -errno;
-		goto out;
-	}
-
-	/* fetching elf header params */
-	ret = fread(&entry->header, sizeof(entry->header), 1, global_config->ldc_fd);
-	if (ret != 1) {
+	/* fetching elf header params, entries are word aligned */
+	if (log_entry_address < base_address || offset % sizeof(uint32_t) ||
+	    ldc_dict.size < sizeof(header) || offset > ldc_dict.size - sizeof(header)) {
 		log_err("Failed to read entry header for offset 0x%x in dictionary.\n",
 			entry_offset);
-		ret = -1;
-		goto out;
+		return -1;
 	}
-	if (entry->header.file_name_len > TRACE_MAX_FILENAME_LEN) {
+	src = ldc_dict.data + offset;
+	header = *(const struct ldc_entry_header *)src;
+	src += sizeof(header);
+
+	if (header.file_name_len > TRACE_MAX_FILENAME_LEN) {
 		log_err("Invalid filename length %d or ldc file does not match firmware\n",
-			entry->header.file_name_len);
-		ret = -EINVAL;
-		goto out;
+			header.file_name_len);
+		return -EINVAL;
+	}
+	if (header.text_len > TRACE_MAX_TEXT_LEN) {
+		log_err("Invalid text length.\n");
+		return -EINVAL;
+	}
+	if (header.params_num > TRACE_MAX_PARAMS_COUNT) {
+		log_err("Invalid number of parameters.\n");
+		return -EINVAL;
+	}
+	if (header.file_name_len + header.text_len >
+	    ldc_dict.size - offset - sizeof(header)) {
+		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
+			entry_offset);
+		return -1;
 	}
-	entry->file_name = (char *)malloc(entry->header.file_name_len + 1);
 
-	if (!entry->file_name) {
-		log_err("can't allocate %d byte for entry.file_name\n",
-			entry->header.file_name_len);
-		ret = -ENOMEM;
-		goto out;
+	/* the strings follow the entry in the same allocation */
+	e = calloc(1, sizeof(*e) + header.file_name_len + 1 + 2 * (header.text_len + 1));
+	if (!e) {
+		log_err("can't allocate memory for entry at offset 0x%x\n", entry_offset);
+		return -ENOMEM;
 	}
+	e->header = header;
+	e->address = log_entry_address;
+	e->file_name = (char *)(e + 1);
+	e->text = e->file_name + header.file_name_len + 1;
+	e->format = e->text + header.text_len + 1;
 
-	ret = fread(entry->file_name, sizeof(char), entry->header.file_name_len,
-		    global_config->ldc_fd);
-	entry->file_name[entry->header.file_name_len] = '\0';
+	strncpy(e->file_name, (const char *)src, header.file_name_len);
+	src += header.file_name_len;
+	strncpy(e->text, (const char *)src, header.text_len);
+	strcpy(e->format, e->text);
 
-	if (ret != entry->header.file_name_len) {
-		log_err("Failed to read source filename for offset 0x%x in dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+	e->location = format_file_name(e->file_name, global_config->raw_output);
+	parse_format(e);
+
+	*entry = e;
+	return 0;
+}
+
+/** Looks up the dictionary entry of a log statement, parsing it on first use.
+ *
+ * @param[in] log_entry_address address of the entry in firmware
+ * @param[out] entry dictionary entry
+ * @return 0 on success, negative error code otherwise
+ */
+static int ldc_entry_get(uint32_t log_entry_address, const struct ldc_entry **entry)
+{
+	struct ldc_entry **bucket = ldc_bucket(log_entry_address);
+	struct ldc_entry *e;
+	int ret;
+
+	for (e = *bucket; e; e = e->next)
+		if (e->address == log_entry_address) {
+			*entry = e;
+			return 0;
+		}
+
+	ret = ldc_entry_parse(&e, log_entry_address);
+	if (ret)
+		return ret;
+
+	e->next = *bucket;
+	*bucket = e;
+	*entry = e;
+
+	return 0;
+}
+
+/** Reads the log entries section of the .ldc file into memory, once for
+ * the whole run instead of seeking and reading for every log statement.
+ */
+static int ldc_dict_load(void)
+{
+	const struct snd_sof_logs_header *logs_hdr = global_config->logs_header;
+	const struct snd_sof_uids_header *uids_hdr = global_config->uids_dict;
+	FILE *ldc_fd = global_config->ldc_fd;
+	int ret;
+
+	ldc_dict.size = logs_hdr->data_length;
+	ldc_dict.data = malloc(ldc_dict.size);
+	if (!ldc_dict.data) {
+		log_err("failed to alloc memory for log entries.\n");
+		return -ENOMEM;
 	}
 
-	/* fetching text */
-	if (entry->header.text_len > TRACE_MAX_TEXT_LEN) {
-		log_err("Invalid text length.\n");
-		ret = -EINVAL;
-		goto out;
+	ret = fseek(ldc_fd, logs_hdr->data_offset, SEEK_SET);
+	if (ret) {
+		log_err("Error while seeking to log entries from %s.\n",
+			global_config->ldc_file);
+		return -errno;
 	}
-	entry->text = (char *)malloc(entry->header.text_len + 1);
-	if (!entry->text) {
-		log_err("can't allocate %d byte for entry.text\n", entry->header.text_len);
-		ret = -ENOMEM;
-		goto out;
+
+	if (ldc_dict.size && fread(ldc_dict.data, ldc_dict.size, 1, ldc_fd) != 1) {
+		log_err("failed to read log entries section data.\n");
+		return ferror(ldc_fd) ? -ferror(ldc_fd) : -EINVAL;
 	}
-	ret = fread(entry->text, sizeof(char), entry->header.text_len, global_config->ldc_fd);
-	if (ret != entry->header.text_len) {
-		log_err("Failed to read log message at offset 0x%x from dictionary.\n",
-			entry_offset);
-		ret = -1;
-		goto out;
+
+	ldc_dict.uid_count = uids_hdr->data_length / sizeof(struct sof_uuid_entry);
+	ldc_dict.uid_strs = calloc((size_t)ldc_dict.uid_count * LDC_UUID_VARIANTS,
+				   sizeof(*ldc_dict.uid_strs));
+	if (!ldc_dict.uid_strs && ldc_dict.uid_count) {
+		log_err("failed to alloc memory for uuid strings.\n");
+		return -ENOMEM;
 	}
-	entry->text[entry->header.text_len] = '\0';
 
 	return 0;
+}
 
-out:
-	free(entry->text);
-	entry->text = NULL;
-	free(entry->file_name);
-	entry->file_name = NULL;
+static void ldc_dict_free(void)
+{
+	struct ldc_entry *e;
+	uint32_t i;
 
-	return ret;
+	for (i = 0; i < LDC_HASH_BUCKETS; i++)
+		while ((e = ldc_dict.buckets[i])) {
+			ldc_dict.buckets[i] = e->next;
+			free(e);
+		}
+
+	if (ldc_dict.uid_strs)
+		for (i = 0; i < ldc_dict.uid_count * LDC_UUID_VARIANTS; i++)
+			free(ldc_dict.uid_strs[i]);
+
+	free(ldc_dict.uid_strs);
+	free(ldc_dict.data);
+	memset(&ldc_dict, 0, sizeof(ldc_dict));
 }
 
 /** Gets the dictionary entry matching the log entry argument, reads
@@ -699,38 +840,26 @@ out:
  */
 static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_timestamp)
 {
-	struct ldc_entry entry;
+	uint32_t params[TRACE_MAX_PARAMS_COUNT];
+	const struct ldc_entry *entry;
 	int ret;
 
-	ret = read_entry_from_ldc_file(&entry, dma_log->log_entry_address);
+	ret = ldc_entry_get(dma_log->log_entry_address, &entry);
 	if (ret < 0) {
-		log_err("read_entry_from_ldc_file(0x%x) returned %d\n",
+		log_err("ldc_entry_get(0x%x) returned %d\n",
 			dma_log->log_entry_address, ret);
-		goto out;
+		return ret;
 	}
 
 	/* fetching entry params from dma dump */
-	if (entry.header.params_num > TRACE_MAX_PARAMS_COUNT) {
-		log_err("Invalid number of parameters.\n");
-		ret = -EINVAL;
-		goto out;
-	}
-	entry.params = (uint32_t *)malloc(sizeof(uint32_t) * entry.header.params_num);
-	if (!entry.params) {
-		log_err("can't allocate %d byte for entry.params\n",
-			(int)(sizeof(uint32_t) * entry.header.params_num));
-		ret = -ENOMEM;
-		goto out;
-	}
-
 	if (global_config->serial_fd < 0) {
-		ret = fread(entry.params, sizeof(uint32_t), entry.header.params_num,
+		ret = fread(params, sizeof(uint32_t), entry->header.params_num,
 			    global_config->in_fd);
-		if (ret != entry.header.params_num) {
+		if (ret != entry->header.params_num) {
 			fprintf(global_config->out_fd,
 				"warn: failed to fread() %d params from the log for %s:%d\n",
-				entry.header.params_num,
-				entry.file_name, entry.header.line_idx);
+				entry->header.params_num,
+				entry->file_name, entry->header.line_idx);
 
 			ret = ferror(global_config->in_fd) ? -1 : 0;
 
@@ -738,23 +867,23 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 				fprintf(global_config->out_fd,
 					"warn: log's End Of File. Device suspend?\n");
 
-			goto out;
+			return ret;
 		}
 	} else { /* serial */
-		size_t size = sizeof(uint32_t) * entry.header.params_num;
+		size_t size = sizeof(uint32_t) * entry->header.params_num;
 		uint8_t *n;
 
 		/* Repeatedly read() how much we still miss until we got
 		 * enough for the number of params needed by this
 		 * particular statement.
 		 */
-		for (n = (uint8_t *)entry.params; size; n += ret, size -= ret) {
+		for (n = (uint8_t *)params; size; n += ret, size -= ret) {
 			ret = read(global_config->serial_fd, n, size);
 			if (ret < 0) {
 				ret = -errno;
 				log_err("Failed to fread %d params from serial: %s\n",
-					entry.header.params_num, strerror(errno));
-				goto out;
+					entry->header.params_num, strerror(errno));
+				return ret;
 			}
 			if (ret != size)
 				log_err("Partial read of %u bytes of %zu, reading more\n",
@@ -763,20 +892,10 @@ static int fetch_entry(const struct log_entry_header *dma_log, uint64_t *last_ti
 	} /* serial */
 
 	/* printing entry content */
-	print_entry_params(dma_log, &entry, *last_timestamp);
+	print_entry_params(dma_log, entry, params, *last_timestamp);
 	*last_timestamp = dma_log->timestamp;
 
-	/* set f_ldc file position to the beginning */
-	rewind(global_config->ldc_fd);
-
-	ret = 0;
-out:
-	/* free alocated memory */
-	free(entry.params);
-	free(entry.text);
-	free(entry.file_name);
-
-	return ret;
+	return 0;
 }
 
 static int serial_read(uint64_t *last_timestamp)
@@ -1140,6 +1259,10 @@ int convert(void)
 		goto out;
 	}
 
+	ret = ldc_dict_load();
+	if (ret)
+		goto out;
+
 	if (config->filter_config) {
 		ret = filter_update_firmware();
 		if (ret) {
@@ -1150,6 +1273,7 @@ int convert(void)
 
 	ret = logger_read();
 out:
+	ldc_dict_free();
 	free(config->uids_dict);
 	return ret;
 }
@@ -787,49 +787,18 @@ int plug_parse_topology(snd_sof_plug_t *plug)
 	char pipeline_string[256] = {0};
 	int i;
 	int ret = 0;
-	FILE *file;
-	size_t size;
 
 	tplg_debug("parsing topology file %s\n", ctx->tplg_file);
 
 	ctx->ctl_arg = plug;
 	ctx->ctl_cb = plug_kcontrol_cb_new;
 
-	/* open topology file */
-	file = fopen(ctx->tplg_file, "rb");
-	if (!file) {
-		SNDERR("error: can't open topology %s : %s\n", ctx->tplg_file, strerror(errno));
-		return -errno;
-	}
-
-	/* file size */
-	if (fseek(file, 0, SEEK_END)) {
-		SNDERR("error: can't seek to end of topology: %s\n", strerror(errno));
-		fclose(file);
-		return -errno;
-	}
-	ctx->tplg_size = ftell(file);
-	if (fseek(file, 0, SEEK_SET)) {
-		SNDERR("error: can't seek to beginning of topology: %s\n", strerror(errno));
-		fclose(file);
-		return -errno;
-	}
-
-	/* load whole topology into memory */
-	ctx->tplg_base = calloc(ctx->tplg_size, 1);
-	if (!ctx->tplg_base) {
-		SNDERR("error: can't alloc buffer for topology %zu bytes\n", ctx->tplg_size);
-		fclose(file);
-		return -ENOMEM;
-	}
-	ret = fread(ctx->tplg_base, ctx->tplg_size, 1, file);
-	if (ret != 1) {
-		SNDERR("error: can't read topology: %s\n",
-		       strerror(errno));
-		fclose(file);
-		return -errno;
+	/* map topology file */
+	ret = tplg_map(ctx);
+	if (ret < 0) {
+		SNDERR("error: can't map topology %s\n", ctx->tplg_file);
+		return ret;
 	}
-	fclose(file);
 
 	/* initialize widget, route, pipeline and pcm lists */
 	list_init(&plug->widget_list);
@@ -1555,6 +1524,6 @@ void plug_free_topology(snd_sof_plug_t *plug)
 		free(pipe_info);
 	}
 
-	free(ctx->tplg_base);
+	tplg_unmap(ctx);
 	tplg_debug("freed all pipelines, widgets, routes and pcms\n");
 }
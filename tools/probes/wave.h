@@ -8,17 +8,31 @@
 #ifndef __WAVE_H__
 #define __WAVE_H__
 
+#include <stdint.h>
+
 #define HEADER_RIFF 0x46464952	/**< ASCII "RIFF" */
 #define HEADER_WAVE 0x45564157	/**< ASCII "WAVE" */
 #define HEADER_FMT  0x20746d66	/**< ASCII "fmt " */
 #define HEADER_DATA 0x61746164	/**< ASCII "data" */
 
+#define WAVE_FORMAT_PCM		0x0001
+#define WAVE_FORMAT_EXTENSIBLE	0xfffe
+
+/** offset of the sub format GUID from the start of the fmt chunk body */
+#define WAVE_FMT_SUBFORMAT_OFFSET	24
+
 struct riff_chunk {
 	uint32_t chunk_id;
 	uint32_t chunk_size;
 	uint32_t format;
 };
 
+/** header of any chunk following the riff chunk */
+struct chunk_header {
+	uint32_t chunk_id;
+	uint32_t chunk_size;
+};
+
 struct fmt_subchunk {
 	uint32_t subchunk_id;
 	uint32_t subchunk_size;
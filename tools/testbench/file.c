@@ -22,9 +22,16 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <strings.h>
+#if !defined __XCC__
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "testbench/utils.h"
 #include "testbench/file.h"
 #include "testbench/file_ipc4.h"
+#include "wave.h"
 #include "../../src/audio/copier/copier.h"
 
 
@@ -81,63 +88,653 @@ static void sign_extend_source_s24(const struct audio_stream *source, int sample
 }
 
 /*
- * Read 32-bit samples from binary file
+ * Sample data access of raw and wav files. Regular files are mapped to
+ * memory, so the samples are copied and converted straight from and to the
+ * page cache. Other files, e.g. pipes, are accessed via a staging buffer.
  */
-static int read_binary_s32(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
+
+#if !defined __XCC__
+/* maps a regular input file as a whole, false if it needs stdio access */
+static bool file_map_input(struct file_state *fs)
 {
-	int32_t *snk = (int32_t *)sink->w_ptr;
-	size_t samples_avail;
-	size_t bytes_snk;
-	size_t bytes = samples * sizeof(int32_t);
+	struct file_map *map = &fs->map;
+	struct stat st;
+	void *base;
+
+	if (fstat(fileno(fs->rfh), &st) < 0 || !S_ISREG(st.st_mode) || !st.st_size)
+		return false;
+
+	base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fs->rfh), 0);
+	if (base == MAP_FAILED)
+		return false;
+
+	/* the samples are read once from start to end */
+	madvise(base, st.st_size, MADV_SEQUENTIAL);
+	map->base = base;
+	map->size = st.st_size;
+	map->avail = st.st_size;
+	return true;
+}
+
+/*
+ * Maps the window of a regular output file that starts from the page of the
+ * write position, false if that fails. The file is extended to cover the
+ * window and truncated to the written size when closed.
+ */
+static bool file_map_output(struct file_state *fs)
+{
+	struct file_map *map = &fs->map;
+	int fd = fileno(fs->wfh);
+	uint64_t offset;
+	struct stat st;
+	void *base;
+
+	if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	if (map->base)
+		munmap(map->base, map->size);
+
+	map->base = NULL;
+	offset = map->written & ~((uint64_t)sysconf(_SC_PAGESIZE) - 1);
+	if (ftruncate(fd, offset + FILE_MAP_WINDOW_BYTES) < 0)
+		return false;
+
+	base = mmap(NULL, FILE_MAP_WINDOW_BYTES, PROT_READ | PROT_WRITE, MAP_SHARED, fd,
+		    offset);
+	if (base == MAP_FAILED) {
+		/* don't leave the window size to the file */
+		if (ftruncate(fd, map->written) < 0)
+			fprintf(stderr, "error: truncating file %s - %s\n", fs->fn,
+				strerror(errno));
+		return false;
+	}
+
+	map->base = base;
+	map->size = FILE_MAP_WINDOW_BYTES;
+	map->pos = map->written - offset;
+	return true;
+}
+#endif
+
+static int file_open_map(struct file_state *fs)
+{
+	struct file_map *map = &fs->map;
+
+	map->avail = UINT64_MAX;
+#if !defined __XCC__
+	if (fs->mode == FILE_READ)
+		map->mapped = file_map_input(fs);
+	else
+		map->mapped = file_map_output(fs);
+
+	if (map->mapped)
+		return 0;
+#endif
+
+	map->stage = malloc(FILE_STAGE_BYTES);
+	return map->stage ? 0 : -ENOMEM;
+}
+
+static void file_close_map(struct file_state *fs)
+{
+	struct file_map *map = &fs->map;
+
+#if !defined __XCC__
+	if (map->base)
+		munmap(map->base, map->size);
+
+	/* drop the unused part of the last output window */
+	if (map->mapped && fs->mode == FILE_WRITE &&
+	    ftruncate(fileno(fs->wfh), map->written) < 0)
+		fprintf(stderr, "error: truncating file %s - %s\n", fs->fn, strerror(errno));
+#endif
+
+	free(map->stage);
+	map->base = NULL;
+	map->stage = NULL;
+}
+
+/* gets up to count units of input data, returns 0 at the end of data */
+static size_t file_in_get(struct file_state *fs, const uint8_t **ptr, size_t unit,
+			  size_t count)
+{
+	struct file_map *map = &fs->map;
+
+	count = MIN(count, map->avail / unit);
+	if (map->mapped) {
+		*ptr = map->base + map->pos;
+		map->pos += count * unit;
+	} else {
+		count = MIN(count, FILE_STAGE_BYTES / unit);
+		count = fread(map->stage, unit, count, fs->rfh);
+		*ptr = map->stage;
+	}
+
+	map->avail -= count * unit;
+	return count;
+}
+
+/* gets room for up to count units of output data, returns 0 on failure */
+static size_t file_out_get(struct file_state *fs, uint8_t **ptr, size_t unit, size_t count)
+{
+	struct file_map *map = &fs->map;
+
+	if (!map->mapped) {
+		*ptr = map->stage;
+		return MIN(count, FILE_STAGE_BYTES / unit);
+	}
+
+#if !defined __XCC__
+	if (!map->base || map->size - map->pos < unit) {
+		if (!file_map_output(fs))
+			return 0;
+	}
+#endif
+
+	*ptr = map->base + map->pos;
+	return MIN(count, (map->size - map->pos) / unit);
+}
+
+/* stores count units of output data placed to the room from file_out_get() */
+static int file_out_commit(struct file_state *fs, size_t unit, size_t count)
+{
+	struct file_map *map = &fs->map;
+
+	if (map->mapped)
+		map->pos += count * unit;
+	else if (fwrite(map->stage, unit, count, fs->wfh) != count)
+		return -EIO;
+
+	map->written += count * unit;
+	return 0;
+}
+
+static int file_in_read(struct file_state *fs, void *data, size_t bytes)
+{
+	const uint8_t *src;
+	size_t n;
+
+	while (bytes) {
+		n = file_in_get(fs, &src, 1, bytes);
+		if (!n)
+			return -EINVAL;
+
+		memcpy_s(data, bytes, src, n);
+		data = (uint8_t *)data + n;
+		bytes -= n;
+	}
+
+	return 0;
+}
+
+static int file_in_skip(struct file_state *fs, size_t bytes)
+{
+	const uint8_t *src;
+	size_t n;
+
+	while (bytes) {
+		n = file_in_get(fs, &src, 1, bytes);
+		if (!n)
+			return -EINVAL;
+
+		bytes -= n;
+	}
+
+	return 0;
+}
+
+static int file_out_write(struct file_state *fs, const void *data, size_t bytes)
+{
+	uint8_t *dst;
+	size_t n;
 	int ret;
-	int samples_copied = 0;
 
 	while (bytes) {
-		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_snk));
-		ret = fread(snk, sizeof(int32_t), samples_avail, cd->fs.rfh);
-		if (!ret) {
-			cd->fs.reached_eof = 1;
-			return samples_copied;
+		n = file_out_get(fs, &dst, 1, bytes);
+		if (!n)
+			return -EIO;
+
+		memcpy_s(dst, n, data, n);
+		ret = file_out_commit(fs, 1, n);
+		if (ret < 0)
+			return ret;
+
+		data = (const uint8_t *)data + n;
+		bytes -= n;
+	}
+
+	return 0;
+}
+
+/*
+ * Sample format conversion. Samples are converted in blocks through MSB
+ * aligned 32 bit values. Samples in files are accessed by bytes since wav
+ * data need not be aligned, in streams by their type.
+ */
+
+#define FILE_CONV_BLOCK		256
+
+static const int file_sample_bytes[] = {
+	[FILE_SAMPLE_S16] = 2,
+	[FILE_SAMPLE_S24_3] = 3,
+	[FILE_SAMPLE_S24_4] = 4,
+	[FILE_SAMPLE_S32] = 4,
+};
+
+static void file_decode(int32_t *q, const uint8_t *src, enum file_sample_format fmt, int n)
+{
+	int i;
+
+	switch (fmt) {
+	case FILE_SAMPLE_S16:
+		for (i = 0; i < n; i++, src += 2)
+			q[i] = (int32_t)((uint32_t)src[0] << 16 | (uint32_t)src[1] << 24);
+		break;
+	case FILE_SAMPLE_S24_3:
+		for (i = 0; i < n; i++, src += 3)
+			q[i] = (int32_t)((uint32_t)src[0] << 8 | (uint32_t)src[1] << 16 |
+					 (uint32_t)src[2] << 24);
+		break;
+	case FILE_SAMPLE_S24_4:
+		/* the MSB byte of the container is ignored */
+		for (i = 0; i < n; i++, src += 4)
+			q[i] = (int32_t)((uint32_t)src[0] << 8 | (uint32_t)src[1] << 16 |
+					 (uint32_t)src[2] << 24);
+		break;
+	case FILE_SAMPLE_S32:
+		for (i = 0; i < n; i++, src += 4)
+			q[i] = (int32_t)((uint32_t)src[0] | (uint32_t)src[1] << 8 |
+					 (uint32_t)src[2] << 16 | (uint32_t)src[3] << 24);
+		break;
+	}
+}
+
+static void file_encode(uint8_t *dst, const int32_t *q, enum file_sample_format fmt, int n)
+{
+	int32_t v;
+	int i;
+
+	switch (fmt) {
+	case FILE_SAMPLE_S16:
+		for (i = 0; i < n; i++, dst += 2) {
+			dst[0] = q[i] >> 16;
+			dst[1] = q[i] >> 24;
+		}
+		break;
+	case FILE_SAMPLE_S24_3:
+		for (i = 0; i < n; i++, dst += 3) {
+			dst[0] = q[i] >> 8;
+			dst[1] = q[i] >> 16;
+			dst[2] = q[i] >> 24;
+		}
+		break;
+	case FILE_SAMPLE_S24_4:
+		/* sign extended to the container */
+		for (i = 0; i < n; i++, dst += 4) {
+			v = q[i] >> 8;
+			dst[0] = v;
+			dst[1] = v >> 8;
+			dst[2] = v >> 16;
+			dst[3] = v >> 24;
+		}
+		break;
+	case FILE_SAMPLE_S32:
+		for (i = 0; i < n; i++, dst += 4) {
+			dst[0] = q[i];
+			dst[1] = q[i] >> 8;
+			dst[2] = q[i] >> 16;
+			dst[3] = q[i] >> 24;
 		}
+		break;
+	}
+}
+
+static void file_stream_decode(int32_t *q, const void *src, enum file_sample_format fmt, int n)
+{
+	const int16_t *s16 = src;
+	const int32_t *s32 = src;
+	int i;
 
-		samples_copied += ret;
-		bytes -= ret * sizeof(int32_t);
-		snk = audio_stream_wrap(sink, snk + ret);
+	switch (fmt) {
+	case FILE_SAMPLE_S16:
+		for (i = 0; i < n; i++)
+			q[i] = (int32_t)((uint32_t)s16[i] << 16);
+		break;
+	case FILE_SAMPLE_S24_4:
+		for (i = 0; i < n; i++)
+			q[i] = (int32_t)((uint32_t)s32[i] << 8);
+		break;
+	default:
+		for (i = 0; i < n; i++)
+			q[i] = s32[i];
+		break;
 	}
+}
 
-	return samples_copied;
+static void file_stream_encode(void *dst, const int32_t *q, enum file_sample_format fmt, int n)
+{
+	int16_t *d16 = dst;
+	int32_t *d32 = dst;
+	int i;
+
+	switch (fmt) {
+	case FILE_SAMPLE_S16:
+		for (i = 0; i < n; i++)
+			d16[i] = q[i] >> 16;
+		break;
+	case FILE_SAMPLE_S24_4:
+		/* masked like the other 24 bit inputs, see mask_sink_s24() */
+		for (i = 0; i < n; i++)
+			d32[i] = (q[i] >> 8) & 0x00ffffff;
+		break;
+	default:
+		for (i = 0; i < n; i++)
+			d32[i] = q[i];
+		break;
+	}
+}
+
+/* converts n file samples to stream samples */
+static void file_to_stream(struct file_comp_data *cd, void *dst, const uint8_t *src, int n)
+{
+	int32_t q[FILE_CONV_BLOCK];
+	int sink_bytes = file_sample_bytes[cd->stream_fmt];
+	int block;
+
+	if (cd->file_fmt == cd->stream_fmt && cd->file_fmt != FILE_SAMPLE_S24_4) {
+		memcpy_s(dst, n * sink_bytes, src, n * sink_bytes);
+		return;
+	}
+
+	while (n) {
+		block = MIN(n, FILE_CONV_BLOCK);
+		file_decode(q, src, cd->file_fmt, block);
+		file_stream_encode(dst, q, cd->stream_fmt, block);
+		src += block * cd->file_sample_bytes;
+		dst = (uint8_t *)dst + block * sink_bytes;
+		n -= block;
+	}
+}
+
+/* converts n stream samples to file samples */
+static void file_from_stream(struct file_comp_data *cd, uint8_t *dst, const void *src, int n)
+{
+	int32_t q[FILE_CONV_BLOCK];
+	int source_bytes = file_sample_bytes[cd->stream_fmt];
+	int block;
+
+	if (cd->file_fmt == cd->stream_fmt && cd->file_fmt != FILE_SAMPLE_S24_4) {
+		memcpy_s(dst, n * source_bytes, src, n * source_bytes);
+		return;
+	}
+
+	while (n) {
+		block = MIN(n, FILE_CONV_BLOCK);
+		file_stream_decode(q, src, cd->stream_fmt, block);
+		file_encode(dst, q, cd->file_fmt, block);
+		src = (const uint8_t *)src + block * source_bytes;
+		dst += block * cd->file_sample_bytes;
+		n -= block;
+	}
 }
 
 /*
- * Write 32-bit samples to binary file
+ * Read samples from raw or wav file
  */
-static int write_binary_s32(struct file_comp_data *cd, const struct audio_stream *source,
+static int file_read_stream(struct file_comp_data *cd, const struct audio_stream *sink,
 			    int samples)
 {
-	int32_t *src = (int32_t *)source->r_ptr;
-	size_t samples_avail;
-	size_t bytes_src;
-	size_t bytes = samples * sizeof(int32_t);
-	int ret;
+	uint8_t *snk = sink->w_ptr;
+	int sample_bytes = audio_stream_sample_bytes(sink);
+	const uint8_t *src;
 	int samples_copied = 0;
+	size_t n;
+
+	while (samples_copied < samples) {
+		n = audio_stream_bytes_without_wrap(sink, snk) / sample_bytes;
+		n = MIN(n, samples - samples_copied);
+		n = file_in_get(&cd->fs, &src, cd->file_sample_bytes, n);
+		if (!n) {
+			cd->fs.reached_eof = true;
+			break;
+		}
 
-	while (bytes) {
-		bytes_src = audio_stream_bytes_without_wrap(source, src);
-		samples_avail = FILE_BYTES_TO_S32_SAMPLES(MIN(bytes, bytes_src));
-		ret = fwrite(src, sizeof(int32_t), samples_avail, cd->fs.wfh);
-		if (ret == 0) {
+		file_to_stream(cd, snk, src, n);
+		samples_copied += n;
+		snk = audio_stream_wrap(sink, snk + n * sample_bytes);
+	}
+
+	return samples_copied;
+}
+
+/*
+ * Write samples to raw or wav file
+ */
+static int file_write_stream(struct file_comp_data *cd, const struct audio_stream *source,
+			     int samples)
+{
+	uint8_t *src = source->r_ptr;
+	int sample_bytes = audio_stream_sample_bytes(source);
+	int samples_copied = 0;
+	uint8_t *dst;
+	size_t n;
+
+	while (samples_copied < samples) {
+		n = audio_stream_bytes_without_wrap(source, src) / sample_bytes;
+		n = MIN(n, samples - samples_copied);
+		n = file_out_get(&cd->fs, &dst, cd->file_sample_bytes, n);
+		if (!n) {
 			cd->fs.write_failed = true;
-			return samples_copied;
+			break;
 		}
-		samples_copied += ret;
-		bytes -= ret * sizeof(int32_t);
-		src = audio_stream_wrap(source, src + ret);
+
+		file_from_stream(cd, dst, src, n);
+		if (file_out_commit(&cd->fs, cd->file_sample_bytes, n) < 0) {
+			cd->fs.write_failed = true;
+			break;
+		}
+
+		samples_copied += n;
+		src = audio_stream_wrap(source, src + n * sample_bytes);
 	}
 
 	return samples_copied;
 }
 
+/*
+ * wav file headers
+ */
+
+static int file_wav_parse_fmt(struct file_state *fs, struct file_wav_info *info,
+			      uint32_t size)
+{
+	const uint32_t fmt_size = sizeof(struct fmt_subchunk) - sizeof(struct chunk_header);
+	struct fmt_subchunk fmt;
+	uint16_t sub_format;
+	uint16_t format;
+	uint32_t read = fmt_size;
+	int ret;
+
+	if (size < fmt_size)
+		return -EINVAL;
+
+	/* the chunk header is already consumed, read the fields after it */
+	ret = file_in_read(fs, &fmt.audio_format, fmt_size);
+	if (ret < 0)
+		return ret;
+
+	format = fmt.audio_format;
+	if (format == WAVE_FORMAT_EXTENSIBLE &&
+	    size >= WAVE_FMT_SUBFORMAT_OFFSET + sizeof(sub_format)) {
+		ret = file_in_skip(fs, WAVE_FMT_SUBFORMAT_OFFSET - fmt_size);
+		if (ret < 0)
+			return ret;
+
+		/* the sub format GUID starts with the format code */
+		ret = file_in_read(fs, &sub_format, sizeof(sub_format));
+		if (ret < 0)
+			return ret;
+
+		format = sub_format;
+		read = WAVE_FMT_SUBFORMAT_OFFSET + sizeof(sub_format);
+	}
+
+	if (format != WAVE_FORMAT_PCM || !fmt.num_channels ||
+	    fmt.block_align * 8 != fmt.bits_per_sample * fmt.num_channels) {
+		fprintf(stderr, "error: unsupported wav format %#x, %u bits in %u bytes\n",
+			format, fmt.bits_per_sample, fmt.block_align);
+		return -EINVAL;
+	}
+
+	switch (fmt.bits_per_sample) {
+	case 16:
+		info->fmt = FILE_SAMPLE_S16;
+		break;
+	case 24:
+		info->fmt = FILE_SAMPLE_S24_3;
+		break;
+	case 32:
+		info->fmt = FILE_SAMPLE_S32;
+		break;
+	default:
+		fprintf(stderr, "error: unsupported wav sample size %u\n", fmt.bits_per_sample);
+		return -EINVAL;
+	}
+
+	info->rate = fmt.sample_rate;
+	info->channels = fmt.num_channels;
+	info->bits = fmt.bits_per_sample;
+
+	/* skip the rest with the pad byte of odd sizes */
+	return file_in_skip(fs, size - read + (size & 1));
+}
+
+/* reads the header up to the sample data and limits the input to the data chunk */
+static int file_wav_parse(struct file_state *fs, struct file_wav_info *info)
+{
+	struct riff_chunk riff;
+	struct chunk_header chunk;
+	bool have_fmt = false;
+	int ret;
+
+	ret = file_in_read(fs, &riff, sizeof(riff));
+	if (ret < 0 || riff.chunk_id != HEADER_RIFF || riff.format != HEADER_WAVE) {
+		fprintf(stderr, "error: %s is not a wav file\n", fs->fn);
+		return -EINVAL;
+	}
+
+	for (;;) {
+		ret = file_in_read(fs, &chunk, sizeof(chunk));
+		if (ret < 0) {
+			fprintf(stderr, "error: no data in wav file %s\n", fs->fn);
+			return ret;
+		}
+
+		if (chunk.chunk_id == HEADER_DATA)
+			break;
+
+		if (chunk.chunk_id == HEADER_FMT) {
+			ret = file_wav_parse_fmt(fs, info, chunk.chunk_size);
+			have_fmt = true;
+		} else {
+			ret = file_in_skip(fs, chunk.chunk_size + (chunk.chunk_size & 1));
+		}
+
+		if (ret < 0)
+			return ret;
+	}
+
+	if (!have_fmt) {
+		fprintf(stderr, "error: no format in wav file %s\n", fs->fn);
+		return -EINVAL;
+	}
+
+	/* streaming writers may leave the size unset */
+	if (chunk.chunk_size && chunk.chunk_size != UINT32_MAX)
+		fs->map.avail = MIN(fs->map.avail, chunk.chunk_size);
+
+	return 0;
+}
+
+static void file_wav_header(struct wave *hdr, const struct file_wav_info *info,
+			    uint64_t data_bytes)
+{
+	uint32_t frame_bytes = info->channels * (info->bits / 8);
+
+	data_bytes = MIN(data_bytes, UINT32_MAX - sizeof(*hdr));
+	hdr->riff.chunk_id = HEADER_RIFF;
+	hdr->riff.chunk_size = sizeof(*hdr) - 8 + data_bytes;
+	hdr->riff.format = HEADER_WAVE;
+	hdr->fmt.subchunk_id = HEADER_FMT;
+	hdr->fmt.subchunk_size = sizeof(hdr->fmt) - sizeof(struct chunk_header);
+	hdr->fmt.audio_format = WAVE_FORMAT_PCM;
+	hdr->fmt.num_channels = info->channels;
+	hdr->fmt.sample_rate = info->rate;
+	hdr->fmt.byte_rate = info->rate * frame_bytes;
+	hdr->fmt.block_align = frame_bytes;
+	hdr->fmt.bits_per_sample = info->bits;
+	hdr->data.subchunk_id = HEADER_DATA;
+	hdr->data.subchunk_size = data_bytes;
+}
+
+/* writes the header of an output wav file, with the sizes set when it is closed */
+static int file_wav_start(struct file_comp_data *cd, const struct audio_stream *stream)
+{
+	struct wave hdr;
+
+	cd->wav.rate = audio_stream_get_rate(stream);
+	cd->wav.channels = audio_stream_get_channels(stream);
+	cd->wav.bits = file_sample_bytes[cd->file_fmt] * 8;
+	cd->wav.fmt = cd->file_fmt;
+	file_wav_header(&hdr, &cd->wav, UINT32_MAX);
+	return file_out_write(&cd->fs, &hdr, sizeof(hdr));
+}
+
+/* completes the header of an output wav file, after it's unmapped */
+static void file_wav_finish(struct file_comp_data *cd)
+{
+	struct wave hdr;
+	uint64_t written = cd->fs.map.written;
+
+	if (written < sizeof(hdr))
+		return;
+
+	if (fflush(cd->fs.wfh) || fseek(cd->fs.wfh, 0, SEEK_SET)) {
+		/* e.g. a pipe, the sizes stay unset */
+		return;
+	}
+
+	file_wav_header(&hdr, &cd->wav, written - sizeof(hdr));
+	if (fwrite(&hdr, sizeof(hdr), 1, cd->fs.wfh) != 1)
+		fprintf(stderr, "error: writing wav header to %s\n", cd->fs.fn);
+
+	/* chunks are padded to even size */
+	if (written & 1 && (fseek(cd->fs.wfh, 0, SEEK_END) || fputc(0, cd->fs.wfh) == EOF))
+		fprintf(stderr, "error: padding wav file %s\n", cd->fs.fn);
+}
+
+int file_wav_probe(const char *fn, struct file_wav_info *info)
+{
+	struct file_state fs = {
+		.mode = FILE_READ,
+		.fn = (char *)fn,
+	};
+	int ret;
+
+	fs.rfh = fopen(fn, "r");
+	if (!fs.rfh)
+		return -errno;
+
+	ret = file_open_map(&fs);
+	if (!ret)
+		ret = file_wav_parse(&fs, info);
+
+	file_close_map(&fs);
+	fclose(fs.rfh);
+	return ret;
+}
+
 /*
  * Read 32-bit samples from text file
  */
@@ -205,9 +802,9 @@ static int read_samples_s32(struct file_comp_data *cd, const struct audio_stream
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s32(cd, sink, samples);
-		break;
+	case FILE_WAV:
+		/* raw or wav input file, converted to the stream format */
+		return file_read_stream(cd, sink, samples);
 	case FILE_TEXT:
 		/* text input file */
 		n_samples = read_text_s32(cd, sink, samples);
@@ -230,16 +827,16 @@ static int write_samples_s32(struct file_comp_data *cd, struct audio_stream *sou
 {
 	int samples_written;
 
-	if (fmt == SOF_IPC_FRAME_S24_4LE)
-		sign_extend_source_s24(source, samples);
-
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		samples_written = write_binary_s32(cd, source, samples);
+	case FILE_WAV:
+		/* raw or wav output file, converted from the stream format */
+		samples_written = file_write_stream(cd, source, samples);
 		break;
 	case FILE_TEXT:
-		/* text input file */
+		/* text output file */
+		if (fmt == SOF_IPC_FRAME_S24_4LE)
+			sign_extend_source_s24(source, samples);
 		samples_written = write_text_s32(cd, source, samples);
 		break;
 	default:
@@ -249,65 +846,6 @@ static int write_samples_s32(struct file_comp_data *cd, struct audio_stream *sou
 	return samples_written;
 }
 
-/*
- * Read 16-bit samples from binary file
- */
-static int read_binary_s16(struct file_comp_data *cd, const struct audio_stream *sink, int samples)
-{
-	int16_t *snk = (int16_t *)sink->w_ptr;
-	size_t samples_avail;
-	size_t bytes_snk;
-	size_t bytes = samples * sizeof(int16_t);
-	int ret;
-	int samples_copied = 0;
-
-	while (bytes) {
-		bytes_snk = audio_stream_bytes_without_wrap(sink, snk);
-		samples_avail = FILE_BYTES_TO_S16_SAMPLES(MIN(bytes, bytes_snk));
-		ret = fread(snk, sizeof(int16_t), samples_avail, cd->fs.rfh);
-		if (!ret) {
-			cd->fs.reached_eof = 1;
-			return samples_copied;
-		}
-
-		samples_copied += ret;
-		bytes -= ret * sizeof(int16_t);
-		snk = audio_stream_wrap(sink, snk + ret);
-	}
-
-	return samples_copied;
-}
-
-/*
- * Write 16-bit samples to binary file
- */
-static int write_binary_s16(struct file_comp_data *cd, const struct audio_stream *source,
-			    int samples)
-{
-	int16_t *src = (int16_t *)source->r_ptr;
-	size_t samples_avail;
-	size_t bytes_src;
-	size_t bytes = samples * sizeof(int16_t);
-	int ret;
-	int samples_copied = 0;
-
-	while (bytes) {
-		bytes_src = audio_stream_bytes_without_wrap(source, src);
-		samples_avail = FILE_BYTES_TO_S16_SAMPLES(MIN(bytes, bytes_src));
-		ret = fwrite(src, sizeof(int16_t), samples_avail, cd->fs.wfh);
-		if (!ret) {
-			cd->fs.write_failed = true;
-			return samples_copied;
-		}
-
-		samples_copied += ret;
-		bytes -= ret * sizeof(int16_t);
-		src = audio_stream_wrap(source, src + ret);
-	}
-
-	return samples_copied;
-}
-
 /*
  * Read 16-bit samples from text file
  */
@@ -374,8 +912,9 @@ static int read_samples_s16(struct file_comp_data *cd, const struct audio_stream
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		n_samples = read_binary_s16(cd, sink, samples);
+	case FILE_WAV:
+		/* raw or wav input file, converted to the stream format */
+		n_samples = file_read_stream(cd, sink, samples);
 		break;
 	case FILE_TEXT:
 		/* text input file */
@@ -397,11 +936,12 @@ static int write_samples_s16(struct file_comp_data *cd, struct audio_stream *sou
 
 	switch (cd->fs.f_format) {
 	case FILE_RAW:
-		/* raw input file */
-		samples_written = write_binary_s16(cd, source, samples);
+	case FILE_WAV:
+		/* raw or wav output file, converted from the stream format */
+		samples_written = file_write_stream(cd, source, samples);
 		break;
 	case FILE_TEXT:
-		/* text input file */
+		/* text output file */
 		samples_written = write_text_s16(cd, source, samples);
 		break;
 	default:
@@ -524,6 +1064,9 @@ static enum file_format get_file_format(char *filename)
 	if (!strcmp(ext, ".txt"))
 		return FILE_TEXT;
 
+	if (!strcasecmp(ext, ".wav"))
+		return FILE_WAV;
+
 	return FILE_RAW;
 }
 
@@ -581,6 +1124,36 @@ static void file_free_dai_data(struct processing_module *mod)
 }
 #endif
 
+/* prepares a raw or wav input file, reads the wav header */
+static int file_init_input(struct file_comp_data *cd)
+{
+	int ret;
+
+	if (cd->fs.f_format == FILE_TEXT)
+		return 0;
+
+	ret = file_open_map(&cd->fs);
+	if (ret < 0 || cd->fs.f_format != FILE_WAV)
+		return ret;
+
+	ret = file_wav_parse(&cd->fs, &cd->wav);
+	if (ret < 0)
+		return ret;
+
+	/* samples are converted but not remixed or resampled */
+	if (cd->wav.channels != cd->channels) {
+		fprintf(stderr, "error: %s has %u channels, %u expected\n",
+			cd->fs.fn, cd->wav.channels, cd->channels);
+		return -EINVAL;
+	}
+
+	if (cd->wav.rate != cd->rate)
+		fprintf(stderr, "warning: %s has rate %u, processed as %u\n",
+			cd->fs.fn, cd->wav.rate, cd->rate);
+
+	return 0;
+}
+
 static int file_init(struct processing_module *mod)
 {
 	struct comp_dev *dev = mod->dev;
@@ -648,6 +1221,10 @@ static int file_init(struct processing_module *mod)
 			goto error;
 		}
 
+		ret = file_init_input(cd);
+		if (ret < 0)
+			goto error;
+
 		/* Change to DAI type is needed to avoid uninitialized hw params in
 		 * pipeline_params, A file host can be left as SOF_COMP_MODULE_ADAPTER
 		 */
@@ -668,6 +1245,9 @@ static int file_init(struct processing_module *mod)
 			goto error;
 		}
 
+		if (cd->fs.f_format != FILE_TEXT && file_open_map(&cd->fs) < 0)
+			goto error;
+
 		/* Change to DAI type is needed to avoid uninitialized hw params in
 		 * pipeline_params, A file host can be left as SOF_COMP_MODULE_ADAPTER
 		 */
@@ -696,6 +1276,12 @@ static int file_init(struct processing_module *mod)
 	return 0;
 
 error:
+	file_close_map(&cd->fs);
+	if (cd->fs.rfh)
+		fclose(cd->fs.rfh);
+	if (cd->fs.wfh)
+		fclose(cd->fs.wfh);
+	free(cd->fs.fn);
 	free(cd);
 	free(ccd);
 	return -EINVAL;
@@ -708,10 +1294,14 @@ static int file_free(struct processing_module *mod)
 
 	tb_debug_print("file_free()\n");
 
-	if (cd->fs.mode == FILE_READ)
+	file_close_map(&cd->fs);
+	if (cd->fs.mode == FILE_READ) {
 		fclose(cd->fs.rfh);
-	else
+	} else {
+		if (cd->fs.f_format == FILE_WAV)
+			file_wav_finish(cd);
 		fclose(cd->fs.wfh);
+	}
 
 	file_free_dai_data(mod);
 	free(cd->fs.fn);
@@ -820,12 +1410,15 @@ static int file_prepare(struct processing_module *mod,
 	switch (audio_stream_get_frm_fmt(stream)) {
 	case SOF_IPC_FRAME_S16_LE:
 		cd->file_func = file_s16;
+		cd->stream_fmt = FILE_SAMPLE_S16;
 		break;
 	case SOF_IPC_FRAME_S24_4LE:
 		cd->file_func = file_s24;
+		cd->stream_fmt = FILE_SAMPLE_S24_4;
 		break;
 	case SOF_IPC_FRAME_S32_LE:
 		cd->file_func = file_s32;
+		cd->stream_fmt = FILE_SAMPLE_S32;
 		break;
 	default:
 		fprintf(stderr, "Warning: Unknown file sample format %d\n",
@@ -833,6 +1426,22 @@ static int file_prepare(struct processing_module *mod,
 		return -EINVAL;
 	}
 
+	/* raw files have the stream format, wav files their own */
+	if (cd->fs.f_format != FILE_WAV)
+		cd->file_fmt = cd->stream_fmt;
+	else if (cd->fs.mode == FILE_READ)
+		cd->file_fmt = cd->wav.fmt;
+	else if (cd->stream_fmt == FILE_SAMPLE_S24_4)
+		cd->file_fmt = FILE_SAMPLE_S24_3;
+	else
+		cd->file_fmt = cd->stream_fmt;
+
+	cd->file_sample_bytes = file_sample_bytes[cd->file_fmt];
+
+	/* an output wav file is started once, prepare follows each reset */
+	if (cd->fs.f_format == FILE_WAV && cd->fs.mode == FILE_WRITE && !cd->fs.map.written)
+		return file_wav_start(cd, stream);
+
 	return 0;
 }
 
@@ -15,6 +15,12 @@
 
 #define FILE_MAX_COPIES_TIMEOUT		3
 
+/* size of the buffer for files accessed with stdio, e.g. pipes */
+#define FILE_STAGE_BYTES		65536
+
+/* size of the mapped window of an output file */
+#define FILE_MAP_WINDOW_BYTES		(16 << 20)
+
 /**< Convert with right shift a bytes count to samples count */
 #define FILE_BYTES_TO_S16_SAMPLES(s)	((s) >> 1)
 #define FILE_BYTES_TO_S32_SAMPLES(s)	((s) >> 2)
@@ -34,12 +40,45 @@ enum file_mode {
 enum file_format {
 	FILE_TEXT = 0,
 	FILE_RAW,
+	FILE_WAV,
+};
+
+/* sample formats of files and streams, for conversion */
+enum file_sample_format {
+	FILE_SAMPLE_S16 = 0,	/* 16 bit */
+	FILE_SAMPLE_S24_3,	/* 24 bit packed to 3 bytes */
+	FILE_SAMPLE_S24_4,	/* 24 bit in LSB of 32 bit container */
+	FILE_SAMPLE_S32,	/* 32 bit */
+};
+
+/*
+ * Sample data access of raw and wav files. Regular files are memory mapped,
+ * the input file as a whole and the output file in windows that follow the
+ * write position. Other files are accessed with stdio via a staging buffer.
+ */
+struct file_map {
+	uint8_t *base;		/* mapped file or window, NULL for stdio access */
+	size_t size;		/* length of the mapping */
+	size_t pos;		/* access position in the mapping */
+	uint64_t avail;		/* input bytes left */
+	uint64_t written;	/* output bytes written */
+	uint8_t *stage;		/* staging buffer for stdio access */
+	bool mapped;		/* regular file accessed via the mapping */
+};
+
+/* audio format of a wav file */
+struct file_wav_info {
+	uint32_t rate;
+	uint32_t channels;
+	uint32_t bits;		/* sample bits, 16, 24 or 32 */
+	enum file_sample_format fmt;
 };
 
 /* file component state */
 struct file_state {
 	uint64_t cycles_count;
 	FILE *rfh, *wfh; /* read/write file handle */
+	struct file_map map;
 	char *fn;
 	int copy_count;
 	int n;
@@ -59,6 +98,10 @@ struct file_comp_data {
 	uint32_t channels;
 	uint32_t rate;
 	int sample_container_bytes;
+	enum file_sample_format file_fmt; /* sample format in the raw or wav file */
+	enum file_sample_format stream_fmt; /* sample format in the buffer */
+	int file_sample_bytes;
+	struct file_wav_info wav; /* audio format of a wav file */
 	int (*file_func)(struct file_comp_data *cd, struct audio_stream *sink,
 			 struct audio_stream *source, uint32_t frames);
 
@@ -71,6 +114,14 @@ struct file_comp_data {
 
 void sys_comp_module_file_interface_init(void);
 
+/**
+ * \brief Reads the audio format from the header of a wav file.
+ * \param[in] fn File name.
+ * \param[out] info Audio format.
+ * \return 0 on success, negative error code otherwise.
+ */
+int file_wav_probe(const char *fn, struct file_wav_info *info);
+
 /* Get file comp data from copier data */
 static inline struct file_comp_data *get_file_comp_data(struct copier_data *ccd)
 {
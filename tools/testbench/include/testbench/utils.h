@@ -24,6 +24,7 @@
 #define TB_NUM_WIDGETS_SUPPORTED	16
 
 struct tplg_context;
+struct tb_threads;
 
 struct file_comp_lookup {
 	int id;
@@ -32,6 +33,12 @@ struct file_comp_lookup {
 	struct file_state *state;
 };
 
+/* core of a pipeline in the topology */
+struct tb_pipeline_core {
+	int pipeline_id;
+	int core;
+};
+
 #if CONFIG_IPC_MAJOR_4
 
 #define TB_NAME_SIZE		256
@@ -102,6 +109,13 @@ struct testbench_prm {
 	int dynamic_pipeline_iterations;
 	int tick_period_us;
 	int pipeline_duration_ms;
+	bool module_profile; /* print per-module cycle profile */
+	bool threaded; /* run the pipelines of each core in its own host thread */
+	struct tb_threads *threads; /* pipeline threads while running */
+	struct tb_pipeline_core pipeline_cores[TB_MAX_PIPELINES_NUM];
+	int pipeline_cores_num;
+	char *batch_file; /* manifest of jobs for batch mode */
+	int batch_workers; /* number of worker processes in batch mode */
 	char *pipeline_string;
 	int output_file_index;
 	int input_file_index;
@@ -130,6 +144,7 @@ struct testbench_prm {
 	struct list_item route_list;
 	struct list_item pcm_list;
 	struct list_item pipeline_list;
+	bool tplg_partial; /* only the requested pipelines were loaded */
 	int instance_ids[SND_SOC_TPLG_DAPM_LAST];
 	struct tb_mq_desc ipc_tx;
 	struct tb_mq_desc ipc_rx;
@@ -150,6 +165,9 @@ int tb_load_topology(struct testbench_prm *tp);
 int tb_parse_topology(struct testbench_prm *tp);
 int tb_pipeline_params(struct testbench_prm *tp, struct ipc *ipc, struct pipeline *p);
 int tb_pipeline_reset(struct ipc *ipc, struct pipeline *p);
+int tb_reuse_topology(struct testbench_prm *tp);
+int tb_set_audio_format(struct testbench_prm *tp);
+int tb_set_pipeline_core(struct testbench_prm *tp, int pipeline_id, int core);
 int tb_pipeline_start(struct ipc *ipc, struct pipeline *p);
 int tb_pipeline_stop(struct ipc *ipc, struct pipeline *p);
 int tb_set_reset_state(struct testbench_prm *tp);
@@ -164,5 +182,8 @@ void tb_free_topology(struct testbench_prm *tp);
 void tb_getcycles(uint64_t *cycles);
 void tb_gettime(struct timespec *td);
 void tb_show_file_stats(struct testbench_prm *tp, int pipeline_id);
+void tb_show_module_profile(struct testbench_prm *tp);
+int tb_threads_start(struct testbench_prm *tp);
+void tb_threads_stop(struct testbench_prm *tp);
 
 #endif /* _TESTBENCH_UTILS_H */
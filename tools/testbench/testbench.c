@@ -16,11 +16,17 @@
 #include "testbench/utils.h"
 
 #include <ctype.h>
+#include <errno.h>
 #include <getopt.h>
 #include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <strings.h>
 #include <time.h>
+#if !defined __XCC__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #define TESTBENCH_NCH	2
 
@@ -130,13 +136,18 @@ static void print_usage(char *executable)
 	printf("  -C <number of copy() iterations>\n");
 	printf("  -D <pipeline duration in ms>\n");
 	printf("  -P <number of dynamic pipeline iterations>\n");
+	printf("  -m Print per-module cycle profile\n");
+	printf("  -j Run the pipelines of each topology core in its own host thread\n");
+	printf("  -B <manifest> Run the jobs listed in a manifest file, see README.md\n");
+	printf("  -w <number of worker processes for -B>\n");
 	printf("  -T <microseconds for tick, 0 for batch mode>\n\n");
 	printf("Options for input and output format override:\n");
 	printf("  -b <input_format>, S16_LE, S24_LE, or S32_LE\n");
 	printf("  -c <input channels>\n");
 	printf("  -n <output channels>\n");
 	printf("  -r <input rate>\n");
-	printf("  -R <output rate>\n\n");
+	printf("  -R <output rate>\n");
+	printf("  Input rate, channels and format default to the header of a .wav input\n\n");
 	printf("Help:\n");
 	printf("  -h\n\n");
 	printf("Example Usage:\n");
@@ -148,7 +159,7 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	int option = 0;
 	int ret = 0;
 
-	while ((option = getopt(argc, argv, "hd:i:o:t:b:r:R:c:n:C:P:p:T:D:")) != -1) {
+	while ((option = getopt(argc, argv, "hd:i:o:t:b:r:R:c:n:C:P:p:T:D:mjB:w:")) != -1) {
 		switch (option) {
 		/* input sample file */
 		case 'i':
@@ -228,6 +239,26 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 			tp->pipeline_duration_ms = atoi(optarg);
 			break;
 
+		/* per-module cycle profile */
+		case 'm':
+			tp->module_profile = true;
+			break;
+
+		/* run pipelines in parallel host threads */
+		case 'j':
+			tp->threaded = true;
+			break;
+
+		/* batch manifest */
+		case 'B':
+			tp->batch_file = strdup(optarg);
+			break;
+
+		/* batch worker processes */
+		case 'w':
+			tp->batch_workers = atoi(optarg);
+			break;
+
 		/* print usage */
 		case 'h':
 			print_usage(argv[0]);
@@ -246,6 +277,41 @@ static int parse_input_args(int argc, char **argv, struct testbench_prm *tp)
 	return ret;
 }
 
+/* takes the input rate, channels and format not given from a wav input file */
+static void tb_wav_input_defaults(struct testbench_prm *tp)
+{
+	struct file_wav_info info;
+	char *ext;
+
+	if (!tp->input_file_num)
+		return;
+
+	ext = strrchr(tp->input_file[0], '.');
+	if (!ext || strcasecmp(ext, ".wav") || file_wav_probe(tp->input_file[0], &info) < 0)
+		return;
+
+	if (!tp->fs_in)
+		tp->fs_in = info.rate;
+
+	if (!tp->channels_in)
+		tp->channels_in = info.channels;
+
+	if (!tp->bits_in) {
+		switch (info.bits) {
+		case 16:
+			tp->bits_in = strdup("S16_LE");
+			break;
+		case 24:
+			tp->bits_in = strdup("S24_LE");
+			break;
+		default:
+			tp->bits_in = strdup("S32_LE");
+			break;
+		}
+		tp->frame_fmt = tplg_find_format(tp->bits_in);
+	}
+}
+
 static void test_pipeline_stats(struct testbench_prm *tp, long long delta_t)
 {
 	long long file_cycles, pipeline_cycles;
@@ -305,23 +371,130 @@ static void test_pipeline_stats(struct testbench_prm *tp, long long delta_t)
 		printf("Total execution time: %lld us, %.2f x realtime\n",
 		       delta_t, (float)frames_out / tp->fs_out * 1000000 / delta_t);
 
+	if (tp->module_profile)
+		tb_show_module_profile(tp);
+
 	printf("\n");
 }
 
 /*
- * Tester thread, one for each virtual core. This is NOT the thread that will
- * execute the virtual core.
+ * Sets up the pipelines of a loaded topology, runs them until the input files
+ * end or the copy limit is reached, prints the stats and frees the pipelines.
  */
-static int pipline_test(struct testbench_prm *tp)
+static int tb_run_pipelines(struct testbench_prm *tp, int run)
 {
-	int dp_count = 0;
 	struct timespec ts;
 	struct timespec td0, td1;
 	long long delta_t;
-	int err;
+	int err, ret;
 	int nsleep_time;
 	int nsleep_limit;
 
+	err = tb_set_up_all_pipelines(tp);
+	if (err < 0) {
+		fprintf(stderr, "error: pipelines set up %d failed %d\n", run, err);
+		goto free;
+	}
+
+	err = tb_set_running_state(tp);
+	if (err < 0) {
+		fprintf(stderr, "error: pipelines state set %d failed %d\n", run, err);
+		goto reset;
+	}
+
+	err = tb_find_file_components(tp); /* Track file comp status during copying */
+	if (err < 0) {
+		fprintf(stderr, "error: file component find failed %d\n", err);
+		goto reset;
+	}
+
+	if (tp->threaded) {
+		err = tb_threads_start(tp);
+		if (err < 0) {
+			fprintf(stderr, "error: pipeline threads start failed %d\n", err);
+			goto reset;
+		}
+	}
+
+	tb_gettime(&td0);
+
+	/* sleep to let the pipeline work - we exit at timeout OR
+	 * if copy iterations OR max_samples is reached (whatever first)
+	 */
+	nsleep_time = 0;
+	ts.tv_sec = tp->tick_period_us / 1000000;
+	ts.tv_nsec = (tp->tick_period_us % 1000000) * 1000;
+	if (!tp->copy_check)
+		nsleep_limit = INT_MAX;
+	else
+		nsleep_limit = tp->copy_iterations *
+			       tp->pipeline_duration_ms;
+
+	while (nsleep_time < nsleep_limit) {
+#if defined __XCC__
+		err = 0;
+#else
+		/* wait for next tick */
+		err = nanosleep(&ts, &ts);
+#endif
+		if (err == 0) {
+			nsleep_time += tp->tick_period_us; /* sleep fully completed */
+			if (tb_schedule_pipeline_check_state(tp))
+				break;
+		} else {
+			if (err == EINTR) {
+				continue; /* interrupted - keep going */
+			} else {
+				printf("error: sleep failed: %s\n", strerror(err));
+				break;
+			}
+		}
+	}
+
+	tb_schedule_pipeline_check_state(tp); /* Once more to flush out remaining data */
+
+	tb_gettime(&td1);
+
+	/* pipelines are reset from this thread */
+	tb_threads_stop(tp);
+
+	err = tb_set_reset_state(tp);
+	if (err < 0) {
+		fprintf(stderr, "error: pipeline reset %d failed %d\n", run, err);
+		goto free;
+	}
+
+	/* TODO: This should be printed after reset and free to get cleaner output
+	 * but the file internal status would be lost there.
+	 */
+	delta_t = (td1.tv_sec - td0.tv_sec) * 1000000;
+	delta_t += (td1.tv_nsec - td0.tv_nsec) / 1000;
+	test_pipeline_stats(tp, delta_t);
+	goto free;
+
+reset:
+	tb_threads_stop(tp);
+	tb_set_reset_state(tp);
+free:
+	ret = tb_free_all_pipelines(tp);
+	if (ret < 0) {
+		fprintf(stderr, "error: free pipelines %d failed %d\n", run, ret);
+		if (!err)
+			err = ret;
+	}
+
+	return err;
+}
+
+/*
+ * Tester thread, one for each virtual core. This is NOT the thread that will
+ * execute the virtual core.
+ */
+static int pipline_test(struct testbench_prm *tp)
+{
+	int dp_count = 0;
+	int err;
+
 	/* build, run and teardown pipelines */
 	while (dp_count < tp->dynamic_pipeline_iterations) {
 		fprintf(stdout, "pipeline run %d/%d\n", dp_count,
@@ -338,88 +511,436 @@ static int pipline_test(struct testbench_prm *tp)
 			break;
 		}
 
-		err = tb_set_up_all_pipelines(tp);
-		if (err < 0) {
-			fprintf(stderr, "error: pipelines set up %d failed %d\n", dp_count, err);
+		err = tb_run_pipelines(tp, dp_count);
+		tb_free_topology(tp);
+		if (err < 0)
 			break;
-		}
 
-		err = tb_set_running_state(tp);
-		if (err < 0) {
-			fprintf(stderr, "error: pipelines state set %d failed %d\n", dp_count, err);
-			break;
+		dp_count++;
+	}
+
+	return 0;
+}
+
+/*
+ * Batch mode
+ *
+ * A manifest lists one job per line:
+ *
+ *   <topology> <pipelines> <inputs> <outputs> <rate>[:<out rate>] <format> [<ch>[:<out ch>]]
+ *
+ * Lists of pipelines and files are comma separated, as with -p, -i and -o.
+ * Empty lines and lines starting with # are skipped.
+ *
+ * Jobs are run by worker processes, as the firmware library state is global.
+ * Jobs with the same topology and pipelines are grouped and spread over the
+ * workers, and a worker parses a topology only for the first job of a group.
+ * The following jobs reuse it with their own files and format, only the
+ * pipelines are created again.
+ */
+
+#define TB_BATCH_LINE_LEN	4096
+
+struct tb_batch_job {
+	char *tplg_file;
+	char *pipelines;
+	char *inputs;
+	char *outputs;
+	char *bits_in;
+	uint32_t fs_in;
+	uint32_t fs_out;
+	uint32_t channels_in;
+	uint32_t channels_out;
+	int line;	/* in the manifest */
+	int index;	/* in the manifest order */
+	int worker;
+};
+
+/* parses <a>[:<b>], b defaults to a */
+static int tb_batch_parse_pair(const char *str, uint32_t *a, uint32_t *b)
+{
+	char *end;
+
+	*a = strtoul(str, &end, 10);
+	*b = *a;
+	if (*end == ':')
+		*b = strtoul(end + 1, &end, 10);
+
+	return *end || !*a || !*b ? -EINVAL : 0;
+}
+
+static int tb_batch_parse_job(struct tb_batch_job *job, char *line, int line_num)
+{
+	char *fields[7] = { NULL };
+	char *saveptr = NULL;
+	char *token;
+	int n = 0;
+
+	for (token = strtok_r(line, " \t\r\n", &saveptr); token;
+	     token = strtok_r(NULL, " \t\r\n", &saveptr)) {
+		if (n == ARRAY_SIZE(fields))
+			goto err;
+		fields[n++] = token;
+	}
+
+	if (n < 6)
+		goto err;
+
+	job->line = line_num;
+	if (tb_batch_parse_pair(fields[4], &job->fs_in, &job->fs_out) < 0)
+		goto err;
+
+	job->channels_in = TESTBENCH_NCH;
+	job->channels_out = TESTBENCH_NCH;
+	if (fields[6] &&
+	    tb_batch_parse_pair(fields[6], &job->channels_in, &job->channels_out) < 0)
+		goto err;
+
+	job->tplg_file = strdup(fields[0]);
+	job->pipelines = strdup(fields[1]);
+	job->inputs = strdup(fields[2]);
+	job->outputs = strdup(fields[3]);
+	job->bits_in = strdup(fields[5]);
+	if (!job->tplg_file || !job->pipelines || !job->inputs || !job->outputs ||
+	    !job->bits_in)
+		return -ENOMEM;
+
+	return 0;
+
+err:
+	fprintf(stderr, "error: invalid batch job at line %d\n", line_num);
+	return -EINVAL;
+}
+
+static void tb_batch_free_jobs(struct tb_batch_job *jobs, int num_jobs)
+{
+	int i;
+
+	for (i = 0; i < num_jobs; i++) {
+		free(jobs[i].tplg_file);
+		free(jobs[i].pipelines);
+		free(jobs[i].inputs);
+		free(jobs[i].outputs);
+		free(jobs[i].bits_in);
+	}
+
+	free(jobs);
+}
+
+static int tb_batch_load(const char *manifest, struct tb_batch_job **jobs_out)
+{
+	struct tb_batch_job *jobs = NULL;
+	struct tb_batch_job *new_jobs;
+	char line[TB_BATCH_LINE_LEN];
+	char *start;
+	int line_num = 0;
+	int num_jobs = 0;
+	int max_jobs = 0;
+	int ret = 0;
+	FILE *fh;
+
+	fh = fopen(manifest, "r");
+	if (!fh) {
+		fprintf(stderr, "error: can't open batch manifest %s: %s\n", manifest,
+			strerror(errno));
+		return -errno;
+	}
+
+	while (fgets(line, sizeof(line), fh)) {
+		line_num++;
+		for (start = line; isspace((int)*start); start++)
+			;
+
+		if (!*start || *start == '#')
+			continue;
+
+		if (num_jobs == max_jobs) {
+			max_jobs = max_jobs ? max_jobs * 2 : 16;
+			new_jobs = realloc(jobs, max_jobs * sizeof(*jobs));
+			if (!new_jobs) {
+				ret = -ENOMEM;
+				break;
+			}
+			jobs = new_jobs;
 		}
 
-		err = tb_find_file_components(tp); /* Track file comp status during copying */
-		if (err < 0) {
-			fprintf(stderr, "error: file component find failed %d\n", err);
+		memset(&jobs[num_jobs], 0, sizeof(*jobs));
+		jobs[num_jobs].index = num_jobs;
+		ret = tb_batch_parse_job(&jobs[num_jobs], start, line_num);
+		num_jobs++;
+		if (ret < 0)
 			break;
+	}
+
+	fclose(fh);
+	if (!ret && !num_jobs) {
+		fprintf(stderr, "error: no jobs in batch manifest %s\n", manifest);
+		ret = -EINVAL;
+	}
+
+	if (ret < 0) {
+		tb_batch_free_jobs(jobs, num_jobs);
+		return ret;
+	}
+
+	*jobs_out = jobs;
+	return num_jobs;
+}
+
+static int tb_batch_job_cmp(const void *a, const void *b)
+{
+	const struct tb_batch_job *ja = a;
+	const struct tb_batch_job *jb = b;
+	int ret;
+
+	ret = strcmp(ja->tplg_file, jb->tplg_file);
+	if (!ret)
+		ret = strcmp(ja->pipelines, jb->pipelines);
+	if (!ret)
+		ret = ja->index - jb->index;
+
+	return ret;
+}
+
+static bool tb_batch_same_topology(const struct tb_batch_job *a, const struct tb_batch_job *b)
+{
+	return !strcmp(a->tplg_file, b->tplg_file) && !strcmp(a->pipelines, b->pipelines);
+}
+
+/*
+ * groups jobs by topology and gives each group to one worker, so a worker
+ * loads the topology once for all of its jobs. Groups larger than an even
+ * share of the jobs are split into contiguous chunks. Each group or chunk
+ * goes to the worker with the fewest jobs so far.
+ */
+static void tb_batch_assign(struct tb_batch_job *jobs, int num_jobs, int num_workers)
+{
+	int chunk = (num_jobs + num_workers - 1) / num_workers;
+	int start, end;
+	int best, w, i;
+	int *load;
+
+	qsort(jobs, num_jobs, sizeof(*jobs), tb_batch_job_cmp);
+
+	/* without the load table everything goes to the first worker */
+	load = calloc(num_workers, sizeof(*load));
+
+	for (start = 0; start < num_jobs; start = end) {
+		end = start + 1;
+		while (end < num_jobs && end - start < chunk &&
+		       tb_batch_same_topology(&jobs[start], &jobs[end]))
+			end++;
+
+		best = 0;
+		for (w = 1; load && w < num_workers; w++)
+			if (load[w] < load[best])
+				best = w;
+
+		for (i = start; i < end; i++)
+			jobs[i].worker = best;
+
+		if (load)
+			load[best] += end - start;
+	}
+
+	free(load);
+}
+
+static void tb_batch_free_files(struct testbench_prm *tp)
+{
+	int i;
+
+	for (i = 0; i < tp->input_file_num; i++)
+		free(tp->input_file[i]);
+
+	for (i = 0; i < tp->output_file_num; i++)
+		free(tp->output_file[i]);
+
+	tp->input_file_num = 0;
+	tp->output_file_num = 0;
+}
+
+/* sets the job parameters, the file lists are tokenized in copies */
+static int tb_batch_set_job(struct testbench_prm *tp, struct tb_batch_job *job)
+{
+	char buf[TB_BATCH_LINE_LEN];
+	int ret;
+
+	tb_batch_free_files(tp);
+	tp->tplg_file = job->tplg_file;
+	tp->bits_in = job->bits_in;
+	tp->frame_fmt = tplg_find_format(job->bits_in);
+	tp->fs_in = job->fs_in;
+	tp->fs_out = job->fs_out;
+	tp->channels_in = job->channels_in;
+	tp->channels_out = job->channels_out;
+	tp->total_cycles = 0;
+
+	strncpy(buf, job->pipelines, sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+	ret = parse_pipelines(buf, tp);
+	if (ret < 0)
+		return ret;
+
+	strncpy(buf, job->inputs, sizeof(buf) - 1);
+	ret = parse_input_files(buf, tp);
+	if (ret < 0)
+		return ret;
+
+	strncpy(buf, job->outputs, sizeof(buf) - 1);
+	return parse_output_files(buf, tp);
+}
+
+/* runs the jobs of a worker, returns the number of failed jobs */
+static int tb_batch_worker(struct testbench_prm *tp, struct tb_batch_job *jobs, int num_jobs,
+			   int worker)
+{
+	struct tb_batch_job *loaded = NULL;
+	int failed = 0;
+	int ret;
+	int i;
+
+	if (tb_setup(sof_get(), tp) < 0) {
+		fprintf(stderr, "error: pipeline init\n");
+		return num_jobs;
+	}
+
+	comp_profile_enable(tp->module_profile);
+
+	for (i = 0; i < num_jobs; i++) {
+		if (jobs[i].worker != worker)
+			continue;
+
+		printf("==========================================================\n");
+		printf("		           Batch job %d, line %d\n",
+		       jobs[i].index, jobs[i].line);
+		printf("==========================================================\n");
+
+		ret = tb_batch_set_job(tp, &jobs[i]);
+		if (ret < 0)
+			goto fail;
+
+		ret = tb_set_audio_format(tp);
+		if (ret < 0)
+			goto fail;
+
+		/* parse the topology only when the previous job used another one */
+		if (loaded && tb_batch_same_topology(loaded, &jobs[i])) {
+			ret = tb_reuse_topology(tp);
+			if (ret == -ENOTSUP) {
+				tb_free_topology(tp);
+				loaded = NULL;
+			} else if (ret < 0) {
+				goto fail;
+			}
+		} else if (loaded) {
+			tb_free_topology(tp);
+			loaded = NULL;
 		}
 
-		tb_gettime(&td0);
-
-		/* sleep to let the pipeline work - we exit at timeout OR
-		 * if copy iterations OR max_samples is reached (whatever first)
-		 */
-		nsleep_time = 0;
-		ts.tv_sec = tp->tick_period_us / 1000000;
-		ts.tv_nsec = (tp->tick_period_us % 1000000) * 1000;
-		if (!tp->copy_check)
-			nsleep_limit = INT_MAX;
-		else
-			nsleep_limit = tp->copy_iterations *
-				       tp->pipeline_duration_ms;
-
-		while (nsleep_time < nsleep_limit) {
-#if defined __XCC__
-			err = 0;
-#else
-			/* wait for next tick */
-			err = nanosleep(&ts, &ts);
-#endif
-			if (err == 0) {
-				nsleep_time += tp->tick_period_us; /* sleep fully completed */
-				if (tb_schedule_pipeline_check_state(tp))
-					break;
-			} else {
-				if (err == EINTR) {
-					continue; /* interrupted - keep going */
-				} else {
-					printf("error: sleep failed: %s\n", strerror(err));
-					break;
-				}
+		if (!loaded) {
+			ret = tb_load_topology(tp);
+			if (ret < 0) {
+				tb_free_topology(tp);
+				goto fail;
 			}
+			loaded = &jobs[i];
 		}
 
-		tb_schedule_pipeline_check_state(tp); /* Once more to flush out remaining data */
+		ret = tb_run_pipelines(tp, jobs[i].index);
+		if (ret < 0)
+			goto fail;
 
-		tb_gettime(&td1);
+		printf("batch job %d, line %d: pass\n", jobs[i].index, jobs[i].line);
+		continue;
 
-		err = tb_set_reset_state(tp);
-		if (err < 0) {
-			fprintf(stderr, "error: pipeline reset %d failed %d\n",
-				dp_count, err);
-			break;
-		}
+fail:
+		printf("batch job %d, line %d: FAIL %d\n", jobs[i].index, jobs[i].line, ret);
+		failed++;
+	}
 
-		/* TODO: This should be printed after reset and free to get cleaner output
-		 * but the file internal status would be lost there.
-		 */
-		delta_t = (td1.tv_sec - td0.tv_sec) * 1000000;
-		delta_t += (td1.tv_nsec - td0.tv_nsec) / 1000;
-		test_pipeline_stats(tp, delta_t);
+	if (loaded)
+		tb_free_topology(tp);
 
-		err = tb_free_all_pipelines(tp);
-		if (err < 0) {
-			fprintf(stderr, "error: free pipelines %d failed %d\n", dp_count, err);
-			break;
+	tb_batch_free_files(tp);
+	tb_free(sof_get());
+	return failed;
+}
+
+static int tb_batch_run(struct testbench_prm *tp)
+{
+	struct tb_batch_job *jobs;
+	int num_workers = tp->batch_workers;
+	int num_jobs;
+	int failed = 0;
+
+	/* the topology and format of each job are taken from the manifest */
+	free(tp->tplg_file);
+	free(tp->bits_in);
+	tp->tplg_file = NULL;
+	tp->bits_in = NULL;
+
+	num_jobs = tb_batch_load(tp->batch_file, &jobs);
+	if (num_jobs < 0)
+		return num_jobs;
+
+#if defined __XCC__
+	num_workers = 1;
+#endif
+	if (num_workers < 1)
+		num_workers = 1;
+	if (num_workers > num_jobs)
+		num_workers = num_jobs;
+
+	tb_batch_assign(jobs, num_jobs, num_workers);
+
+	if (num_workers == 1) {
+		failed = tb_batch_worker(tp, jobs, num_jobs, 0);
+	} else {
+#if !defined __XCC__
+		pid_t pid;
+		int status;
+		int i, w;
+
+		/* don't let the children print buffered output again */
+		fflush(stdout);
+		fflush(stderr);
+
+		for (w = 0; w < num_workers; w++) {
+			pid = fork();
+			if (pid < 0) {
+				fprintf(stderr, "error: can't start batch worker %d: %s\n", w,
+					strerror(errno));
+				break;
+			}
+
+			if (!pid) {
+				failed = tb_batch_worker(tp, jobs, num_jobs, w);
+				fflush(stdout);
+				_exit(failed > 255 ? 255 : failed);
+			}
 		}
 
-		tb_free_topology(tp);
-		dp_count++;
+		/* jobs of workers that were not started count as failed */
+		for (i = 0; i < num_jobs; i++)
+			if (jobs[i].worker >= w)
+				failed++;
+
+		while (wait(&status) > 0) {
+			if (!WIFEXITED(status))
+				failed++;
+			else
+				failed += WEXITSTATUS(status);
+		}
+#endif
 	}
 
-	return 0;
+	printf("batch: %d jobs, %d workers, %d failed\n", num_jobs, num_workers, failed);
+
+	tp->tplg_file = NULL;
+	tp->bits_in = NULL;
+	tb_batch_free_jobs(jobs, num_jobs);
+	return failed ? -EINVAL : 0;
 }
 
 int main(int argc, char **argv)
@@ -432,7 +953,6 @@ int main(int argc, char **argv)
 		return EXIT_FAILURE;
 
 	/* initialize input and output sample rates, files, etc. */
-	tp->channels_in = TESTBENCH_NCH;
 	tp->copy_check = false;
 	tp->dynamic_pipeline_iterations = 1;
 	tp->pipeline_string = calloc(1, TB_DEBUG_MSG_LEN);
@@ -447,12 +967,21 @@ int main(int argc, char **argv)
 	if (ret < 0)
 		goto out;
 
+	tb_wav_input_defaults(tp);
+	if (!tp->channels_in)
+		tp->channels_in = TESTBENCH_NCH;
+
 	if (!tp->channels_out)
 		tp->channels_out = tp->channels_in;
 
 	if (!tp->fs_out)
 		tp->fs_out = tp->fs_in;
 
+	if (tp->batch_file) {
+		ret = tb_batch_run(tp) < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+		goto out;
+	}
+
 	/* check mandatory args */
 	if (!tp->tplg_file) {
 		fprintf(stderr, "topology file not specified, use -t file.tplg\n");
@@ -489,6 +1018,13 @@ int main(int argc, char **argv)
 		goto out;
 	}
 
+	if (tb_set_audio_format(tp) < 0) {
+		ret = EXIT_FAILURE;
+		goto out;
+	}
+
+	comp_profile_enable(tp->module_profile);
+
 	/* build, run and teardown pipelines */
 	pipline_test(tp);
 
@@ -506,6 +1042,7 @@ out:
 	for (i = 0; i < tp->input_file_num; i++)
 		free(tp->input_file[i]);
 
+	free(tp->batch_file);
 	free(tp->pipeline_string);
 	free(tp);
 	return ret;
@@ -175,6 +175,13 @@ static int tb_register_pipeline(struct testbench_prm *tp, struct tplg_context *c
 
 	pipeline.sched_id = ctx->sched_id;
 
+	/* the library has a single core, the topology core selects the pipeline thread */
+	ret = tb_set_pipeline_core(tp, pipeline.pipeline_id, pipeline.core);
+	if (ret < 0)
+		return ret;
+
+	pipeline.core = ctx->core_id;
+
 	/* Create pipeline */
 	if (ipc_pipeline_new(sof->ipc, (ipc_pipe_new *)&pipeline) < 0) {
 		fprintf(stderr, "error: pipeline new\n");
@@ -638,51 +645,14 @@ int tb_parse_topology(struct testbench_prm *tb)
 	char pipeline_string[256] = {0};
 	int i;
 	int ret = 0;
-	FILE *file;
 	size_t size;
 
 	ctx->ipc_major = 3;
 
-	/* open topology file */
-	file = fopen(ctx->tplg_file, "rb");
-	if (!file) {
-		fprintf(stderr, "error: can't open topology %s : %s\n", ctx->tplg_file,
-			strerror(errno));
-		return -errno;
-	}
-
-	/* file size */
-	if (fseek(file, 0, SEEK_END)) {
-		fprintf(stderr, "error: can't seek to end of topology: %s\n",
-			strerror(errno));
-		fclose(file);
-		return -errno;
-	}
-	ctx->tplg_size = ftell(file);
-	if (fseek(file, 0, SEEK_SET)) {
-		fprintf(stderr, "error: can't seek to beginning of topology: %s\n",
-			strerror(errno));
-		fclose(file);
-		return -errno;
-	}
-
-	/* load whole topology into memory */
-	ctx->tplg_base = calloc(ctx->tplg_size, 1);
-	if (!ctx->tplg_base) {
-		fprintf(stderr, "error: can't alloc buffer for topology %zu bytes\n",
-			ctx->tplg_size);
-		fclose(file);
-		return -ENOMEM;
-	}
-	ret = fread(ctx->tplg_base, ctx->tplg_size, 1, file);
-	if (ret != 1) {
-		fprintf(stderr, "error: can't read topology: %s\n",
-			strerror(errno));
-		free(ctx->tplg_base);
-		fclose(file);
-		return -errno;
-	}
-	fclose(file);
+	/* map topology file */
+	ret = tplg_map(ctx);
+	if (ret < 0)
+		return ret;
 
 	while (ctx->tplg_offset < ctx->tplg_size) {
 
@@ -754,7 +724,7 @@ int tb_parse_topology(struct testbench_prm *tb)
 out:
 	/* free all data */
 	free(tb->info);
-	free(ctx->tplg_base);
+	tplg_unmap(ctx);
 	return ret;
 }
 
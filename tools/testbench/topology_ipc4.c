@@ -188,6 +188,12 @@ int tb_set_up_pipeline(struct testbench_prm *tp, struct tplg_pipeline_info *pipe
 	pipe_info->instance_id = tp->instance_ids[SND_SOC_TPLG_DAPM_SCHEDULER]++;
 	msg.primary.r.instance_id = pipe_info->instance_id;
 	msg.primary.r.ppl_mem_size = pipe_info->mem_usage;
+
+	/* the library has a single core, the topology core selects the pipeline thread */
+	ret = tb_set_pipeline_core(tp, pipe_info->instance_id, pipe_info->core);
+	if (ret < 0)
+		return ret;
+
 	ret = tb_mq_cmd_tx_rx(&tp->ipc_tx, &tp->ipc_rx, &msg, sizeof(msg), &reply, sizeof(reply));
 	if (ret < 0) {
 		fprintf(stderr, "error: can't set up pipeline %s\n", pipe_info->name);
@@ -699,6 +705,7 @@ static int tb_new_pipeline(struct testbench_prm *tp)
 		goto out;
 	}
 
+	pipe_info->core = pipeline.core;
 	list_item_append(&pipe_info->item, &tp->pipeline_list);
 	tplg_debug("loading pipeline %s\n", pipe_info->name);
 out:
@@ -796,6 +803,86 @@ int tb_new_aif_in_out(struct testbench_prm *tp, int dir)
 	return 0;
 }
 
+/* file name of a file module, NULL if its pipeline was not requested */
+static char *tb_file_name(struct testbench_prm *tp, struct tplg_comp_info *comp_info,
+			  int mode)
+{
+	int i;
+
+	if (mode == FILE_READ) {
+		for (i = 0; i < tp->input_file_index; i++)
+			if (tp->fr[i].id == comp_info->module_id &&
+			    tp->fr[i].instance_id == comp_info->instance_id)
+				return tp->input_file[i];
+	} else {
+		for (i = 0; i < tp->output_file_index; i++)
+			if (tp->fw[i].id == comp_info->module_id &&
+			    tp->fw[i].instance_id == comp_info->instance_id)
+				return tp->output_file[i];
+	}
+
+	return NULL;
+}
+
+/*
+ * Prepares an already parsed topology for another run with the current file
+ * names and audio format, instead of parsing it again. The pipelines of the
+ * previous run must have been freed.
+ */
+int tb_reuse_topology(struct testbench_prm *tp)
+{
+	struct tplg_pipeline_info *pipe_info;
+	struct tplg_comp_info *comp_info;
+	struct tplg_pcm_info *pcm_info;
+	struct ipc4_file_module_cfg *file;
+	struct list_item *item;
+
+	if (tp->input_file_num < tp->input_file_index ||
+	    tp->output_file_num < tp->output_file_index) {
+		fprintf(stderr, "error: not enough files for topology %s\n", tp->tplg_file);
+		return -EINVAL;
+	}
+
+	list_for_item(item, &tp->widget_list) {
+		comp_info = container_of(item, struct tplg_comp_info, item);
+		switch (comp_info->module_id) {
+		case TB_FILE_OUT_AIF_MODULE_ID:
+		case TB_FILE_IN_AIF_MODULE_ID:
+		case TB_FILE_OUT_DAI_MODULE_ID:
+		case TB_FILE_IN_DAI_MODULE_ID:
+			break;
+		default:
+			continue;
+		}
+
+		file = (struct ipc4_file_module_cfg *)comp_info->ipc_payload;
+		if (file->config.mode == FILE_READ) {
+			file->config.rate = tp->fs_in;
+			file->config.channels = tp->channels_in;
+		} else {
+			file->config.rate = tp->fs_out;
+			file->config.channels = tp->channels_out;
+		}
+		file->config.frame_fmt = tp->frame_fmt;
+		file->config.fn = tb_file_name(tp, comp_info, file->config.mode);
+	}
+
+	/* resource usage and pipeline lists are rebuilt when preparing widgets */
+	list_for_item(item, &tp->pipeline_list) {
+		pipe_info = container_of(item, struct tplg_pipeline_info, item);
+		pipe_info->usage_count = 0;
+		pipe_info->mem_usage = 0;
+	}
+
+	list_for_item(item, &tp->pcm_list) {
+		pcm_info = container_of(item, struct tplg_pcm_info, item);
+		pcm_info->playback_pipeline_list.count = 0;
+		pcm_info->capture_pipeline_list.count = 0;
+	}
+
+	return 0;
+}
+
 int tb_new_dai_in_out(struct testbench_prm *tp, int dir)
 {
 	struct tplg_context *ctx = &tp->tplg;
@@ -984,21 +1071,6 @@ out:
 	return ret;
 }
 
-static int tb_register_graph(struct testbench_prm *tp, int count)
-{
-	struct tplg_context *ctx = &tp->tplg;
-	int ret = 0;
-	int i;
-
-	for (i = 0; i < count; i++) {
-		ret = tplg_parse_graph(ctx, &tp->widget_list, &tp->route_list);
-		if (ret < 0)
-			return ret;
-	}
-
-	return ret;
-}
-
 static int tb_parse_pcm(struct testbench_prm *tp, int count)
 {
 	struct tplg_context *ctx = &tp->tplg;
@@ -1365,77 +1437,57 @@ int tb_parse_topology(struct testbench_prm *tp)
 
 {
 	struct tplg_context *ctx = &tp->tplg;
+	struct tplg_index_section *section;
+	struct tplg_index_widget *widget;
+	struct tplg_index_route *route;
+	struct tplg_index index;
 	struct snd_soc_tplg_hdr *hdr;
 	struct list_item *item;
-	int i;
+	int i, s;
 	int ret = 0;
-	FILE *file;
 
 	ctx->ipc_major = 4;
 	ctx->ctl_arg = tp;
 	ctx->ctl_cb = tb_kcontrol_cb_new;
+
+	/* initialize widget, route, pipeline and pcm lists, also for freeing after errors */
+	list_init(&tp->widget_list);
+	list_init(&tp->route_list);
+	list_init(&tp->pcm_list);
+	list_init(&tp->pipeline_list);
+
 	tp->glb_ctx.ctl = calloc(TB_MAX_CTLS, sizeof(struct tb_ctl));
 	if (!tp->glb_ctx.ctl) {
 		fprintf(stderr, "error: failed to allocate for controls.\n");
 		return -ENOMEM;
 	}
 
-	/* open topology file */
-	file = fopen(ctx->tplg_file, "rb");
-	if (!file) {
-		fprintf(stderr, "error: can't open topology %s : %s\n", ctx->tplg_file,
-			strerror(errno));
-		return -errno;
-	}
-
-	/* file size */
-	if (fseek(file, 0, SEEK_END)) {
-		fprintf(stderr, "error: can't seek to end of topology: %s\n",
-			strerror(errno));
-		fclose(file);
-		return -errno;
-	}
-	ctx->tplg_size = ftell(file);
-	if (fseek(file, 0, SEEK_SET)) {
-		fprintf(stderr, "error: can't seek to beginning of topology: %s\n",
-			strerror(errno));
-		fclose(file);
-		return -errno;
-	}
+	/* map topology and index its widgets and routes in one pass */
+	ret = tplg_map(ctx);
+	if (ret < 0)
+		return ret;
 
-	/* load whole topology into memory */
-	ctx->tplg_base = calloc(ctx->tplg_size, 1);
-	if (!ctx->tplg_base) {
-		fprintf(stderr, "error: can't alloc buffer for topology %zu bytes\n",
-			ctx->tplg_size);
-		fclose(file);
-		return -ENOMEM;
-	}
-	ret = fread(ctx->tplg_base, ctx->tplg_size, 1, file);
-	if (ret != 1) {
-		fprintf(stderr, "error: can't read topology: %s\n", strerror(errno));
-		free(ctx->tplg_base);
-		fclose(file);
-		return -errno;
+	ret = tplg_index_build(ctx, &index);
+	if (ret < 0) {
+		fprintf(stderr, "error: can't index topology %s\n", ctx->tplg_file);
+		goto out;
 	}
-	fclose(file);
 
-	/* initialize widget, route, pipeline and pcm lists */
-	list_init(&tp->widget_list);
-	list_init(&tp->route_list);
-	list_init(&tp->pcm_list);
-	list_init(&tp->pipeline_list);
+	/* load only the requested pipelines and the ones they connect to */
+	ret = tplg_index_select_pipelines(&index, tp->pipelines, tp->pipeline_num);
+	if (ret < 0)
+		goto out;
 
-	while (ctx->tplg_offset < ctx->tplg_size) {
-		/* read next topology header */
-		hdr = tplg_get_hdr(ctx);
+	for (s = 0; s < index.num_sections; s++) {
+		section = &index.sections[s];
+		hdr = section->hdr;
 
 		tplg_debug("type: %x, size: 0x%x count: %d index: %d\n",
 			   hdr->type, hdr->payload_size, hdr->count, hdr->index);
 
 		ctx->hdr = hdr;
 
-		/* parse header and load the next block based on type */
+		/* load the selected objects of the block based on type */
 		switch (hdr->type) {
 		/* load dapm widget */
 		case SND_SOC_TPLG_TYPE_DAPM_WIDGET:
@@ -1446,25 +1498,38 @@ int tb_parse_topology(struct testbench_prm *tp)
 			ctx->pipeline_id = hdr->index;
 
 			for (i = 0; i < hdr->count; i++) {
+				widget = &index.widgets[section->first + i];
+				if (!widget->selected)
+					continue;
+
+				ctx->tplg_offset = widget->offset;
+				ctx->comp_id = widget->comp_id;
 				ret = tb_load_widget(tp);
 				if (ret < 0) {
 					fprintf(stderr, "error: loading widget\n");
 					goto out;
 				}
-				ctx->comp_id++;
 			}
 			break;
 
 		/* set up component connections from pipeline graph */
 		case SND_SOC_TPLG_TYPE_DAPM_GRAPH:
-			ret = tb_register_graph(tp, hdr->count);
-			if (ret < 0) {
-				fprintf(stderr, "error: pipeline graph\n");
-				goto out;
+			for (i = 0; i < hdr->count; i++) {
+				route = &index.routes[section->first + i];
+				if (!route->selected)
+					continue;
+
+				ctx->tplg_offset = route->offset;
+				ret = tplg_parse_graph(ctx, &tp->widget_list, &tp->route_list);
+				if (ret < 0) {
+					fprintf(stderr, "error: pipeline graph\n");
+					goto out;
+				}
 			}
 			break;
 
 		case SND_SOC_TPLG_TYPE_PCM:
+			ctx->tplg_offset = section->offset;
 			ret = tb_parse_pcm(tp, hdr->count);
 			if (ret < 0) {
 				fprintf(stderr, "error: parsing pcm\n");
@@ -1473,11 +1538,13 @@ int tb_parse_topology(struct testbench_prm *tp)
 			break;
 
 		default:
-			tplg_skip_hdr_payload(ctx);
 			break;
 		}
 	}
 
+	tp->tplg_partial = index.partial;
+	tplg_index_free(&index);
+
 	/* assign pipeline to every widget in the widget list */
 	list_for_item(item, &tp->widget_list) {
 		struct tplg_comp_info *comp_info = container_of(item, struct tplg_comp_info, item);
@@ -1503,7 +1570,8 @@ int tb_parse_topology(struct testbench_prm *tp)
 
 out:
 	/* free all data */
-	free(ctx->tplg_base);
+	tplg_index_free(&index);
+	tplg_unmap(ctx);
 	return ret;
 }
 
@@ -19,6 +19,8 @@
 
 #if defined __XCC__
 #include <xtensa/tie/xt_timer.h>
+#else
+#include <pthread.h>
 #endif
 
 int tb_load_topology(struct testbench_prm *tp)
@@ -33,6 +35,14 @@ int tb_load_topology(struct testbench_prm *tp)
 	ctx->sof = sof_get();
 	ctx->tplg_file = tp->tplg_file;
 
+	/* file components are numbered again in every parse */
+	tp->input_file_index = 0;
+	tp->output_file_index = 0;
+	tp->pipeline_cores_num = 0;
+#if CONFIG_IPC_MAJOR_4
+	memset(tp->instance_ids, 0, sizeof(tp->instance_ids));
+#endif
+
 	/* parse topology file and create pipeline */
 	ret = tb_parse_topology(tp);
 	if (ret < 0)
@@ -170,10 +180,276 @@ bool tb_is_pipeline_enabled(struct testbench_prm *tp, int pipeline_id)
 	return false;
 }
 
+int tb_set_pipeline_core(struct testbench_prm *tp, int pipeline_id, int core)
+{
+	int i;
+
+	for (i = 0; i < tp->pipeline_cores_num; i++) {
+		if (tp->pipeline_cores[i].pipeline_id == pipeline_id) {
+			tp->pipeline_cores[i].core = core;
+			return 0;
+		}
+	}
+
+	if (tp->pipeline_cores_num == TB_MAX_PIPELINES_NUM) {
+		fprintf(stderr, "error: max pipeline number is %d\n", TB_MAX_PIPELINES_NUM);
+		return -EINVAL;
+	}
+
+	tp->pipeline_cores[i].pipeline_id = pipeline_id;
+	tp->pipeline_cores[i].core = core;
+	tp->pipeline_cores_num++;
+	return 0;
+}
+
+#if !defined __XCC__
+/*
+ * With -j the LL tasks of each core in the topology run in their own host
+ * thread, in the order of a single threaded tick. All threads are released for
+ * each tick of the shared virtual LL clock and the tick completes when all of
+ * them are done. The buffers between pipelines on different cores are shared
+ * and locked like in firmware.
+ */
+struct tb_pipeline_thread {
+	pthread_t thread;
+	int core;
+	struct task *tasks[TB_MAX_PIPELINES_NUM];	/* in single threaded order */
+	int num_tasks;
+	struct tb_threads *threads;
+	uint64_t cycles;
+};
+
+struct tb_threads {
+	pthread_mutex_t lock;
+	pthread_cond_t tick_start;	/* signalled for every tick */
+	pthread_cond_t tick_done;	/* signalled when a thread is done with a tick */
+	uint32_t tick;			/* current tick */
+	int pending;			/* threads not done with the current tick */
+	bool stop;
+	int count;
+	struct tb_pipeline_thread thread[TB_MAX_PIPELINES_NUM];
+};
+
+static void *tb_pipeline_thread_run(void *arg)
+{
+	struct tb_pipeline_thread *pt = arg;
+	struct tb_threads *threads = pt->threads;
+	uint64_t cycles0, cycles1;
+	uint32_t tick = 0;
+	bool stop;
+	int i;
+
+	for (;;) {
+		pthread_mutex_lock(&threads->lock);
+		while (threads->tick == tick && !threads->stop)
+			pthread_cond_wait(&threads->tick_start, &threads->lock);
+		tick = threads->tick;
+		stop = threads->stop;
+		pthread_mutex_unlock(&threads->lock);
+
+		if (stop)
+			break;
+
+		tb_getcycles(&cycles0);
+		for (i = 0; i < pt->num_tasks; i++)
+			schedule_ll_run_task(pt->tasks[i]);
+		tb_getcycles(&cycles1);
+		pt->cycles += cycles1 - cycles0;
+
+		pthread_mutex_lock(&threads->lock);
+		if (!--threads->pending)
+			pthread_cond_signal(&threads->tick_done);
+		pthread_mutex_unlock(&threads->lock);
+	}
+
+	return NULL;
+}
+
+static void tb_threads_tick(struct tb_threads *threads)
+{
+	pthread_mutex_lock(&threads->lock);
+	threads->pending = threads->count;
+	threads->tick++;
+	pthread_cond_broadcast(&threads->tick_start);
+	while (threads->pending)
+		pthread_cond_wait(&threads->tick_done, &threads->lock);
+	pthread_mutex_unlock(&threads->lock);
+}
+
+static int tb_pipeline_core(struct testbench_prm *tp, struct pipeline *p)
+{
+	int i;
+
+	for (i = 0; i < tp->pipeline_cores_num; i++)
+		if (tp->pipeline_cores[i].pipeline_id == p->pipeline_id)
+			return tp->pipeline_cores[i].core;
+
+	return 0;
+}
+
+static struct tb_pipeline_thread *tb_core_thread(struct tb_threads *threads, int core)
+{
+	struct tb_pipeline_thread *pt;
+	int i;
+
+	for (i = 0; i < threads->count; i++)
+		if (threads->thread[i].core == core)
+			return &threads->thread[i];
+
+	pt = &threads->thread[threads->count++];
+	pt->core = core;
+	return pt;
+}
+
+/*
+ * Assigns the LL tasks to the threads of their pipeline cores and marks the
+ * buffers between pipelines on different cores as shared, as
+ * comp_buffer_connect() does for the firmware objects of different cores.
+ */
+static int tb_threads_assign(struct testbench_prm *tp, struct tb_threads *threads)
+{
+	struct task *tasks[TB_MAX_PIPELINES_NUM];
+	struct tb_pipeline_thread *pt;
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	struct comp_buffer *buffer;
+	struct comp_dev *sink;
+	int num_tasks;
+	int core;
+	int t;
+
+	num_tasks = schedule_ll_tasks_get(tasks, TB_MAX_PIPELINES_NUM);
+	if (num_tasks < 0) {
+		fprintf(stderr, "error: more than %d LL tasks\n", TB_MAX_PIPELINES_NUM);
+		return num_tasks;
+	}
+
+	for (t = 0; t < num_tasks; t++) {
+		/* tasks not owned by a pipeline stay on their own core */
+		core = tasks[t]->core;
+		list_for_item(clist, &sof_get()->ipc->comp_list) {
+			icd = container_of(clist, struct ipc_comp_dev, list);
+			if (icd->type == COMP_TYPE_PIPELINE &&
+			    icd->pipeline->pipe_task == tasks[t]) {
+				core = tb_pipeline_core(tp, icd->pipeline);
+				break;
+			}
+		}
+
+		pt = tb_core_thread(threads, core);
+		pt->tasks[pt->num_tasks++] = tasks[t];
+	}
+
+	list_for_item(clist, &sof_get()->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT)
+			continue;
+
+		comp_dev_for_each_consumer(icd->cd, buffer) {
+			sink = comp_buffer_get_sink_component(buffer);
+			if (sink && sink->pipeline && icd->cd->pipeline &&
+			    tb_pipeline_core(tp, icd->cd->pipeline) !=
+			    tb_pipeline_core(tp, sink->pipeline))
+				buffer->audio_buffer.is_shared = true;
+		}
+	}
+
+	return 0;
+}
+
+int tb_threads_start(struct testbench_prm *tp)
+{
+	struct tb_pipeline_thread *pt;
+	struct tb_threads *threads;
+	int count;
+	int ret;
+	int i;
+
+	threads = calloc(1, sizeof(*threads));
+	if (!threads)
+		return -ENOMEM;
+
+	pthread_mutex_init(&threads->lock, NULL);
+	pthread_cond_init(&threads->tick_start, NULL);
+	pthread_cond_init(&threads->tick_done, NULL);
+	tp->threads = threads;
+
+	ret = tb_threads_assign(tp, threads);
+	count = threads->count;
+	threads->count = 0;
+	if (ret < 0) {
+		tb_threads_stop(tp);
+		return ret;
+	}
+
+	for (i = 0; i < count; i++) {
+		pt = &threads->thread[i];
+		pt->threads = threads;
+		ret = pthread_create(&pt->thread, NULL, tb_pipeline_thread_run, pt);
+		if (ret) {
+			fprintf(stderr, "error: failed to create pipeline thread: %s\n",
+				strerror(ret));
+			tb_threads_stop(tp);
+			return -ret;
+		}
+
+		/* a thread only waits for the next tick, it can be added any time */
+		threads->count = i + 1;
+	}
+
+	if (tb_check_trace(LOG_LEVEL_DEBUG))
+		printf("debug: running the pipelines of %d cores in threads\n", count);
+
+	return 0;
+}
+
+void tb_threads_stop(struct testbench_prm *tp)
+{
+	struct tb_threads *threads = tp->threads;
+	int i;
+
+	if (!threads)
+		return;
+
+	pthread_mutex_lock(&threads->lock);
+	threads->stop = true;
+	pthread_cond_broadcast(&threads->tick_start);
+	pthread_mutex_unlock(&threads->lock);
+
+	for (i = 0; i < threads->count; i++) {
+		pthread_join(threads->thread[i].thread, NULL);
+		tp->total_cycles += threads->thread[i].cycles;
+	}
+
+	pthread_cond_destroy(&threads->tick_start);
+	pthread_cond_destroy(&threads->tick_done);
+	pthread_mutex_destroy(&threads->lock);
+	free(threads);
+	tp->threads = NULL;
+}
+#else
+int tb_threads_start(struct testbench_prm *tp)
+{
+	fprintf(stderr, "error: pipeline threads are not supported\n");
+	return -ENOTSUP;
+}
+
+void tb_threads_stop(struct testbench_prm *tp)
+{
+}
+#endif
+
 bool tb_schedule_pipeline_check_state(struct testbench_prm *tp)
 {
 	uint64_t cycles0, cycles1;
 
+#if !defined __XCC__
+	if (tp->threads) {
+		tb_threads_tick(tp->threads);
+		return tb_is_file_component_at_eof(tp);
+	}
+#endif
+
 	tb_getcycles(&cycles0);
 
 	schedule_ll_run_tasks();
@@ -185,6 +461,46 @@ bool tb_schedule_pipeline_check_state(struct testbench_prm *tp)
 	return tb_is_file_component_at_eof(tp);
 }
 
+void tb_show_module_profile(struct testbench_prm *tp)
+{
+#if CONFIG_COMP_PROFILE
+	static const char * const phase_name[COMP_PROFILE_PHASE_COUNT] = {
+		"copy", "get_data", "process", "commit",
+	};
+	const struct comp_profile *prof;
+	const struct comp_profile_stats *stats;
+	struct ipc_comp_dev *icd;
+	struct list_item *clist;
+	int i;
+
+	printf("Module profile (host time in ns):\n");
+	printf("%-10s %-9s %8s %8s %8s %8s %8s %10s\n", "comp", "phase", "count",
+	       "min", "avg", "max", "p99", "bytes/tick");
+
+	list_for_item(clist, &sof_get()->ipc->comp_list) {
+		icd = container_of(clist, struct ipc_comp_dev, list);
+		if (icd->type != COMP_TYPE_COMPONENT)
+			continue;
+
+		prof = comp_dev_profile(icd->cd);
+		for (i = 0; i < COMP_PROFILE_PHASE_COUNT; i++) {
+			stats = &prof->phase[i];
+			if (!stats->count)
+				continue;
+
+			printf("%#-10x %-9s %8u %8u %8llu %8u %8u", icd->id, phase_name[i],
+			       stats->count, stats->min,
+			       (unsigned long long)(stats->total / stats->count), stats->max,
+			       comp_profile_percentile(stats, 990));
+			if (i == COMP_PROFILE_COPY)
+				printf(" %10llu",
+				       (unsigned long long)(prof->total_bytes / stats->count));
+			printf("\n");
+		}
+	}
+#endif
+}
+
 struct ipc_data {
 	struct ipc_data_host_buffer dh_buffer;
 };
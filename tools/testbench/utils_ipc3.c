@@ -77,6 +77,12 @@ int tb_setup(struct sof *sof, struct testbench_prm *tp)
 	return 0;
 }
 
+int tb_set_audio_format(struct testbench_prm *tp)
+{
+	/* the formats are passed with the pipeline params */
+	return 0;
+}
+
 /* Get pipeline host component */
 static struct comp_dev *tb_get_pipeline_host(struct pipeline *p)
 {
@@ -299,6 +305,12 @@ int tb_free_all_pipelines(struct testbench_prm *tp)
 	return 0;
 }
 
+int tb_reuse_topology(struct testbench_prm *tp)
+{
+	/* components are created while parsing, parse again */
+	return -ENOTSUP;
+}
+
 void tb_free_topology(struct testbench_prm *tp)
 {
 }
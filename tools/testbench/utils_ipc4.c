@@ -35,8 +35,6 @@ LOG_MODULE_REGISTER(testbench, CONFIG_SOF_LOG_LEVEL);
 int tb_setup(struct sof *sof, struct testbench_prm *tp)
 {
 	struct ll_schedule_domain domain = {0};
-	int bits;
-	int krate;
 
 	domain.next_tick = tp->tick_period_us;
 
@@ -96,6 +94,20 @@ int tb_setup(struct sof *sof, struct testbench_prm *tp)
 
 	tb_debug_print("ipc and scheduler initialized\n");
 
+	/* TODO: Need to set this later for larger topologies with multiple PCMs. The
+	 * pipelines are determined based on just the PCM ID for the device that we
+	 * want to start playback/capture on.
+	 */
+	tp->pcm_id = 0;
+
+	return 0;
+}
+
+int tb_set_audio_format(struct testbench_prm *tp)
+{
+	int bits;
+	int krate;
+
 	/* setup IPC4 audio format */
 	tp->num_configs = 1;
 	krate = tp->fs_in / 1000;
@@ -127,12 +139,6 @@ int tb_setup(struct sof *sof, struct testbench_prm *tp)
 	tp->config[0].format = tp->frame_fmt;
 	tp->period_frames = krate;
 
-	/* TODO: Need to set this later for larger topologies with multiple PCMs. The
-	 * pipelines are determined based on just the PCM ID for the device that we
-	 * want to start playback/capture on.
-	 */
-	tp->pcm_id = 0;
-
 	return 0;
 }
 
@@ -395,12 +401,14 @@ static int tb_set_up_pipelines(struct testbench_prm *tp, int dir)
 	struct tplg_comp_info *host = NULL;
 	struct tplg_pcm_info *pcm_info;
 	struct list_item *item;
+	bool pcm_found = false;
 	int ret;
 
 	list_for_item(item, &tp->pcm_list) {
 		pcm_info = container_of(item, struct tplg_pcm_info, item);
 
 		if (pcm_info->id == tp->pcm_id) {
+			pcm_found = true;
 			if (dir)
 				host = pcm_info->capture_host;
 			else
@@ -410,6 +418,10 @@ static int tb_set_up_pipelines(struct testbench_prm *tp, int dir)
 	}
 
 	if (!host) {
+		/* the PCM of a pipeline that was not loaded */
+		if (pcm_found && tp->tplg_partial)
+			return 0;
+
 		fprintf(stderr, "No host component found for PCM ID: %d\n", tp->pcm_id);
 		return -EINVAL;
 	}
@@ -624,7 +636,7 @@ void tb_free_topology(struct testbench_prm *tp)
 		free(pipe_info);
 	}
 
-	free(ctx->tplg_base);
+	tplg_unmap(ctx);
 	free(tp->glb_ctx.ctl);
 	tb_debug_print("freed all pipelines, widgets, routes and pcms\n");
 }
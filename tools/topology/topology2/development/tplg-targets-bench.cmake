@@ -61,3 +61,6 @@ foreach(comp bench_param IN ZIP_LISTS components_s24 component_parameters_s24)
 	#message(STATUS "Item=" ${item})
 	list(APPEND TPLGS "${item}")
 endforeach()
+
+# Gain with the DAI pipelines on core 1 for the testbench -j option
+list(APPEND TPLGS "sof-hda-generic\;sof-hda-benchmark-gain32-cores\;HDA_CONFIG=benchmark,BENCH_CONFIG=gain32,BENCH_GAIN_PARAMS=default,BENCH_DAI_CORE=1")
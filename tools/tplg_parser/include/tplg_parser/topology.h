@@ -107,6 +107,7 @@ struct tplg_pipeline_info {
 	int instance_id;
 	int usage_count;
 	int mem_usage;
+	int core;
 	char *name;
 	struct list_item item; /* item in a list */
 };
@@ -192,6 +193,46 @@ struct tplg_context {
 		      void *comp, void *arg, int index);
 };
 
+/* widget found by tplg_index_build() */
+struct tplg_index_widget {
+	struct snd_soc_tplg_dapm_widget *widget;
+	long offset;		/* offset of the widget in the topology */
+	int comp_id;		/* component ID the widget gets in a full load */
+	int pipeline_id;	/* index of the widget section */
+	bool selected;		/* to be loaded */
+};
+
+/* route found by tplg_index_build() */
+struct tplg_index_route {
+	struct snd_soc_tplg_dapm_graph_elem *elem;
+	long offset;		/* offset of the route in the topology */
+	int source;		/* index of the source widget, -1 if not found */
+	int sink;		/* index of the sink widget, -1 if not found */
+	bool selected;		/* to be loaded */
+};
+
+/* section of the topology, in file order */
+struct tplg_index_section {
+	struct snd_soc_tplg_hdr *hdr;
+	long offset;		/* offset of the section payload */
+	int first;		/* first widget or route of the section */
+};
+
+/* one pass index of a mapped topology */
+struct tplg_index {
+	struct tplg_index_section *sections;
+	struct tplg_index_widget *widgets;
+	struct tplg_index_route *routes;
+	int num_sections;
+	int num_widgets;
+	int num_routes;
+	int ipc_major;		/* of the indexed topology */
+	bool partial;		/* only some pipelines are selected */
+	/* widget name hash, open addressing, -1 marks free slots */
+	int *hash;
+	uint32_t hash_size;
+};
+
 #define tplg_get(ctx) ((void *)(ctx->tplg_base + ctx->tplg_offset))
 
 #define tplg_get_hdr(ctx)							\
@@ -327,6 +368,11 @@ int sof_parse_token_sets(void *object, const struct sof_topology_token *tokens,
 			 int count, struct snd_soc_tplg_vendor_array *array,
 			 int priv_size, int num_sets, int object_size);
 int tplg_parse_widget_audio_formats(struct tplg_context *ctx);
+int tplg_map(struct tplg_context *ctx);
+void tplg_unmap(struct tplg_context *ctx);
+int tplg_index_build(struct tplg_context *ctx, struct tplg_index *index);
+int tplg_index_select_pipelines(struct tplg_index *index, const int *pipelines, int count);
+void tplg_index_free(struct tplg_index *index);
 int tplg_parse_graph(struct tplg_context *ctx, struct list_item *widget_list,
 		     struct list_item *route_list);
 int tplg_parse_pcm(struct tplg_context *ctx, struct list_item *widget_list,
@@ -0,0 +1,473 @@
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// Copyright(c) 2025 Intel Corporation. All rights reserved.
+
+/*
+ * Topology mapping and indexing
+ *
+ * The topology file is mapped rather than read, so loading costs no copy and
+ * untouched sections are never paged in. A single pass over the section
+ * headers records where every widget and route starts, which pipeline a
+ * widget belongs to and the component ID it gets in a full load. Routes are
+ * resolved to widgets through a name hash. Callers can then select the
+ * pipelines they need and load only their widgets and routes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <ipc/topology.h>
+#include <sof/common.h>
+#include <tplg_parser/topology.h>
+
+int tplg_map(struct tplg_context *ctx)
+{
+	struct stat st;
+	void *base;
+	int fd;
+
+	fd = open(ctx->tplg_file, O_RDONLY);
+	if (fd < 0) {
+		fprintf(stderr, "error: can't open topology %s : %s\n", ctx->tplg_file,
+			strerror(errno));
+		return -errno;
+	}
+
+	if (fstat(fd, &st) < 0 || !st.st_size) {
+		fprintf(stderr, "error: can't get size of topology %s\n", ctx->tplg_file);
+		close(fd);
+		return -EINVAL;
+	}
+
+	/* private writable mapping, the parsers may patch objects in place */
+	base = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (base == MAP_FAILED) {
+		fprintf(stderr, "error: can't map topology %s : %s\n", ctx->tplg_file,
+			strerror(errno));
+		return -errno;
+	}
+
+	ctx->tplg_base = base;
+	ctx->tplg_size = st.st_size;
+	ctx->tplg_offset = 0;
+
+	return 0;
+}
+
+void tplg_unmap(struct tplg_context *ctx)
+{
+	if (ctx->tplg_base)
+		munmap(ctx->tplg_base, ctx->tplg_size);
+
+	ctx->tplg_base = NULL;
+	ctx->tplg_size = 0;
+}
+
+/*
+ * size of a kcontrol including its private data, which must fit into the
+ * remaining bytes of its section
+ */
+static int tplg_control_size(const struct snd_soc_tplg_ctl_hdr *ctl_hdr, size_t avail,
+			     size_t *size)
+{
+	const struct snd_soc_tplg_private *priv;
+	size_t fixed;
+
+	if (avail < sizeof(*ctl_hdr))
+		return -EINVAL;
+
+	switch (ctl_hdr->ops.info) {
+	case SND_SOC_TPLG_CTL_VOLSW:
+	case SND_SOC_TPLG_CTL_STROBE:
+	case SND_SOC_TPLG_CTL_VOLSW_SX:
+	case SND_SOC_TPLG_CTL_VOLSW_XR_SX:
+	case SND_SOC_TPLG_CTL_RANGE:
+	case SND_SOC_TPLG_DAPM_CTL_VOLSW:
+		fixed = sizeof(struct snd_soc_tplg_mixer_control);
+		priv = &((const struct snd_soc_tplg_mixer_control *)ctl_hdr)->priv;
+		break;
+
+	case SND_SOC_TPLG_CTL_ENUM:
+	case SND_SOC_TPLG_CTL_ENUM_VALUE:
+	case SND_SOC_TPLG_DAPM_CTL_ENUM_DOUBLE:
+	case SND_SOC_TPLG_DAPM_CTL_ENUM_VIRT:
+	case SND_SOC_TPLG_DAPM_CTL_ENUM_VALUE:
+		fixed = sizeof(struct snd_soc_tplg_enum_control);
+		priv = &((const struct snd_soc_tplg_enum_control *)ctl_hdr)->priv;
+		break;
+
+	case SND_SOC_TPLG_CTL_BYTES:
+		fixed = sizeof(struct snd_soc_tplg_bytes_control);
+		priv = &((const struct snd_soc_tplg_bytes_control *)ctl_hdr)->priv;
+		break;
+
+	default:
+		return -EOPNOTSUPP;
+	}
+
+	if (avail < fixed || priv->size > avail - fixed)
+		return -EINVAL;
+
+	*size = fixed + priv->size;
+	return 0;
+}
+
+/* names are fixed size arrays, a malformed topology may leave them unterminated */
+static bool tplg_name_valid(const char *name, size_t size)
+{
+	return strnlen(name, size) < size;
+}
+
+/* FNV-1a, widget names are short */
+static uint32_t tplg_name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*name)
+		hash = (hash ^ (uint8_t)*name++) * 16777619U;
+
+	return hash;
+}
+
+static int tplg_index_find(const struct tplg_index *index, const char *name)
+{
+	uint32_t mask = index->hash_size - 1;
+	uint32_t slot = tplg_name_hash(name) & mask;
+	int w;
+
+	for (; (w = index->hash[slot]) >= 0; slot = (slot + 1) & mask)
+		if (!strcmp(index->widgets[w].widget->name, name))
+			return w;
+
+	return -1;
+}
+
+static int tplg_index_hash_widgets(struct tplg_index *index)
+{
+	uint32_t mask, slot;
+	int i;
+
+	/* at most half full */
+	index->hash_size = 16;
+	while (index->hash_size < 2 * index->num_widgets)
+		index->hash_size <<= 1;
+
+	index->hash = malloc(index->hash_size * sizeof(*index->hash));
+	if (!index->hash)
+		return -ENOMEM;
+
+	memset(index->hash, 0xff, index->hash_size * sizeof(*index->hash));
+	mask = index->hash_size - 1;
+
+	/* duplicate names resolve to the first widget, as in a full load */
+	for (i = 0; i < index->num_widgets; i++) {
+		if (tplg_index_find(index, index->widgets[i].widget->name) >= 0)
+			continue;
+
+		slot = tplg_name_hash(index->widgets[i].widget->name) & mask;
+		while (index->hash[slot] >= 0)
+			slot = (slot + 1) & mask;
+		index->hash[slot] = i;
+	}
+
+	return 0;
+}
+
+static void *tplg_index_grow(void *array, int count, int *max, size_t size)
+{
+	void *new_array;
+
+	if (count < *max)
+		return array;
+
+	*max = *max ? *max * 2 : 64;
+	new_array = realloc(array, *max * size);
+	if (!new_array)
+		free(array);
+
+	return new_array;
+}
+
+/* records the widgets of a widget section and skips over their kcontrols */
+static int tplg_index_widget_section(struct tplg_context *ctx, struct tplg_index *index,
+				     struct snd_soc_tplg_hdr *hdr, int *max_widgets, int *comp_id)
+{
+	struct snd_soc_tplg_dapm_widget *widget;
+	struct snd_soc_tplg_ctl_hdr *ctl_hdr;
+	struct tplg_index_widget *entry;
+	long offset = ctx->tplg_offset;
+	long end = offset + hdr->payload_size;
+	size_t ctl_size;
+	int ret;
+	int i, j;
+
+	for (i = 0; i < hdr->count; i++) {
+		index->widgets = tplg_index_grow(index->widgets, index->num_widgets,
+						 max_widgets, sizeof(*index->widgets));
+		if (!index->widgets)
+			return -ENOMEM;
+
+		widget = MOVE_POINTER_BY_BYTES(ctx->tplg_base, offset);
+		if ((size_t)(end - offset) < sizeof(*widget) || !tplg_valid_widget(widget) ||
+		    widget->priv.size > end - offset - sizeof(*widget) ||
+		    !tplg_name_valid(widget->name, sizeof(widget->name))) {
+			fprintf(stderr, "error: invalid widget at offset %ld\n", offset);
+			return -EINVAL;
+		}
+
+		entry = &index->widgets[index->num_widgets++];
+		entry->widget = widget;
+		entry->offset = offset;
+		entry->comp_id = (*comp_id)++;
+		entry->pipeline_id = hdr->index;
+		entry->selected = true;
+
+		offset += sizeof(*widget) + widget->priv.size;
+		for (j = 0; j < widget->num_kcontrols; j++) {
+			ctl_hdr = MOVE_POINTER_BY_BYTES(ctx->tplg_base, offset);
+			ret = tplg_control_size(ctl_hdr, end - offset, &ctl_size);
+			if (ret == -EOPNOTSUPP) {
+				fprintf(stderr, "error: control type %d not supported in %s\n",
+					ctl_hdr->ops.info, widget->name);
+				return ret;
+			}
+			if (ret < 0) {
+				fprintf(stderr, "error: invalid control at offset %ld in %s\n",
+					offset, widget->name);
+				return ret;
+			}
+			offset += ctl_size;
+		}
+	}
+
+	return 0;
+}
+
+/* records the routes of a graph section */
+static int tplg_index_graph_section(struct tplg_context *ctx, struct tplg_index *index,
+				    struct snd_soc_tplg_hdr *hdr, int *max_routes)
+{
+	struct tplg_index_route *route;
+	int i;
+
+	if (hdr->count > hdr->payload_size / sizeof(struct snd_soc_tplg_dapm_graph_elem)) {
+		fprintf(stderr, "error: %u routes don't fit in section at offset %ld\n",
+			hdr->count, ctx->tplg_offset);
+		return -EINVAL;
+	}
+
+	for (i = 0; i < hdr->count; i++) {
+		index->routes = tplg_index_grow(index->routes, index->num_routes, max_routes,
+						sizeof(*index->routes));
+		if (!index->routes)
+			return -ENOMEM;
+
+		route = &index->routes[index->num_routes++];
+		route->offset = ctx->tplg_offset + i * sizeof(struct snd_soc_tplg_dapm_graph_elem);
+		route->elem = MOVE_POINTER_BY_BYTES(ctx->tplg_base, route->offset);
+		route->selected = true;
+
+		if (!tplg_name_valid(route->elem->source, sizeof(route->elem->source)) ||
+		    !tplg_name_valid(route->elem->sink, sizeof(route->elem->sink)) ||
+		    !tplg_name_valid(route->elem->control, sizeof(route->elem->control))) {
+			fprintf(stderr, "error: invalid route at offset %ld\n", route->offset);
+			return -EINVAL;
+		}
+	}
+
+	return 0;
+}
+
+int tplg_index_build(struct tplg_context *ctx, struct tplg_index *index)
+{
+	struct snd_soc_tplg_hdr *hdr;
+	struct tplg_index_section *section;
+	struct tplg_index_route *route;
+	int max_sections = 0;
+	int max_widgets = 0;
+	int max_routes = 0;
+	int comp_id = ctx->comp_id;
+	int ret = -ENOMEM;
+	int i;
+
+	memset(index, 0, sizeof(*index));
+	index->ipc_major = ctx->ipc_major;
+	ctx->tplg_offset = 0;
+
+	while (ctx->tplg_offset < ctx->tplg_size) {
+		/* the header and its payload must be within the file */
+		hdr = MOVE_POINTER_BY_BYTES(ctx->tplg_base, ctx->tplg_offset);
+		if (ctx->tplg_size - ctx->tplg_offset < sizeof(*hdr) ||
+		    hdr->size != sizeof(*hdr) ||
+		    hdr->payload_size > ctx->tplg_size - ctx->tplg_offset - sizeof(*hdr)) {
+			fprintf(stderr, "error: invalid or truncated section at offset %ld\n",
+				ctx->tplg_offset);
+			ret = -EINVAL;
+			goto err;
+		}
+		ctx->tplg_offset += sizeof(*hdr);
+
+		index->sections = tplg_index_grow(index->sections, index->num_sections,
+						  &max_sections, sizeof(*index->sections));
+		if (!index->sections) {
+			ret = -ENOMEM;
+			goto err;
+		}
+
+		section = &index->sections[index->num_sections++];
+		section->hdr = hdr;
+		section->offset = ctx->tplg_offset;
+
+		switch (hdr->type) {
+		case SND_SOC_TPLG_TYPE_DAPM_WIDGET:
+			section->first = index->num_widgets;
+			ret = tplg_index_widget_section(ctx, index, hdr, &max_widgets, &comp_id);
+			if (ret < 0)
+				goto err;
+			break;
+
+		case SND_SOC_TPLG_TYPE_DAPM_GRAPH:
+			section->first = index->num_routes;
+			ret = tplg_index_graph_section(ctx, index, hdr, &max_routes);
+			if (ret < 0)
+				goto err;
+			break;
+
+		default:
+			break;
+		}
+
+		ctx->tplg_offset += hdr->payload_size;
+	}
+
+	ret = tplg_index_hash_widgets(index);
+	if (ret < 0)
+		goto err;
+
+	for (i = 0; i < index->num_routes; i++) {
+		route = &index->routes[i];
+		route->source = tplg_index_find(index, route->elem->source);
+		route->sink = tplg_index_find(index, route->elem->sink);
+	}
+
+	ctx->tplg_offset = 0;
+	return 0;
+
+err:
+	tplg_index_free(index);
+	ctx->tplg_offset = 0;
+	return ret;
+}
+
+/* checks if a pipeline ID is in the sorted set */
+static bool tplg_index_has_pipeline(const int *ids, int count, int id)
+{
+	int lo = 0, hi = count;
+	int mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (ids[mid] == id)
+			return true;
+		if (ids[mid] < id)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return false;
+}
+
+static int tplg_index_add_pipeline(int *ids, int count, int id)
+{
+	int i = count;
+
+	while (i > 0 && ids[i - 1] > id) {
+		ids[i] = ids[i - 1];
+		i--;
+	}
+	ids[i] = id;
+
+	return count + 1;
+}
+
+int tplg_index_select_pipelines(struct tplg_index *index, const int *pipelines, int count)
+{
+	struct tplg_index_route *route;
+	int source_pipe, sink_pipe;
+	int num_ids = 0;
+	bool changed;
+	int *ids;
+	int i;
+
+	/* IPC3 loaders set up all widgets and don't use the selection */
+	if (index->ipc_major != 4) {
+		fprintf(stderr, "error: pipeline selection needs an IPC4 topology\n");
+		return -EOPNOTSUPP;
+	}
+
+	/* no more pipelines than widgets and requested IDs */
+	ids = malloc((index->num_widgets + count) * sizeof(*ids));
+	if (!ids)
+		return -ENOMEM;
+
+	for (i = 0; i < count; i++)
+		if (!tplg_index_has_pipeline(ids, num_ids, pipelines[i]))
+			num_ids = tplg_index_add_pipeline(ids, num_ids, pipelines[i]);
+
+	/* pipelines connected to a selected one are needed to set it up */
+	do {
+		changed = false;
+		for (i = 0; i < index->num_routes; i++) {
+			route = &index->routes[i];
+			if (route->source < 0 || route->sink < 0)
+				continue;
+
+			source_pipe = index->widgets[route->source].pipeline_id;
+			sink_pipe = index->widgets[route->sink].pipeline_id;
+			if (tplg_index_has_pipeline(ids, num_ids, source_pipe) ==
+			    tplg_index_has_pipeline(ids, num_ids, sink_pipe))
+				continue;
+
+			num_ids = tplg_index_add_pipeline(ids, num_ids,
+							  tplg_index_has_pipeline(ids, num_ids,
+										  source_pipe) ?
+							  sink_pipe : source_pipe);
+			changed = true;
+		}
+	} while (changed);
+
+	for (i = 0; i < index->num_widgets; i++)
+		index->widgets[i].selected =
+			tplg_index_has_pipeline(ids, num_ids, index->widgets[i].pipeline_id);
+
+	/* routes to unknown widgets stay selected, loading them reports the error */
+	for (i = 0; i < index->num_routes; i++) {
+		route = &index->routes[i];
+		if (route->source >= 0 && route->sink >= 0)
+			route->selected = index->widgets[route->source].selected;
+	}
+
+	index->partial = true;
+	free(ids);
+
+	return 0;
+}
+
+void tplg_index_free(struct tplg_index *index)
+{
+	free(index->sections);
+	free(index->widgets);
+	free(index->routes);
+	free(index->hash);
+	memset(index, 0, sizeof(*index));
+}
@@ -14,6 +14,7 @@
 #endif
 
 #include <sof/common.h>
+#include <sof/list.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
 #include <sof/lib/memory.h>
@@ -63,6 +64,32 @@ struct mm_heap {
 	struct mm_info info;
 };
 
+#if CONFIG_MM_SLAB
+/* slab object sizes are multiples of this, at least a cache line */
+#define MM_SLAB_ALIGN	(PLATFORM_DCACHE_ALIGN > 32 ? PLATFORM_DCACHE_ALIGN : 32)
+/* one slab for each object size up to CONFIG_MM_SLAB_MAX_SIZE */
+#define MM_SLAB_CLASSES	(CONFIG_MM_SLAB_MAX_SIZE / MM_SLAB_ALIGN)
+/* runtime and runtime shared zones */
+#define MM_SLAB_ZONES	2
+
+/* slab usage, free slots in allocated pages are the fragmentation cost */
+struct mm_slab_info {
+	uint32_t pages;		/* pages taken from the heap */
+	uint32_t objs_total;	/* object slots in those pages */
+	uint32_t objs_used;	/* slots handed out */
+	uint32_t objs_peak;	/* maximum of objs_used */
+	uint32_t allocs;	/* allocations served from the slab */
+	uint32_t fallbacks;	/* allocations left to the block maps for lack of pages */
+};
+
+/* cache of equally sized objects carved out of heap blocks */
+struct mm_slab {
+	struct list_item partial;	/* pages with free slots */
+	uint32_t obj_size;		/* slot size in bytes */
+	struct mm_slab_info info;
+};
+#endif
+
 /* heap block memory map */
 struct mm {
 	/* system heap - used during init cannot be freed */
@@ -80,6 +107,11 @@ struct mm {
 	/* general component buffer heap */
 	struct mm_heap buffer[PLATFORM_HEAP_BUFFER];
 
+#if CONFIG_MM_SLAB
+	/* per core caches of small runtime objects */
+	struct mm_slab slab[CONFIG_CORE_COUNT][MM_SLAB_ZONES][MM_SLAB_CLASSES];
+#endif
+
 	struct mm_info total;
 	uint32_t heap_trace_updated;	/* updates that can be presented */
 	struct k_spinlock lock;	/* all allocs and frees are atomic */
@@ -108,6 +140,16 @@ void heap_trace(struct mm_heap *heap, int size);
 int heap_info(enum mem_zone zone, int index, struct mm_info *out);
 #endif
 
+#if CONFIG_MM_SLAB
+/** Fetch slab usage of a core, summed over all object sizes
+ * @param zone SOF_MEM_ZONE_RUNTIME or SOF_MEM_ZONE_RUNTIME_SHARED
+ * @param core cpu core index
+ * @param out output variable, objs_peak is the sum of per size peaks
+ * @return error code or zero
+ */
+int heap_slab_info(enum mem_zone zone, int core, struct mm_slab_info *out);
+#endif
+
 /* retrieve memory map pointer */
 static inline struct mm *memmap_get(void)
 {
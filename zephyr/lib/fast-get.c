@@ -8,106 +8,246 @@
 #include <stdint.h>
 #include <errno.h>
 
+#include <sof/common.h>
 #include <sof/lib/fast-get.h>
+#include <sof/list.h>
 #include <rtos/alloc.h>
 #include <rtos/cache.h>
 #include <rtos/spinlock.h>
 #include <rtos/symbol.h>
 #include <ipc/topology.h>
 
+/*
+ * Entries are hashed by their DRAM address for fast_get() and by their SRAM
+ * address for fast_put(). Each hash bucket has its own locks, so unrelated
+ * tables don't contend. Lock order is: DRAM bucket lock, then SRAM bucket
+ * lock or the LRU lock. Nothing else is ever nested.
+ *
+ * With CONFIG_FAST_GET_LRU_SIZE > 0 released copies are not freed right away
+ * but kept in an LRU ordered pool of up to that many bytes, so that a stream
+ * restart finds its coefficients still in SRAM. The pool holds one reference
+ * to each entry in it.
+ */
+
+#define FAST_GET_BUCKETS CONFIG_FAST_GET_HASH_BUCKETS
+
+STATIC_ASSERT(FAST_GET_BUCKETS && !(FAST_GET_BUCKETS & (FAST_GET_BUCKETS - 1)),
+	      fast_get_buckets_not_power_of_two);
+
 struct sof_fast_get_entry {
+	struct sof_fast_get_entry *dram_next;	/* chain in DRAM address bucket */
+	struct sof_fast_get_entry *sram_next;	/* chain in SRAM address bucket */
+	struct list_item lru;			/* retained pool, least recently used first */
 	const void *dram_ptr;
 	void *sram_ptr;
 	size_t size;
-	unsigned int refcount;
+	unsigned int refcount;			/* users, plus one while retained */
+	bool retained;				/* in the retained pool, under lru_lock */
+};
+
+struct sof_fast_get_bucket {
+	struct k_spinlock dram_lock;
+	struct k_spinlock sram_lock;
+	struct sof_fast_get_entry *dram_entries;
+	struct sof_fast_get_entry *sram_entries;
 };
 
 struct sof_fast_get_data {
-	struct k_spinlock lock;
-	size_t num_entries;
-	struct sof_fast_get_entry *entries;
+	struct sof_fast_get_bucket buckets[FAST_GET_BUCKETS];
+	struct k_spinlock lru_lock;
+	struct list_item lru;
+	size_t lru_size;
 };
 
 static struct sof_fast_get_data fast_get_data = {
-	.num_entries = 0,
-	.entries = NULL,
+	.lru = LIST_INIT(fast_get_data.lru),
 };
 
 LOG_MODULE_REGISTER(fast_get, CONFIG_SOF_LOG_LEVEL);
 
-static int fast_get_realloc(struct sof_fast_get_data *data)
+static struct sof_fast_get_bucket *fast_get_bucket(struct sof_fast_get_data *data,
+						   const void *ptr)
+{
+	/* Fibonacci hashing, the low bits of aligned addresses carry no information */
+	uint32_t hash = (uint32_t)((uintptr_t)ptr >> 2) * 2654435761U;
+
+	return &data->buckets[(hash >> 16) & (FAST_GET_BUCKETS - 1)];
+}
+
+static struct sof_fast_get_entry *fast_get_find_entry(struct sof_fast_get_bucket *bucket,
+						      const void *dram_ptr)
+{
+	struct sof_fast_get_entry *entry;
+
+	for (entry = bucket->dram_entries; entry; entry = entry->dram_next)
+		if (entry->dram_ptr == dram_ptr)
+			return entry;
+
+	return NULL;
+}
+
+static struct sof_fast_get_entry *fast_put_find_entry(struct sof_fast_get_bucket *bucket,
+						      const void *sram_ptr)
 {
-	struct sof_fast_get_entry *entries;
-	/*
-	 * Allocate 8 entries for the beginning. Currently we only use 2 entries
-	 * at most, so this should provide a reasonable first allocation.
-	 */
-	const unsigned int init_n_entries = 8;
-	unsigned int n_entries = data->num_entries ? data->num_entries * 2 : init_n_entries;
-
-	entries = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
-			  n_entries * sizeof(*entries));
-	if (!entries)
-		return -ENOMEM;
-
-	if (data->num_entries) {
-		memcpy_s(entries, n_entries * sizeof(*entries), data->entries,
-			 data->num_entries * sizeof(*entries));
-		rfree(data->entries);
+	struct sof_fast_get_entry *entry;
+
+	for (entry = bucket->sram_entries; entry; entry = entry->sram_next)
+		if (entry->sram_ptr == sram_ptr)
+			return entry;
+
+	return NULL;
+}
+
+/* called with the DRAM bucket lock of the entry held */
+static void fast_get_unlink(struct sof_fast_get_data *data,
+			    struct sof_fast_get_bucket *bucket,
+			    struct sof_fast_get_entry *entry)
+{
+	struct sof_fast_get_bucket *sram_bucket = fast_get_bucket(data, entry->sram_ptr);
+	struct sof_fast_get_entry **pentry;
+	k_spinlock_key_t key;
+
+	for (pentry = &bucket->dram_entries; *pentry != entry; pentry = &(*pentry)->dram_next)
+		;
+	*pentry = entry->dram_next;
+
+	key = k_spin_lock(&sram_bucket->sram_lock);
+	for (pentry = &sram_bucket->sram_entries; *pentry != entry;
+	     pentry = &(*pentry)->sram_next)
+		;
+	*pentry = entry->sram_next;
+	k_spin_unlock(&sram_bucket->sram_lock, key);
+}
+
+static void fast_get_free(struct sof_fast_get_entry *entry)
+{
+	rfree(entry->sram_ptr);
+	rfree(entry);
+}
+
+/*
+ * Takes over the reference of the retained pool if the entry is in it.
+ * Called with the DRAM bucket lock of the entry held.
+ */
+static bool fast_get_lru_take(struct sof_fast_get_data *data, struct sof_fast_get_entry *entry)
+{
+	k_spinlock_key_t key;
+	bool taken = false;
+
+	key = k_spin_lock(&data->lru_lock);
+	if (entry->retained) {
+		list_item_del(&entry->lru);
+		data->lru_size -= entry->size;
+		entry->retained = false;
+		taken = true;
 	}
+	k_spin_unlock(&data->lru_lock, key);
+
+	return taken;
+}
 
-	data->entries = entries;
-	data->num_entries = n_entries;
+/*
+ * Hands the last reference of the entry to the retained pool.
+ * Called with the DRAM bucket lock of the entry held.
+ */
+static bool fast_get_lru_give(struct sof_fast_get_data *data, struct sof_fast_get_entry *entry)
+{
+	k_spinlock_key_t key;
+
+	if (entry->size > CONFIG_FAST_GET_LRU_SIZE)
+		return false;
 
-	return 0;
+	key = k_spin_lock(&data->lru_lock);
+	list_item_append(&entry->lru, &data->lru);
+	data->lru_size += entry->size;
+	entry->retained = true;
+	k_spin_unlock(&data->lru_lock, key);
+
+	return true;
 }
 
-static struct sof_fast_get_entry *fast_get_find_entry(struct sof_fast_get_data *data,
-						      const void *dram_ptr)
+/* evicts least recently used entries until the pool fits in its budget */
+static void fast_get_lru_trim(struct sof_fast_get_data *data)
 {
-	int i;
+	struct sof_fast_get_bucket *bucket;
+	struct sof_fast_get_entry *entry;
+	k_spinlock_key_t key;
+
+	for (;;) {
+		key = k_spin_lock(&data->lru_lock);
+		if (data->lru_size <= CONFIG_FAST_GET_LRU_SIZE) {
+			k_spin_unlock(&data->lru_lock, key);
+			return;
+		}
+
+		/* the pool reference now belongs to us */
+		entry = list_first_item(&data->lru, struct sof_fast_get_entry, lru);
+		list_item_del(&entry->lru);
+		data->lru_size -= entry->size;
+		entry->retained = false;
+		k_spin_unlock(&data->lru_lock, key);
 
-	for (i = 0; i < data->num_entries; i++) {
-		if (data->entries[i].dram_ptr == dram_ptr)
-			return &data->entries[i];
+		bucket = fast_get_bucket(data, entry->dram_ptr);
+		key = k_spin_lock(&bucket->dram_lock);
+		/* a fast_get() may have revived the entry meanwhile */
+		if (--entry->refcount) {
+			k_spin_unlock(&bucket->dram_lock, key);
+			continue;
+		}
+
+		fast_get_unlink(data, bucket, entry);
+		k_spin_unlock(&bucket->dram_lock, key);
+
+		tr_dbg(fast_get, "evict %p, size %u", entry->dram_ptr, entry->size);
+		fast_get_free(entry);
 	}
+}
 
-	for (i = 0; i < data->num_entries; i++) {
-		if (data->entries[i].dram_ptr == NULL)
-			return &data->entries[i];
+static struct sof_fast_get_entry *fast_get_entry_new(const void *dram_ptr, size_t size)
+{
+	struct sof_fast_get_entry *entry;
+
+	entry = rzalloc(SOF_MEM_ZONE_RUNTIME_SHARED, SOF_MEM_FLAG_COHERENT, SOF_MEM_CAPS_RAM,
+			sizeof(*entry));
+	if (!entry)
+		return NULL;
+
+	entry->sram_ptr = rmalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
+	if (!entry->sram_ptr) {
+		rfree(entry);
+		return NULL;
 	}
 
-	return NULL;
+	memcpy_s(entry->sram_ptr, size, dram_ptr, size);
+	entry->dram_ptr = dram_ptr;
+	entry->size = size;
+	entry->refcount = 1;
+
+	return entry;
 }
 
 const void *fast_get(const void *dram_ptr, size_t size)
 {
 	struct sof_fast_get_data *data = &fast_get_data;
+	struct sof_fast_get_bucket *bucket = fast_get_bucket(data, dram_ptr);
+	struct sof_fast_get_bucket *sram_bucket;
 	struct sof_fast_get_entry *entry;
-	k_spinlock_key_t key;
-	void *ret;
-
-	key = k_spin_lock(&data->lock);
-	do {
-		entry = fast_get_find_entry(data, dram_ptr);
-		if (!entry) {
-			if (fast_get_realloc(data)) {
-				ret = NULL;
-				goto out;
-			}
-		}
-	} while (!entry);
+	k_spinlock_key_t key, sram_key;
+	void *ret = NULL;
 
-	if (entry->sram_ptr) {
-		if (entry->size != size || entry->dram_ptr != dram_ptr) {
-			tr_err(fast_get, "size %u != %u or ptr %p != %p mismatch",
-				entry->size, size, entry->dram_ptr, dram_ptr);
-			ret = NULL;
+	key = k_spin_lock(&bucket->dram_lock);
+	entry = fast_get_find_entry(bucket, dram_ptr);
+	if (entry) {
+		if (entry->size != size) {
+			tr_err(fast_get, "size %u != %u mismatch for %p",
+			       entry->size, size, dram_ptr);
 			goto out;
 		}
 
+		if (!fast_get_lru_take(data, entry))
+			entry->refcount++;
+
 		ret = entry->sram_ptr;
-		entry->refcount++;
 		/*
 		 * The data is constant, so it's safe to use cached access to
 		 * it, but initially we have to invalidate cached
@@ -116,56 +256,61 @@ const void *fast_get(const void *dram_ptr, size_t size)
 		goto out;
 	}
 
-	ret = rmalloc(SOF_MEM_ZONE_RUNTIME, 0, SOF_MEM_CAPS_RAM, size);
-	if (!ret)
+	entry = fast_get_entry_new(dram_ptr, size);
+	if (!entry)
 		goto out;
-	entry->size = size;
-	entry->sram_ptr = ret;
-	memcpy_s(entry->sram_ptr, entry->size, dram_ptr, size);
-	entry->dram_ptr = dram_ptr;
-	entry->refcount = 1;
-out:
-	k_spin_unlock(&data->lock, key);
-	tr_dbg(fast_get, "get %p, %p, size %u, refcnt %u", dram_ptr, ret, size,
-	       entry ? entry->refcount : 0);
 
-	return ret;
-}
-EXPORT_SYMBOL(fast_get);
+	entry->dram_next = bucket->dram_entries;
+	bucket->dram_entries = entry;
 
-static struct sof_fast_get_entry *fast_put_find_entry(struct sof_fast_get_data *data,
-						      const void *sram_ptr)
-{
-	int i;
+	sram_bucket = fast_get_bucket(data, entry->sram_ptr);
+	sram_key = k_spin_lock(&sram_bucket->sram_lock);
+	entry->sram_next = sram_bucket->sram_entries;
+	sram_bucket->sram_entries = entry;
+	k_spin_unlock(&sram_bucket->sram_lock, sram_key);
 
-	for (i = 0; i < data->num_entries; i++) {
-		if (data->entries[i].sram_ptr == sram_ptr)
-			return &data->entries[i];
-	}
+	ret = entry->sram_ptr;
+out:
+	k_spin_unlock(&bucket->dram_lock, key);
+	tr_dbg(fast_get, "get %p, %p, size %u", dram_ptr, ret, size);
 
-	return NULL;
+	return ret;
 }
+EXPORT_SYMBOL(fast_get);
 
 void fast_put(const void *sram_ptr)
 {
 	struct sof_fast_get_data *data = &fast_get_data;
+	struct sof_fast_get_bucket *bucket = fast_get_bucket(data, sram_ptr);
 	struct sof_fast_get_entry *entry;
 	k_spinlock_key_t key;
+	bool retained = false;
 
-	key = k_spin_lock(&fast_get_data.lock);
-	entry = fast_put_find_entry(data, sram_ptr);
+	key = k_spin_lock(&bucket->sram_lock);
+	entry = fast_put_find_entry(bucket, sram_ptr);
+	k_spin_unlock(&bucket->sram_lock, key);
 	if (!entry) {
 		tr_err(fast_get, "Put called to unknown address %p", sram_ptr);
-		goto out;
-	}
-	entry->refcount--;
-	if (!entry->refcount) {
-		rfree(entry->sram_ptr);
-		memset(entry, 0, sizeof(*entry));
+		return;
 	}
-out:
-	tr_dbg(fast_get, "put %p, DRAM %p size %u refcnt %u", sram_ptr, entry ? entry->dram_ptr : 0,
-	       entry ? entry->size : 0, entry ? entry->refcount : 0);
-	k_spin_unlock(&data->lock, key);
+
+	/* our reference keeps the entry alive until it is dropped below */
+	bucket = fast_get_bucket(data, entry->dram_ptr);
+	key = k_spin_lock(&bucket->dram_lock);
+	if (entry->refcount == 1 && CONFIG_FAST_GET_LRU_SIZE)
+		retained = fast_get_lru_give(data, entry);
+
+	if (!retained && !--entry->refcount)
+		fast_get_unlink(data, bucket, entry);
+	else
+		entry = NULL;
+	k_spin_unlock(&bucket->dram_lock, key);
+
+	tr_dbg(fast_get, "put %p, retained %d", sram_ptr, retained);
+
+	if (entry)
+		fast_get_free(entry);
+	if (retained)
+		fast_get_lru_trim(data);
 }
 EXPORT_SYMBOL(fast_put);